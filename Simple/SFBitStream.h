@@ -0,0 +1,233 @@
+/**
+ * \file
+ * Declares the SFBitReader and SFBitWriter Objective-C interface classes.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "SFStream.h"
+#import "sfbits.h"
+
+/**
+ * \ingroup sf_networking
+ * Reads bit fields from a stream.
+ * Fields of any width up to 64 bits are read most significant bit first.
+ * The object loads the stream bytes 8 at a time in a register, so fields
+ * don't need to be shifted and masked out of whole integers.
+ *
+ * The read position of the stream moves ahead of the bits read, since bytes
+ * are loaded before they are needed. Call #synchronize before reading the
+ * stream directly.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFBitReader : NSObject
+/** @name Properties */ //@{
+// @property (nonatomic, readonly) SFStream *stream;//{{{
+/**
+ * Gets the stream read.
+ **/
+@property (nonatomic, readonly) SFStream *stream;
+//}}}
+// @property (nonatomic, readonly) size_t bitsAvailable;//{{{
+/**
+ * Gets the number of bits that can still be read.
+ **/
+@property (nonatomic, readonly) size_t bitsAvailable;
+//}}}
+// @property (nonatomic, readonly) error_t error;//{{{
+/**
+ * Gets the error number of the last failed operation.
+ * \c ENODATA when there are not enough bits in the stream.
+ **/
+@property (nonatomic, readonly) error_t error;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithStream:(SFStream *)stream;//{{{
+/**
+ * Initializes the object.
+ * @param stream The stream to read, starting at its read position. It is
+ * retained.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithStream:(SFStream *)stream;
+//}}}
+//@}
+
+/** @name Reading */ //@{
+// - (uint64_t)readBits:(unsigned)count;//{{{
+/**
+ * Reads a field.
+ * @param count Number of bits, from 0 to 64.
+ * @return The field, right aligned. Zero when there are not enough bits. In
+ * this case nothing is read and #error is set.
+ **/
+- (uint64_t)readBits:(unsigned)count;
+//}}}
+// - (uint64_t)readUnary;//{{{
+/**
+ * Reads an unary code: a number of zero bits followed by a one bit.
+ * @return The number of zero bits. Zero on failure. See #error.
+ **/
+- (uint64_t)readUnary;
+//}}}
+// - (uint64_t)readExpGolomb;//{{{
+/**
+ * Reads an unsigned exp-Golomb code of order zero.
+ * @return The value. Zero on failure. See #error.
+ **/
+- (uint64_t)readExpGolomb;
+//}}}
+// - (int64_t)readSignedExpGolomb;//{{{
+/**
+ * Reads a signed exp-Golomb code of order zero.
+ * @return The value. Zero on failure. See #error.
+ **/
+- (int64_t)readSignedExpGolomb;
+//}}}
+//@}
+
+/** @name Alignment */ //@{
+// - (void)alignToByte;//{{{
+/**
+ * Skips the bits up to the next byte boundary.
+ **/
+- (void)alignToByte;
+//}}}
+// - (void)synchronize;//{{{
+/**
+ * Moves the read position of the stream back to the next bit to read.
+ * After this the read position is just after the byte that has the next
+ * bit. When the object is aligned, see #alignToByte, the stream can be read
+ * directly and the object used again after that.
+ **/
+- (void)synchronize;
+//}}}
+//@}
+
+/** @name C Level Access */ //@{
+// - (bitreader_t *)handle;//{{{
+/**
+ * Gets the C structure of this reader.
+ * Use it with the functions of sfbits.h to read many fields without sending
+ * one message for each.
+ * @return The address of the structure. It is valid while this object is
+ * alive.
+ **/
+- (bitreader_t *)handle;
+//}}}
+//@}
+@end
+
+/**
+ * \ingroup sf_networking
+ * Writes bit fields in a stream.
+ * Fields are collected in a 64 bits register and stored in the stream when
+ * it is full. The last bits are kept in the object until #flush is called.
+ * Releasing the object doesn't flush it.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFBitWriter : NSObject
+/** @name Properties */ //@{
+// @property (nonatomic, readonly) SFStream *stream;//{{{
+/**
+ * Gets the stream written.
+ **/
+@property (nonatomic, readonly) SFStream *stream;
+//}}}
+// @property (nonatomic, readonly) error_t error;//{{{
+/**
+ * Gets the error number of the last failed operation.
+ * \c ENOMEM when the stream cannot grow. \c EINVAL when a value cannot be
+ * coded.
+ **/
+@property (nonatomic, readonly) error_t error;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithStream:(SFStream *)stream;//{{{
+/**
+ * Initializes the object.
+ * @param stream The stream to write, starting at its write position. It is
+ * retained.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithStream:(SFStream *)stream;
+//}}}
+//@}
+
+/** @name Writing */ //@{
+// - (BOOL)writeBits:(uint64_t)value count:(unsigned)count;//{{{
+/**
+ * Writes a field.
+ * @param value The field, right aligned. Bits above \a count are ignored.
+ * @param count Number of bits, from 0 to 64.
+ * @return \b YES on success. \b NO on failure. See #error.
+ **/
+- (BOOL)writeBits:(uint64_t)value count:(unsigned)count;
+//}}}
+// - (BOOL)writeUnary:(uint64_t)value;//{{{
+/**
+ * Writes an unary code.
+ * @param value Number of zero bits before the one bit.
+ * @return \b YES on success. \b NO on failure. See #error.
+ **/
+- (BOOL)writeUnary:(uint64_t)value;
+//}}}
+// - (BOOL)writeExpGolomb:(uint64_t)value;//{{{
+/**
+ * Writes an unsigned exp-Golomb code of order zero.
+ * @param value The value. \c UINT64_MAX cannot be coded.
+ * @return \b YES on success. \b NO on failure. See #error.
+ **/
+- (BOOL)writeExpGolomb:(uint64_t)value;
+//}}}
+// - (BOOL)writeSignedExpGolomb:(int64_t)value;//{{{
+/**
+ * Writes a signed exp-Golomb code of order zero.
+ * @param value The value. \c INT64_MIN cannot be coded.
+ * @return \b YES on success. \b NO on failure. See #error.
+ **/
+- (BOOL)writeSignedExpGolomb:(int64_t)value;
+//}}}
+//@}
+
+/** @name Alignment */ //@{
+// - (void)alignToByte;//{{{
+/**
+ * Writes zero bits up to the next byte boundary.
+ **/
+- (void)alignToByte;
+//}}}
+// - (BOOL)flush;//{{{
+/**
+ * Aligns the object and stores all its bits in the stream.
+ * @return \b YES on success. \b NO when the stream cannot grow.
+ **/
+- (BOOL)flush;
+//}}}
+//@}
+
+/** @name C Level Access */ //@{
+// - (bitwriter_t *)handle;//{{{
+/**
+ * Gets the C structure of this writer.
+ * @return The address of the structure. It is valid while this object is
+ * alive.
+ **/
+- (bitwriter_t *)handle;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,258 @@
+/**
+ * \file
+ * Defines the SFBitReader and SFBitWriter Objective-C interface classes.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFBitStream.h"
+#import "sfdebug.h"
+
+#include <sys/errno.h>
+
+/* ===========================================================================
+ * SFBitReader EXTENSION
+ * ======================================================================== */
+@interface SFBitReader () {
+    SFStream   *m_stream;
+    bitreader_t m_reader;
+    error_t     m_error;
+}
+@end
+
+/* ===========================================================================
+ * SFBitReader IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFBitReader
+// Properties
+// @property (nonatomic, readonly) SFStream *stream;//{{{
+@synthesize stream = m_stream;
+//}}}
+// @property (nonatomic, readonly) size_t bitsAvailable;//{{{
+- (size_t)bitsAvailable {
+    return SFBitReaderAvailable(&m_reader);
+}
+//}}}
+// @property (nonatomic, readonly) error_t error;//{{{
+@synthesize error = m_error;
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithStream:(SFStream *)stream;//{{{
+- (instancetype)initWithStream:(SFStream *)stream
+{
+    self = [super init];
+    if (self)
+    {
+        m_stream = [stream retain];
+        SFBitReaderInit(&m_reader, [stream handle]);
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [m_stream release];
+    [super dealloc];
+}
+//}}}
+
+// Reading
+// - (uint64_t)readBits:(unsigned)count;//{{{
+- (uint64_t)readBits:(unsigned)count
+{
+    uint64_t value = 0;
+
+    if (!SFBitReaderRead(&m_reader, count, &value))
+        m_error = ENODATA;
+
+    return value;
+}
+//}}}
+// - (uint64_t)readUnary;//{{{
+- (uint64_t)readUnary
+{
+    uint64_t value = 0;
+
+    if (!SFBitReaderReadUnary(&m_reader, &value))
+        m_error = ENODATA;
+
+    return value;
+}
+//}}}
+// - (uint64_t)readExpGolomb;//{{{
+- (uint64_t)readExpGolomb
+{
+    uint64_t value = 0;
+
+    if (!SFBitReaderReadExpGolomb(&m_reader, &value))
+        m_error = ENODATA;
+
+    return value;
+}
+//}}}
+// - (int64_t)readSignedExpGolomb;//{{{
+- (int64_t)readSignedExpGolomb
+{
+    int64_t value = 0;
+
+    if (!SFBitReaderReadSignedExpGolomb(&m_reader, &value))
+        m_error = ENODATA;
+
+    return value;
+}
+//}}}
+
+// Alignment
+// - (void)alignToByte;//{{{
+- (void)alignToByte
+{
+    SFBitReaderAlign(&m_reader);
+}
+//}}}
+// - (void)synchronize;//{{{
+- (void)synchronize
+{
+    SFBitReaderSync(&m_reader);
+}
+//}}}
+
+// C Level Access
+// - (bitreader_t *)handle;//{{{
+- (bitreader_t *)handle
+{
+    return &m_reader;
+}
+//}}}
+@end
+
+/* ===========================================================================
+ * SFBitWriter EXTENSION
+ * ======================================================================== */
+@interface SFBitWriter () {
+    SFStream   *m_stream;
+    bitwriter_t m_writer;
+    error_t     m_error;
+}
+@end
+
+/* ===========================================================================
+ * SFBitWriter IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFBitWriter
+// Properties
+// @property (nonatomic, readonly) SFStream *stream;//{{{
+@synthesize stream = m_stream;
+//}}}
+// @property (nonatomic, readonly) error_t error;//{{{
+@synthesize error = m_error;
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithStream:(SFStream *)stream;//{{{
+- (instancetype)initWithStream:(SFStream *)stream
+{
+    self = [super init];
+    if (self)
+    {
+        m_stream = [stream retain];
+        SFBitWriterInit(&m_writer, [stream handle]);
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [m_stream release];
+    [super dealloc];
+}
+//}}}
+
+// Writing
+// - (BOOL)writeBits:(uint64_t)value count:(unsigned)count;//{{{
+- (BOOL)writeBits:(uint64_t)value count:(unsigned)count
+{
+    if (count > 64) {
+        m_error = EINVAL;
+        return NO;
+    }
+
+    if (!SFBitWriterWrite(&m_writer, value, count)) {
+        m_error = ENOMEM;
+        return NO;
+    }
+    return YES;
+}
+//}}}
+// - (BOOL)writeUnary:(uint64_t)value;//{{{
+- (BOOL)writeUnary:(uint64_t)value
+{
+    if (!SFBitWriterWriteUnary(&m_writer, value)) {
+        m_error = ENOMEM;
+        return NO;
+    }
+    return YES;
+}
+//}}}
+// - (BOOL)writeExpGolomb:(uint64_t)value;//{{{
+- (BOOL)writeExpGolomb:(uint64_t)value
+{
+    if (!SFBitWriterWriteExpGolomb(&m_writer, value)) {
+        m_error = ((value == UINT64_MAX) ? EINVAL : ENOMEM);
+        return NO;
+    }
+    return YES;
+}
+//}}}
+// - (BOOL)writeSignedExpGolomb:(int64_t)value;//{{{
+- (BOOL)writeSignedExpGolomb:(int64_t)value
+{
+    if (!SFBitWriterWriteSignedExpGolomb(&m_writer, value)) {
+        m_error = ((value == INT64_MIN) ? EINVAL : ENOMEM);
+        return NO;
+    }
+    return YES;
+}
+//}}}
+
+// Alignment
+// - (void)alignToByte;//{{{
+- (void)alignToByte
+{
+    SFBitWriterAlign(&m_writer);
+}
+//}}}
+// - (BOOL)flush;//{{{
+- (BOOL)flush
+{
+    if (!SFBitWriterFlush(&m_writer)) {
+        m_error = ENOMEM;
+        return NO;
+    }
+    return YES;
+}
+//}}}
+
+// C Level Access
+// - (bitwriter_t *)handle;//{{{
+- (bitwriter_t *)handle
+{
+    return &m_writer;
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
@@ -0,0 +1,107 @@
+/**
+ * \file
+ * Declares the SFChunkPool Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+
+/**
+ * \ingroup sf_networking
+ * A synchronized pool of fixed size memory chunks.
+ * Chunks released to the pool are kept for reuse, up to a maximum number, so
+ * streams that grow and shrink all the time don't go to the system allocator
+ * for every chunk. The pool can be shared by any number of streams in any
+ * thread.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFChunkPool : NSObject
+/** @name Properties */ //@{
+// @property (nonatomic, readonly) size_t chunkSize;//{{{
+/**
+ * Gets the size, in bytes, of every chunk in this pool.
+ * This is always a power of two.
+ **/
+@property (nonatomic, readonly) size_t chunkSize;
+//}}}
+// @property (nonatomic, readonly) size_t maximumFreeChunks;//{{{
+/**
+ * Gets the maximum number of free chunks kept for reuse.
+ **/
+@property (nonatomic, readonly) size_t maximumFreeChunks;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithChunkSize:(size_t)size maximumFreeChunks:(size_t)maximum;//{{{
+/**
+ * Initializes the pool.
+ * @param size The size of every chunk. Will be rounded up to a power of two
+ * and cannot be less than 256 bytes.
+ * @param maximum Maximum number of free chunks kept for reuse. Chunks
+ * released beyond this limit are returned to the system.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithChunkSize:(size_t)size maximumFreeChunks:(size_t)maximum;
+//}}}
+//@}
+
+/** @name Statistics */ //@{
+// - (size_t)freeChunks;//{{{
+/**
+ * Gets the number of chunks waiting for reuse.
+ **/
+- (size_t)freeChunks;
+//}}}
+// - (size_t)chunksInUse;//{{{
+/**
+ * Gets the number of chunks allocated from this pool and not yet released.
+ **/
+- (size_t)chunksInUse;
+//}}}
+//@}
+
+/** @name Chunks */ //@{
+// - (void *)allocChunk;//{{{
+/**
+ * Gets one chunk from the pool.
+ * @return The address of a chunk with #chunkSize bytes. The content is not
+ * initialized. \b NULL when there is no memory available.
+ **/
+- (void *)allocChunk;
+//}}}
+// - (void)releaseChunk:(void *)chunk;//{{{
+/**
+ * Returns a chunk to the pool.
+ * @param chunk The address returned by #allocChunk. \b NULL is ignored.
+ **/
+- (void)releaseChunk:(void *)chunk;
+//}}}
+// - (void)drain;//{{{
+/**
+ * Returns all free chunks to the system.
+ **/
+- (void)drain;
+//}}}
+//@}
+
+/** @name Shared Pool */ //@{
+// + (SFChunkPool *)defaultPool;//{{{
+/**
+ * Gets the pool shared by the framework.
+ * @return A pool of 16 KB chunks keeping, at most, 64 free chunks.
+ **/
++ (SFChunkPool *)defaultPool;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,174 @@
+/**
+ * \file
+ * Defines the SFChunkPool Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFChunkPool.h"
+
+#include <stdlib.h>
+
+/**
+ * Minimum size of a chunk.
+ **/
+#define SFCHUNK_MINIMUM_SIZE        256
+
+/* ===========================================================================
+ * SFChunkPool EXTENSION
+ * ======================================================================== */
+@interface SFChunkPool () {
+    void  **m_free;
+    size_t  m_freeCount;
+    size_t  m_inUse;
+    size_t  m_chunkSize;
+    size_t  m_maximum;
+    NSLock *m_lock;
+}
+@end
+
+/* ===========================================================================
+ * SFChunkPool IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFChunkPool
+// Properties
+// @property (nonatomic, readonly) size_t chunkSize;//{{{
+@synthesize chunkSize = m_chunkSize;
+//}}}
+// @property (nonatomic, readonly) size_t maximumFreeChunks;//{{{
+@synthesize maximumFreeChunks = m_maximum;
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithChunkSize:(size_t)size maximumFreeChunks:(size_t)maximum;//{{{
+- (instancetype)initWithChunkSize:(size_t)size maximumFreeChunks:(size_t)maximum
+{
+    self = [super init];
+    if (self)
+    {
+        m_chunkSize = SFCHUNK_MINIMUM_SIZE;
+        while ((m_chunkSize < size) && (m_chunkSize < (SIZE_MAX / 2)))
+            m_chunkSize <<= 1;
+
+        m_maximum = maximum;
+        m_free = (void **)malloc(((maximum > 0) ? maximum : 1) * sizeof(void *));
+        m_lock = [NSLock new];
+
+        if (m_free == NULL) {
+            [self release];
+            return nil;
+        }
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [self drain];
+    free(m_free);
+    [m_lock release];
+    [super dealloc];
+}
+//}}}
+
+// Statistics
+// - (size_t)freeChunks;//{{{
+- (size_t)freeChunks
+{
+    size_t total;
+
+    [m_lock lock];
+    total = m_freeCount;
+    [m_lock unlock];
+
+    return total;
+}
+//}}}
+// - (size_t)chunksInUse;//{{{
+- (size_t)chunksInUse
+{
+    size_t total;
+
+    [m_lock lock];
+    total = m_inUse;
+    [m_lock unlock];
+
+    return total;
+}
+//}}}
+
+// Chunks
+// - (void *)allocChunk;//{{{
+- (void *)allocChunk
+{
+    void *chunk = NULL;
+
+    [m_lock lock];
+    if (m_freeCount > 0)
+        chunk = m_free[--m_freeCount];
+    [m_lock unlock];
+
+    if (chunk == NULL)
+        chunk = malloc(m_chunkSize);
+
+    if (chunk != NULL)
+    {
+        [m_lock lock];
+        m_inUse++;
+        [m_lock unlock];
+    }
+    return chunk;
+}
+//}}}
+// - (void)releaseChunk:(void *)chunk;//{{{
+- (void)releaseChunk:(void *)chunk
+{
+    if (chunk == NULL) return;
+
+    [m_lock lock];
+    m_inUse--;
+    if (m_freeCount < m_maximum) {
+        m_free[m_freeCount++] = chunk;
+        chunk = NULL;
+    }
+    [m_lock unlock];
+
+    if (chunk != NULL) free(chunk);
+}
+//}}}
+// - (void)drain;//{{{
+- (void)drain
+{
+    [m_lock lock];
+    while (m_freeCount > 0)
+        free(m_free[--m_freeCount]);
+    [m_lock unlock];
+}
+//}}}
+
+// Shared Pool
+// + (SFChunkPool *)defaultPool;//{{{
++ (SFChunkPool *)defaultPool
+{
+    static SFChunkPool *pool = nil;
+    static dispatch_once_t once;
+
+    dispatch_once(&once, ^{
+        pool = [[SFChunkPool alloc] initWithChunkSize:(16 * 1024) maximumFreeChunks:64];
+    });
+    return pool;
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
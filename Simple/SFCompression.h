@@ -0,0 +1,273 @@
+/**
+ * \file
+ * Declares the SFCompressor and SFDecompressor Objective-C interface classes.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "SFStream.h"
+
+/**
+ * \ingroup sf_networking
+ * \defgroup sf_compression_consts Constants
+ * Enumerations and constants for this group.
+ * @{ *//* ---------------------------------------------------------------- */
+typedef NS_ENUM(NSInteger, SFCompressionAlgorithm) {
+    SFCompressionDeflate = 0,   /**< zlib format. Better ratio.             */
+    SFCompressionLZ = 1         /**< Built-in LZ blocks. Faster.            */
+};
+
+/**
+ * Default compression level. Used by \c initWithStream:algorithm:.
+ **/
+#define SF_COMPRESSION_DEFAULT_LEVEL    6
+
+/**
+ * Greatest number of uncompressed bytes in a block of \c SFCompressionLZ.
+ **/
+#define SF_COMPRESSION_BLOCK_SIZE       (64 * 1024)
+///@} sf_compression_consts
+
+/**
+ * \ingroup sf_networking
+ * Compresses data into a stream.
+ * Data given to the object is compressed in pieces and appended to the
+ * output stream, directly in its buffer. Only one block of data is kept by
+ * the object, so the memory used doesn't depend on the size of the payload.
+ *
+ * The \c SFCompressionLZ format is a sequence of blocks. Each block starts
+ * with the varint number of uncompressed bytes, zero marking the end, then
+ * the varint number of stored bytes shifted left by one, with the low bit set
+ * when the block is stored uncompressed, then the block bytes.
+ * @remarks \c SFCompressionDeflate uses the system zlib. Apps that import
+ * the framework as a module (\c \@import Simple or with \c CLANG_MODULES
+ * enabled) link it automatically. Others must add \c -lz to their linker
+ * flags, since the framework is a static library.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFCompressor : NSObject
+/** @name Properties */ //@{
+// @property (nonatomic, readonly) SFStream *stream;//{{{
+/**
+ * Gets the stream that receives the compressed data.
+ **/
+@property (nonatomic, readonly) SFStream *stream;
+//}}}
+// @property (nonatomic, readonly) SFCompressionAlgorithm algorithm;//{{{
+/**
+ * Gets the algorithm used.
+ **/
+@property (nonatomic, readonly) SFCompressionAlgorithm algorithm;
+//}}}
+// @property (nonatomic, readonly) error_t error;//{{{
+/**
+ * Gets the error number of the last failed operation.
+ * \c ENOMEM when the output stream cannot grow.
+ **/
+@property (nonatomic, readonly) error_t error;
+//}}}
+//@}
+
+/** @name Counters */ //@{
+// @property (nonatomic, readonly) uint64_t bytesIn;//{{{
+/**
+ * Gets the number of uncompressed bytes given to this object.
+ **/
+@property (nonatomic, readonly) uint64_t bytesIn;
+//}}}
+// @property (nonatomic, readonly) uint64_t bytesOut;//{{{
+/**
+ * Gets the number of compressed bytes written in the stream.
+ **/
+@property (nonatomic, readonly) uint64_t bytesOut;
+//}}}
+// @property (nonatomic, readonly) double ratio;//{{{
+/**
+ * Gets the compression ratio: #bytesIn divided by #bytesOut.
+ * Zero when nothing was written yet.
+ **/
+@property (nonatomic, readonly) double ratio;
+//}}}
+// @property (nonatomic, readonly) double throughput;//{{{
+/**
+ * Gets the number of uncompressed bytes processed per second.
+ * Only the time spent in this object is counted.
+ **/
+@property (nonatomic, readonly) double throughput;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm level:(int)level;//{{{
+/**
+ * Initializes the object.
+ * @param stream The stream that receives the compressed data. It is
+ * retained.
+ * @param algorithm The algorithm to use.
+ * @param level From 1 (fastest) to 9 (smallest). Used by \c
+ * SFCompressionDeflate only.
+ * @return This object initialized. \b nil when there is no memory
+ * available.
+ **/
+- (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm level:(int)level;
+//}}}
+// - (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm;//{{{
+/**
+ * Initializes the object with the default compression level.
+ * @param stream The stream that receives the compressed data.
+ * @param algorithm The algorithm to use.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm;
+//}}}
+//@}
+
+/** @name Operations */ //@{
+// - (BOOL)write:(const void *)data length:(size_t)length;//{{{
+/**
+ * Compresses data.
+ * @param data Bytes to compress.
+ * @param length Number of bytes in \a data.
+ * @return \b YES on success. \b NO on failure. See #error.
+ * @remarks Compressed bytes may be kept by the object until a block is
+ * complete. Use #flush to write all of them.
+ **/
+- (BOOL)write:(const void *)data length:(size_t)length;
+//}}}
+// - (BOOL)flush;//{{{
+/**
+ * Writes all pending data in the stream.
+ * After this the receiver can decompress everything written so far. Each
+ * flush costs a few bytes and ends the current block, so flush at message
+ * boundaries only.
+ * @return \b YES on success. \b NO on failure.
+ **/
+- (BOOL)flush;
+//}}}
+// - (BOOL)finish;//{{{
+/**
+ * Writes all pending data and the end of the compressed data.
+ * Nothing can be written after this.
+ * @return \b YES on success. \b NO on failure.
+ **/
+- (BOOL)finish;
+//}}}
+//@}
+@end
+
+/**
+ * \ingroup sf_networking
+ * Decompresses data from a stream.
+ * The object reads compressed bytes from the input stream as they arrive and
+ * gives back the uncompressed data in pieces. Incomplete input is not an
+ * error: the operations return zero until more bytes are written in the
+ * input stream.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFDecompressor : NSObject
+/** @name Properties */ //@{
+// @property (nonatomic, readonly) SFStream *stream;//{{{
+/**
+ * Gets the stream with the compressed data.
+ **/
+@property (nonatomic, readonly) SFStream *stream;
+//}}}
+// @property (nonatomic, readonly) SFCompressionAlgorithm algorithm;//{{{
+/**
+ * Gets the algorithm used.
+ **/
+@property (nonatomic, readonly) SFCompressionAlgorithm algorithm;
+//}}}
+// @property (nonatomic, readonly, getter=isFinished) BOOL finished;//{{{
+/**
+ * Gets whether the end of the compressed data was reached and all bytes
+ * were read.
+ **/
+@property (nonatomic, readonly, getter=isFinished) BOOL finished;
+//}}}
+// @property (nonatomic, readonly) error_t error;//{{{
+/**
+ * Gets the error number of the last failed operation.
+ * \c EILSEQ when the compressed data is malformed. \c ENOMEM when there is
+ * no memory available.
+ **/
+@property (nonatomic, readonly) error_t error;
+//}}}
+//@}
+
+/** @name Counters */ //@{
+// @property (nonatomic, readonly) uint64_t bytesIn;//{{{
+/**
+ * Gets the number of compressed bytes consumed from the stream.
+ **/
+@property (nonatomic, readonly) uint64_t bytesIn;
+//}}}
+// @property (nonatomic, readonly) uint64_t bytesOut;//{{{
+/**
+ * Gets the number of uncompressed bytes produced.
+ **/
+@property (nonatomic, readonly) uint64_t bytesOut;
+//}}}
+// @property (nonatomic, readonly) double ratio;//{{{
+/**
+ * Gets the compression ratio: #bytesOut divided by #bytesIn.
+ * Zero when nothing was read yet.
+ **/
+@property (nonatomic, readonly) double ratio;
+//}}}
+// @property (nonatomic, readonly) double throughput;//{{{
+/**
+ * Gets the number of uncompressed bytes produced per second.
+ * Only the time spent in this object is counted.
+ **/
+@property (nonatomic, readonly) double throughput;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm;//{{{
+/**
+ * Initializes the object.
+ * @param stream The stream with the compressed data, starting at its read
+ * position. It is retained.
+ * @param algorithm The algorithm used to compress the data.
+ * @return This object initialized. \b nil when there is no memory
+ * available.
+ **/
+- (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm;
+//}}}
+//@}
+
+/** @name Operations */ //@{
+// - (size_t)read:(void *)buffer length:(size_t)length;//{{{
+/**
+ * Decompresses data.
+ * @param buffer Where to store the uncompressed bytes.
+ * @param length Number of bytes available in \a buffer.
+ * @return The number of bytes stored in \a buffer. Zero when more input is
+ * needed, at the end of the data or on failure (see #error).
+ **/
+- (size_t)read:(void *)buffer length:(size_t)length;
+//}}}
+// - (size_t)readIntoStream:(SFStream *)stream;//{{{
+/**
+ * Decompresses all available input into another stream.
+ * The bytes are stored directly in the buffer of \a stream, at its write
+ * position.
+ * @param stream The stream that receives the uncompressed bytes.
+ * @return The number of bytes written in \a stream.
+ **/
+- (size_t)readIntoStream:(SFStream *)stream;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,630 @@
+/**
+ * \file
+ * Defines the SFCompressor and SFDecompressor Objective-C interface classes.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFCompression.h"
+#import "sfvarint.h"
+#import "sflz.h"
+#import "sfdebug.h"
+
+#include <stdlib.h>
+#include <sys/errno.h>
+#include <zlib.h>
+
+/**
+ * Number of bytes reserved in the output stream for each call to zlib.
+ **/
+#define SF_COMPRESSION_CHUNK_SIZE   (16 * 1024)
+
+/**
+ * Greatest number of input bytes given to zlib at once. Its counters are
+ * 32 bits wide.
+ **/
+#define SF_COMPRESSION_ZLIB_LIMIT   (1024 * 1024 * 1024)
+
+// static double SFCompressionThroughput(uint64_t bytes, CFTimeInterval seconds);//{{{
+/**
+ * Bytes per second, or zero when no time was measured.
+ **/
+static double SFCompressionThroughput(uint64_t bytes, CFTimeInterval seconds)
+{
+    return ((seconds > 0.0) ? ((double)bytes / seconds) : 0.0);
+}
+//}}}
+
+/* ===========================================================================
+ * SFCompressor EXTENSION
+ * ======================================================================== */
+@interface SFCompressor () {
+    SFStream *m_stream;
+    SFCompressionAlgorithm m_algorithm;
+    z_stream  m_zstream;
+    uint8_t  *m_block;              /* Pending bytes of the LZ format.      */
+    size_t    m_blockLength;
+    uint32_t *m_table;              /* SFLZCompress() work memory.          */
+    BOOL      m_finished;
+    uint64_t  m_bytesIn;
+    uint64_t  m_bytesOut;
+    CFTimeInterval m_seconds;
+    error_t   m_error;
+}
+// - (BOOL)deflate:(const uint8_t *)data length:(size_t)length mode:(int)mode;//{{{
+/**
+ * Runs zlib over the data, appending its output in the stream.
+ **/
+- (BOOL)deflate:(const uint8_t *)data length:(size_t)length mode:(int)mode;
+//}}}
+// - (BOOL)writeBlock:(const uint8_t *)data length:(size_t)length;//{{{
+/**
+ * Compresses one block of the LZ format into the stream.
+ **/
+- (BOOL)writeBlock:(const uint8_t *)data length:(size_t)length;
+//}}}
+@end
+
+/* ===========================================================================
+ * SFCompressor IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFCompressor
+// Properties
+// @property (nonatomic, readonly) SFStream *stream;//{{{
+@synthesize stream = m_stream;
+//}}}
+// @property (nonatomic, readonly) SFCompressionAlgorithm algorithm;//{{{
+@synthesize algorithm = m_algorithm;
+//}}}
+// @property (nonatomic, readonly) error_t error;//{{{
+@synthesize error = m_error;
+//}}}
+
+// Counters
+// @property (nonatomic, readonly) uint64_t bytesIn;//{{{
+@synthesize bytesIn = m_bytesIn;
+//}}}
+// @property (nonatomic, readonly) uint64_t bytesOut;//{{{
+@synthesize bytesOut = m_bytesOut;
+//}}}
+// @property (nonatomic, readonly) double ratio;//{{{
+- (double)ratio {
+    return ((m_bytesOut > 0) ? ((double)m_bytesIn / (double)m_bytesOut) : 0.0);
+}
+//}}}
+// @property (nonatomic, readonly) double throughput;//{{{
+- (double)throughput {
+    return SFCompressionThroughput(m_bytesIn, m_seconds);
+}
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm level:(int)level;//{{{
+- (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm level:(int)level
+{
+    self = [super init];
+    if (self)
+    {
+        m_stream = [stream retain];
+        m_algorithm = algorithm;
+
+        if (algorithm == SFCompressionDeflate)
+        {
+            if (deflateInit(&m_zstream, level) != Z_OK)
+            {
+                m_algorithm = SFCompressionLZ;  /* Nothing to end in dealloc. */
+                [self release];
+                return nil;
+            }
+        }
+        else
+        {
+            m_block = (uint8_t *)malloc(SF_COMPRESSION_BLOCK_SIZE);
+            m_table = (uint32_t *)malloc(SF_LZ_TABLE_SIZE * sizeof(uint32_t));
+
+            if ((m_block == NULL) || (m_table == NULL))
+            {
+                [self release];
+                return nil;
+            }
+        }
+    }
+    return self;
+}
+//}}}
+// - (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm;//{{{
+- (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm
+{
+    return [self initWithStream:stream algorithm:algorithm level:SF_COMPRESSION_DEFAULT_LEVEL];
+}
+//}}}
+
+// NSObject: Overrides
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    if (m_algorithm == SFCompressionDeflate)
+        deflateEnd(&m_zstream);
+
+    if (m_block != NULL) free(m_block);
+    if (m_table != NULL) free(m_table);
+
+    [m_stream release];
+    [super dealloc];
+}
+//}}}
+
+// Operations
+// - (BOOL)write:(const void *)data length:(size_t)length;//{{{
+- (BOOL)write:(const void *)data length:(size_t)length
+{
+    const uint8_t *ptr = (const uint8_t *)data;
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    BOOL result = YES;
+
+    if (m_finished) {
+        m_error = EINVAL;
+        return NO;
+    }
+
+    m_bytesIn += length;
+
+    if (m_algorithm == SFCompressionDeflate)
+    {
+        while (result && (length > 0))
+        {
+            size_t part = ((length < SF_COMPRESSION_ZLIB_LIMIT) ? length : SF_COMPRESSION_ZLIB_LIMIT);
+
+            result = [self deflate:ptr length:part mode:Z_NO_FLUSH];
+            ptr += part; length -= part;
+        }
+    }
+    else
+    {
+        while (result && (length > 0))
+        {
+            /* Whole blocks are compressed from the caller memory. */
+            if ((m_blockLength == 0) && (length >= SF_COMPRESSION_BLOCK_SIZE))
+            {
+                result = [self writeBlock:ptr length:SF_COMPRESSION_BLOCK_SIZE];
+                ptr += SF_COMPRESSION_BLOCK_SIZE; length -= SF_COMPRESSION_BLOCK_SIZE;
+                continue;
+            }
+
+            size_t part = (SF_COMPRESSION_BLOCK_SIZE - m_blockLength);
+            if (part > length) part = length;
+
+            memcpy((m_block + m_blockLength), ptr, part);
+            m_blockLength += part;
+            ptr += part; length -= part;
+
+            if (m_blockLength == SF_COMPRESSION_BLOCK_SIZE)
+            {
+                result = [self writeBlock:m_block length:m_blockLength];
+                m_blockLength = 0;
+            }
+        }
+    }
+
+    m_seconds += (CFAbsoluteTimeGetCurrent() - start);
+    return result;
+}
+//}}}
+// - (BOOL)flush;//{{{
+- (BOOL)flush
+{
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    BOOL result = YES;
+
+    if (m_finished)
+        return YES;
+
+    if (m_algorithm == SFCompressionDeflate)
+        result = [self deflate:NULL length:0 mode:Z_SYNC_FLUSH];
+    else if (m_blockLength > 0)
+    {
+        result = [self writeBlock:m_block length:m_blockLength];
+        m_blockLength = 0;
+    }
+
+    m_seconds += (CFAbsoluteTimeGetCurrent() - start);
+    return result;
+}
+//}}}
+// - (BOOL)finish;//{{{
+- (BOOL)finish
+{
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    BOOL result;
+
+    if (m_finished)
+        return YES;
+
+    if (m_algorithm == SFCompressionDeflate)
+        result = [self deflate:NULL length:0 mode:Z_FINISH];
+    else if ((result = [self flush]))
+    {
+        /* A block with no bytes marks the end. */
+        result = SFStreamWriteVarint([m_stream handle], 0);
+        if (result)
+            m_bytesOut += 1;
+        else
+            m_error = ENOMEM;
+    }
+
+    m_finished = result;
+    m_seconds += (CFAbsoluteTimeGetCurrent() - start);
+    return result;
+}
+//}}}
+
+// Local Operations
+// - (BOOL)deflate:(const uint8_t *)data length:(size_t)length mode:(int)mode;//{{{
+- (BOOL)deflate:(const uint8_t *)data length:(size_t)length mode:(int)mode
+{
+    stream_t *output = [m_stream handle];
+    int result = Z_OK;
+
+    m_zstream.next_in = (Bytef *)data;
+    m_zstream.avail_in = (uInt)length;
+
+    do {
+        uint8_t *ptr = __SFStreamReserve(output, SF_COMPRESSION_CHUNK_SIZE);
+
+        if (ptr == NULL) {
+            m_error = ENOMEM;
+            return NO;
+        }
+
+        m_zstream.next_out = ptr;
+        m_zstream.avail_out = SF_COMPRESSION_CHUNK_SIZE;
+
+        result = deflate(&m_zstream, mode);
+        if (result == Z_STREAM_ERROR) {
+            m_error = EINVAL;
+            return NO;
+        }
+
+        size_t produced = (SF_COMPRESSION_CHUNK_SIZE - m_zstream.avail_out);
+        __SFStreamCommit(output, produced);
+        m_bytesOut += produced;
+
+    } while ((result != Z_STREAM_END) && ((m_zstream.avail_out == 0) || (m_zstream.avail_in > 0)));
+
+    return YES;
+}
+//}}}
+// - (BOOL)writeBlock:(const uint8_t *)data length:(size_t)length;//{{{
+- (BOOL)writeBlock:(const uint8_t *)data length:(size_t)length
+{
+    stream_t *output = [m_stream handle];
+    size_t bound = SFLZCompressBound(length);
+    size_t header = SFVarintSize(length);
+    size_t room = SFVarintSize(((uint64_t)bound << 1) | 1);
+    uint8_t *ptr = __SFStreamReserve(output, (header + room + bound));
+
+    if (ptr == NULL) {
+        m_error = ENOMEM;
+        return NO;
+    }
+
+    /* Compressed in place, after room for the largest size prefix. */
+    SFVarintEncode(ptr, length);
+    size_t packed = SFLZCompress(data, length, (ptr + header + room), bound, m_table);
+    uint64_t prefix = (((uint64_t)packed << 1) | 0);
+
+    if ((packed == 0) || (packed >= length))
+    {
+        packed = length;                /* Stored uncompressed. */
+        prefix = (((uint64_t)length << 1) | 1);
+        memcpy((ptr + header + room), data, length);
+    }
+
+    size_t size = SFVarintEncode((ptr + header), prefix);
+    if (size < room)
+        memmove((ptr + header + size), (ptr + header + room), packed);
+
+    __SFStreamCommit(output, (header + size + packed));
+    m_bytesOut += (header + size + packed);
+    return YES;
+}
+//}}}
+@end
+
+/* ===========================================================================
+ * SFDecompressor EXTENSION
+ * ======================================================================== */
+@interface SFDecompressor () {
+    SFStream *m_stream;
+    SFCompressionAlgorithm m_algorithm;
+    z_stream  m_zstream;
+    uint8_t  *m_block;              /* Decoded LZ block not read yet.       */
+    size_t    m_blockLength;
+    size_t    m_blockOffset;
+    BOOL      m_ended;              /* End of the compressed data found.    */
+    uint64_t  m_bytesIn;
+    uint64_t  m_bytesOut;
+    CFTimeInterval m_seconds;
+    error_t   m_error;
+}
+// - (size_t)inflate:(uint8_t *)buffer length:(size_t)length;//{{{
+/**
+ * Runs zlib over the available input.
+ **/
+- (size_t)inflate:(uint8_t *)buffer length:(size_t)length;
+//}}}
+// - (size_t)readBlock:(uint8_t *)buffer length:(size_t)length;//{{{
+/**
+ * Decodes the next LZ block. When it fits in \a buffer it is decoded there
+ * and its length is returned. Otherwise it is decoded in the internal block
+ * and zero is returned.
+ **/
+- (size_t)readBlock:(uint8_t *)buffer length:(size_t)length;
+//}}}
+@end
+
+/* ===========================================================================
+ * SFDecompressor IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFDecompressor
+// Properties
+// @property (nonatomic, readonly) SFStream *stream;//{{{
+@synthesize stream = m_stream;
+//}}}
+// @property (nonatomic, readonly) SFCompressionAlgorithm algorithm;//{{{
+@synthesize algorithm = m_algorithm;
+//}}}
+// @property (nonatomic, readonly, getter=isFinished) BOOL finished;//{{{
+- (BOOL)isFinished {
+    return (m_ended && (m_blockOffset == m_blockLength));
+}
+//}}}
+// @property (nonatomic, readonly) error_t error;//{{{
+@synthesize error = m_error;
+//}}}
+
+// Counters
+// @property (nonatomic, readonly) uint64_t bytesIn;//{{{
+@synthesize bytesIn = m_bytesIn;
+//}}}
+// @property (nonatomic, readonly) uint64_t bytesOut;//{{{
+@synthesize bytesOut = m_bytesOut;
+//}}}
+// @property (nonatomic, readonly) double ratio;//{{{
+- (double)ratio {
+    return ((m_bytesIn > 0) ? ((double)m_bytesOut / (double)m_bytesIn) : 0.0);
+}
+//}}}
+// @property (nonatomic, readonly) double throughput;//{{{
+- (double)throughput {
+    return SFCompressionThroughput(m_bytesOut, m_seconds);
+}
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm;//{{{
+- (instancetype)initWithStream:(SFStream *)stream algorithm:(SFCompressionAlgorithm)algorithm
+{
+    self = [super init];
+    if (self)
+    {
+        m_stream = [stream retain];
+        m_algorithm = algorithm;
+
+        if (algorithm == SFCompressionDeflate)
+        {
+            if (inflateInit(&m_zstream) != Z_OK)
+            {
+                m_algorithm = SFCompressionLZ;  /* Nothing to end in dealloc. */
+                [self release];
+                return nil;
+            }
+        }
+        else if ((m_block = (uint8_t *)malloc(SF_COMPRESSION_BLOCK_SIZE)) == NULL)
+        {
+            [self release];
+            return nil;
+        }
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    if (m_algorithm == SFCompressionDeflate)
+        inflateEnd(&m_zstream);
+
+    if (m_block != NULL) free(m_block);
+
+    [m_stream release];
+    [super dealloc];
+}
+//}}}
+
+// Operations
+// - (size_t)read:(void *)buffer length:(size_t)length;//{{{
+- (size_t)read:(void *)buffer length:(size_t)length
+{
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    uint8_t *ptr = (uint8_t *)buffer;
+    size_t total = 0;
+
+    if ((buffer == NULL) || (length == 0))
+        return 0;
+
+    if (m_algorithm == SFCompressionDeflate)
+        total = [self inflate:ptr length:length];
+    else
+    {
+        while (total < length)
+        {
+            if (m_blockOffset < m_blockLength)
+            {
+                size_t part = (m_blockLength - m_blockOffset);
+                if (part > (length - total)) part = (length - total);
+
+                memcpy((ptr + total), (m_block + m_blockOffset), part);
+                m_blockOffset += part;
+                total += part;
+                continue;
+            }
+
+            if (m_ended || (m_error != 0))
+                break;
+
+            size_t decoded = [self readBlock:(ptr + total) length:(length - total)];
+            if ((decoded == 0) && (m_blockLength == 0))
+                break;              /* Incomplete input, end or failure. */
+
+            total += decoded;
+        }
+    }
+
+    m_bytesOut += total;
+    m_seconds += (CFAbsoluteTimeGetCurrent() - start);
+    return total;
+}
+//}}}
+// - (size_t)readIntoStream:(SFStream *)stream;//{{{
+- (size_t)readIntoStream:(SFStream *)stream
+{
+    stream_t *output = [stream handle];
+    size_t total = 0, done;
+
+    do {
+        uint8_t *ptr = __SFStreamReserve(output, SF_COMPRESSION_BLOCK_SIZE);
+
+        if (ptr == NULL) {
+            m_error = ENOMEM;
+            break;
+        }
+
+        done = [self read:ptr length:SF_COMPRESSION_BLOCK_SIZE];
+        __SFStreamCommit(output, done);
+        total += done;
+    } while (done > 0);
+
+    return total;
+}
+//}}}
+
+// Local Operations
+// - (size_t)inflate:(uint8_t *)buffer length:(size_t)length;//{{{
+- (size_t)inflate:(uint8_t *)buffer length:(size_t)length
+{
+    stream_t *input = [m_stream handle];
+    size_t available = SFStreamAvailable(input);
+    int result;
+
+    if (m_ended)
+        return 0;
+
+    if (available > SF_COMPRESSION_ZLIB_LIMIT) available = SF_COMPRESSION_ZLIB_LIMIT;
+    if (length > SF_COMPRESSION_ZLIB_LIMIT) length = SF_COMPRESSION_ZLIB_LIMIT;
+
+    m_zstream.next_in = (input->buffer + input->nextRead);
+    m_zstream.avail_in = (uInt)available;
+    m_zstream.next_out = buffer;
+    m_zstream.avail_out = (uInt)length;
+
+    result = inflate(&m_zstream, Z_NO_FLUSH);
+
+    size_t consumed = (available - m_zstream.avail_in);
+    input->nextRead += consumed;
+    m_bytesIn += consumed;
+
+    switch (result)
+    {
+    case Z_STREAM_END:
+        m_ended = YES;
+        break;
+    case Z_NEED_DICT:
+    case Z_DATA_ERROR:
+        m_error = EILSEQ;
+        break;
+    case Z_MEM_ERROR:
+        m_error = ENOMEM;
+        break;
+    }
+    /* Z_BUF_ERROR only means that more input is needed. */
+    return (length - m_zstream.avail_out);
+}
+//}}}
+// - (size_t)readBlock:(uint8_t *)buffer length:(size_t)length;//{{{
+- (size_t)readBlock:(uint8_t *)buffer length:(size_t)length
+{
+    stream_t *input = [m_stream handle];
+    const uint8_t *ptr = (input->buffer + input->nextRead);
+    size_t available = SFStreamAvailable(input);
+    uint64_t raw = 0, prefix = 0;
+    int header, size;
+
+    m_blockLength = m_blockOffset = 0;
+
+    if ((header = SFVarintDecode(ptr, available, &raw)) <= 0)
+    {
+        if (header < 0) m_error = EILSEQ;
+        return 0;
+    }
+
+    if (raw == 0)
+    {
+        m_ended = YES;
+        input->nextRead += (size_t)header;
+        m_bytesIn += (size_t)header;
+        return 0;
+    }
+
+    if ((size = SFVarintDecode((ptr + header), (available - (size_t)header), &prefix)) <= 0)
+    {
+        if (size < 0) m_error = EILSEQ;
+        return 0;
+    }
+
+    size_t packed = (size_t)(prefix >> 1);
+    BOOL stored = (BOOL)(prefix & 1);
+
+    if ((raw > SF_COMPRESSION_BLOCK_SIZE) || (packed > SFLZCompressBound(SF_COMPRESSION_BLOCK_SIZE)) || (stored && (packed != raw)))
+    {
+        m_error = EILSEQ;
+        return 0;
+    }
+
+    if ((available - (size_t)(header + size)) < packed)
+        return 0;                   /* The block is not complete yet. */
+
+    /* Small buffers receive the block through the internal one. */
+    uint8_t *dest = ((length >= raw) ? buffer : m_block);
+    const uint8_t *src = (ptr + header + size);
+
+    if (stored)
+        memcpy(dest, src, packed);
+    else if (SFLZDecompress(src, packed, dest, (size_t)raw) != (intptr_t)raw)
+    {
+        m_error = EILSEQ;
+        return 0;
+    }
+
+    input->nextRead += (size_t)(header + size) + packed;
+    m_bytesIn += (size_t)(header + size) + packed;
+
+    if (dest == buffer)
+        return (size_t)raw;
+
+    m_blockLength = (size_t)raw;
+    return 0;
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
@@ -0,0 +1,192 @@
+/**
+ * \file
+ * Declares the SFConnectionPool Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "sfstd.h"
+#import "SFSocket.h"
+#import "SFSocketLoop.h"
+
+/**
+ * \ingroup sf_networking
+ * Keeps connections open to be reused by later requests.
+ * Connections are kept by \e host:port. A request takes an idle connection
+ * when there is one, so it doesn't pay the TCP handshake, or opens a new
+ * one. When the host already has #maximumConnections connections the
+ * request waits for one to be released.
+ *
+ * Before an idle connection is given, it is checked with a \c recv() peek
+ * that doesn't wait: a connection closed by the peer, failed or with
+ * unexpected data is closed and not used. Idle connections are also closed
+ * after #idleTimeout seconds by #evictIdleConnections, that can run in a
+ * timer of an SFSocketLoop.
+ *
+ * The class is thread safe.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFConnectionPool : NSObject
+/** @name Properties */ //@{
+// @property (nonatomic) NSUInteger maximumConnections;//{{{
+/**
+ * Gets or sets the greatest number of connections of each host, idle or in
+ * use. Default is 16.
+ **/
+@property (nonatomic) NSUInteger maximumConnections;
+//}}}
+// @property (nonatomic) NSUInteger maximumIdleConnections;//{{{
+/**
+ * Gets or sets the greatest number of idle connections kept for each host.
+ * Connections released above this number are closed. Default is 4.
+ **/
+@property (nonatomic) NSUInteger maximumIdleConnections;
+//}}}
+// @property (nonatomic) NSTimeInterval idleTimeout;//{{{
+/**
+ * Gets or sets the number of seconds an idle connection is kept.
+ * Default is 30 seconds.
+ **/
+@property (nonatomic) NSTimeInterval idleTimeout;
+//}}}
+// @property (nonatomic) NSTimeInterval connectTimeout;//{{{
+/**
+ * Gets or sets the greatest number of seconds a request waits for a
+ * connection, including the handshake. Default is 10 seconds.
+ **/
+@property (nonatomic) NSTimeInterval connectTimeout;
+//}}}
+//@}
+
+/** @name Statistics */ //@{
+// @property (nonatomic, readonly) uint64_t numberOfRequests;//{{{
+/**
+ * Gets the number of connections requested.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfRequests;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfHits;//{{{
+/**
+ * Gets the number of requests answered with an idle connection.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfHits;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfHandshakes;//{{{
+/**
+ * Gets the number of connections opened, including pre-warmed ones.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfHandshakes;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfEvictions;//{{{
+/**
+ * Gets the number of idle connections closed because they expired or were
+ * not alive anymore.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfEvictions;
+//}}}
+// @property (nonatomic, readonly) double hitRate;//{{{
+/**
+ * Gets the fraction of requests, from 0.0 to 1.0, answered with an idle
+ * connection.
+ **/
+@property (nonatomic, readonly) double hitRate;
+//}}}
+// @property (nonatomic, readonly) NSTimeInterval averageWaitTime;//{{{
+/**
+ * Gets the average number of seconds the requests waited for a connection.
+ * The time includes handshakes and the waits for a connection released.
+ **/
+@property (nonatomic, readonly) NSTimeInterval averageWaitTime;
+//}}}
+// - (void)resetStatistics;//{{{
+/**
+ * Sets all counters to zero.
+ **/
+- (void)resetStatistics;
+//}}}
+//@}
+
+/** @name Connections */ //@{
+// - (SFSocket *)connectionToHost:(NSString *)host port:(NSUInteger)port error:(error_t *)error;//{{{
+/**
+ * Gets a connection to a host.
+ * An idle connection is used when available. Otherwise a new connection is
+ * opened and the caller waits until it is ready.
+ * @param host Name or numeric address of the host.
+ * @param port The port.
+ * @param error Receives zero or the error number. \c ETIMEDOUT when no
+ * connection was available in #connectTimeout seconds. Can be \c NULL.
+ * @return A connected socket, in non-blocking mode. \b nil on failure. It
+ * must be given back with #releaseConnection: or #discardConnection:.
+ **/
+- (SFSocket *)connectionToHost:(NSString *)host port:(NSUInteger)port error:(error_t *)error;
+//}}}
+// - (void)releaseConnection:(SFSocket *)socket;//{{{
+/**
+ * Gives back a connection to be reused.
+ * The connection is closed when it failed, is closed, has data in its write
+ * queue or the host already has #maximumIdleConnections idle connections.
+ * Remove it from any SFSocketLoop before this call.
+ * @param socket The connection given by #connectionToHost:port:error:.
+ **/
+- (void)releaseConnection:(SFSocket *)socket;
+//}}}
+// - (void)discardConnection:(SFSocket *)socket;//{{{
+/**
+ * Closes a connection that must not be reused.
+ * @param socket The connection given by #connectionToHost:port:error:.
+ **/
+- (void)discardConnection:(SFSocket *)socket;
+//}}}
+// - (NSUInteger)prewarmHost:(NSString *)host port:(NSUInteger)port count:(NSUInteger)count;//{{{
+/**
+ * Opens connections to a host in advance.
+ * All connections are opened at the same time and the caller waits up to
+ * #connectTimeout seconds for them. The ready ones are kept idle.
+ * @param host Name or numeric address of the host.
+ * @param port The port.
+ * @param count Number of connections. Limited by #maximumIdleConnections
+ * and #maximumConnections.
+ * @return The number of idle connections added.
+ **/
+- (NSUInteger)prewarmHost:(NSString *)host port:(NSUInteger)port count:(NSUInteger)count;
+//}}}
+//@}
+
+/** @name Eviction */ //@{
+// - (NSUInteger)evictIdleConnections;//{{{
+/**
+ * Closes the idle connections older than #idleTimeout or not alive.
+ * @return The number of connections closed.
+ **/
+- (NSUInteger)evictIdleConnections;
+//}}}
+// - (uintptr_t)scheduleEvictionInLoop:(SFSocketLoop *)loop interval:(NSTimeInterval)interval;//{{{
+/**
+ * Calls #evictIdleConnections periodically in a loop thread.
+ * @param loop The loop that runs the timer. It retains this pool until the
+ * timer is cancelled.
+ * @param interval Seconds between evictions.
+ * @return The timer identifier, to be used with SFSocketLoop::cancelTimer:.
+ **/
+- (uintptr_t)scheduleEvictionInLoop:(SFSocketLoop *)loop interval:(NSTimeInterval)interval;
+//}}}
+// - (void)closeAllConnections;//{{{
+/**
+ * Closes all idle connections.
+ * Connections in use are closed when given back.
+ **/
+- (void)closeAllConnections;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,506 @@
+/**
+ * \file
+ * Defines the SFConnectionPool Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFConnectionPool.h"
+#import "sfdebug.h"
+
+#include <sys/errno.h>
+#include <sys/socket.h>
+
+/** Default value of SFConnectionPool::maximumConnections. */
+#define SF_POOL_MAXIMUM_CONNECTIONS 16
+
+/** Default value of SFConnectionPool::maximumIdleConnections. */
+#define SF_POOL_MAXIMUM_IDLE        4
+
+/** Default value of SFConnectionPool::idleTimeout, in seconds. */
+#define SF_POOL_IDLE_TIMEOUT        30.0
+
+/** Default value of SFConnectionPool::connectTimeout, in seconds. */
+#define SF_POOL_CONNECT_TIMEOUT     10.0
+
+/* ===========================================================================
+ * SFConnectionPoolHost INTERFACE
+ * ======================================================================== */
+/**
+ * Connections of one host:port.
+ **/
+@interface SFConnectionPoolHost : NSObject {
+@public
+    NSString       *host;
+    NSUInteger      port;
+    NSMutableArray *idle;           /* Most recently released last.         */
+    NSMutableArray *released;       /* Release time of each idle one.       */
+    NSUInteger      total;          /* Idle, in use and connecting.         */
+}
+@end
+
+@implementation SFConnectionPoolHost
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [host release];
+    [idle release];
+    [released release];
+    [super dealloc];
+}
+//}}}
+@end
+
+/* ===========================================================================
+ * SFConnectionPool EXTENSION
+ * ======================================================================== */
+@interface SFConnectionPool () {
+    NSCondition *m_lock;            /* Guards everything below.             */
+    NSMutableDictionary *m_hosts;   /* "host:port" to SFConnectionPoolHost. */
+    NSMutableDictionary *m_inUse;   /* Socket address to its host.          */
+    NSUInteger m_maximumConnections;
+    NSUInteger m_maximumIdle;
+    NSTimeInterval m_idleTimeout;
+    NSTimeInterval m_connectTimeout;
+    uint64_t m_requests;
+    uint64_t m_hits;
+    uint64_t m_handshakes;
+    uint64_t m_evictions;
+    NSTimeInterval m_waited;
+}
+// - (SFConnectionPoolHost *)entryForHost:(NSString *)host port:(NSUInteger)port;//{{{
+/**
+ * Gets the connections of a host, creating the object when needed.
+ * Called with the lock held.
+ **/
+- (SFConnectionPoolHost *)entryForHost:(NSString *)host port:(NSUInteger)port;
+//}}}
+// - (NSUInteger)openSockets:(NSArray *)sockets host:(NSString *)host port:(NSUInteger)port error:(error_t *)error;//{{{
+/**
+ * Opens several sockets at the same time and waits for them up to
+ * #connectTimeout seconds. Sockets that failed are closed.
+ * Called without the lock.
+ * @param error Receives the error of the last socket that failed.
+ * @return The number of sockets connected.
+ **/
+- (NSUInteger)openSockets:(NSArray *)sockets host:(NSString *)host port:(NSUInteger)port error:(error_t *)error;
+//}}}
+// - (void)evictFromLoop:(SFSocketLoop *)loop;//{{{
+/**
+ * Timer action of #scheduleEvictionInLoop:interval:.
+ **/
+- (void)evictFromLoop:(SFSocketLoop *)loop;
+//}}}
+@end
+
+/* ===========================================================================
+ * Local Functions
+ * ======================================================================== */
+// static BOOL SFConnectionPoolAlive(SFSocket *socket);//{{{
+/**
+ * Checks an idle connection without waiting.
+ * An idle connection has nothing to read: a \c recv() peek must fail with
+ * \c EAGAIN. Data, the end of the connection or any other error means it
+ * cannot be reused.
+ **/
+static BOOL SFConnectionPoolAlive(SFSocket *socket)
+{
+    char byte;
+    ssize_t result;
+
+    if (([socket descriptor] < 0) || ([socket queuedBytes] > 0))
+        return NO;
+
+    result = recv([socket descriptor], &byte, 1, (MSG_PEEK | MSG_DONTWAIT));
+    return ((result < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)));
+}
+//}}}
+
+/* ===========================================================================
+ * SFConnectionPool IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFConnectionPool
+// Properties
+// @property (nonatomic) NSUInteger maximumConnections;//{{{
+@synthesize maximumConnections = m_maximumConnections;
+//}}}
+// @property (nonatomic) NSUInteger maximumIdleConnections;//{{{
+@synthesize maximumIdleConnections = m_maximumIdle;
+//}}}
+// @property (nonatomic) NSTimeInterval idleTimeout;//{{{
+@synthesize idleTimeout = m_idleTimeout;
+//}}}
+// @property (nonatomic) NSTimeInterval connectTimeout;//{{{
+@synthesize connectTimeout = m_connectTimeout;
+//}}}
+
+// Statistics
+// @property (nonatomic, readonly) uint64_t numberOfRequests;//{{{
+@synthesize numberOfRequests = m_requests;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfHits;//{{{
+@synthesize numberOfHits = m_hits;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfHandshakes;//{{{
+@synthesize numberOfHandshakes = m_handshakes;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfEvictions;//{{{
+@synthesize numberOfEvictions = m_evictions;
+//}}}
+// @property (nonatomic, readonly) double hitRate;//{{{
+- (double)hitRate
+{
+    double rate;
+
+    [m_lock lock];
+    rate = ((m_requests > 0) ? ((double)m_hits / (double)m_requests) : 0.0);
+    [m_lock unlock];
+    return rate;
+}
+//}}}
+// @property (nonatomic, readonly) NSTimeInterval averageWaitTime;//{{{
+- (NSTimeInterval)averageWaitTime
+{
+    NSTimeInterval average;
+
+    [m_lock lock];
+    average = ((m_requests > 0) ? (m_waited / (double)m_requests) : 0.0);
+    [m_lock unlock];
+    return average;
+}
+//}}}
+// - (void)resetStatistics;//{{{
+- (void)resetStatistics
+{
+    [m_lock lock];
+    m_requests = m_hits = m_handshakes = m_evictions = 0;
+    m_waited = 0.0;
+    [m_lock unlock];
+}
+//}}}
+
+// NSObject: Overrides
+// - (id)init;//{{{
+- (id)init
+{
+    self = [super init];
+    if (self)
+    {
+        m_lock  = [NSCondition new];
+        m_hosts = [NSMutableDictionary new];
+        m_inUse = [NSMutableDictionary new];
+        m_maximumConnections = SF_POOL_MAXIMUM_CONNECTIONS;
+        m_maximumIdle    = SF_POOL_MAXIMUM_IDLE;
+        m_idleTimeout    = SF_POOL_IDLE_TIMEOUT;
+        m_connectTimeout = SF_POOL_CONNECT_TIMEOUT;
+    }
+    return self;
+}
+//}}}
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [self closeAllConnections];
+    [m_lock release];
+    [m_hosts release];
+    [m_inUse release];
+    [super dealloc];
+}
+//}}}
+
+// Connections
+// - (SFSocket *)connectionToHost:(NSString *)host port:(NSUInteger)port error:(error_t *)error;//{{{
+- (SFSocket *)connectionToHost:(NSString *)host port:(NSUInteger)port error:(error_t *)error
+{
+    NSDate *start = [NSDate date];
+    NSDate *limit = [start dateByAddingTimeInterval:m_connectTimeout];
+    SFConnectionPoolHost *entry;
+    SFSocket *socket = nil;
+    error_t failure = 0;
+
+    [m_lock lock];
+    m_requests++;
+    entry = [self entryForHost:host port:port];
+
+    for (;;)
+    {
+        /* The connection released last is the least likely to be closed. */
+        while ([entry->idle count] > 0)
+        {
+            socket = [[[entry->idle lastObject] retain] autorelease];
+            [entry->idle removeLastObject];
+            [entry->released removeLastObject];
+
+            if (SFConnectionPoolAlive(socket)) break;
+
+            [socket close];
+            entry->total--;
+            m_evictions++;
+            socket = nil;
+        }
+
+        if (socket != nil) {
+            m_hits++;
+            break;
+        }
+
+        if (entry->total < m_maximumConnections)
+        {
+            entry->total++;
+            [m_lock unlock];
+
+            socket = [[[SFSocket alloc] init] autorelease];
+            if ([self openSockets:[NSArray arrayWithObject:socket] host:host port:port error:&failure] == 0)
+                socket = nil;
+
+            [m_lock lock];
+            m_handshakes++;
+            if (socket == nil)
+            {
+                entry->total--;
+                [m_lock signal];
+            }
+            break;
+        }
+
+        /* All connections are in use. Waits for one to be given back. */
+        if (![m_lock waitUntilDate:limit]) {
+            failure = ETIMEDOUT;
+            break;
+        }
+    }
+
+    if (socket != nil)
+        [m_inUse setObject:entry forKey:[NSValue valueWithPointer:socket]];
+
+    m_waited += -[start timeIntervalSinceNow];
+    [m_lock unlock];
+
+    if (error != NULL) *error = failure;
+    return socket;
+}
+//}}}
+// - (void)releaseConnection:(SFSocket *)socket;//{{{
+- (void)releaseConnection:(SFSocket *)socket
+{
+    NSValue *key = [NSValue valueWithPointer:socket];
+    SFConnectionPoolHost *entry;
+
+    [m_lock lock];
+    entry = [[[m_inUse objectForKey:key] retain] autorelease];
+    if (entry == nil) {
+        [m_lock unlock];
+        return;
+    }
+    [m_inUse removeObjectForKey:key];
+
+    if (([entry->idle count] < m_maximumIdle) && SFConnectionPoolAlive(socket))
+    {
+        [entry->idle addObject:socket];
+        [entry->released addObject:[NSDate date]];
+    }
+    else
+    {
+        [socket close];
+        entry->total--;
+    }
+
+    [m_lock signal];
+    [m_lock unlock];
+}
+//}}}
+// - (void)discardConnection:(SFSocket *)socket;//{{{
+- (void)discardConnection:(SFSocket *)socket
+{
+    NSValue *key = [NSValue valueWithPointer:socket];
+    SFConnectionPoolHost *entry;
+
+    [m_lock lock];
+    entry = [m_inUse objectForKey:key];
+    if (entry != nil)
+    {
+        entry->total--;
+        [m_inUse removeObjectForKey:key];
+        [m_lock signal];
+    }
+    [m_lock unlock];
+
+    [socket close];
+}
+//}}}
+// - (NSUInteger)prewarmHost:(NSString *)host port:(NSUInteger)port count:(NSUInteger)count;//{{{
+- (NSUInteger)prewarmHost:(NSString *)host port:(NSUInteger)port count:(NSUInteger)count
+{
+    NSMutableArray *sockets;
+    SFConnectionPoolHost *entry;
+    NSUInteger room, ready;
+    error_t error;
+
+    [m_lock lock];
+    entry = [[[self entryForHost:host port:port] retain] autorelease];
+
+    room = ((m_maximumIdle > [entry->idle count]) ? (m_maximumIdle - [entry->idle count]) : 0);
+    if (count > room) count = room;
+
+    room = ((m_maximumConnections > entry->total) ? (m_maximumConnections - entry->total) : 0);
+    if (count > room) count = room;
+
+    entry->total += count;
+    [m_lock unlock];
+
+    if (count == 0) return 0;
+
+    sockets = [NSMutableArray arrayWithCapacity:count];
+    while ([sockets count] < count)
+        [sockets addObject:[[[SFSocket alloc] init] autorelease]];
+
+    ready = [self openSockets:sockets host:host port:port error:&error];
+
+    [m_lock lock];
+    m_handshakes += count;
+    entry->total -= (count - ready);
+
+    for (SFSocket *socket in sockets)
+    {
+        if ([socket descriptor] < 0) continue;
+
+        [entry->idle addObject:socket];
+        [entry->released addObject:[NSDate date]];
+    }
+    [m_lock broadcast];
+    [m_lock unlock];
+
+    return ready;
+}
+//}}}
+
+// Eviction
+// - (NSUInteger)evictIdleConnections;//{{{
+- (NSUInteger)evictIdleConnections
+{
+    NSDate *limit = [NSDate dateWithTimeIntervalSinceNow:-m_idleTimeout];
+    NSUInteger index, evicted = 0;
+
+    [m_lock lock];
+    for (SFConnectionPoolHost *entry in [m_hosts objectEnumerator])
+    {
+        for (index = [entry->idle count]; index-- > 0; )
+        {
+            SFSocket *socket = [entry->idle objectAtIndex:index];
+            NSDate *released = [entry->released objectAtIndex:index];
+
+            if (([released compare:limit] == NSOrderedDescending) && SFConnectionPoolAlive(socket))
+                continue;
+
+            [socket close];
+            [entry->idle removeObjectAtIndex:index];
+            [entry->released removeObjectAtIndex:index];
+            entry->total--;
+            evicted++;
+        }
+    }
+    m_evictions += evicted;
+
+    if (evicted > 0) [m_lock broadcast];
+    [m_lock unlock];
+    return evicted;
+}
+//}}}
+// - (uintptr_t)scheduleEvictionInLoop:(SFSocketLoop *)loop interval:(NSTimeInterval)interval;//{{{
+- (uintptr_t)scheduleEvictionInLoop:(SFSocketLoop *)loop interval:(NSTimeInterval)interval
+{
+    return [loop scheduleTimer:interval repeats:YES target:self selector:@selector(evictFromLoop:)];
+}
+//}}}
+// - (void)closeAllConnections;//{{{
+- (void)closeAllConnections
+{
+    [m_lock lock];
+    for (SFConnectionPoolHost *entry in [m_hosts objectEnumerator])
+    {
+        for (SFSocket *socket in entry->idle)
+            [socket close];
+
+        entry->total -= [entry->idle count];
+        [entry->idle removeAllObjects];
+        [entry->released removeAllObjects];
+    }
+    [m_lock broadcast];
+    [m_lock unlock];
+}
+//}}}
+
+// Local Operations
+// - (SFConnectionPoolHost *)entryForHost:(NSString *)host port:(NSUInteger)port;//{{{
+- (SFConnectionPoolHost *)entryForHost:(NSString *)host port:(NSUInteger)port
+{
+    NSString *key = [NSString stringWithFormat:@"%@:%lu", [host lowercaseString], (unsigned long)port];
+    SFConnectionPoolHost *entry = [m_hosts objectForKey:key];
+
+    if (entry == nil)
+    {
+        entry = [[SFConnectionPoolHost alloc] init];
+        entry->host     = [host copy];
+        entry->port     = port;
+        entry->idle     = [NSMutableArray new];
+        entry->released = [NSMutableArray new];
+
+        [m_hosts setObject:entry forKey:key];
+        [entry release];
+    }
+    return entry;
+}
+//}}}
+// - (NSUInteger)openSockets:(NSArray *)sockets host:(NSString *)host port:(NSUInteger)port error:(error_t *)error;//{{{
+- (NSUInteger)openSockets:(NSArray *)sockets host:(NSString *)host port:(NSUInteger)port error:(error_t *)error
+{
+    NSMutableArray *pending = [NSMutableArray arrayWithCapacity:[sockets count]];
+    NSDate *limit = [NSDate dateWithTimeIntervalSinceNow:m_connectTimeout];
+    NSUInteger ready = 0;
+
+    *error = 0;
+
+    /* Every handshake runs at the same time. */
+    for (SFSocket *socket in sockets)
+    {
+        error_t result = [socket open:host port:port];
+
+        if (result == 0)
+            ready++;
+        else if (result == EINPROGRESS)
+            [pending addObject:socket];
+        else
+            *error = result;
+    }
+
+    if ([pending count] == 0)
+        return ready;
+
+    /* Sockets that fail or time out are closed. */
+    ready += [SFSocket waitSockets:pending timeout:[limit timeIntervalSinceNow]];
+    for (SFSocket *socket in pending)
+    {
+        if ([socket error] == 0) continue;
+
+        *error = [socket error];
+        sfdebug("SFConnectionPool::connect('%s', %u): %d\n", [host UTF8String], (unsigned)port, *error);
+    }
+    return ready;
+}
+//}}}
+// - (void)evictFromLoop:(SFSocketLoop *)loop;//{{{
+- (void)evictFromLoop:(SFSocketLoop *)loop
+{
+    [self evictIdleConnections];
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
@@ -0,0 +1,275 @@
+/**
+ * \file
+ * Declares the SFDatagramSocket Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "sfstd.h"
+#import "SFStream.h"
+#import "SFSocketProfile.h"
+
+#include <sys/uio.h>
+
+/**
+ * \ingroup sf_networking
+ * A UDP socket that sends and receives datagrams in batches.
+ * Received datagrams are kept in a slab allocated once, with #batchSize
+ * slots of #datagramSize bytes. #receiveBatch fills as many slots as there
+ * are datagrams waiting and the datagrams are read in place, as SFStreamReader
+ * views or raw bytes. Nothing is allocated or copied per datagram. The
+ * contents are valid until the next #receiveBatch.
+ *
+ * A batch is sent with #sendBuffers:count:, one datagram per buffer,
+ * straight from the caller memory.
+ *
+ * The socket is non-blocking. It is created by #bind:port: or
+ * #connect:port:, in the family of the address, IPv4 or IPv6.
+ * @remarks Darwin has no \c recvmmsg() or \c sendmmsg(), nor segmentation
+ * offload for UDP. A batch is made of one system call per datagram, until
+ * the kernel has no more datagrams or no more room, and #datagramSize must
+ * hold the largest datagram expected. Longer ones are truncated: see
+ * #isDatagramTruncatedAtIndex:.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFDatagramSocket : NSObject
+/** @name Properties */ //@{
+// @property (nonatomic, readonly) error_t error;//{{{
+/**
+ * Gets the last error number generated by an operation.
+ **/
+@property (nonatomic, readonly) error_t error;
+//}}}
+// @property (nonatomic, readonly) socket_t descriptor;//{{{
+/**
+ * Gets the socket descriptor. -1 when the socket is not open.
+ **/
+@property (nonatomic, readonly) socket_t descriptor;
+//}}}
+// @property (nonatomic, readonly) NSUInteger localPort;//{{{
+/**
+ * Gets the local port of the socket. Zero when the socket is not open.
+ **/
+@property (nonatomic, readonly) NSUInteger localPort;
+//}}}
+// @property (nonatomic, readonly) NSUInteger batchSize;//{{{
+/**
+ * Gets the greatest number of datagrams received by #receiveBatch.
+ **/
+@property (nonatomic, readonly) NSUInteger batchSize;
+//}}}
+// @property (nonatomic, readonly) size_t datagramSize;//{{{
+/**
+ * Gets the size of each slot of the receive slab.
+ **/
+@property (nonatomic, readonly) size_t datagramSize;
+//}}}
+// @property (nonatomic, copy) SFSocketProfile *profile;//{{{
+/**
+ * Gets or sets the options applied when the socket is created.
+ * Only the socket options are used, like the buffer sizes. Applied right
+ * away when the socket is already open: check #error. Default is \b nil.
+ **/
+@property (nonatomic, copy) SFSocketProfile *profile;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithBatchSize:(NSUInteger)count datagramSize:(size_t)size;//{{{
+/**
+ * Initializes the object and allocates its receive slab.
+ * @param count Greatest number of datagrams in a batch. Zero uses 64.
+ * @param size Size of each slot. Zero uses 2048 bytes, enough for any
+ * datagram of an Ethernet link.
+ * @return This object initialized. \b nil when the slab could not be
+ * allocated.
+ **/
+- (instancetype)initWithBatchSize:(NSUInteger)count datagramSize:(size_t)size;
+//}}}
+//@}
+
+/** @name Connection */ //@{
+// - (error_t)bind:(NSString *)address port:(NSUInteger)port;//{{{
+/**
+ * Binds the socket to a local address, to receive datagrams.
+ * @param address The IP of the local interface, IPv4 or IPv6. \b nil binds
+ * all IPv4 interfaces.
+ * @param port The local port. Zero lets the system choose one. See
+ * #localPort.
+ * @return Zero on success. Otherwise the error number.
+ **/
+- (error_t)bind:(NSString *)address port:(NSUInteger)port;
+//}}}
+// - (error_t)connect:(NSString *)address port:(NSUInteger)port;//{{{
+/**
+ * Sets the peer of this socket.
+ * Datagrams sent by #sendBuffers:count: go to this peer and only datagrams
+ * from it are received. No packet is sent.
+ * @param address The name or IP of the peer.
+ * @param port The peer port.
+ * @return Zero on success. Otherwise the error number.
+ **/
+- (error_t)connect:(NSString *)address port:(NSUInteger)port;
+//}}}
+// - (void)close;//{{{
+/**
+ * Closes the socket. The slab is kept, so the object can be opened again.
+ **/
+- (void)close;
+//}}}
+//@}
+
+/** @name Receiving */ //@{
+// - (intptr_t)receiveBatch;//{{{
+/**
+ * Receives the datagrams waiting, up to #batchSize.
+ * The datagrams of the previous batch are discarded.
+ * @return The number of datagrams received. Zero when there is none. -1 on
+ * failure: check #error.
+ **/
+- (intptr_t)receiveBatch;
+//}}}
+// @property (nonatomic, readonly) NSUInteger count;//{{{
+/**
+ * Gets the number of datagrams in the last batch received.
+ **/
+@property (nonatomic, readonly) NSUInteger count;
+//}}}
+// - (const uint8_t *)bytesOfDatagramAtIndex:(NSUInteger)index;//{{{
+/**
+ * Gets the bytes of a datagram of the last batch.
+ * @param index Index of the datagram, less than #count.
+ * @return The address of the bytes in the slab. \c NULL when \a index is
+ * out of range.
+ **/
+- (const uint8_t *)bytesOfDatagramAtIndex:(NSUInteger)index;
+//}}}
+// - (size_t)lengthOfDatagramAtIndex:(NSUInteger)index;//{{{
+/**
+ * Gets the length of a datagram of the last batch.
+ * @param index Index of the datagram, less than #count.
+ * @return The number of bytes. Zero when \a index is out of range.
+ **/
+- (size_t)lengthOfDatagramAtIndex:(NSUInteger)index;
+//}}}
+// - (BOOL)isDatagramTruncatedAtIndex:(NSUInteger)index;//{{{
+/**
+ * Checks whether a datagram of the last batch was longer than #datagramSize.
+ * Only the first #datagramSize bytes of such a datagram are kept, and
+ * #lengthOfDatagramAtIndex: returns #datagramSize. The rest is discarded by
+ * the kernel.
+ * @param index Index of the datagram, less than #count.
+ * @return \b YES when the datagram was truncated. \b NO otherwise or when
+ * \a index is out of range.
+ **/
+- (BOOL)isDatagramTruncatedAtIndex:(NSUInteger)index;
+//}}}
+// - (SFStreamReader *)datagramAtIndex:(NSUInteger)index;//{{{
+/**
+ * Gets a stream that reads a datagram of the last batch in place.
+ * @param index Index of the datagram, less than #count.
+ * @return A temporary stream over the slab. It must not be used after the
+ * next #receiveBatch or after this object is released. \b nil when \a index
+ * is out of range.
+ **/
+- (SFStreamReader *)datagramAtIndex:(NSUInteger)index;
+//}}}
+// - (NSData *)addressOfDatagramAtIndex:(NSUInteger)index;//{{{
+/**
+ * Gets the address of the sender of a datagram of the last batch.
+ * @param index Index of the datagram, less than #count.
+ * @return A temporary \c NSData object with a \c sockaddr_in or \c
+ * sockaddr_in6 structure. \b nil when \a index is out of range.
+ **/
+- (NSData *)addressOfDatagramAtIndex:(NSUInteger)index;
+//}}}
+//@}
+
+/** @name Sending */ //@{
+// - (intptr_t)sendBuffers:(const struct iovec *)buffers count:(NSUInteger)count;//{{{
+/**
+ * Sends many datagrams to the peer set by #connect:port:.
+ * Each buffer is a datagram. They are sent in order until the kernel has
+ * no more room.
+ * @param buffers Array of buffer descriptors.
+ * @param count Number of items in \a buffers.
+ * @return The number of datagrams sent. Less than \a count when the kernel
+ * had no more room: send the rest later. -1 when nothing was sent because
+ * of a failure: check #error.
+ **/
+- (intptr_t)sendBuffers:(const struct iovec *)buffers count:(NSUInteger)count;
+//}}}
+// - (intptr_t)sendDatagrams:(NSArray *)datagrams;//{{{
+/**
+ * Sends many \c NSData objects, each one a datagram, to the peer set by
+ * #connect:port:.
+ * @param datagrams Array of \c NSData objects.
+ * @return As in #sendBuffers:count:.
+ **/
+- (intptr_t)sendDatagrams:(NSArray *)datagrams;
+//}}}
+// - (BOOL)send:(const void *)bytes length:(size_t)length toAddress:(NSData *)address;//{{{
+/**
+ * Sends a single datagram to an address.
+ * @param bytes The datagram contents.
+ * @param length Number of bytes in \a bytes.
+ * @param address \c NSData object with a \c sockaddr structure, as given by
+ * SFResolver or #addressOfDatagramAtIndex:.
+ * @return \b YES when sent. \b NO on failure, including no room in the
+ * kernel (\c EAGAIN): check #error.
+ **/
+- (BOOL)send:(const void *)bytes length:(size_t)length toAddress:(NSData *)address;
+//}}}
+//@}
+
+/** @name Statistics */ //@{
+// @property (nonatomic, readonly) uint64_t datagramsReceived;//{{{
+/**
+ * Gets the number of datagrams received.
+ **/
+@property (nonatomic, readonly) uint64_t datagramsReceived;
+//}}}
+// @property (nonatomic, readonly) uint64_t datagramsTruncated;//{{{
+/**
+ * Gets the number of datagrams received that were longer than
+ * #datagramSize. They are also counted in #datagramsReceived.
+ **/
+@property (nonatomic, readonly) uint64_t datagramsTruncated;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfReceiveCalls;//{{{
+/**
+ * Gets the number of system calls made to receive datagrams.
+ * Calls that returned \c EAGAIN or were interrupted are counted.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfReceiveCalls;
+//}}}
+// @property (nonatomic, readonly) uint64_t datagramsSent;//{{{
+/**
+ * Gets the number of datagrams sent.
+ **/
+@property (nonatomic, readonly) uint64_t datagramsSent;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfSendCalls;//{{{
+/**
+ * Gets the number of system calls made to send datagrams.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfSendCalls;
+//}}}
+// - (void)resetStatistics;//{{{
+/**
+ * Sets all statistics to zero.
+ **/
+- (void)resetStatistics;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
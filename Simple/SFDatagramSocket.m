@@ -0,0 +1,478 @@
+/**
+ * \file
+ * Defines the SFDatagramSocket Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFDatagramSocket.h"
+#import "SFResolver.h"
+#import "sfdebug.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/errno.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+/** Number of slots of the receive slab when none is given. */
+#define SF_DATAGRAM_BATCH_SIZE      64
+
+/** Size of each slot of the receive slab when none is given. */
+#define SF_DATAGRAM_SIZE            2048
+
+/* ===========================================================================
+ * SFDatagramSocket EXTENSION
+ * ======================================================================== */
+@interface SFDatagramSocket () {
+    socket_t  m_sd;
+    error_t   m_error;
+    SFSocketProfile *m_profile;
+
+    uint8_t  *m_slab;               /* m_batchSize slots of m_datagramSize. */
+    size_t   *m_lengths;
+    BOOL     *m_truncated;          /* Datagrams longer than a slot.        */
+    struct sockaddr_storage *m_senders;
+    socklen_t *m_senderLengths;
+    NSUInteger m_batchSize;
+    size_t    m_datagramSize;
+    NSUInteger m_count;             /* Datagrams in the last batch.         */
+
+    uint64_t  m_datagramsReceived;
+    uint64_t  m_datagramsTruncated;
+    uint64_t  m_receiveCalls;
+    uint64_t  m_datagramsSent;
+    uint64_t  m_sendCalls;
+}
+// - (error_t)openFamily:(sa_family_t)family;//{{{
+/**
+ * Creates the socket, in non-blocking mode, when it is not open yet.
+ * @return Zero on success. \c EAFNOSUPPORT when the socket is already open
+ * in another family.
+ **/
+- (error_t)openFamily:(sa_family_t)family;
+//}}}
+// - (NSData *)addressOf:(NSString *)host port:(NSUInteger)port;//{{{
+/**
+ * Resolves an address with the shared resolver, setting #error on failure.
+ **/
+- (NSData *)addressOf:(NSString *)host port:(NSUInteger)port;
+//}}}
+@end
+
+/* ===========================================================================
+ * SFDatagramSocket IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFDatagramSocket
+// Properties
+// @property (nonatomic, readonly) error_t error;//{{{
+@synthesize error = m_error;
+//}}}
+// @property (nonatomic, readonly) socket_t descriptor;//{{{
+@synthesize descriptor = m_sd;
+//}}}
+// @property (nonatomic, readonly) NSUInteger localPort;//{{{
+- (NSUInteger)localPort
+{
+    struct sockaddr_storage addr;
+    socklen_t size = sizeof(addr);
+
+    if ((m_sd < 0) || (getsockname(m_sd, (struct sockaddr *)&addr, &size) < 0))
+        return 0;
+
+    if (addr.ss_family == AF_INET6)
+        return ntohs(((struct sockaddr_in6 *)&addr)->sin6_port);
+    return ntohs(((struct sockaddr_in *)&addr)->sin_port);
+}
+//}}}
+// @property (nonatomic, readonly) NSUInteger batchSize;//{{{
+@synthesize batchSize = m_batchSize;
+//}}}
+// @property (nonatomic, readonly) size_t datagramSize;//{{{
+@synthesize datagramSize = m_datagramSize;
+//}}}
+// @property (nonatomic, copy) SFSocketProfile *profile;//{{{
+@synthesize profile = m_profile;
+- (void)setProfile:(SFSocketProfile *)profile
+{
+    if (profile == m_profile) return;
+
+    [m_profile release];
+    m_profile = [profile copy];
+
+    m_error = 0;
+    if ((m_sd >= 0) && (m_profile != nil))
+        m_error = [m_profile applyToDescriptor:m_sd];
+}
+//}}}
+// @property (nonatomic, readonly) NSUInteger count;//{{{
+@synthesize count = m_count;
+//}}}
+
+// Statistics
+// @property (nonatomic, readonly) uint64_t datagramsReceived;//{{{
+@synthesize datagramsReceived = m_datagramsReceived;
+//}}}
+// @property (nonatomic, readonly) uint64_t datagramsTruncated;//{{{
+@synthesize datagramsTruncated = m_datagramsTruncated;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfReceiveCalls;//{{{
+@synthesize numberOfReceiveCalls = m_receiveCalls;
+//}}}
+// @property (nonatomic, readonly) uint64_t datagramsSent;//{{{
+@synthesize datagramsSent = m_datagramsSent;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfSendCalls;//{{{
+@synthesize numberOfSendCalls = m_sendCalls;
+//}}}
+// - (void)resetStatistics;//{{{
+- (void)resetStatistics
+{
+    m_datagramsReceived = m_datagramsTruncated = m_receiveCalls = 0;
+    m_datagramsSent = m_sendCalls = 0;
+}
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithBatchSize:(NSUInteger)count datagramSize:(size_t)size;//{{{
+- (instancetype)initWithBatchSize:(NSUInteger)count datagramSize:(size_t)size
+{
+    self = [super init];
+    if (self)
+    {
+        m_sd = -1;
+        m_batchSize    = ((count > 0) ? count : SF_DATAGRAM_BATCH_SIZE);
+        m_datagramSize = ((size > 0) ? size : SF_DATAGRAM_SIZE);
+
+        /* Allocated once. Every batch is received in the same memory. */
+        m_slab          = (uint8_t *)malloc(m_batchSize * m_datagramSize);
+        m_lengths       = (size_t *)calloc(m_batchSize, sizeof(size_t));
+        m_truncated     = (BOOL *)calloc(m_batchSize, sizeof(BOOL));
+        m_senders       = (struct sockaddr_storage *)calloc(m_batchSize, sizeof(struct sockaddr_storage));
+        m_senderLengths = (socklen_t *)calloc(m_batchSize, sizeof(socklen_t));
+
+        if (!m_slab || !m_lengths || !m_truncated || !m_senders || !m_senderLengths)
+        {
+            [self release];
+            return nil;
+        }
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (id)init;//{{{
+- (id)init
+{
+    return [self initWithBatchSize:0 datagramSize:0];
+}
+//}}}
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    if (m_sd >= 0) close(m_sd);
+    free(m_slab);
+    free(m_lengths);
+    free(m_truncated);
+    free(m_senders);
+    free(m_senderLengths);
+    [m_profile release];
+    [super dealloc];
+}
+//}}}
+
+// Connection
+// - (error_t)bind:(NSString *)address port:(NSUInteger)port;//{{{
+- (error_t)bind:(NSString *)address port:(NSUInteger)port
+{
+    struct sockaddr_in in_addr;
+    const struct sockaddr *addr = (const struct sockaddr *)&in_addr;
+    socklen_t length = sizeof(struct sockaddr_in);
+
+    memset(&in_addr, 0, sizeof(in_addr));
+    in_addr.sin_len    = sizeof(struct sockaddr_in);
+    in_addr.sin_family = AF_INET;
+    in_addr.sin_port   = htons((uint16_t)port);
+    in_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (address != nil)
+    {
+        NSData *local = [self addressOf:address port:port];
+
+        if (local == nil)
+            return m_error;
+
+        addr   = (const struct sockaddr *)[local bytes];
+        length = (socklen_t)[local length];
+    }
+
+    if ([self openFamily:addr->sa_family] != 0)
+        return m_error;
+
+    if (bind(m_sd, addr, length) < 0)
+        return m_error = errno;
+
+    return m_error = 0;
+}
+//}}}
+// - (error_t)connect:(NSString *)address port:(NSUInteger)port;//{{{
+- (error_t)connect:(NSString *)address port:(NSUInteger)port
+{
+    NSData *remote = [self addressOf:address port:port];
+    const struct sockaddr *addr;
+
+    if (remote == nil)
+        return m_error;
+
+    addr = (const struct sockaddr *)[remote bytes];
+    if ([self openFamily:addr->sa_family] != 0)
+        return m_error;
+
+    if (connect(m_sd, addr, (socklen_t)[remote length]) < 0)
+        return m_error = errno;
+
+    return m_error = 0;
+}
+//}}}
+// - (void)close;//{{{
+- (void)close
+{
+    if (m_sd >= 0) close(m_sd);
+    m_sd = -1;
+    m_count = 0;
+}
+//}}}
+
+// Receiving
+// - (intptr_t)receiveBatch;//{{{
+- (intptr_t)receiveBatch
+{
+    NSUInteger index;
+
+    m_error = 0;
+    m_count = 0;
+    if (m_sd < 0) {
+        m_error = ENOTCONN;
+        return -1;
+    }
+
+    for (index = 0; index < m_batchSize; ++index)
+    {
+        struct iovec iov = { m_slab + (index * m_datagramSize), m_datagramSize };
+        struct msghdr msg;
+        ssize_t received;
+
+        /* recvmsg() tells when the datagram didn't fit the slot. */
+        do {
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_name    = &m_senders[index];
+            msg.msg_namelen = sizeof(struct sockaddr_storage);
+            msg.msg_iov     = &iov;
+            msg.msg_iovlen  = 1;
+            received = recvmsg(m_sd, &msg, 0);
+            m_receiveCalls++;
+        } while ((received < 0) && (errno == EINTR));
+
+        if (received < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) break;
+
+            /* Datagrams already received are kept. The error is reported
+             * by the next call. */
+            if (index > 0) break;
+
+            m_error = errno;
+            return -1;
+        }
+        m_lengths[index] = (size_t)received;
+        m_senderLengths[index] = msg.msg_namelen;
+        m_truncated[index] = ((msg.msg_flags & MSG_TRUNC) != 0);
+        if (m_truncated[index]) m_datagramsTruncated++;
+    }
+
+    m_count = index;
+    m_datagramsReceived += index;
+    return (intptr_t)index;
+}
+//}}}
+// - (const uint8_t *)bytesOfDatagramAtIndex:(NSUInteger)index;//{{{
+- (const uint8_t *)bytesOfDatagramAtIndex:(NSUInteger)index
+{
+    if (index >= m_count) return NULL;
+    return m_slab + (index * m_datagramSize);
+}
+//}}}
+// - (size_t)lengthOfDatagramAtIndex:(NSUInteger)index;//{{{
+- (size_t)lengthOfDatagramAtIndex:(NSUInteger)index
+{
+    return ((index < m_count) ? m_lengths[index] : 0);
+}
+//}}}
+// - (BOOL)isDatagramTruncatedAtIndex:(NSUInteger)index;//{{{
+- (BOOL)isDatagramTruncatedAtIndex:(NSUInteger)index
+{
+    return ((index < m_count) ? m_truncated[index] : NO);
+}
+//}}}
+// - (SFStreamReader *)datagramAtIndex:(NSUInteger)index;//{{{
+- (SFStreamReader *)datagramAtIndex:(NSUInteger)index
+{
+    if (index >= m_count) return nil;
+
+    /* A view over the slab. Nothing is copied. */
+    return [[[SFStreamReader alloc] initWithBytes:(m_slab + (index * m_datagramSize)) length:m_lengths[index]] autorelease];
+}
+//}}}
+// - (NSData *)addressOfDatagramAtIndex:(NSUInteger)index;//{{{
+- (NSData *)addressOfDatagramAtIndex:(NSUInteger)index
+{
+    if (index >= m_count) return nil;
+    return [NSData dataWithBytes:&m_senders[index] length:m_senderLengths[index]];
+}
+//}}}
+
+// Sending
+// - (intptr_t)sendBuffers:(const struct iovec *)buffers count:(NSUInteger)count;//{{{
+- (intptr_t)sendBuffers:(const struct iovec *)buffers count:(NSUInteger)count
+{
+    NSUInteger index;
+
+    m_error = 0;
+    if (m_sd < 0) {
+        m_error = ENOTCONN;
+        return -1;
+    }
+
+    for (index = 0; index < count; ++index)
+    {
+        ssize_t sent;
+
+        do {
+            sent = send(m_sd, buffers[index].iov_base, buffers[index].iov_len, 0);
+            m_sendCalls++;
+        } while ((sent < 0) && (errno == EINTR));
+
+        if (sent < 0)
+        {
+            /* Darwin reports a full interface queue with ENOBUFS. */
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS)) break;
+            if (index > 0) break;
+
+            m_error = errno;
+            return -1;
+        }
+    }
+
+    m_datagramsSent += index;
+    return (intptr_t)index;
+}
+//}}}
+// - (intptr_t)sendDatagrams:(NSArray *)datagrams;//{{{
+- (intptr_t)sendDatagrams:(NSArray *)datagrams
+{
+    NSUInteger index, count = [datagrams count];
+    struct iovec local[SF_DATAGRAM_BATCH_SIZE];
+    struct iovec *buffers = local;
+    intptr_t sent;
+
+    if (count > SF_DATAGRAM_BATCH_SIZE)
+    {
+        buffers = (struct iovec *)malloc(count * sizeof(struct iovec));
+        if (buffers == NULL) {
+            m_error = ENOMEM;
+            return -1;
+        }
+    }
+
+    for (index = 0; index < count; ++index)
+    {
+        NSData *data = [datagrams objectAtIndex:index];
+
+        buffers[index].iov_base = (void *)[data bytes];
+        buffers[index].iov_len  = [data length];
+    }
+
+    sent = [self sendBuffers:buffers count:count];
+    if (buffers != local) free(buffers);
+    return sent;
+}
+//}}}
+// - (BOOL)send:(const void *)bytes length:(size_t)length toAddress:(NSData *)address;//{{{
+- (BOOL)send:(const void *)bytes length:(size_t)length toAddress:(NSData *)address
+{
+    const struct sockaddr *addr = (const struct sockaddr *)[address bytes];
+    ssize_t sent;
+
+    m_error = 0;
+    if ([address length] < sizeof(struct sockaddr)) {
+        m_error = EINVAL;
+        return FALSE;
+    }
+    if ([self openFamily:addr->sa_family] != 0)
+        return FALSE;
+
+    do {
+        sent = sendto(m_sd, bytes, length, 0, addr, (socklen_t)[address length]);
+        m_sendCalls++;
+    } while ((sent < 0) && (errno == EINTR));
+
+    if (sent < 0) {
+        m_error = errno;
+        return FALSE;
+    }
+    m_datagramsSent++;
+    return TRUE;
+}
+//}}}
+
+// Local Operations
+// - (error_t)openFamily:(sa_family_t)family;//{{{
+- (error_t)openFamily:(sa_family_t)family
+{
+    struct sockaddr_storage addr;
+    socklen_t size = sizeof(addr);
+    int blockModeOff = TRUE;
+
+    m_error = 0;
+    if (m_sd >= 0)
+    {
+        if ((getsockname(m_sd, (struct sockaddr *)&addr, &size) == 0) && (addr.ss_family != family))
+            m_error = EAFNOSUPPORT;
+        return m_error;
+    }
+
+    if ((family != AF_INET) && (family != AF_INET6))
+        return m_error = EAFNOSUPPORT;
+
+    m_sd = socket(family, SOCK_DGRAM, IPPROTO_UDP);
+    if (m_sd < 0) {
+        return m_error = errno;
+    }
+
+    ioctl(m_sd, FIONBIO, &blockModeOff);
+
+    /* A failed option doesn't stop the socket. It is logged by the profile. */
+    [m_profile applyToDescriptor:m_sd];
+    return m_error;
+}
+//}}}
+// - (NSData *)addressOf:(NSString *)host port:(NSUInteger)port;//{{{
+- (NSData *)addressOf:(NSString *)host port:(NSUInteger)port
+{
+    NSArray *addresses = [[SFResolver sharedResolver] addressesForHost:host port:port error:&m_error];
+
+    return [addresses objectAtIndex:0];
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
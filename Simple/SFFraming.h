@@ -0,0 +1,145 @@
+/**
+ * \file
+ * Declares the SFFraming Objective-C category extension for
+ * SFStream interface.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "SFStream.h"
+#import "sfvarint.h"
+
+/**
+ * \ingroup sf_networking
+ * SFStream varint and framing additions.
+ * The operations are wrappers of the functions in sfvarint.h. Frames are
+ * read without copying: the payload is returned as a slice of the stream
+ * buffer (see SFStream::streamWithRange:). A reading loop fed by a socket
+ * looks like this:
+ * @code
+ * SFStream *input = [[SFStream alloc] initWithCapacity:65536];
+ * SFStream *frame;
+ *
+ * while ([socket readIntoStream:input] > 0)
+ * {
+ *     while ((frame = [input readFrameWithMaximumLength:limit]) != nil)
+ *         [self process:frame];
+ *
+ *     if ([input peekFrameLength:NULL maximumLength:limit] == SFFrameMalformed)
+ *         break;
+ *     [input purgeReadBytes];
+ * }
+ * @endcode
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFStream (SFFraming)
+/** @name Varints */ //@{
+// - (BOOL)writeVarint:(uint64_t)value;//{{{
+/**
+ * Writes an unsigned integer in LEB128 encoding.
+ * @param value The value.
+ * @return \b YES on success. \b NO when there is no memory available.
+ **/
+- (BOOL)writeVarint:(uint64_t)value;
+//}}}
+// - (BOOL)readVarint:(uint64_t *)value;//{{{
+/**
+ * Reads an unsigned integer in LEB128 encoding.
+ * @param value Receives the value.
+ * @return \b YES on success. \b NO when the value is incomplete or
+ * malformed. Then the read position is not changed.
+ **/
+- (BOOL)readVarint:(uint64_t *)value;
+//}}}
+// - (BOOL)writeSignedVarint:(int64_t)value;//{{{
+/**
+ * Writes a signed integer in zigzag and LEB128 encoding.
+ * @param value The value.
+ * @return \b YES on success. \b NO when there is no memory available.
+ **/
+- (BOOL)writeSignedVarint:(int64_t)value;
+//}}}
+// - (BOOL)readSignedVarint:(int64_t *)value;//{{{
+/**
+ * Reads a signed integer in zigzag and LEB128 encoding.
+ * @param value Receives the value.
+ * @return \b YES on success. \b NO when the value is incomplete or
+ * malformed. Then the read position is not changed.
+ **/
+- (BOOL)readSignedVarint:(int64_t *)value;
+//}}}
+// - (size_t)readVarints:(uint64_t *)values count:(size_t)count;//{{{
+/**
+ * Reads a sequence of unsigned integers in LEB128 encoding.
+ * @param values Array that receives the values.
+ * @param count Maximum number of values to read.
+ * @return The number of values read. The read position is moved after the
+ * last value read.
+ **/
+- (size_t)readVarints:(uint64_t *)values count:(size_t)count;
+//}}}
+//@}
+
+/** @name Frames */ //@{
+// - (BOOL)writeFrame:(const void *)data length:(size_t)length;//{{{
+/**
+ * Writes a frame: the payload length as a varint followed by the payload.
+ * @param data The payload.
+ * @param length Number of bytes in \a data.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeFrame:(const void *)data length:(size_t)length;
+//}}}
+// - (BOOL)writeFrameWithData:(NSData *)data;//{{{
+/**
+ * Writes a frame with the content of a \c NSData object.
+ * @param data The payload. \b nil writes an empty frame.
+ * @return \b YES on success. \b NO when there is no memory available.
+ **/
+- (BOOL)writeFrameWithData:(NSData *)data;
+//}}}
+// - (SFFrameStatus)peekFrameLength:(size_t *)length maximumLength:(size_t)maximum;//{{{
+/**
+ * Checks whether a whole frame is available at the read position.
+ * Nothing is consumed.
+ * @param length Receives the payload length when the prefix is complete.
+ * Can be \b NULL.
+ * @param maximum Greatest payload length accepted. Longer frames are
+ * reported as malformed.
+ * @return One of the \c SFFrameStatus values.
+ **/
+- (SFFrameStatus)peekFrameLength:(size_t *)length maximumLength:(size_t)maximum;
+//}}}
+// - (SFStream *)readFrameWithMaximumLength:(size_t)maximum;//{{{
+/**
+ * Reads a whole frame.
+ * @param maximum Greatest payload length accepted.
+ * @return A temporary SFStream object sharing the payload bytes with this
+ * stream. \b nil when there is no whole frame available. In this case the
+ * read position is not changed.
+ **/
+- (SFStream *)readFrameWithMaximumLength:(size_t)maximum;
+//}}}
+// - (NSData *)readFrameDataWithMaximumLength:(size_t)maximum;//{{{
+/**
+ * Reads a whole frame as a \c NSData object.
+ * @param maximum Greatest payload length accepted.
+ * @return A temporary \c NSData object sharing the payload bytes with this
+ * stream. An empty frame results in an empty object. \b nil when there is no
+ * whole frame available. In this case the read position is not changed.
+ **/
+- (NSData *)readFrameDataWithMaximumLength:(size_t)maximum;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
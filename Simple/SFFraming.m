@@ -0,0 +1,116 @@
+/**
+ * \file
+ * Defines the SFFraming Objective-C category extension for
+ * SFStream interface.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFFraming.h"
+
+/* ===========================================================================
+ * SFFraming CATEGORY EXTENSION
+ * ======================================================================== */
+@implementation SFStream (SFFraming)
+// Varints
+// - (BOOL)writeVarint:(uint64_t)value;//{{{
+- (BOOL)writeVarint:(uint64_t)value
+{
+    return SFStreamWriteVarint([self handle], value);
+}
+//}}}
+// - (BOOL)readVarint:(uint64_t *)value;//{{{
+- (BOOL)readVarint:(uint64_t *)value
+{
+    return SFStreamReadVarint([self handle], value);
+}
+//}}}
+// - (BOOL)writeSignedVarint:(int64_t)value;//{{{
+- (BOOL)writeSignedVarint:(int64_t)value
+{
+    return SFStreamWriteSignedVarint([self handle], value);
+}
+//}}}
+// - (BOOL)readSignedVarint:(int64_t *)value;//{{{
+- (BOOL)readSignedVarint:(int64_t *)value
+{
+    return SFStreamReadSignedVarint([self handle], value);
+}
+//}}}
+// - (size_t)readVarints:(uint64_t *)values count:(size_t)count;//{{{
+- (size_t)readVarints:(uint64_t *)values count:(size_t)count
+{
+    stream_t *s = [self handle];
+    size_t consumed = 0;
+    size_t total = SFVarintDecodeArray((s->buffer + s->nextRead), SFStreamAvailable(s), values, count, &consumed);
+
+    s->nextRead += consumed;
+    return total;
+}
+//}}}
+
+// Frames
+// - (BOOL)writeFrame:(const void *)data length:(size_t)length;//{{{
+- (BOOL)writeFrame:(const void *)data length:(size_t)length
+{
+    return SFStreamWriteFrame([self handle], data, length);
+}
+//}}}
+// - (BOOL)writeFrameWithData:(NSData *)data;//{{{
+- (BOOL)writeFrameWithData:(NSData *)data
+{
+    return SFStreamWriteFrame([self handle], [data bytes], [data length]);
+}
+//}}}
+// - (SFFrameStatus)peekFrameLength:(size_t *)length maximumLength:(size_t)maximum;//{{{
+- (SFFrameStatus)peekFrameLength:(size_t *)length maximumLength:(size_t)maximum
+{
+    return SFStreamPeekFrame([self handle], maximum, NULL, length);
+}
+//}}}
+// - (SFStream *)readFrameWithMaximumLength:(size_t)maximum;//{{{
+- (SFStream *)readFrameWithMaximumLength:(size_t)maximum
+{
+    stream_t *s = [self handle];
+    size_t header = 0, length = 0;
+
+    if (SFStreamPeekFrame(s, maximum, &header, &length) != SFFrameComplete)
+        return nil;
+
+    SFStream *frame = [self streamWithRange:NSMakeRange((s->nextRead + header), length)];
+    if (frame != nil)
+        s->nextRead += (header + length);
+
+    return frame;
+}
+//}}}
+// - (NSData *)readFrameDataWithMaximumLength:(size_t)maximum;//{{{
+- (NSData *)readFrameDataWithMaximumLength:(size_t)maximum
+{
+    stream_t *s = [self handle];
+    size_t header = 0, length = 0;
+
+    if (SFStreamPeekFrame(s, maximum, &header, &length) != SFFrameComplete)
+        return nil;
+
+    s->nextRead += header;
+    if (length == 0)
+        return [NSData data];
+
+    NSData *data = [self dataFromReadingBytes:(intptr_t)length];
+    if (data == nil)
+        s->nextRead -= header;      /* No memory. Nothing is consumed. */
+
+    return data;
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
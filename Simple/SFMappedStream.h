@@ -0,0 +1,118 @@
+/**
+ * \file
+ * Declares the SFMappedStream Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "SFStream.h"
+
+/**
+ * \ingroup sf_networking
+ * \defgroup sf_mapped_stream_consts Constants
+ * Enumerations and constants for this group.
+ * @{ *//* ---------------------------------------------------------------- */
+typedef NS_ENUM(NSInteger, SFMappedStreamAccess) {
+    SFMappedStreamAccessNormal = 0,         /**< No special treatment.      */
+    SFMappedStreamAccessSequential = 1,     /**< Read ahead aggressively.   */
+    SFMappedStreamAccessRandom = 2          /**< Don't read ahead.          */
+};
+///@} sf_mapped_stream_consts
+
+/**
+ * \ingroup sf_networking
+ * A read-only stream over a memory mapped file.
+ * Nothing is read when the object is created. The file pages are loaded by
+ * the system when they are touched, so opening a large file is immediate and
+ * the memory used follows the data actually read.
+ *
+ * When the file is larger than the window size only part of it is mapped at
+ * a time. The window is moved when a read needs bytes outside it. This keeps
+ * the address space used bounded on 32 bits devices. #purgeReadBytes moves
+ * the start of the stream forward and tells the system the pages before it
+ * are not needed anymore.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFMappedStream : NSObject <SFStreamProtocol, SFStreamReaderProtocol>
+/** @name Properties */ //@{
+// @property (nonatomic) SFMappedStreamAccess accessPattern;//{{{
+/**
+ * Gets or sets how the stream is expected to be read.
+ * The value is given to the system through \c madvise() and controls how
+ * much data is read ahead. The default is \c SFMappedStreamAccessNormal.
+ **/
+@property (nonatomic) SFMappedStreamAccess accessPattern;
+//}}}
+// @property (nonatomic, readonly) size_t windowSize;//{{{
+/**
+ * Gets the maximum number of bytes mapped at once.
+ * Zero means that the whole region is mapped.
+ **/
+@property (nonatomic, readonly) size_t windowSize;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithPath:(NSString *)path offset:(off_t)offset length:(size_t)length windowSize:(size_t)windowSize;//{{{
+/**
+ * Initializes the object mapping a region of a file.
+ * @param path Full path of the file.
+ * @param offset Offset, in the file, of the first byte of the stream.
+ * @param length Number of bytes of the stream. When zero the stream goes to
+ * the end of the file. Also it is limited to the end of the file.
+ * @param windowSize Maximum number of bytes mapped at once. It is rounded up
+ * to the system page size. When zero the whole region is mapped.
+ * @return This object initialized or \b nil when the file cannot be opened
+ * or mapped. The error number is left in \c errno.
+ **/
+- (instancetype)initWithPath:(NSString *)path offset:(off_t)offset length:(size_t)length windowSize:(size_t)windowSize;
+//}}}
+// - (instancetype)initWithPath:(NSString *)path;//{{{
+/**
+ * Initializes the object mapping a file.
+ * @param path Full path of the file.
+ * @return This object initialized or \b nil when the file cannot be opened
+ * or mapped. The error number is left in \c errno.
+ * @remarks On 64 bits devices the whole file is mapped. Otherwise windows of
+ * 64 MB are used.
+ **/
+- (instancetype)initWithPath:(NSString *)path;
+//}}}
+//@}
+
+/** @name Direct Access */ //@{
+// - (const uint8_t *)bytesAtIndex:(size_t)offset length:(size_t)length;//{{{
+/**
+ * Gets the address of a region of the stream.
+ * @param offset Offset of the first byte of the region.
+ * @param length Number of contiguous bytes needed.
+ * @return The address of the byte at \a offset. \b NULL when the region goes
+ * beyond the stream length or it cannot be mapped.
+ * @remarks When the stream uses a window #bytes and #bytesAtIndex: return
+ * memory valid only up to the end of the current window, as reported by
+ * #numberOfContiguousBytes for the reading position. This operation
+ * moves the window so \a length bytes are accessible. In both cases the
+ * address is valid until the next operation on the stream.
+ **/
+- (const uint8_t *)bytesAtIndex:(size_t)offset length:(size_t)length;
+//}}}
+// - (void)willNeedLength:(size_t)length;//{{{
+/**
+ * Asks the system to load the next bytes in background.
+ * @param length Number of bytes, starting at the read position. They are
+ * limited to the current window.
+ **/
+- (void)willNeedLength:(size_t)length;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
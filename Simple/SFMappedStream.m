@@ -0,0 +1,535 @@
+/**
+ * \file
+ * Defines the SFMappedStream Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFMappedStream.h"
+#import "sfdebug.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <libkern/OSByteOrder.h>
+
+/**
+ * Window size used by SFMappedStream::initWithPath: on 32 bits devices.
+ **/
+#define SFMAPPED_DEFAULT_WINDOW     (64 * 1024 * 1024)
+
+/* ===========================================================================
+ * MAPPING FUNCTIONS
+ * ======================================================================== */
+/**
+ * State of a mapped file region.
+ * The stream byte at offset \c n is the file byte at \c base + \c n.
+ **/
+typedef struct SF_MAPPED {
+    int      fd;                    /**< File descriptor or -1.             */
+    int      advice;                /**< Value given to madvise().          */
+    uint8_t *map;                   /**< Mapped memory or NULL.             */
+    size_t   mapLength;             /**< Length of the mapping.             */
+    off_t    mapOffset;             /**< File offset of the mapping.        */
+    off_t    base;                  /**< File offset of the stream start.   */
+    size_t   length;                /**< Length of the stream.              */
+    size_t   nextRead;              /**< Next reading offset.               */
+    size_t   window;                /**< Maximum mapping length or zero.    */
+} mapped_t;
+
+// static void mapped_unmap(mapped_t *m);//{{{
+/**
+ * Removes the current mapping.
+ **/
+static void mapped_unmap(mapped_t *m)
+{
+    if (m->map != NULL)
+        munmap(m->map, m->mapLength);
+
+    m->map = NULL;
+    m->mapLength = 0;
+    m->mapOffset = 0;
+}
+//}}}
+// static const uint8_t *mapped_remap(mapped_t *m, size_t offset, size_t size);//{{{
+/**
+ * Maps a window starting at the page of a stream offset.
+ * The window has, at least, \a size bytes after \a offset.
+ **/
+static const uint8_t *mapped_remap(mapped_t *m, size_t offset, size_t size)
+{
+    off_t page  = (off_t)getpagesize();
+    off_t start = (m->base + (off_t)offset);
+    off_t from  = (start & ~(page - 1));
+    off_t end   = (m->base + (off_t)m->length);
+    size_t span = ((m->window > 0) ? m->window : (size_t)(end - from));
+
+    if (span < (size_t)(start - from) + size)
+        span = ((size_t)(start - from) + size);
+    if ((off_t)span > (end - from))
+        span = (size_t)(end - from);
+
+    mapped_unmap(m);
+
+    void *ptr = mmap(NULL, span, PROT_READ, MAP_PRIVATE, m->fd, from);
+    if (ptr == MAP_FAILED)
+        return NULL;
+
+    madvise(ptr, span, m->advice);
+
+    m->map = (uint8_t *)ptr;
+    m->mapLength = span;
+    m->mapOffset = from;
+    return (m->map + (start - from));
+}
+//}}}
+// static inline const uint8_t *mapped_window(mapped_t *m, size_t offset, size_t size);//{{{
+/**
+ * Gets the address of \a size contiguous bytes at a stream offset.
+ * The caller guarantees that the region is inside the stream.
+ **/
+static inline const uint8_t *mapped_window(mapped_t *m, size_t offset, size_t size)
+{
+    off_t start = (m->base + (off_t)offset);
+
+    if ((m->map != NULL) && (start >= m->mapOffset) && ((start + (off_t)size) <= (m->mapOffset + (off_t)m->mapLength)))
+        return (m->map + (start - m->mapOffset));
+
+    return mapped_remap(m, offset, size);
+}
+//}}}
+// static inline size_t mapped_contiguous(const mapped_t *m, size_t offset);//{{{
+/**
+ * Gets the number of mapped bytes from a stream offset to the end of the
+ * current window. The offset must be mapped.
+ **/
+static inline size_t mapped_contiguous(const mapped_t *m, size_t offset)
+{
+    off_t start = (m->base + (off_t)offset);
+    return (size_t)((m->mapOffset + (off_t)m->mapLength) - start);
+}
+//}}}
+// static inline BOOL mapped_read(mapped_t *m, void *dest, size_t size);//{{{
+/**
+ * Reads exactly \a size bytes. Nothing is read if there is not enough data.
+ **/
+static inline BOOL mapped_read(mapped_t *m, void *dest, size_t size)
+{
+    const uint8_t *ptr;
+
+    if ((m->length - m->nextRead) < size)
+        return NO;
+
+    if ((ptr = mapped_window(m, m->nextRead, size)) == NULL)
+        return NO;
+
+    memcpy(dest, ptr, size);
+    m->nextRead += size;
+    return YES;
+}
+//}}}
+
+/* ===========================================================================
+ * SFMappedStream EXTENSION
+ * ======================================================================== */
+@interface SFMappedStream () {
+    mapped_t m_mapped;
+    SFMappedStreamAccess m_access;
+}
+@end
+
+/* ===========================================================================
+ * SFMappedStream IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFMappedStream
+// Properties
+// @property (nonatomic) SFMappedStreamAccess accessPattern;//{{{
+- (SFMappedStreamAccess)accessPattern {
+    return m_access;
+}
+- (void)setAccessPattern:(SFMappedStreamAccess)accessPattern
+{
+    switch (accessPattern)
+    {
+    case SFMappedStreamAccessSequential: m_mapped.advice = MADV_SEQUENTIAL; break;
+    case SFMappedStreamAccessRandom:     m_mapped.advice = MADV_RANDOM;     break;
+    default:                             m_mapped.advice = MADV_NORMAL;     break;
+    }
+    m_access = accessPattern;
+
+    if (m_mapped.map != NULL)
+        madvise(m_mapped.map, m_mapped.mapLength, m_mapped.advice);
+}
+//}}}
+// @property (nonatomic, readonly) size_t windowSize;//{{{
+- (size_t)windowSize {
+    return m_mapped.window;
+}
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithPath:(NSString *)path offset:(off_t)offset length:(size_t)length windowSize:(size_t)windowSize;//{{{
+- (instancetype)initWithPath:(NSString *)path offset:(off_t)offset length:(size_t)length windowSize:(size_t)windowSize
+{
+    self = [super init];
+    if (self)
+    {
+        struct stat info;
+        size_t page = (size_t)getpagesize();
+
+        m_mapped.fd = open([path fileSystemRepresentation], O_RDONLY);
+        m_mapped.advice = MADV_NORMAL;
+
+        if ((m_mapped.fd < 0) || (fstat(m_mapped.fd, &info) < 0) || (offset < 0))
+        {
+            if (offset < 0) errno = EINVAL;
+            [self release];
+            return nil;
+        }
+
+        if (offset > info.st_size) offset = info.st_size;
+        if ((length == 0) || ((off_t)length > (info.st_size - offset)))
+            length = (size_t)(info.st_size - offset);
+
+        if ((windowSize > 0) && (windowSize < length))
+            m_mapped.window = ((windowSize + (page - 1)) & ~(page - 1));
+
+        m_mapped.base = offset;
+        m_mapped.length = length;
+
+        /* The whole region is mapped now and the file is not needed anymore.
+         * Windows are mapped when first read. */
+        if (m_mapped.window == 0)
+        {
+            if ((length > 0) && (mapped_remap(&m_mapped, 0, 0) == NULL))
+            {
+                [self release];
+                return nil;
+            }
+            close(m_mapped.fd);
+            m_mapped.fd = -1;
+        }
+    }
+    return self;
+}
+//}}}
+// - (instancetype)initWithPath:(NSString *)path;//{{{
+- (instancetype)initWithPath:(NSString *)path
+{
+    size_t window = ((sizeof(void *) > 4) ? 0 : SFMAPPED_DEFAULT_WINDOW);
+    return [self initWithPath:path offset:0 length:0 windowSize:window];
+}
+//}}}
+
+// NSObject: Overrides
+// - (id)init;//{{{
+- (id)init
+{
+    m_mapped.fd = -1;
+    [self release];
+    return nil;
+}
+//}}}
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    mapped_unmap(&m_mapped);
+    if (m_mapped.fd >= 0) close(m_mapped.fd);
+    [super dealloc];
+}
+//}}}
+
+// Direct Access
+// - (const uint8_t *)bytesAtIndex:(size_t)offset length:(size_t)length;//{{{
+- (const uint8_t *)bytesAtIndex:(size_t)offset length:(size_t)length
+{
+    if ((offset >= m_mapped.length) || (length > (m_mapped.length - offset)))
+        return NULL;
+
+    return mapped_window(&m_mapped, offset, ((length > 0) ? length : 1));
+}
+//}}}
+// - (void)willNeedLength:(size_t)length;//{{{
+- (void)willNeedLength:(size_t)length
+{
+    size_t available = (m_mapped.length - m_mapped.nextRead);
+    size_t page = (size_t)getpagesize();
+
+    if (length > available) length = available;
+    if (length == 0) return;
+
+    const uint8_t *ptr = mapped_window(&m_mapped, m_mapped.nextRead, 1);
+    if (ptr == NULL) return;
+
+    size_t contiguous = mapped_contiguous(&m_mapped, m_mapped.nextRead);
+    if (length > contiguous) length = contiguous;
+
+    /* madvise() needs an address aligned to the page. */
+    uintptr_t start = ((uintptr_t)ptr & ~(uintptr_t)(page - 1));
+    madvise((void *)start, (length + ((uintptr_t)ptr - start)), MADV_WILLNEED);
+}
+//}}}
+
+// SFStreamProtocol: Properties Implementation
+// - (size_t)capacity;//{{{
+- (size_t)capacity {
+    return m_mapped.length;
+}
+//}}}
+// - (size_t)length;//{{{
+- (size_t)length {
+    return m_mapped.length;
+}
+//}}}
+
+// SFStreamReaderProtocol Reading Information
+// - (size_t)readPosition;//{{{
+- (size_t)readPosition {
+    return m_mapped.nextRead;
+}
+//}}}
+// - (size_t)numberOfBytesAvailable;//{{{
+- (size_t)numberOfBytesAvailable {
+    return (m_mapped.length - m_mapped.nextRead);
+}
+//}}}
+// - (BOOL)setReadPosition:(size_t)offset;//{{{
+- (BOOL)setReadPosition:(size_t)offset
+{
+    if (offset > m_mapped.length) return NO;
+    m_mapped.nextRead = offset;
+    return YES;
+}
+//}}}
+
+// SFStreamReaderProtocol Direct Access
+// - (const uint8_t *)bytes;//{{{
+- (const uint8_t *)bytes
+{
+    if (m_mapped.nextRead >= m_mapped.length)
+        return NULL;
+
+    return mapped_window(&m_mapped, m_mapped.nextRead, 1);
+}
+//}}}
+// - (const uint8_t *)bytesAtIndex:(size_t)offset;//{{{
+- (const uint8_t *)bytesAtIndex:(size_t)offset
+{
+    sfassert(offset < m_mapped.length, "SFMappedStream::bytesAtIndex[] offset greater than length\n");
+    if (offset >= m_mapped.length) return NULL;
+
+    return mapped_window(&m_mapped, offset, 1);
+}
+//}}}
+// - (size_t)numberOfContiguousBytes;//{{{
+- (size_t)numberOfContiguousBytes
+{
+    size_t available = (m_mapped.length - m_mapped.nextRead);
+
+    if (available == 0)
+        return 0;
+
+    /* Maps the window #bytes will return, then measures it. */
+    if (mapped_window(&m_mapped, m_mapped.nextRead, 1) == NULL)
+        return 0;
+
+    size_t contiguous = mapped_contiguous(&m_mapped, m_mapped.nextRead);
+    return ((contiguous < available) ? contiguous : available);
+}
+//}}}
+
+// SFStreamReaderProtocol Basic Reading Operations
+// - (size_t)read:(void *)buffer length:(size_t)length;//{{{
+- (size_t)read:(void *)buffer length:(size_t)length
+{
+    size_t available = (m_mapped.length - m_mapped.nextRead);
+    size_t total = 0;
+    uint8_t *out = (uint8_t *)buffer;
+
+    if (length > available) length = available;
+    if (buffer == NULL) return 0;
+
+    /* Copies window by window. */
+    while (total < length)
+    {
+        const uint8_t *ptr = mapped_window(&m_mapped, m_mapped.nextRead, 1);
+        if (ptr == NULL) break;
+
+        size_t part = mapped_contiguous(&m_mapped, m_mapped.nextRead);
+        if (part > (length - total)) part = (length - total);
+
+        memcpy(out + total, ptr, part);
+        total += part;
+        m_mapped.nextRead += part;
+    }
+    return total;
+}
+//}}}
+// - (uint8_t)readByte;//{{{
+- (uint8_t)readByte
+{
+    uint8_t value = 0;
+
+    mapped_read(&m_mapped, &value, sizeof(uint8_t));
+    return value;
+}
+//}}}
+// - (uint16_t)readShort;//{{{
+- (uint16_t)readShort
+{
+    uint16_t value = 0;
+
+    mapped_read(&m_mapped, &value, sizeof(uint16_t));
+    return value;
+}
+//}}}
+// - (uint32_t)readInt;//{{{
+- (uint32_t)readInt
+{
+    uint32_t value = 0;
+
+    mapped_read(&m_mapped, &value, sizeof(uint32_t));
+    return value;
+}
+//}}}
+// - (uint64_t)readLong;//{{{
+- (uint64_t)readLong
+{
+    uint64_t value = 0;
+
+    mapped_read(&m_mapped, &value, sizeof(uint64_t));
+    return value;
+}
+//}}}
+// - (float)readFloat;//{{{
+- (float)readFloat
+{
+    float value = 0.0f;
+
+    mapped_read(&m_mapped, &value, sizeof(float));
+    return value;
+}
+//}}}
+// - (double)readDouble;//{{{
+- (double)readDouble
+{
+    double value = 0.0;
+
+    mapped_read(&m_mapped, &value, sizeof(double));
+    return value;
+}
+//}}}
+// - (void)purgeReadBytes;//{{{
+- (void)purgeReadBytes
+{
+    size_t page = (size_t)getpagesize();
+    off_t start = (m_mapped.base + (off_t)m_mapped.nextRead);
+
+    if (m_mapped.nextRead == 0)
+        return;
+
+    /* Pages of the current mapping before the new start are dropped. */
+    if ((m_mapped.map != NULL) && (start > m_mapped.mapOffset))
+    {
+        off_t end = (m_mapped.mapOffset + (off_t)m_mapped.mapLength);
+        size_t unused = (size_t)(((start < end) ? start : end) - m_mapped.mapOffset);
+
+        unused &= ~(page - 1);
+        if (unused > 0)
+            madvise(m_mapped.map, unused, MADV_DONTNEED);
+    }
+
+    m_mapped.base   += (off_t)m_mapped.nextRead;
+    m_mapped.length -= m_mapped.nextRead;
+    m_mapped.nextRead = 0;
+}
+//}}}
+
+// SFStreamReaderProtocol Big-Endian to Host Conversions
+// - (uint16_t)readBigEndianShort;//{{{
+- (uint16_t)readBigEndianShort
+{
+    return OSSwapBigToHostInt16([self readShort]);
+}
+//}}}
+// - (uint32_t)readBigEndianInt;//{{{
+- (uint32_t)readBigEndianInt
+{
+    return OSSwapBigToHostInt32([self readInt]);
+}
+//}}}
+// - (uint64_t)readBigEndignLong;//{{{
+- (uint64_t)readBigEndignLong
+{
+    return OSSwapBigToHostInt64([self readLong]);
+}
+//}}}
+// - (float)readBigEndianFloat;//{{{
+- (float)readBigEndianFloat
+{
+    NSSwappedFloat swappedFloat = { 0 };
+
+    mapped_read(&m_mapped, &swappedFloat, sizeof(NSSwappedFloat));
+    return NSSwapBigFloatToHost(swappedFloat);
+}
+//}}}
+// - (double)readBigEndianDouble;//{{{
+- (double)readBigEndianDouble
+{
+    NSSwappedDouble swappedDouble = { 0 };
+
+    mapped_read(&m_mapped, &swappedDouble, sizeof(NSSwappedDouble));
+    return NSSwapBigDoubleToHost(swappedDouble);
+}
+//}}}
+
+// SFStreamReaderProtocol Little-Endian to Host Conversions
+// - (uint16_t)readLittleEndianShort;//{{{
+- (uint16_t)readLittleEndianShort
+{
+    return OSSwapLittleToHostInt16([self readShort]);
+}
+//}}}
+// - (uint32_t)readLittleEndianInt;//{{{
+- (uint32_t)readLittleEndianInt
+{
+    return OSSwapLittleToHostInt32([self readInt]);
+}
+//}}}
+// - (uint64_t)readLittleEndianLong;//{{{
+- (uint64_t)readLittleEndianLong
+{
+    return OSSwapLittleToHostInt64([self readLong]);
+}
+//}}}
+// - (float)readLittleEndianFloat;//{{{
+- (float)readLittleEndianFloat
+{
+    NSSwappedFloat swappedFloat = { 0 };
+
+    mapped_read(&m_mapped, &swappedFloat, sizeof(NSSwappedFloat));
+    return NSSwapLittleFloatToHost(swappedFloat);
+}
+//}}}
+// - (double)readLittleEndianDouble;//{{{
+- (double)readLittleEndianDouble
+{
+    NSSwappedDouble swappedDouble = { 0 };
+
+    mapped_read(&m_mapped, &swappedDouble, sizeof(NSSwappedDouble));
+    return NSSwapLittleDoubleToHost(swappedDouble);
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
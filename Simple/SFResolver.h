@@ -0,0 +1,193 @@
+/**
+ * \file
+ * Declares the SFResolver Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "sfstd.h"
+
+/**
+ * \ingroup sf_networking
+ * Block called with the result of a resolution.
+ * @param addresses Array of \c NSData objects, each one with a \c sockaddr
+ * structure (\c sockaddr_in or \c sockaddr_in6) with the port already set.
+ * \b nil when the resolution failed.
+ * @param error Zero on success. Otherwise the error number.
+ * @since 2.1
+ **/
+typedef void (^SFResolverCompletion)(NSArray *addresses, error_t error);
+
+/**
+ * \ingroup sf_networking
+ * Resolves host names asynchronously, keeping the results in a cache.
+ * Names are resolved with \c getaddrinfo() by a small pool of worker threads,
+ * so the caller is never blocked. Results are kept for #timeToLive seconds
+ * and failures for #negativeTimeToLive seconds. Requests for a name already
+ * being resolved don't start another lookup: they wait for the one in
+ * progress. Numeric addresses are converted in the caller thread and are not
+ * cached.
+ *
+ * The class is thread safe. Subclasses can replace the lookup, as a test
+ * stub, by overriding #lookupHost:port:addresses:.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFResolver : NSObject
+/** @name Properties */ //@{
+// @property (nonatomic) NSTimeInterval timeToLive;//{{{
+/**
+ * Gets or sets the number of seconds a resolved name is kept in the cache.
+ * Default is 60 seconds.
+ **/
+@property (nonatomic) NSTimeInterval timeToLive;
+//}}}
+// @property (nonatomic) NSTimeInterval negativeTimeToLive;//{{{
+/**
+ * Gets or sets the number of seconds a name that could not be resolved is
+ * kept in the cache.
+ * Temporary failures, like \c EAI_AGAIN, are not cached. Default is 10
+ * seconds.
+ **/
+@property (nonatomic) NSTimeInterval negativeTimeToLive;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfHits;//{{{
+/**
+ * Gets the number of requests answered by the cache.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfHits;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfMisses;//{{{
+/**
+ * Gets the number of requests that started a lookup.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfMisses;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfCoalesced;//{{{
+/**
+ * Gets the number of requests that waited for a lookup already in
+ * progress.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfCoalesced;
+//}}}
+// @property (nonatomic, readonly) double hitRate;//{{{
+/**
+ * Gets the fraction of requests, from 0.0 to 1.0, that didn't start a
+ * lookup.
+ * Requests that waited for a lookup in progress count as hits.
+ **/
+@property (nonatomic, readonly) double hitRate;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithThreads:(NSUInteger)count;//{{{
+/**
+ * Initializes the object and starts its worker threads.
+ * @param count Number of worker threads. Zero uses 2.
+ * @return This object initialized.
+ * @remarks The threads retain the object. Call #stop before releasing it.
+ **/
+- (instancetype)initWithThreads:(NSUInteger)count;
+//}}}
+//@}
+
+/** @name Resolution */ //@{
+// - (void)resolveHost:(NSString *)host port:(NSUInteger)port completion:(SFResolverCompletion)completion;//{{{
+/**
+ * Resolves a name.
+ * @param host The name or numeric address.
+ * @param port The port set in the resulting addresses.
+ * @param completion Block called with the result. It is called in the
+ * caller thread, before the method returns, when the result is in the cache
+ * or \a host is a numeric address. Otherwise it is called in a worker
+ * thread.
+ **/
+- (void)resolveHost:(NSString *)host port:(NSUInteger)port completion:(SFResolverCompletion)completion;
+//}}}
+// - (NSArray *)addressesForHost:(NSString *)host port:(NSUInteger)port error:(error_t *)error;//{{{
+/**
+ * Resolves a name, waiting for the result.
+ * The cache and the lookups in progress are used as in
+ * #resolveHost:port:completion:.
+ * @param host The name or numeric address.
+ * @param port The port set in the resulting addresses.
+ * @param error Receives zero or the error number. Can be \c NULL.
+ * @return Array of \c NSData objects with \c sockaddr structures. \b nil on
+ * failure.
+ **/
+- (NSArray *)addressesForHost:(NSString *)host port:(NSUInteger)port error:(error_t *)error;
+//}}}
+// - (NSArray *)cachedAddressesForHost:(NSString *)host port:(NSUInteger)port;//{{{
+/**
+ * Gets the addresses of a name only when they are in the cache.
+ * Doesn't change the statistics.
+ * @param host The name.
+ * @param port The port.
+ * @return Array of \c NSData objects with \c sockaddr structures. \b nil
+ * when the name is not in the cache, expired or failed.
+ **/
+- (NSArray *)cachedAddressesForHost:(NSString *)host port:(NSUInteger)port;
+//}}}
+//@}
+
+/** @name Operations */ //@{
+// - (void)removeAllEntries;//{{{
+/**
+ * Empties the cache.
+ * Lookups in progress are not affected.
+ **/
+- (void)removeAllEntries;
+//}}}
+// - (void)resetStatistics;//{{{
+/**
+ * Sets all counters to zero.
+ **/
+- (void)resetStatistics;
+//}}}
+// - (void)stop;//{{{
+/**
+ * Ends the worker threads after the lookups in progress.
+ * Requests made after this call fail with \c ECANCELED, unless answered by
+ * the cache.
+ **/
+- (void)stop;
+//}}}
+//@}
+
+/** @name Overrides */ //@{
+// - (error_t)lookupHost:(NSString *)host port:(NSUInteger)port addresses:(NSArray **)addresses;//{{{
+/**
+ * Makes the lookup of a name.
+ * Called in a worker thread. The default implementation calls \c
+ * getaddrinfo().
+ * @param host The name.
+ * @param port The port.
+ * @param addresses Receives the array of \c NSData objects with \c sockaddr
+ * structures, on success.
+ * @return Zero on success. \c EAGAIN for a temporary failure, that is not
+ * cached. Any other error number is cached for #negativeTimeToLive seconds.
+ **/
+- (error_t)lookupHost:(NSString *)host port:(NSUInteger)port addresses:(NSArray **)addresses;
+//}}}
+//@}
+
+/** @name Shared Resolver */ //@{
+// + (SFResolver *)sharedResolver;//{{{
+/**
+ * Gets the resolver used by SFSocket and SFSocketLoop.
+ * @return A resolver with the default number of threads. Never released.
+ **/
++ (SFResolver *)sharedResolver;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,444 @@
+/**
+ * \file
+ * Defines the SFResolver Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFResolver.h"
+#import "sfdebug.h"
+
+#include <sys/errno.h>
+#include <sys/socket.h>
+#include <netdb.h>
+
+/** Number of worker threads when none is given. */
+#define SF_RESOLVER_THREADS         2
+
+/** Default value of SFResolver::timeToLive, in seconds. */
+#define SF_RESOLVER_TTL             60.0
+
+/** Default value of SFResolver::negativeTimeToLive, in seconds. */
+#define SF_RESOLVER_NEGATIVE_TTL    10.0
+
+/* ===========================================================================
+ * SFResolverEntry INTERFACE
+ * ======================================================================== */
+/**
+ * One name in the cache. While the lookup is in progress it keeps the
+ * blocks waiting for the result.
+ **/
+@interface SFResolverEntry : NSObject {
+@public
+    NSString       *host;
+    NSUInteger      port;
+    NSArray        *addresses;
+    error_t         error;
+    NSTimeInterval  expires;        /* Reference date, in seconds.          */
+    NSMutableArray *waiting;        /* Not nil while the lookup runs.       */
+}
+@end
+
+@implementation SFResolverEntry
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [host release];
+    [addresses release];
+    [waiting release];
+    [super dealloc];
+}
+//}}}
+@end
+
+/* ===========================================================================
+ * SFResolver EXTENSION
+ * ======================================================================== */
+@interface SFResolver () {
+    NSCondition *m_lock;            /* Guards everything below.             */
+    NSMutableDictionary *m_entries;
+    NSMutableArray *m_queue;        /* Entries waiting for a worker.        */
+    BOOL m_stopping;
+    NSTimeInterval m_timeToLive;
+    NSTimeInterval m_negativeTimeToLive;
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint64_t m_coalesced;
+}
+// - (NSArray *)numericAddressesForHost:(NSString *)host port:(NSUInteger)port;//{{{
+/**
+ * Converts a numeric address without any lookup.
+ * @return \b nil when \a host is not numeric.
+ **/
+- (NSArray *)numericAddressesForHost:(NSString *)host port:(NSUInteger)port;
+//}}}
+// - (void)workerMain:(id)unused;//{{{
+/**
+ * Body of the worker threads.
+ **/
+- (void)workerMain:(id)unused;
+//}}}
+@end
+
+/* ===========================================================================
+ * Local Functions
+ * ======================================================================== */
+// static NSArray *SFResolverAddresses(struct addrinfo *list);//{{{
+/**
+ * Copies the addresses of a \c getaddrinfo() result.
+ **/
+static NSArray *SFResolverAddresses(struct addrinfo *list)
+{
+    NSMutableArray *addresses = [NSMutableArray array];
+
+    for (; list != NULL; list = list->ai_next)
+    {
+        if ((list->ai_family == AF_INET) || (list->ai_family == AF_INET6))
+            [addresses addObject:[NSData dataWithBytes:list->ai_addr length:list->ai_addrlen]];
+    }
+    return (([addresses count] > 0) ? addresses : nil);
+}
+//}}}
+// static error_t SFResolverError(int result);//{{{
+/**
+ * Converts a \c getaddrinfo() error to an error number.
+ * The values follow the ones used by SFSocket::open:port: before 2.1.
+ **/
+static error_t SFResolverError(int result)
+{
+    switch (result)
+    {
+    case EAI_NONAME: return ENETDOWN;
+    case EAI_AGAIN:  return EAGAIN;
+    case EAI_FAIL:   return ECONNREFUSED;
+    case EAI_MEMORY: return ENOMEM;
+    case EAI_SYSTEM: return errno;
+    default:         return ENETUNREACH;
+    }
+}
+//}}}
+
+/* ===========================================================================
+ * SFResolver IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFResolver
+// Properties
+// @property (nonatomic) NSTimeInterval timeToLive;//{{{
+@synthesize timeToLive = m_timeToLive;
+//}}}
+// @property (nonatomic) NSTimeInterval negativeTimeToLive;//{{{
+@synthesize negativeTimeToLive = m_negativeTimeToLive;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfHits;//{{{
+@synthesize numberOfHits = m_hits;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfMisses;//{{{
+@synthesize numberOfMisses = m_misses;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfCoalesced;//{{{
+@synthesize numberOfCoalesced = m_coalesced;
+//}}}
+// @property (nonatomic, readonly) double hitRate;//{{{
+- (double)hitRate
+{
+    double rate = 0.0;
+
+    [m_lock lock];
+    if ((m_hits + m_misses + m_coalesced) > 0)
+        rate = (double)(m_hits + m_coalesced) / (double)(m_hits + m_misses + m_coalesced);
+    [m_lock unlock];
+    return rate;
+}
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithThreads:(NSUInteger)count;//{{{
+- (instancetype)initWithThreads:(NSUInteger)count
+{
+    self = [super init];
+    if (self)
+    {
+        m_lock    = [NSCondition new];
+        m_entries = [NSMutableDictionary new];
+        m_queue   = [NSMutableArray new];
+        m_timeToLive = SF_RESOLVER_TTL;
+        m_negativeTimeToLive = SF_RESOLVER_NEGATIVE_TTL;
+
+        if (count == 0) count = SF_RESOLVER_THREADS;
+
+        while (count-- > 0)
+        {
+            NSThread *thread = [[NSThread alloc] initWithTarget:self selector:@selector(workerMain:) object:nil];
+            [thread setName:@"SFResolver"];
+            [thread start];
+            [thread release];
+        }
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (id)init;//{{{
+- (id)init
+{
+    return [self initWithThreads:0];
+}
+//}}}
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [m_lock release];
+    [m_entries release];
+    [m_queue release];
+    [super dealloc];
+}
+//}}}
+
+// Resolution
+// - (void)resolveHost:(NSString *)host port:(NSUInteger)port completion:(SFResolverCompletion)completion;//{{{
+- (void)resolveHost:(NSString *)host port:(NSUInteger)port completion:(SFResolverCompletion)completion
+{
+    NSString *key = [NSString stringWithFormat:@"%@:%lu", [host lowercaseString], (unsigned long)port];
+    NSArray  *numeric = [self numericAddressesForHost:host port:port];
+    SFResolverEntry *entry;
+
+    if (numeric != nil) {
+        completion(numeric, 0);
+        return;
+    }
+
+    [m_lock lock];
+    entry = [m_entries objectForKey:key];
+
+    if ((entry != nil) && (entry->waiting != nil))
+    {
+        /* A lookup is in progress. Waits for it. */
+        SFResolverCompletion copy = [completion copy];
+        [entry->waiting addObject:copy];
+        [copy release];
+        m_coalesced++;
+        [m_lock unlock];
+        return;
+    }
+
+    if ((entry != nil) && (entry->expires > [NSDate timeIntervalSinceReferenceDate]))
+    {
+        NSArray *addresses = [[entry->addresses retain] autorelease];
+        error_t  error = entry->error;
+
+        m_hits++;
+        [m_lock unlock];
+        completion(addresses, error);
+        return;
+    }
+
+    if (m_stopping) {
+        [m_lock unlock];
+        completion(nil, ECANCELED);
+        return;
+    }
+
+    entry = [[SFResolverEntry alloc] init];
+    entry->host    = [host copy];
+    entry->port    = port;
+    entry->waiting = [[NSMutableArray alloc] initWithObjects:[[completion copy] autorelease], nil];
+
+    [m_entries setObject:entry forKey:key];
+    [m_queue addObject:entry];
+    [entry release];
+    m_misses++;
+
+    [m_lock signal];
+    [m_lock unlock];
+}
+//}}}
+// - (NSArray *)addressesForHost:(NSString *)host port:(NSUInteger)port error:(error_t *)error;//{{{
+- (NSArray *)addressesForHost:(NSString *)host port:(NSUInteger)port error:(error_t *)error
+{
+    NSConditionLock *done = [[NSConditionLock alloc] initWithCondition:0];
+    __block NSArray *result = nil;
+    __block error_t  failure = 0;
+
+    [self resolveHost:host port:port completion:^(NSArray *addresses, error_t code) {
+        [done lock];
+        result  = [addresses retain];
+        failure = code;
+        [done unlockWithCondition:1];
+    }];
+
+    [done lockWhenCondition:1];
+    [done unlock];
+    [done release];
+
+    if (error != NULL) *error = failure;
+    return [result autorelease];
+}
+//}}}
+// - (NSArray *)cachedAddressesForHost:(NSString *)host port:(NSUInteger)port;//{{{
+- (NSArray *)cachedAddressesForHost:(NSString *)host port:(NSUInteger)port
+{
+    NSString *key = [NSString stringWithFormat:@"%@:%lu", [host lowercaseString], (unsigned long)port];
+    SFResolverEntry *entry;
+    NSArray *addresses = nil;
+
+    [m_lock lock];
+    entry = [m_entries objectForKey:key];
+    if ((entry != nil) && (entry->waiting == nil) && (entry->expires > [NSDate timeIntervalSinceReferenceDate]))
+        addresses = [[entry->addresses retain] autorelease];
+    [m_lock unlock];
+    return addresses;
+}
+//}}}
+
+// Operations
+// - (void)removeAllEntries;//{{{
+- (void)removeAllEntries
+{
+    NSMutableArray *pending = [NSMutableArray array];
+
+    [m_lock lock];
+    for (SFResolverEntry *entry in [m_entries objectEnumerator])
+    {
+        if (entry->waiting != nil)
+            [pending addObject:entry];
+    }
+    [m_entries removeAllObjects];
+
+    /* Lookups in progress still coalesce new requests. */
+    for (SFResolverEntry *entry in pending)
+        [m_entries setObject:entry forKey:[NSString stringWithFormat:@"%@:%lu", [entry->host lowercaseString], (unsigned long)entry->port]];
+    [m_lock unlock];
+}
+//}}}
+// - (void)resetStatistics;//{{{
+- (void)resetStatistics
+{
+    [m_lock lock];
+    m_hits = m_misses = m_coalesced = 0;
+    [m_lock unlock];
+}
+//}}}
+// - (void)stop;//{{{
+- (void)stop
+{
+    [m_lock lock];
+    m_stopping = YES;
+    [m_lock broadcast];
+    [m_lock unlock];
+}
+//}}}
+
+// Overrides
+// - (error_t)lookupHost:(NSString *)host port:(NSUInteger)port addresses:(NSArray **)addresses;//{{{
+- (error_t)lookupHost:(NSString *)host port:(NSUInteger)port addresses:(NSArray **)addresses
+{
+    struct addrinfo hints, *list = NULL;
+    char service[16];
+    int  result;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags    = AI_NUMERICSERV;
+    snprintf(service, sizeof(service), "%lu", (unsigned long)port);
+
+    result = getaddrinfo([host UTF8String], service, &hints, &list);
+    if (result != 0)
+        return SFResolverError(result);
+
+    *addresses = SFResolverAddresses(list);
+    freeaddrinfo(list);
+    return ((*addresses != nil) ? 0 : ENETDOWN);
+}
+//}}}
+
+// Shared Resolver
+// + (SFResolver *)sharedResolver;//{{{
++ (SFResolver *)sharedResolver
+{
+    static SFResolver *resolver = nil;
+    static dispatch_once_t once;
+
+    dispatch_once(&once, ^{
+        resolver = [[SFResolver alloc] initWithThreads:0];
+    });
+    return resolver;
+}
+//}}}
+
+// Local Operations
+// - (NSArray *)numericAddressesForHost:(NSString *)host port:(NSUInteger)port;//{{{
+- (NSArray *)numericAddressesForHost:(NSString *)host port:(NSUInteger)port
+{
+    struct addrinfo hints, *list = NULL;
+    char service[16];
+    NSArray *addresses;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags    = (AI_NUMERICHOST | AI_NUMERICSERV);
+    snprintf(service, sizeof(service), "%lu", (unsigned long)port);
+
+    if (getaddrinfo([host UTF8String], service, &hints, &list) != 0)
+        return nil;
+
+    addresses = SFResolverAddresses(list);
+    freeaddrinfo(list);
+    return addresses;
+}
+//}}}
+// - (void)workerMain:(id)unused;//{{{
+- (void)workerMain:(id)unused
+{
+    for (;;)
+    {
+        @autoreleasepool
+        {
+            SFResolverEntry *entry;
+            NSArray *addresses = nil, *waiting;
+            error_t error;
+
+            [m_lock lock];
+            while (([m_queue count] == 0) && !m_stopping)
+                [m_lock wait];
+
+            if ([m_queue count] == 0)
+            {
+                /* Stopping and nothing left to resolve. */
+                [m_lock unlock];
+                break;
+            }
+            entry = [[[m_queue objectAtIndex:0] retain] autorelease];
+            [m_queue removeObjectAtIndex:0];
+            [m_lock unlock];
+
+            error = [self lookupHost:entry->host port:entry->port addresses:&addresses];
+            sfdebug("SFResolver::lookup('%s'): %d\n", [entry->host UTF8String], error);
+
+            [m_lock lock];
+            entry->addresses = [addresses retain];
+            entry->error     = error;
+            entry->expires   = [NSDate timeIntervalSinceReferenceDate] +
+                               ((error == 0) ? m_timeToLive : ((error == EAGAIN) ? 0.0 : m_negativeTimeToLive));
+            waiting = [entry->waiting autorelease];
+            entry->waiting = nil;
+            [m_lock unlock];
+
+            for (SFResolverCompletion completion in waiting)
+                completion(addresses, error);
+        }
+    }
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
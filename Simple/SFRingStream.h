@@ -0,0 +1,115 @@
+/**
+ * \file
+ * Declares the SFRingStream Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "SFStream.h"
+
+#include <sys/uio.h>
+
+/**
+ * \ingroup sf_networking
+ * A read-write memory stream using a circular buffer.
+ * This stream is intended for long lived connections where data is read from
+ * the socket, partialy consumed and purged in a loop. In SFStream
+ * #purgeReadBytes moves all the unread bytes to the start of the buffer. Here
+ * it only moves the start of the circular buffer, without copying anything.
+ *
+ * The reading and writing positions are offsets from the first byte not yet
+ * purged, as in SFStream. Data can wrap around the end of the buffer, so
+ * #readSegments: and #writeSegments:length: give direct access to the
+ * (at most) two regions of memory in use, suitable to \c readv() and \c
+ * writev() calls. #bytes, #bytesAtIndex: and #bufferWithLength: must return
+ * contiguous memory. When the requested region wraps they rearrange the
+ * buffer first, which costs a copy. Prefer the segments operations in hot
+ * paths.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFRingStream : NSObject <SFStreamProtocol, SFStreamReaderProtocol, SFStreamWriterProtocol>
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithCapacity:(size_t)capacity powerOfTwo:(BOOL)powerOfTwo;//{{{
+/**
+ * Initializes the object with an initial buffer capacity.
+ * @param capacity The initial memory capacity for this stream.
+ * @param powerOfTwo When \b YES \a capacity is rounded up to the next power
+ * of two and the buffer keeps this property when it grows. Positions in the
+ * buffer are then computed with a bit mask instead of a comparison.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithCapacity:(size_t)capacity powerOfTwo:(BOOL)powerOfTwo;
+//}}}
+// - (instancetype)initWithCapacity:(size_t)capacity;//{{{
+/**
+ * Initializes the object with an initial buffer capacity.
+ * @param capacity The initial memory capacity for this stream. It will be
+ * rounded up to a power of two.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithCapacity:(size_t)capacity;
+//}}}
+//@}
+
+/** @name Attributes */ //@{
+// @property (nonatomic, readonly) BOOL powerOfTwo;//{{{
+/**
+ * Gets whether the capacity of this stream is kept as a power of two.
+ **/
+@property (nonatomic, readonly) BOOL powerOfTwo;
+//}}}
+//@}
+
+/** @name Direct Access */ //@{
+// - (int)readSegments:(struct iovec *)segments;//{{{
+/**
+ * Gets the memory regions with the bytes available to read.
+ * @param segments An array of, at least, two \c iovec structures. It will
+ * be filled with the address and length of each region, starting at the
+ * read position.
+ * @return The number of regions filled: 0 when there is nothing to read, 1
+ * or 2 when the data wraps around the end of the buffer.
+ * @remarks The read position is not changed. After consuming the bytes
+ * update it with #setReadPosition:.
+ **/
+- (int)readSegments:(struct iovec *)segments;
+//}}}
+// - (int)writeSegments:(struct iovec *)segments length:(size_t)length;//{{{
+/**
+ * Gets memory regions where \a length bytes can be written.
+ * @param segments An array of, at least, two \c iovec structures. It will
+ * be filled with the address and length of each region, starting at the
+ * write position.
+ * @param length The number of bytes that will be written. The buffer grows
+ * if needed.
+ * @return The number of regions filled, 1 or 2. Zero means that \a length
+ * was zero or that there is no memory available.
+ * @remarks The write position and the length are not changed. After
+ * storing the data call #setWritePosition: with the new position. Moving the
+ * write position after the length of the stream extends it.
+ **/
+- (int)writeSegments:(struct iovec *)segments length:(size_t)length;
+//}}}
+//@}
+
+/** @name Reseting */ //@{
+// - (void)reset;//{{{
+/**
+ * Resets both read and write position.
+ * Also the function sets the length of the stream to zero. Still, memory will
+ * not be dealocated. The capacity remains the same.
+ **/
+- (void)reset;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
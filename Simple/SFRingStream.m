@@ -0,0 +1,699 @@
+/**
+ * \file
+ * Defines the SFRingStream Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFRingStream.h"
+#import "sfdebug.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <libkern/OSByteOrder.h>
+
+/**
+ * Minimum capacity of a ring buffer.
+ **/
+#define SFRING_MINIMUM_CAPACITY     64
+
+/* ===========================================================================
+ * RING BUFFER FUNCTIONS
+ * ======================================================================== */
+/**
+ * State of a circular buffer.
+ * Offsets (\c length, \c nextRead and \c nextWrite) are logical, counted from
+ * the byte at physical index \c head.
+ **/
+typedef struct SF_RING {
+    uint8_t *buffer;                /**< Allocated memory.                  */
+    size_t   capacity;              /**< Allocated bytes.                   */
+    size_t   mask;                  /**< capacity - 1 when power of two.    */
+    size_t   head;                  /**< Physical index of logical zero.    */
+    size_t   length;                /**< Number of valid bytes.             */
+    size_t   nextRead;              /**< Next reading offset.               */
+    size_t   nextWrite;             /**< Next writing offset.               */
+} ring_t;
+
+// static size_t ring_round(size_t value);//{{{
+/**
+ * Rounds a value up to the next power of two.
+ **/
+static size_t ring_round(size_t value)
+{
+    size_t result = SFRING_MINIMUM_CAPACITY;
+
+    while ((result < value) && (result < (SIZE_MAX / 2)))
+        result <<= 1;
+
+    return result;
+}
+//}}}
+// static inline size_t ring_index(const ring_t *r, size_t offset);//{{{
+/**
+ * Converts a logical offset into a physical index in the buffer.
+ **/
+static inline size_t ring_index(const ring_t *r, size_t offset)
+{
+    size_t index = (r->head + offset);
+
+    if (r->mask) return (index & r->mask);
+    return ((index >= r->capacity) ? (index - r->capacity) : index);
+}
+//}}}
+// static inline void ring_copy_out(const ring_t *r, size_t offset, void *dest, size_t length);//{{{
+/**
+ * Copies bytes from a logical offset of the ring to a linear buffer.
+ **/
+static inline void ring_copy_out(const ring_t *r, size_t offset, void *dest, size_t length)
+{
+    size_t index = ring_index(r, offset);
+    size_t first = (r->capacity - index);
+
+    if (first >= length) {
+        memcpy(dest, (r->buffer + index), length);
+    } else {
+        memcpy(dest, (r->buffer + index), first);
+        memcpy(((uint8_t *)dest + first), r->buffer, (length - first));
+    }
+}
+//}}}
+// static inline void ring_copy_in(ring_t *r, size_t offset, const void *src, size_t length);//{{{
+/**
+ * Copies bytes from a linear buffer into a logical offset of the ring.
+ **/
+static inline void ring_copy_in(ring_t *r, size_t offset, const void *src, size_t length)
+{
+    size_t index = ring_index(r, offset);
+    size_t first = (r->capacity - index);
+
+    if (first >= length) {
+        memcpy((r->buffer + index), src, length);
+    } else {
+        memcpy((r->buffer + index), src, first);
+        memcpy(r->buffer, ((const uint8_t *)src + first), (length - first));
+    }
+}
+//}}}
+// static BOOL ring_resize(ring_t *r, size_t capacity);//{{{
+/**
+ * Moves the ring data to a new buffer, starting at physical index zero.
+ * @param r The ring.
+ * @param capacity Capacity of the new buffer. Must be greater than or equal
+ * to the ring length.
+ * @return \b YES on success. \b NO if there is no memory available. In this
+ * case the ring is not changed.
+ **/
+static BOOL ring_resize(ring_t *r, size_t capacity)
+{
+    uint8_t *ptr = (uint8_t *)malloc(capacity);
+
+    if (ptr == NULL)
+        return NO;
+
+    if (r->length > 0)
+        ring_copy_out(r, 0, ptr, r->length);
+
+    if (r->buffer != NULL) free(r->buffer);
+
+    r->buffer   = ptr;
+    r->capacity = capacity;
+    r->head     = 0;
+    if (r->mask) r->mask = (capacity - 1);
+
+    return YES;
+}
+//}}}
+// static BOOL ring_reserve(ring_t *r, size_t required);//{{{
+/**
+ * Garantees that the ring can hold \a required logical bytes.
+ * The capacity is doubled when growing.
+ **/
+static BOOL ring_reserve(ring_t *r, size_t required)
+{
+    if (required <= r->capacity)
+        return YES;
+
+    size_t capacity = ((r->capacity > (SIZE_MAX / 2)) ? SIZE_MAX : (r->capacity * 2));
+
+    if (capacity < required) capacity = required;
+    if (r->mask || (r->capacity == 0)) {
+        capacity = ring_round(capacity);
+        if (capacity < required) return NO;
+    }
+
+    return ring_resize(r, capacity);
+}
+//}}}
+// static BOOL ring_linearize(ring_t *r, size_t offset, size_t length);//{{{
+/**
+ * Makes the logical region [offset, offset + length) contiguous in memory.
+ **/
+static BOOL ring_linearize(ring_t *r, size_t offset, size_t length)
+{
+    if ((length == 0) || ((ring_index(r, offset) + length) <= r->capacity))
+        return YES;
+
+    return ring_resize(r, r->capacity);
+}
+//}}}
+// static inline BOOL ring_read(ring_t *r, void *dest, size_t length);//{{{
+/**
+ * Reads exactly \a length bytes. Nothing is read if there is not enough data.
+ **/
+static inline BOOL ring_read(ring_t *r, void *dest, size_t length)
+{
+    if ((r->length - r->nextRead) < length)
+        return NO;
+
+    ring_copy_out(r, r->nextRead, dest, length);
+    r->nextRead += length;
+    return YES;
+}
+//}}}
+// static inline BOOL ring_write(ring_t *r, const void *src, size_t length);//{{{
+/**
+ * Writes \a length bytes at the write position, growing the ring if needed.
+ **/
+static inline BOOL ring_write(ring_t *r, const void *src, size_t length)
+{
+    if ((length > (SIZE_MAX - r->nextWrite)) || !ring_reserve(r, (r->nextWrite + length)))
+        return NO;
+
+    ring_copy_in(r, r->nextWrite, src, length);
+    r->nextWrite += length;
+    if (r->nextWrite > r->length)
+        r->length = r->nextWrite;
+    return YES;
+}
+//}}}
+// static int ring_segments(ring_t *r, size_t offset, size_t length, struct iovec *segments);//{{{
+/**
+ * Fills up to two \c iovec structures covering a logical region.
+ **/
+static int ring_segments(ring_t *r, size_t offset, size_t length, struct iovec *segments)
+{
+    if (length == 0) return 0;
+
+    size_t index = ring_index(r, offset);
+    size_t first = (r->capacity - index);
+
+    segments[0].iov_base = (r->buffer + index);
+    if (first >= length) {
+        segments[0].iov_len = length;
+        return 1;
+    }
+
+    segments[0].iov_len  = first;
+    segments[1].iov_base = r->buffer;
+    segments[1].iov_len  = (length - first);
+    return 2;
+}
+//}}}
+
+/* ===========================================================================
+ * SFRingStream EXTENSION
+ * ======================================================================== */
+@interface SFRingStream () {
+    ring_t m_ring;
+}
+@end
+
+/* ===========================================================================
+ * SFRingStream IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFRingStream
+// Designated Initializers
+// - (instancetype)initWithCapacity:(size_t)capacity powerOfTwo:(BOOL)powerOfTwo;//{{{
+- (instancetype)initWithCapacity:(size_t)capacity powerOfTwo:(BOOL)powerOfTwo
+{
+    self = [super init];
+    if (self)
+    {
+        if (powerOfTwo) {
+            capacity = ring_round(capacity);
+            m_ring.mask = (capacity - 1);
+        }
+
+        if ((capacity > 0) && !ring_resize(&m_ring, capacity))
+        {
+            [self release];
+            return nil;
+        }
+    }
+    return self;
+}
+//}}}
+// - (instancetype)initWithCapacity:(size_t)capacity;//{{{
+- (instancetype)initWithCapacity:(size_t)capacity
+{
+    return [self initWithCapacity:capacity powerOfTwo:YES];
+}
+//}}}
+
+// NSObject: Overrides
+// - (id)init;//{{{
+- (id)init
+{
+    return [self initWithCapacity:0 powerOfTwo:YES];
+}
+//}}}
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    if (m_ring.buffer != NULL)
+        free(m_ring.buffer);
+
+    [super dealloc];
+}
+//}}}
+
+// Attributes
+// @property (nonatomic, readonly) BOOL powerOfTwo;//{{{
+- (BOOL)powerOfTwo {
+    return (m_ring.mask != 0);
+}
+//}}}
+
+// Direct Access
+// - (int)readSegments:(struct iovec *)segments;//{{{
+- (int)readSegments:(struct iovec *)segments
+{
+    return ring_segments(&m_ring, m_ring.nextRead, (m_ring.length - m_ring.nextRead), segments);
+}
+//}}}
+// - (int)writeSegments:(struct iovec *)segments length:(size_t)length;//{{{
+- (int)writeSegments:(struct iovec *)segments length:(size_t)length
+{
+    if ((length == 0) || (length > (SIZE_MAX - m_ring.nextWrite)))
+        return 0;
+
+    if (!ring_reserve(&m_ring, (m_ring.nextWrite + length)))
+        return 0;
+
+    return ring_segments(&m_ring, m_ring.nextWrite, length, segments);
+}
+//}}}
+
+// SFStreamProtocol: Properties Implementation
+// - (size_t)capacity;//{{{
+- (size_t)capacity {
+    return m_ring.capacity;
+}
+//}}}
+// - (size_t)length;//{{{
+- (size_t)length {
+    return m_ring.length;
+}
+//}}}
+
+// SFStreamReaderProtocol Reading Information
+// - (size_t)readPosition;//{{{
+- (size_t)readPosition {
+    return m_ring.nextRead;
+}
+//}}}
+// - (size_t)numberOfBytesAvailable;//{{{
+- (size_t)numberOfBytesAvailable {
+    return (m_ring.length - m_ring.nextRead);
+}
+//}}}
+// - (BOOL)setReadPosition:(size_t)offset;//{{{
+- (BOOL)setReadPosition:(size_t)offset
+{
+    if (offset > m_ring.length) return NO;
+    m_ring.nextRead = offset;
+    return YES;
+}
+//}}}
+
+// SFStreamReaderProtocol Direct Access
+// - (const uint8_t *)bytes;//{{{
+- (const uint8_t *)bytes
+{
+    if (m_ring.buffer == NULL)
+        return NULL;
+
+    if (!ring_linearize(&m_ring, m_ring.nextRead, (m_ring.length - m_ring.nextRead)))
+        return NULL;
+
+    return (m_ring.buffer + ring_index(&m_ring, m_ring.nextRead));
+}
+//}}}
+// - (const uint8_t *)bytesAtIndex:(size_t)offset;//{{{
+- (const uint8_t *)bytesAtIndex:(size_t)offset
+{
+    sfassert(offset < m_ring.length, "SFRingStream::bytesAtIndex[] offset greater than length\n");
+    if (offset >= m_ring.length) return NULL;
+
+    if (!ring_linearize(&m_ring, offset, (m_ring.length - offset)))
+        return NULL;
+
+    return (m_ring.buffer + ring_index(&m_ring, offset));
+}
+//}}}
+// - (size_t)numberOfContiguousBytes;//{{{
+- (size_t)numberOfContiguousBytes {
+    /* #bytes linearizes all the bytes available. */
+    return (m_ring.length - m_ring.nextRead);
+}
+//}}}
+
+// SFStreamReaderProtocol Basic Reading Operations
+// - (size_t)read:(void *)buffer length:(size_t)length;//{{{
+- (size_t)read:(void *)buffer length:(size_t)length
+{
+    size_t available = (m_ring.length - m_ring.nextRead);
+
+    if (length > available) length = available;
+    if ((buffer == NULL) || (length == 0))
+        return 0;
+
+    ring_copy_out(&m_ring, m_ring.nextRead, buffer, length);
+    m_ring.nextRead += length;
+    return length;
+}
+//}}}
+// - (uint8_t)readByte;//{{{
+- (uint8_t)readByte
+{
+    uint8_t value = 0;
+
+    ring_read(&m_ring, &value, sizeof(uint8_t));
+    return value;
+}
+//}}}
+// - (uint16_t)readShort;//{{{
+- (uint16_t)readShort
+{
+    uint16_t value = 0;
+
+    ring_read(&m_ring, &value, sizeof(uint16_t));
+    return value;
+}
+//}}}
+// - (uint32_t)readInt;//{{{
+- (uint32_t)readInt
+{
+    uint32_t value = 0;
+
+    ring_read(&m_ring, &value, sizeof(uint32_t));
+    return value;
+}
+//}}}
+// - (uint64_t)readLong;//{{{
+- (uint64_t)readLong
+{
+    uint64_t value = 0;
+
+    ring_read(&m_ring, &value, sizeof(uint64_t));
+    return value;
+}
+//}}}
+// - (float)readFloat;//{{{
+- (float)readFloat
+{
+    float value = 0.0f;
+
+    ring_read(&m_ring, &value, sizeof(float));
+    return value;
+}
+//}}}
+// - (double)readDouble;//{{{
+- (double)readDouble
+{
+    double value = 0.0;
+
+    ring_read(&m_ring, &value, sizeof(double));
+    return value;
+}
+//}}}
+// - (void)purgeReadBytes;//{{{
+- (void)purgeReadBytes
+{
+    if (m_ring.nextRead == 0)
+        return;
+
+    /* No data is moved. Only the start of the ring changes. */
+    m_ring.head = ring_index(&m_ring, m_ring.nextRead);
+    m_ring.length -= m_ring.nextRead;
+
+    if (m_ring.nextWrite <= m_ring.nextRead)
+        m_ring.nextWrite = 0;
+    else
+        m_ring.nextWrite -= m_ring.nextRead;
+
+    m_ring.nextRead = 0;
+    if (m_ring.length == 0)
+        m_ring.head = 0;
+}
+//}}}
+
+// SFStreamReaderProtocol Big-Endian to Host Conversions
+// - (uint16_t)readBigEndianShort;//{{{
+- (uint16_t)readBigEndianShort
+{
+    return OSSwapBigToHostInt16([self readShort]);
+}
+//}}}
+// - (uint32_t)readBigEndianInt;//{{{
+- (uint32_t)readBigEndianInt
+{
+    return OSSwapBigToHostInt32([self readInt]);
+}
+//}}}
+// - (uint64_t)readBigEndignLong;//{{{
+- (uint64_t)readBigEndignLong
+{
+    return OSSwapBigToHostInt64([self readLong]);
+}
+//}}}
+// - (float)readBigEndianFloat;//{{{
+- (float)readBigEndianFloat
+{
+    NSSwappedFloat swappedFloat = { 0 };
+
+    ring_read(&m_ring, &swappedFloat, sizeof(NSSwappedFloat));
+    return NSSwapBigFloatToHost(swappedFloat);
+}
+//}}}
+// - (double)readBigEndianDouble;//{{{
+- (double)readBigEndianDouble
+{
+    NSSwappedDouble swappedDouble = { 0 };
+
+    ring_read(&m_ring, &swappedDouble, sizeof(NSSwappedDouble));
+    return NSSwapBigDoubleToHost(swappedDouble);
+}
+//}}}
+
+// SFStreamReaderProtocol Little-Endian to Host Conversions
+// - (uint16_t)readLittleEndianShort;//{{{
+- (uint16_t)readLittleEndianShort
+{
+    return OSSwapLittleToHostInt16([self readShort]);
+}
+//}}}
+// - (uint32_t)readLittleEndianInt;//{{{
+- (uint32_t)readLittleEndianInt
+{
+    return OSSwapLittleToHostInt32([self readInt]);
+}
+//}}}
+// - (uint64_t)readLittleEndianLong;//{{{
+- (uint64_t)readLittleEndianLong
+{
+    return OSSwapLittleToHostInt64([self readLong]);
+}
+//}}}
+// - (float)readLittleEndianFloat;//{{{
+- (float)readLittleEndianFloat
+{
+    NSSwappedFloat swappedFloat = { 0 };
+
+    ring_read(&m_ring, &swappedFloat, sizeof(NSSwappedFloat));
+    return NSSwapLittleFloatToHost(swappedFloat);
+}
+//}}}
+// - (double)readLittleEndianDouble;//{{{
+- (double)readLittleEndianDouble
+{
+    NSSwappedDouble swappedDouble = { 0 };
+
+    ring_read(&m_ring, &swappedDouble, sizeof(NSSwappedDouble));
+    return NSSwapLittleDoubleToHost(swappedDouble);
+}
+//}}}
+
+// SFStreamWriterProtocol Writting Information
+// - (size_t)writePosition;//{{{
+- (size_t)writePosition {
+    return m_ring.nextWrite;
+}
+//}}}
+// - (BOOL)setWritePosition:(size_t)offset;//{{{
+- (BOOL)setWritePosition:(size_t)offset
+{
+    if (offset > m_ring.capacity) return NO;
+
+    /* Moving after the end commits bytes stored through
+     * bufferWithLength: or writeSegments:length:. */
+    m_ring.nextWrite = offset;
+    if (offset > m_ring.length)
+        m_ring.length = offset;
+    return YES;
+}
+//}}}
+
+// SFStreamWriterProtocol Direct Access
+// - (void *)bufferWithLength:(size_t)length;//{{{
+- (void *)bufferWithLength:(size_t)length
+{
+    if ((length == 0) || (length > (SIZE_MAX - m_ring.nextWrite)))
+        return NULL;
+
+    if (!ring_reserve(&m_ring, (m_ring.nextWrite + length)))
+        return NULL;
+
+    if (!ring_linearize(&m_ring, m_ring.nextWrite, length))
+        return NULL;
+
+    return (void *)(m_ring.buffer + ring_index(&m_ring, m_ring.nextWrite));
+}
+//}}}
+
+// SFStreamWriterProtocol Basic Writting Operations
+// - (size_t)write:(const void*)data length:(size_t)size;//{{{
+- (size_t)write:(const void*)data length:(size_t)size
+{
+    if ((data == NULL) || (size == 0))
+        return 0;
+
+    return (ring_write(&m_ring, data, size) ? size : 0);
+}
+//}}}
+// - (void)writeByte:(uint8_t)data;//{{{
+- (void)writeByte:(uint8_t)data
+{
+    ring_write(&m_ring, &data, sizeof(uint8_t));
+}
+//}}}
+// - (void)writeShort:(uint16_t)data;//{{{
+- (void)writeShort:(uint16_t)data
+{
+    ring_write(&m_ring, &data, sizeof(uint16_t));
+}
+//}}}
+// - (void)writeInt:(uint32_t)data;//{{{
+- (void)writeInt:(uint32_t)data
+{
+    ring_write(&m_ring, &data, sizeof(uint32_t));
+}
+//}}}
+// - (void)writeLong:(uint64_t)data;//{{{
+- (void)writeLong:(uint64_t)data
+{
+    ring_write(&m_ring, &data, sizeof(uint64_t));
+}
+//}}}
+// - (void)writeFloat:(float)data;//{{{
+- (void)writeFloat:(float)data
+{
+    ring_write(&m_ring, &data, sizeof(float));
+}
+//}}}
+// - (void)writeDouble:(double)data;//{{{
+- (void)writeDouble:(double)data
+{
+    ring_write(&m_ring, &data, sizeof(double));
+}
+//}}}
+
+// SFStreamWriterProtocol Host to Big-Endian Conversions
+// - (void)writeBigEndianShort:(uint16_t)data;//{{{
+- (void)writeBigEndianShort:(uint16_t)data
+{
+    [self writeShort:OSSwapHostToBigInt16(data)];
+}
+//}}}
+// - (void)writeBigEndianInt:(uint32_t)data;//{{{
+- (void)writeBigEndianInt:(uint32_t)data
+{
+    [self writeInt:OSSwapHostToBigInt32(data)];
+}
+//}}}
+// - (void)writeBigEndianLong:(uint64_t)data;//{{{
+- (void)writeBigEndianLong:(uint64_t)data
+{
+    [self writeLong:OSSwapHostToBigInt64(data)];
+}
+//}}}
+// - (void)writeBigEndianFloat:(float)data;//{{{
+- (void)writeBigEndianFloat:(float)data
+{
+    NSSwappedFloat swappedFloat = NSSwapHostFloatToBig(data);
+    ring_write(&m_ring, &swappedFloat, sizeof(NSSwappedFloat));
+}
+//}}}
+// - (void)writeBigEndianDouble:(double)data;//{{{
+- (void)writeBigEndianDouble:(double)data
+{
+    NSSwappedDouble swappedDouble = NSSwapHostDoubleToBig(data);
+    ring_write(&m_ring, &swappedDouble, sizeof(NSSwappedDouble));
+}
+//}}}
+
+// SFStreamWriterProtocol Host to Little-Endian Conversions
+// - (void)writeLittleEndianShort:(uint16_t)data;//{{{
+- (void)writeLittleEndianShort:(uint16_t)data
+{
+    [self writeShort:OSSwapHostToLittleInt16(data)];
+}
+//}}}
+// - (void)writeLittleEndianInt:(uint32_t)data;//{{{
+- (void)writeLittleEndianInt:(uint32_t)data
+{
+    [self writeInt:OSSwapHostToLittleInt32(data)];
+}
+//}}}
+// - (void)writeLittleEndianLong:(uint64_t)data;//{{{
+- (void)writeLittleEndianLong:(uint64_t)data
+{
+    [self writeLong:OSSwapHostToLittleInt64(data)];
+}
+//}}}
+// - (void)writeLittleEndianFloat:(float)data;//{{{
+- (void)writeLittleEndianFloat:(float)data
+{
+    NSSwappedFloat swappedFloat = NSSwapHostFloatToLittle(data);
+    ring_write(&m_ring, &swappedFloat, sizeof(NSSwappedFloat));
+}
+//}}}
+// - (void)writeLittleEndianDouble:(double)data;//{{{
+- (void)writeLittleEndianDouble:(double)data
+{
+    NSSwappedDouble swappedDouble = NSSwapHostDoubleToLittle(data);
+    ring_write(&m_ring, &swappedDouble, sizeof(NSSwappedDouble));
+}
+//}}}
+
+// Reseting
+// - (void)reset;//{{{
+- (void)reset
+{
+    m_ring.head = 0;
+    m_ring.length = 0;
+    m_ring.nextRead = 0;
+    m_ring.nextWrite = 0;
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
@@ -0,0 +1,129 @@
+/**
+ * \file
+ * Declares the SFSegmentedStream Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "SFStream.h"
+#import "SFChunkPool.h"
+
+#include <sys/uio.h>
+
+/**
+ * \ingroup sf_networking
+ * A read-write memory stream built from a chain of fixed size chunks.
+ * This stream is intended for large payloads. Appending data only adds
+ * chunks to the end of the chain, taken from a SFChunkPool, so the data
+ * already written is never copied or reallocated.
+ *
+ * When #releasesReadChunks is \b YES (the default) every chunk that was
+ * completely read is returned to the pool immediately. Memory is then held
+ * only for data not yet consumed. The reading and writing positions keep
+ * counting from the start of the stream, but positions before the first
+ * chunk still alive are no longer accessible. #purgeReadBytes moves the start
+ * of the stream to the read position as in SFStream, without copying data.
+ *
+ * Data is not contiguous in memory. Use #readSegments:count: and
+ * #writeSegments:count:length: to get \c iovec structures for scatter/gather
+ * I/O. #bytes, #bytesAtIndex: and #bufferWithLength: are explicit requests for
+ * contiguous memory. When the requested region spans more than one chunk
+ * they use a temporary buffer, which costs a copy. Reads and writes have
+ * their own buffers, so reading the stream doesn't disturb the bytes written
+ * through #bufferWithLength: before #setWritePosition: commits them.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFSegmentedStream : NSObject <SFStreamProtocol, SFStreamReaderProtocol, SFStreamWriterProtocol>
+/** @name Properties */ //@{
+// @property (nonatomic) BOOL releasesReadChunks;//{{{
+/**
+ * Gets or sets whether chunks completely read are released immediately.
+ * When \b NO the chunks are kept until #purgeReadBytes or #reset is called,
+ * so the read position can be moved back freely.
+ **/
+@property (nonatomic) BOOL releasesReadChunks;
+//}}}
+// @property (nonatomic, readonly) SFChunkPool *pool;//{{{
+/**
+ * Gets the pool where chunks of this stream come from.
+ **/
+@property (nonatomic, readonly) SFChunkPool *pool;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithPool:(SFChunkPool *)pool;//{{{
+/**
+ * Initializes an empty stream.
+ * @param pool The pool providing memory chunks. When \b nil the
+ * SFChunkPool::defaultPool is used.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithPool:(SFChunkPool *)pool;
+//}}}
+//@}
+
+/** @name Attributes */ //@{
+// - (size_t)numberOfChunks;//{{{
+/**
+ * Gets the number of chunks currently held by this stream.
+ **/
+- (size_t)numberOfChunks;
+//}}}
+//@}
+
+/** @name Scatter/Gather Access */ //@{
+// - (int)readSegments:(struct iovec *)segments count:(int)count;//{{{
+/**
+ * Gets the memory regions with the bytes available to read.
+ * @param segments An array of \c iovec structures. It will be filled with
+ * the address and length of each region, starting at the read position.
+ * @param count Number of elements in \a segments.
+ * @return The number of elements filled. Zero when there is nothing to
+ * read. When all elements are used there may be more data after the last
+ * region.
+ * @remarks The read position is not changed. After consuming the bytes
+ * update it with #setReadPosition:.
+ **/
+- (int)readSegments:(struct iovec *)segments count:(int)count;
+//}}}
+// - (int)writeSegments:(struct iovec *)segments count:(int)count length:(size_t)length;//{{{
+/**
+ * Gets memory regions where \a length bytes can be written.
+ * @param segments An array of \c iovec structures. It will be filled with
+ * the address and length of each region, starting at the write position.
+ * @param count Number of elements in \a segments.
+ * @param length The number of bytes that will be written. Chunks are added
+ * to the stream if needed.
+ * @return The number of elements filled. When all elements are used the
+ * regions may cover less than \a length bytes. Zero means that \a length
+ * was zero or that there is no memory available.
+ * @remarks The write position and the length are not changed. After
+ * storing the data call #setWritePosition: with the new position. Moving the
+ * write position after the length of the stream extends it.
+ **/
+- (int)writeSegments:(struct iovec *)segments count:(int)count length:(size_t)length;
+//}}}
+//@}
+
+/** @name Reseting */ //@{
+// - (void)reset;//{{{
+/**
+ * Resets both read and write position.
+ * Also the function sets the length of the stream to zero and returns all
+ * chunks to the pool.
+ **/
+- (void)reset;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,822 @@
+/**
+ * \file
+ * Defines the SFSegmentedStream Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFSegmentedStream.h"
+#import "sfdebug.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <libkern/OSByteOrder.h>
+
+/* ===========================================================================
+ * CHUNK CHAIN FUNCTIONS
+ * ======================================================================== */
+/**
+ * State of a chain of chunks.
+ * Offsets are logical, counted from the start of the stream. The byte at
+ * offset \c base is stored at \c headOffset in the first live chunk.
+ **/
+typedef struct SF_CHAIN {
+    uint8_t    **chunks;            /**< Slots of chunk addresses.          */
+    size_t       first;             /**< Slot of the first live chunk.      */
+    size_t       count;             /**< Number of live chunks.             */
+    size_t       slots;             /**< Number of allocated slots.         */
+    size_t       chunkSize;         /**< Size of every chunk.               */
+    size_t       headOffset;        /**< Offset of \c base in first chunk.  */
+    size_t       base;              /**< First accessible offset.           */
+    size_t       length;            /**< End of valid data.                 */
+    size_t       nextRead;          /**< Next reading offset.               */
+    size_t       nextWrite;         /**< Next writing offset.               */
+    BOOL         releaseRead;       /**< Release chunks already read.       */
+    SFChunkPool *pool;              /**< Source of the chunks.              */
+} chain_t;
+
+// static inline size_t chain_end(const chain_t *c);//{{{
+/**
+ * Gets the logical offset after the last byte of the last chunk.
+ **/
+static inline size_t chain_end(const chain_t *c)
+{
+    return (c->base + (c->count * c->chunkSize) - c->headOffset);
+}
+//}}}
+// static inline uint8_t *chain_locate(const chain_t *c, size_t offset, size_t *avail);//{{{
+/**
+ * Gets the address of a logical offset and the bytes after it in the same
+ * chunk.
+ **/
+static inline uint8_t *chain_locate(const chain_t *c, size_t offset, size_t *avail)
+{
+    size_t k = (offset - c->base + c->headOffset);
+    size_t i = (k / c->chunkSize);          /* chunkSize is a power of two. */
+    size_t o = (k & (c->chunkSize - 1));
+
+    *avail = (c->chunkSize - o);
+    return (c->chunks[c->first + i] + o);
+}
+//}}}
+// static void chain_copy_out(const chain_t *c, size_t offset, void *dest, size_t length);//{{{
+/**
+ * Copies bytes from a logical offset of the chain to a linear buffer.
+ **/
+static void chain_copy_out(const chain_t *c, size_t offset, void *dest, size_t length)
+{
+    uint8_t *out = (uint8_t *)dest;
+    size_t avail, part;
+
+    while (length > 0)
+    {
+        const uint8_t *ptr = chain_locate(c, offset, &avail);
+
+        part = ((avail < length) ? avail : length);
+        memcpy(out, ptr, part);
+        out += part; offset += part; length -= part;
+    }
+}
+//}}}
+// static void chain_copy_in(chain_t *c, size_t offset, const void *src, size_t length);//{{{
+/**
+ * Copies bytes from a linear buffer into a logical offset of the chain.
+ **/
+static void chain_copy_in(chain_t *c, size_t offset, const void *src, size_t length)
+{
+    const uint8_t *in = (const uint8_t *)src;
+    size_t avail, part;
+
+    while (length > 0)
+    {
+        uint8_t *ptr = chain_locate(c, offset, &avail);
+
+        part = ((avail < length) ? avail : length);
+        memcpy(ptr, in, part);
+        in += part; offset += part; length -= part;
+    }
+}
+//}}}
+// static BOOL chain_reserve(chain_t *c, size_t required);//{{{
+/**
+ * Appends chunks until the chain reaches the \a required logical offset.
+ * Existing chunks are never moved. Only the array of addresses can be
+ * reallocated.
+ **/
+static BOOL chain_reserve(chain_t *c, size_t required)
+{
+    while (chain_end(c) < required)
+    {
+        if ((c->first + c->count) == c->slots)
+        {
+            if (c->first > 0)
+            {
+                memmove(c->chunks, (c->chunks + c->first), (c->count * sizeof(uint8_t *)));
+                c->first = 0;
+            }
+            else
+            {
+                size_t slots = ((c->slots > 0) ? (c->slots * 2) : 8);
+                uint8_t **ptr = (uint8_t **)realloc(c->chunks, (slots * sizeof(uint8_t *)));
+
+                if (ptr == NULL) return NO;
+                c->chunks = ptr;
+                c->slots  = slots;
+            }
+        }
+
+        uint8_t *chunk = (uint8_t *)[c->pool allocChunk];
+        if (chunk == NULL) return NO;
+
+        c->chunks[c->first + c->count] = chunk;
+        c->count++;
+    }
+    return YES;
+}
+//}}}
+// static void chain_release_read(chain_t *c);//{{{
+/**
+ * Returns to the pool every chunk before the read position.
+ **/
+static void chain_release_read(chain_t *c)
+{
+    size_t used;
+
+    while ((c->count > 0) && ((c->base + (used = (c->chunkSize - c->headOffset))) <= c->nextRead))
+    {
+        [c->pool releaseChunk:c->chunks[c->first]];
+        c->first++;
+        c->count--;
+        c->base += used;
+        c->headOffset = 0;
+    }
+
+    if (c->count == 0) c->first = 0;
+    if (c->nextWrite < c->base) c->nextWrite = c->base;
+    if (c->length < c->base) c->length = c->base;
+}
+//}}}
+// static void chain_release_all(chain_t *c);//{{{
+/**
+ * Returns all chunks to the pool and resets the chain.
+ **/
+static void chain_release_all(chain_t *c)
+{
+    for (size_t i = 0; i < c->count; ++i)
+        [c->pool releaseChunk:c->chunks[c->first + i]];
+
+    c->first = c->count = 0;
+    c->headOffset = c->base = 0;
+    c->length = c->nextRead = c->nextWrite = 0;
+}
+//}}}
+// static inline BOOL chain_read(chain_t *c, void *dest, size_t length);//{{{
+/**
+ * Reads exactly \a length bytes. Nothing is read if there is not enough data.
+ **/
+static inline BOOL chain_read(chain_t *c, void *dest, size_t length)
+{
+    size_t avail;
+
+    if ((c->length - c->nextRead) < length)
+        return NO;
+
+    const uint8_t *ptr = chain_locate(c, c->nextRead, &avail);
+    if (avail >= length)
+        memcpy(dest, ptr, length);
+    else
+        chain_copy_out(c, c->nextRead, dest, length);
+
+    c->nextRead += length;
+    if (c->releaseRead && (avail <= length))
+        chain_release_read(c);
+
+    return YES;
+}
+//}}}
+// static inline BOOL chain_write(chain_t *c, const void *src, size_t length);//{{{
+/**
+ * Writes \a length bytes at the write position, adding chunks if needed.
+ **/
+static inline BOOL chain_write(chain_t *c, const void *src, size_t length)
+{
+    size_t avail;
+
+    if ((length > (SIZE_MAX - c->nextWrite)) || !chain_reserve(c, (c->nextWrite + length)))
+        return NO;
+
+    uint8_t *ptr = chain_locate(c, c->nextWrite, &avail);
+    if (avail >= length)
+        memcpy(ptr, src, length);
+    else
+        chain_copy_in(c, c->nextWrite, src, length);
+
+    c->nextWrite += length;
+    if (c->nextWrite > c->length)
+        c->length = c->nextWrite;
+    return YES;
+}
+//}}}
+// static int chain_segments(const chain_t *c, size_t offset, size_t length, struct iovec *segments, int count);//{{{
+/**
+ * Fills \c iovec structures covering a logical region.
+ **/
+static int chain_segments(const chain_t *c, size_t offset, size_t length, struct iovec *segments, int count)
+{
+    int filled = 0;
+    size_t avail;
+
+    while ((length > 0) && (filled < count))
+    {
+        uint8_t *ptr = chain_locate(c, offset, &avail);
+
+        if (avail > length) avail = length;
+        segments[filled].iov_base = ptr;
+        segments[filled].iov_len  = avail;
+        filled++;
+
+        offset += avail;
+        length -= avail;
+    }
+    return filled;
+}
+//}}}
+
+/* ===========================================================================
+ * SFSegmentedStream EXTENSION
+ * ======================================================================== */
+@interface SFSegmentedStream () {
+    chain_t  m_chain;
+    uint8_t *m_view;                /* Contiguous copy for direct access.   */
+    size_t   m_viewSize;
+    uint8_t *m_stage;               /* Buffer given by bufferWithLength:.   */
+    size_t   m_stageSize;
+    size_t   m_staged;              /* Bytes given by bufferWithLength:.    */
+    size_t   m_stagedAt;            /* Offset of the staged bytes.          */
+}
+// - (uint8_t *)viewWithLength:(size_t)length;//{{{
+/**
+ * Gets the temporary buffer used for contiguous access.
+ * @param length Minimum size of the buffer.
+ * @return The buffer address or \b NULL if there is no memory.
+ **/
+- (uint8_t *)viewWithLength:(size_t)length;
+//}}}
+// - (uint8_t *)stageWithLength:(size_t)length;//{{{
+/**
+ * Gets the temporary buffer used by writes that span chunks.
+ * Kept apart from the buffer of #viewWithLength:, so reading the stream
+ * doesn't move or overwrite bytes not yet committed.
+ * @param length Minimum size of the buffer.
+ * @return The buffer address or \b NULL if there is no memory.
+ **/
+- (uint8_t *)stageWithLength:(size_t)length;
+//}}}
+@end
+
+/* ===========================================================================
+ * SFSegmentedStream IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFSegmentedStream
+// Properties
+// @property (nonatomic) BOOL releasesReadChunks;//{{{
+- (BOOL)releasesReadChunks {
+    return m_chain.releaseRead;
+}
+- (void)setReleasesReadChunks:(BOOL)releasesReadChunks
+{
+    m_chain.releaseRead = releasesReadChunks;
+    if (releasesReadChunks) chain_release_read(&m_chain);
+}
+//}}}
+// @property (nonatomic, readonly) SFChunkPool *pool;//{{{
+- (SFChunkPool *)pool {
+    return m_chain.pool;
+}
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithPool:(SFChunkPool *)pool;//{{{
+- (instancetype)initWithPool:(SFChunkPool *)pool
+{
+    self = [super init];
+    if (self)
+    {
+        m_chain.pool = [((pool != nil) ? pool : [SFChunkPool defaultPool]) retain];
+        m_chain.chunkSize = [m_chain.pool chunkSize];
+        m_chain.releaseRead = YES;
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (id)init;//{{{
+- (id)init
+{
+    return [self initWithPool:nil];
+}
+//}}}
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    chain_release_all(&m_chain);
+    if (m_chain.chunks != NULL) free(m_chain.chunks);
+    if (m_view != NULL) free(m_view);
+    if (m_stage != NULL) free(m_stage);
+
+    [m_chain.pool release];
+    [super dealloc];
+}
+//}}}
+
+// Local Operations
+// - (uint8_t *)viewWithLength:(size_t)length;//{{{
+- (uint8_t *)viewWithLength:(size_t)length
+{
+    if (length > m_viewSize)
+    {
+        uint8_t *ptr = (uint8_t *)realloc(m_view, length);
+
+        if (ptr == NULL) return NULL;
+        m_view = ptr;
+        m_viewSize = length;
+    }
+    return m_view;
+}
+//}}}
+// - (uint8_t *)stageWithLength:(size_t)length;//{{{
+- (uint8_t *)stageWithLength:(size_t)length
+{
+    if (length > m_stageSize)
+    {
+        uint8_t *ptr = (uint8_t *)realloc(m_stage, length);
+
+        if (ptr == NULL) return NULL;
+        m_stage = ptr;
+        m_stageSize = length;
+    }
+    return m_stage;
+}
+//}}}
+
+// Attributes
+// - (size_t)numberOfChunks;//{{{
+- (size_t)numberOfChunks {
+    return m_chain.count;
+}
+//}}}
+
+// Scatter/Gather Access
+// - (int)readSegments:(struct iovec *)segments count:(int)count;//{{{
+- (int)readSegments:(struct iovec *)segments count:(int)count
+{
+    return chain_segments(&m_chain, m_chain.nextRead, (m_chain.length - m_chain.nextRead), segments, count);
+}
+//}}}
+// - (int)writeSegments:(struct iovec *)segments count:(int)count length:(size_t)length;//{{{
+- (int)writeSegments:(struct iovec *)segments count:(int)count length:(size_t)length
+{
+    if ((length == 0) || (length > (SIZE_MAX - m_chain.nextWrite)))
+        return 0;
+
+    if (!chain_reserve(&m_chain, (m_chain.nextWrite + length)))
+        return 0;
+
+    m_staged = 0;
+    return chain_segments(&m_chain, m_chain.nextWrite, length, segments, count);
+}
+//}}}
+
+// SFStreamProtocol: Properties Implementation
+// - (size_t)capacity;//{{{
+- (size_t)capacity {
+    return (m_chain.count * m_chain.chunkSize);
+}
+//}}}
+// - (size_t)length;//{{{
+- (size_t)length {
+    return m_chain.length;
+}
+//}}}
+
+// SFStreamReaderProtocol Reading Information
+// - (size_t)readPosition;//{{{
+- (size_t)readPosition {
+    return m_chain.nextRead;
+}
+//}}}
+// - (size_t)numberOfBytesAvailable;//{{{
+- (size_t)numberOfBytesAvailable {
+    return (m_chain.length - m_chain.nextRead);
+}
+//}}}
+// - (BOOL)setReadPosition:(size_t)offset;//{{{
+- (BOOL)setReadPosition:(size_t)offset
+{
+    if ((offset > m_chain.length) || (offset < m_chain.base)) return NO;
+
+    m_chain.nextRead = offset;
+    if (m_chain.releaseRead) chain_release_read(&m_chain);
+    return YES;
+}
+//}}}
+
+// SFStreamReaderProtocol Direct Access
+// - (const uint8_t *)bytes;//{{{
+- (const uint8_t *)bytes
+{
+    size_t available = (m_chain.length - m_chain.nextRead);
+
+    if (available == 0)
+        return NULL;
+
+    return [self bytesAtIndex:m_chain.nextRead];
+}
+//}}}
+// - (const uint8_t *)bytesAtIndex:(size_t)offset;//{{{
+- (const uint8_t *)bytesAtIndex:(size_t)offset
+{
+    sfassert(offset < m_chain.length, "SFSegmentedStream::bytesAtIndex[] offset greater than length\n");
+    if ((offset >= m_chain.length) || (offset < m_chain.base)) return NULL;
+
+    size_t avail, length = (m_chain.length - offset);
+    uint8_t *ptr = chain_locate(&m_chain, offset, &avail);
+
+    if (avail >= length)
+        return ptr;
+
+    /* The region spans chunks. Only now a contiguous copy is built. */
+    if ((ptr = [self viewWithLength:length]) == NULL)
+        return NULL;
+
+    chain_copy_out(&m_chain, offset, ptr, length);
+    return ptr;
+}
+//}}}
+// - (size_t)numberOfContiguousBytes;//{{{
+- (size_t)numberOfContiguousBytes {
+    /* #bytes builds a contiguous view when the data spans chunks. */
+    return (m_chain.length - m_chain.nextRead);
+}
+//}}}
+
+// SFStreamReaderProtocol Basic Reading Operations
+// - (size_t)read:(void *)buffer length:(size_t)length;//{{{
+- (size_t)read:(void *)buffer length:(size_t)length
+{
+    size_t available = (m_chain.length - m_chain.nextRead);
+
+    if (length > available) length = available;
+    if ((buffer == NULL) || (length == 0))
+        return 0;
+
+    chain_read(&m_chain, buffer, length);
+    return length;
+}
+//}}}
+// - (uint8_t)readByte;//{{{
+- (uint8_t)readByte
+{
+    uint8_t value = 0;
+
+    chain_read(&m_chain, &value, sizeof(uint8_t));
+    return value;
+}
+//}}}
+// - (uint16_t)readShort;//{{{
+- (uint16_t)readShort
+{
+    uint16_t value = 0;
+
+    chain_read(&m_chain, &value, sizeof(uint16_t));
+    return value;
+}
+//}}}
+// - (uint32_t)readInt;//{{{
+- (uint32_t)readInt
+{
+    uint32_t value = 0;
+
+    chain_read(&m_chain, &value, sizeof(uint32_t));
+    return value;
+}
+//}}}
+// - (uint64_t)readLong;//{{{
+- (uint64_t)readLong
+{
+    uint64_t value = 0;
+
+    chain_read(&m_chain, &value, sizeof(uint64_t));
+    return value;
+}
+//}}}
+// - (float)readFloat;//{{{
+- (float)readFloat
+{
+    float value = 0.0f;
+
+    chain_read(&m_chain, &value, sizeof(float));
+    return value;
+}
+//}}}
+// - (double)readDouble;//{{{
+- (double)readDouble
+{
+    double value = 0.0;
+
+    chain_read(&m_chain, &value, sizeof(double));
+    return value;
+}
+//}}}
+// - (void)purgeReadBytes;//{{{
+- (void)purgeReadBytes
+{
+    size_t purged = m_chain.nextRead;
+
+    if (purged == 0)
+        return;
+
+    chain_release_read(&m_chain);
+
+    /* Nothing is copied. The offsets are rebased on the read position. */
+    if (m_chain.count > 0)
+        m_chain.headOffset += (m_chain.nextRead - m_chain.base);
+    else
+        m_chain.headOffset = 0;
+
+    m_chain.length -= purged;
+    m_chain.nextWrite = ((m_chain.nextWrite > purged) ? (m_chain.nextWrite - purged) : 0);
+    m_chain.nextRead = 0;
+    m_chain.base = 0;
+    m_staged = 0;
+}
+//}}}
+
+// SFStreamReaderProtocol Big-Endian to Host Conversions
+// - (uint16_t)readBigEndianShort;//{{{
+- (uint16_t)readBigEndianShort
+{
+    return OSSwapBigToHostInt16([self readShort]);
+}
+//}}}
+// - (uint32_t)readBigEndianInt;//{{{
+- (uint32_t)readBigEndianInt
+{
+    return OSSwapBigToHostInt32([self readInt]);
+}
+//}}}
+// - (uint64_t)readBigEndignLong;//{{{
+- (uint64_t)readBigEndignLong
+{
+    return OSSwapBigToHostInt64([self readLong]);
+}
+//}}}
+// - (float)readBigEndianFloat;//{{{
+- (float)readBigEndianFloat
+{
+    NSSwappedFloat swappedFloat = { 0 };
+
+    chain_read(&m_chain, &swappedFloat, sizeof(NSSwappedFloat));
+    return NSSwapBigFloatToHost(swappedFloat);
+}
+//}}}
+// - (double)readBigEndianDouble;//{{{
+- (double)readBigEndianDouble
+{
+    NSSwappedDouble swappedDouble = { 0 };
+
+    chain_read(&m_chain, &swappedDouble, sizeof(NSSwappedDouble));
+    return NSSwapBigDoubleToHost(swappedDouble);
+}
+//}}}
+
+// SFStreamReaderProtocol Little-Endian to Host Conversions
+// - (uint16_t)readLittleEndianShort;//{{{
+- (uint16_t)readLittleEndianShort
+{
+    return OSSwapLittleToHostInt16([self readShort]);
+}
+//}}}
+// - (uint32_t)readLittleEndianInt;//{{{
+- (uint32_t)readLittleEndianInt
+{
+    return OSSwapLittleToHostInt32([self readInt]);
+}
+//}}}
+// - (uint64_t)readLittleEndianLong;//{{{
+- (uint64_t)readLittleEndianLong
+{
+    return OSSwapLittleToHostInt64([self readLong]);
+}
+//}}}
+// - (float)readLittleEndianFloat;//{{{
+- (float)readLittleEndianFloat
+{
+    NSSwappedFloat swappedFloat = { 0 };
+
+    chain_read(&m_chain, &swappedFloat, sizeof(NSSwappedFloat));
+    return NSSwapLittleFloatToHost(swappedFloat);
+}
+//}}}
+// - (double)readLittleEndianDouble;//{{{
+- (double)readLittleEndianDouble
+{
+    NSSwappedDouble swappedDouble = { 0 };
+
+    chain_read(&m_chain, &swappedDouble, sizeof(NSSwappedDouble));
+    return NSSwapLittleDoubleToHost(swappedDouble);
+}
+//}}}
+
+// SFStreamWriterProtocol Writting Information
+// - (size_t)writePosition;//{{{
+- (size_t)writePosition {
+    return m_chain.nextWrite;
+}
+//}}}
+// - (BOOL)setWritePosition:(size_t)offset;//{{{
+- (BOOL)setWritePosition:(size_t)offset
+{
+    if ((offset < m_chain.base) || (offset > chain_end(&m_chain)))
+        return NO;
+
+    /* Bytes stored in the temporary buffer of bufferWithLength: are moved
+     * to the chunks now. */
+    if ((m_staged > 0) && (offset > m_stagedAt))
+    {
+        size_t amount = (offset - m_stagedAt);
+        chain_copy_in(&m_chain, m_stagedAt, m_stage, ((amount < m_staged) ? amount : m_staged));
+    }
+    m_staged = 0;
+
+    m_chain.nextWrite = offset;
+    if (offset > m_chain.length)
+        m_chain.length = offset;
+    return YES;
+}
+//}}}
+
+// SFStreamWriterProtocol Direct Access
+// - (void *)bufferWithLength:(size_t)length;//{{{
+- (void *)bufferWithLength:(size_t)length
+{
+    size_t avail;
+
+    if ((length == 0) || (length > (SIZE_MAX - m_chain.nextWrite)))
+        return NULL;
+
+    if (!chain_reserve(&m_chain, (m_chain.nextWrite + length)))
+        return NULL;
+
+    uint8_t *ptr = chain_locate(&m_chain, m_chain.nextWrite, &avail);
+
+    m_staged = 0;
+    if (avail >= length)
+        return ptr;
+
+    /* The region spans chunks. The caller writes in a temporary buffer that
+     * is copied when the write position is updated. */
+    if ((ptr = [self stageWithLength:length]) == NULL)
+        return NULL;
+
+    m_staged = length;
+    m_stagedAt = m_chain.nextWrite;
+    return ptr;
+}
+//}}}
+
+// SFStreamWriterProtocol Basic Writting Operations
+// - (size_t)write:(const void*)data length:(size_t)size;//{{{
+- (size_t)write:(const void*)data length:(size_t)size
+{
+    if ((data == NULL) || (size == 0))
+        return 0;
+
+    m_staged = 0;
+    return (chain_write(&m_chain, data, size) ? size : 0);
+}
+//}}}
+// - (void)writeByte:(uint8_t)data;//{{{
+- (void)writeByte:(uint8_t)data
+{
+    [self write:&data length:sizeof(uint8_t)];
+}
+//}}}
+// - (void)writeShort:(uint16_t)data;//{{{
+- (void)writeShort:(uint16_t)data
+{
+    [self write:&data length:sizeof(uint16_t)];
+}
+//}}}
+// - (void)writeInt:(uint32_t)data;//{{{
+- (void)writeInt:(uint32_t)data
+{
+    [self write:&data length:sizeof(uint32_t)];
+}
+//}}}
+// - (void)writeLong:(uint64_t)data;//{{{
+- (void)writeLong:(uint64_t)data
+{
+    [self write:&data length:sizeof(uint64_t)];
+}
+//}}}
+// - (void)writeFloat:(float)data;//{{{
+- (void)writeFloat:(float)data
+{
+    [self write:&data length:sizeof(float)];
+}
+//}}}
+// - (void)writeDouble:(double)data;//{{{
+- (void)writeDouble:(double)data
+{
+    [self write:&data length:sizeof(double)];
+}
+//}}}
+
+// SFStreamWriterProtocol Host to Big-Endian Conversions
+// - (void)writeBigEndianShort:(uint16_t)data;//{{{
+- (void)writeBigEndianShort:(uint16_t)data
+{
+    [self writeShort:OSSwapHostToBigInt16(data)];
+}
+//}}}
+// - (void)writeBigEndianInt:(uint32_t)data;//{{{
+- (void)writeBigEndianInt:(uint32_t)data
+{
+    [self writeInt:OSSwapHostToBigInt32(data)];
+}
+//}}}
+// - (void)writeBigEndianLong:(uint64_t)data;//{{{
+- (void)writeBigEndianLong:(uint64_t)data
+{
+    [self writeLong:OSSwapHostToBigInt64(data)];
+}
+//}}}
+// - (void)writeBigEndianFloat:(float)data;//{{{
+- (void)writeBigEndianFloat:(float)data
+{
+    NSSwappedFloat swappedFloat = NSSwapHostFloatToBig(data);
+    [self write:&swappedFloat length:sizeof(NSSwappedFloat)];
+}
+//}}}
+// - (void)writeBigEndianDouble:(double)data;//{{{
+- (void)writeBigEndianDouble:(double)data
+{
+    NSSwappedDouble swappedDouble = NSSwapHostDoubleToBig(data);
+    [self write:&swappedDouble length:sizeof(NSSwappedDouble)];
+}
+//}}}
+
+// SFStreamWriterProtocol Host to Little-Endian Conversions
+// - (void)writeLittleEndianShort:(uint16_t)data;//{{{
+- (void)writeLittleEndianShort:(uint16_t)data
+{
+    [self writeShort:OSSwapHostToLittleInt16(data)];
+}
+//}}}
+// - (void)writeLittleEndianInt:(uint32_t)data;//{{{
+- (void)writeLittleEndianInt:(uint32_t)data
+{
+    [self writeInt:OSSwapHostToLittleInt32(data)];
+}
+//}}}
+// - (void)writeLittleEndianLong:(uint64_t)data;//{{{
+- (void)writeLittleEndianLong:(uint64_t)data
+{
+    [self writeLong:OSSwapHostToLittleInt64(data)];
+}
+//}}}
+// - (void)writeLittleEndianFloat:(float)data;//{{{
+- (void)writeLittleEndianFloat:(float)data
+{
+    NSSwappedFloat swappedFloat = NSSwapHostFloatToLittle(data);
+    [self write:&swappedFloat length:sizeof(NSSwappedFloat)];
+}
+//}}}
+// - (void)writeLittleEndianDouble:(double)data;//{{{
+- (void)writeLittleEndianDouble:(double)data
+{
+    NSSwappedDouble swappedDouble = NSSwapHostDoubleToLittle(data);
+    [self write:&swappedDouble length:sizeof(NSSwappedDouble)];
+}
+//}}}
+
+// Reseting
+// - (void)reset;//{{{
+- (void)reset
+{
+    chain_release_all(&m_chain);
+    m_staged = 0;
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
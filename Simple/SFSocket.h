@@ -14,12 +14,42 @@
  * may change it if you like. Or just use it as it is.
  */
 #import <UIKit/UIKit.h>
+#import "sfstd.h"
+#import "SFStream.h"
+#import "SFSocketProfile.h"
+
+#include <sys/uio.h>
 
 /**
  * \defgroup sf_networking Networking
  * Group having Objective-C interface for networking development.
  * @{ *//* ---------------------------------------------------------------- */
 
+// NS_INLINE struct iovec SFStreamReadVector(id<SFStreamReaderProtocol> stream, size_t amount);//{{{
+/**
+ * Builds a buffer descriptor with the bytes available in a stream.
+ * Used with SFSocket::sendBuffers:count: to send stream regions together
+ * with other buffers, without copying them.
+ * @param stream The stream. Its read position is not changed.
+ * @param amount Greatest number of bytes, starting at the read position.
+ * \c SIZE_MAX takes all bytes available.
+ * @return The descriptor. Valid while the stream is not changed. Its length
+ * is limited to SFStreamContiguousLength(), so it can be less than \a
+ * amount even when the stream has more data.
+ * @since 2.1
+ **/
+NS_INLINE struct iovec SFStreamReadVector(id<SFStreamReaderProtocol> stream, size_t amount)
+{
+    struct iovec vector;
+    size_t available = SFStreamContiguousLength(stream);
+
+    vector.iov_len  = ((amount < available) ? amount : available);
+    vector.iov_base = ((vector.iov_len > 0) ? (void *)[stream bytes] : NULL);
+    if (vector.iov_base == NULL) vector.iov_len = 0;
+    return vector;
+}
+//}}}
+
 /**
  * A Berkley socket implementation in Objective-C.
  *//* --------------------------------------------------------------------- */
@@ -31,6 +61,75 @@
  **/
 @property (nonatomic, readonly) error_t error;
 //}}}
+// @property (nonatomic, readonly) socket_t descriptor;//{{{
+/**
+ * Gets the socket descriptor.
+ * The value is -1 when the socket is not open.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly) socket_t descriptor;
+//}}}
+// @property (nonatomic, readonly) SFStream *inputStream;//{{{
+/**
+ * Gets the stream that receives the data read by an \c SFSocketLoop.
+ * The stream is created in the first access. The loop writes received bytes
+ * directly in its buffer and the application consumes them from there. The
+ * stream is not thread safe: when the socket is registered in a running
+ * loop, use it only from the loop callbacks.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly) SFStream *inputStream;
+//}}}
+// @property (nonatomic, readonly, getter=isListening) BOOL listening;//{{{
+/**
+ * Gets whether this socket is accepting connections.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly, getter=isListening) BOOL listening;
+//}}}
+// @property (nonatomic, readonly) NSUInteger localPort;//{{{
+/**
+ * Gets the local port of the socket.
+ * Zero when the socket is not open. Useful to know the port chosen by the
+ * system when #listen:port:reusePort: was given port zero.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly) NSUInteger localPort;
+//}}}
+// @property (nonatomic, readonly) NSData *remoteAddress;//{{{
+/**
+ * Gets the address of the connected peer.
+ * An \c NSData object with a \c sockaddr_in or \c sockaddr_in6 structure.
+ * \b nil when the socket is not connected.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly) NSData *remoteAddress;
+//}}}
+// @property (nonatomic) NSTimeInterval connectionAttemptDelay;//{{{
+/**
+ * Gets or sets the number of seconds a connection attempt runs alone before
+ * the next address is tried.
+ * Used when #open:port: or #openAddresses: has many addresses. Default is
+ * 0.25 seconds, as recommended by RFC 8305.
+ * @since 2.1
+ **/
+@property (nonatomic) NSTimeInterval connectionAttemptDelay;
+//}}}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithDescriptor:(socket_t)sd;//{{{
+/**
+ * Initializes the object with a socket already connected.
+ * Used with sockets returned by \c accept(). The socket is put in
+ * non-blocking mode.
+ * @param sd The socket descriptor. The object takes its ownership and closes
+ * it when released.
+ * @return This object initialized.
+ * @since 2.1
+ **/
+- (instancetype)initWithDescriptor:(socket_t)sd;
+//}}}
+//@}
 
 /** @name Attributes */ //@{
 // - (intptr_t)available;//{{{
@@ -56,9 +155,47 @@
  * connection is ready. When this value is \c EINPROGRESS the connection will
  * be completed in background. Any other value is an error code and the
  * connection could not be made.
+ * \remarks Since version 2.1 names are resolved by SFResolver::sharedResolver
+ * with \c getaddrinfo(). Numeric addresses and names in its cache don't
+ * block. Other names block the caller until resolved: use
+ * SFSocketLoop::connectSocket:toHost:port: to resolve them in background.
+ * When a name has many addresses, IPv4 and IPv6, they are raced as in
+ * #openAddresses:.
  **/
 - (error_t)open:(NSString*)address port:(NSUInteger)port;
 //}}}
+// - (error_t)openAddress:(NSData *)address;//{{{
+/**
+ * Starts the connection with a peer whose address is already known.
+ * @param address \c NSData object with a \c sockaddr_in or \c sockaddr_in6
+ * structure, as the ones given by SFResolver.
+ * @return Zero when the connection is ready. \c EINPROGRESS when it will be
+ * completed in background. Any other value is an error code.
+ * @since 2.1
+ **/
+- (error_t)openAddress:(NSData *)address;
+//}}}
+// - (error_t)openAddresses:(NSArray *)addresses;//{{{
+/**
+ * Connects to the first of many addresses that answers.
+ * Follows RFC 8305, "Happy Eyeballs": the addresses are tried alternating
+ * IPv6 and IPv4, in the order of the first one. Each attempt runs alone for
+ * #connectionAttemptDelay seconds, or until it fails, before the next one
+ * starts. The attempts in progress go on in parallel and the first to
+ * succeed is kept. The others are cancelled. So a dead or slow address
+ * doesn't hold the connection.
+ *
+ * The attempts advance in #isReady, #waitReady: and
+ * #waitSockets:timeout:. While they are in progress #descriptor is -1.
+ * @param addresses Array of \c NSData objects with \c sockaddr_in or \c
+ * sockaddr_in6 structures, as the ones given by SFResolver.
+ * @return Zero when connected right away. \c EINPROGRESS when the
+ * connection will be completed in background. Any other value is the error
+ * of the last attempt, when all of them failed.
+ * @since 2.1
+ **/
+- (error_t)openAddresses:(NSArray *)addresses;
+//}}}
 // - (error_t)isReady;//{{{
 /**
  * Checks if the connection was made.
@@ -72,6 +209,67 @@
  **/
 - (error_t)isReady;
 //}}}
+// - (error_t)waitReady:(NSTimeInterval)timeout;//{{{
+/**
+ * Waits until the connection started by #open:port: or #openAddresses:
+ * completes.
+ * @param timeout Greatest number of seconds to wait.
+ * @return Zero when connected. \c ETIMEDOUT when the time is over: the
+ * socket is closed. Any other value is the reason of the failure.
+ * @since 2.1
+ **/
+- (error_t)waitReady:(NSTimeInterval)timeout;
+//}}}
+// + (NSUInteger)waitSockets:(NSArray *)sockets timeout:(NSTimeInterval)timeout;//{{{
+/**
+ * Waits until the connections of many sockets complete.
+ * All connections go on in parallel, in a single \c poll() call.
+ * @param sockets Array of SFSocket objects. Sockets not connecting are
+ * only counted.
+ * @param timeout Greatest number of seconds to wait. Sockets still
+ * connecting after that are closed with \c ETIMEDOUT.
+ * @return The number of sockets connected. Check the #error of each one for
+ * the failures.
+ * @since 2.1
+ **/
++ (NSUInteger)waitSockets:(NSArray *)sockets timeout:(NSTimeInterval)timeout;
+//}}}
+// - (void)close;//{{{
+/**
+ * Closes the socket.
+ * The object can be opened again with #open:port:.
+ * @since 2.1
+ **/
+- (void)close;
+//}}}
+//@}
+
+/** @name Listening */ //@{
+// - (error_t)listen:(NSString *)address port:(NSUInteger)port reusePort:(BOOL)reusePort;//{{{
+/**
+ * Starts accepting connections.
+ * @param address The IP of the local interface, IPv4 or IPv6. \b nil to
+ * accept in all IPv4 interfaces.
+ * @param port The local port. Zero lets the system choose one. See
+ * #localPort.
+ * @param reusePort \b YES to set \c SO_REUSEPORT, so other sockets can
+ * listen in the same address and port.
+ * @return Zero on success. Otherwise the error number.
+ * @since 2.1
+ **/
+- (error_t)listen:(NSString *)address port:(NSUInteger)port reusePort:(BOOL)reusePort;
+//}}}
+// - (SFSocket *)accept;//{{{
+/**
+ * Accepts a pending connection.
+ * The socket doesn't block: when there is no connection pending the result
+ * is \b nil and #error is \c EWOULDBLOCK.
+ * @return A temporary \c SFSocket object with the new connection, in
+ * non-blocking mode. \b nil when there is no connection or on failure.
+ * @since 2.1
+ **/
+- (SFSocket *)accept;
+//}}}
 //@}
 
 /** @name Communication */ //@{
@@ -79,8 +277,10 @@
 /**
  * Sends data to the connected peer.
  * \param data The data to be send.
- * \return \b YES if the data was sent. \b NO when an error occurs. The check
- * the error code see the #error property.
+ * \return \b YES if the data was sent or queued. \b NO when an error occurs.
+ * The check the error code see the #error property.
+ * \remarks Since version 2.1 the data is kept in the write queue when the
+ * kernel cannot take all of it. See #send:ofLength:.
  **/
 - (BOOL)send:(NSData*)data;
 //}}}
@@ -89,8 +289,12 @@
  * Sends data to the connected peer.
  * \param data Pointer to the address of the data.
  * \param length Length of the data to send, in bytes.
- * \return \b YES if the data was sent. \b NO when an error occurs. The check
- * the error code see the #error property.
+ * \return \b YES if the data was sent or queued. \b NO when an error occurs.
+ * The check the error code see the #error property.
+ * \remarks Since version 2.1, when the write queue is empty the data is
+ * sent right away and only what the kernel doesn't take is copied to the
+ * queue. When the queue has data, everything is queued after it, so the
+ * order is kept. See #flush.
  **/
 - (BOOL)send:(const void*)data ofLength:(size_t)length;
 //}}}
@@ -101,13 +305,14 @@
  * \param size Length of available memory in \a buffer.
  * \return The function returns the length of data actualy read and copied
  * into the \a buffer memory location. This can be less than the passed in \a
- * size argument. You must always check the length of the data available
- * first, and try to read all that data once. If there is more data than the
- * length of the passed \a buffer, the data will be truncated.
+ * size argument. Data that doesn't fit in \a buffer is left in the socket
+ * for the next call.
  *
  * When there is no data to be read the function returns 0 (zero). If an error
  * occurs the function returns -1. The error code can be recovered using the
  * #error property.
+ * \remarks Since version 2.1 the operation makes a single \c recv() call.
+ * It doesn't query the amount available with #available first.
  **/
 - (intptr_t)read:(void*)buffer ofLength:(size_t)size;
 //}}}
@@ -121,17 +326,262 @@
  * When there is no data to be read the function returns 0 (zero). If an error
  * occurs the function returns -1. The error code can be recovered using the
  * #error property.
+ * \remarks Since version 2.1 the data is received directly at the end of \a
+ * buffer, without a temporary copy, and the operation reads until the
+ * socket is empty: a read shorter than requested or \c EAGAIN. The read
+ * size adapts to the amount received. When the peer closes the connection
+ * after sending data, the data is returned and the end is reported by the
+ * next call.
  **/
 - (intptr_t)read:(NSMutableData*)buffer;
 //}}}
 //@}
 
+/** @name Scatter/Gather */ //@{
+// - (intptr_t)sendBuffers:(const struct iovec *)buffers count:(NSUInteger)count;//{{{
+/**
+ * Sends several buffers in a single system call.
+ * The buffers are sent in order with \c writev(), as if they were one. Like
+ * #send:ofLength:, the bytes the kernel doesn't take are kept in the write
+ * queue.
+ * @param buffers Array of descriptors. See SFStreamReadVector().
+ * @param count Number of elements in \a buffers.
+ * @return The total number of bytes sent or queued. -1 on failure. Check
+ * #error.
+ * @since 2.1
+ **/
+- (intptr_t)sendBuffers:(const struct iovec *)buffers count:(NSUInteger)count;
+//}}}
+// - (intptr_t)sendStreams:(NSArray *)streams;//{{{
+/**
+ * Sends the bytes available in several streams in a single system call.
+ * @param streams Array of objects implementing SFStreamReaderProtocol. The
+ * read position of each one is moved past the bytes sent or queued when the
+ * operation succeeds. Only the contiguous bytes of each stream are taken,
+ * see SFStreamReadVector(). Streams that keep just a part of their data in
+ * memory, like a spilled SFSpillStream, still have bytes available
+ * afterwards: call again until they are empty.
+ * @return The total number of bytes sent or queued. -1 on failure. Check
+ * #error.
+ * @since 2.1
+ **/
+- (intptr_t)sendStreams:(NSArray *)streams;
+//}}}
+// - (intptr_t)readIntoStreams:(NSArray *)streams lengths:(const size_t *)lengths;//{{{
+/**
+ * Reads into several streams in a single system call.
+ * The data is read with \c readv(): the first stream is filled with up to
+ * the first length, then the second, and so on. Useful to read a fixed size
+ * header and its payload into different streams.
+ * @param streams Array of objects implementing SFStreamWriterProtocol. The
+ * same object must not be repeated.
+ * @param lengths Greatest number of bytes written in each stream, starting
+ * at its write position.
+ * @return The total number of bytes read. Zero when there was nothing to
+ * read. -1 on failure or when the peer closed the connection. Check
+ * #error: \c ENOTCONN when the socket is not open, in which case the
+ * streams are not touched.
+ * @since 2.1
+ **/
+- (intptr_t)readIntoStreams:(NSArray *)streams lengths:(const size_t *)lengths;
+//}}}
+//@}
+
+/** @name Tuning */ //@{
+// @property (nonatomic, copy) SFSocketProfile *profile;//{{{
+/**
+ * Gets or sets the options applied to this socket.
+ * The profile is applied when the socket opens a connection, starts
+ * listening and to every socket it accepts. When the socket is already
+ * open it is applied right away: check #error. \b nil uses
+ * #defaultProfile. Set it before #open:port: so buffer sizes take part in
+ * the handshake.
+ * @since 2.1
+ **/
+@property (nonatomic, copy) SFSocketProfile *profile;
+//}}}
+// + (SFSocketProfile *)defaultProfile;//{{{
+/**
+ * Gets the profile of sockets without their own #profile.
+ * This includes the sockets opened by SFSocketLoop and SFConnectionPool.
+ * @return A copy of the profile. \b nil when not set, keeping the system
+ * defaults.
+ * @since 2.1
+ **/
++ (SFSocketProfile *)defaultProfile;
+//}}}
+// + (void)setDefaultProfile:(SFSocketProfile *)profile;//{{{
+/**
+ * Sets the profile of sockets without their own #profile.
+ * Sockets already open are not changed.
+ * @param profile The profile. It is copied. \b nil keeps the system
+ * defaults.
+ * @since 2.1
+ **/
++ (void)setDefaultProfile:(SFSocketProfile *)profile;
+//}}}
+//@}
+
+/** @name Statistics */ //@{
+// @property (nonatomic, readonly) uint64_t bytesReceived;//{{{
+/**
+ * Gets the number of bytes received by the read operations.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly) uint64_t bytesReceived;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfReceiveCalls;//{{{
+/**
+ * Gets the number of system calls made to receive data.
+ * Calls that returned \c EAGAIN or were interrupted are counted.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly) uint64_t numberOfReceiveCalls;
+//}}}
+// @property (nonatomic, readonly) uint64_t bytesSent;//{{{
+/**
+ * Gets the number of bytes taken by the kernel in the send operations.
+ * Bytes still in the write queue are not counted.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly) uint64_t bytesSent;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfSendCalls;//{{{
+/**
+ * Gets the number of system calls made to send data.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly) uint64_t numberOfSendCalls;
+//}}}
+// - (void)resetStatistics;//{{{
+/**
+ * Sets all statistics to zero.
+ * @since 2.1
+ **/
+- (void)resetStatistics;
+//}}}
+//@}
+
+/** @name Write Queue */ //@{
+// @property (nonatomic, readonly) size_t queuedBytes;//{{{
+/**
+ * Gets the number of bytes in the write queue, waiting to be sent.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly) size_t queuedBytes;
+//}}}
+// @property (nonatomic) size_t highWatermark;//{{{
+/**
+ * Gets or sets the queue size that makes the socket congested.
+ * When #queuedBytes grows above this value #congested becomes \b YES and the
+ * watermark target is called. Default is 1 MB.
+ * @since 2.1
+ **/
+@property (nonatomic) size_t highWatermark;
+//}}}
+// @property (nonatomic) size_t lowWatermark;//{{{
+/**
+ * Gets or sets the queue size that ends the congestion.
+ * When the socket is congested and #queuedBytes drops to this value or less
+ * #congested becomes \b NO and the watermark target is called. Default is
+ * 256 KB.
+ * @since 2.1
+ **/
+@property (nonatomic) size_t lowWatermark;
+//}}}
+// @property (nonatomic, readonly, getter=isCongested) BOOL congested;//{{{
+/**
+ * Gets whether the write queue passed the #highWatermark and didn't drop to
+ * the #lowWatermark yet.
+ * Producers should stop queueing data while this is \b YES.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly, getter=isCongested) BOOL congested;
+//}}}
+// - (void)setWatermarkTarget:(id)target selector:(SEL)action;//{{{
+/**
+ * Sets the object called when #congested changes.
+ * @param target The object to call. It is not retained. \b nil removes the
+ * current target.
+ * @param action The selector to call. Must accept a single argument that is
+ * this socket.
+ * @since 2.1
+ **/
+- (void)setWatermarkTarget:(id)target selector:(SEL)action;
+//}}}
+// - (BOOL)enqueueData:(NSData *)data;//{{{
+/**
+ * Adds data to the end of the write queue.
+ * The data object is retained, not copied, unless it is mutable. When the
+ * queue was empty the operation tries to send it right away.
+ * @param data The data to send.
+ * @return \b YES on success. \b NO when the socket is not open or failed.
+ * Check #error.
+ * @since 2.1
+ **/
+- (BOOL)enqueueData:(NSData *)data;
+//}}}
+// - (BOOL)enqueueStream:(SFStream *)stream;//{{{
+/**
+ * Adds the bytes available in a stream to the end of the write queue.
+ * The bytes are not copied: the queue keeps a reference to the stream
+ * buffer and the read position of \a stream is moved to its end. When the
+ * queue was empty the operation tries to send them right away.
+ * @param stream The stream with the data to send.
+ * @return \b YES on success. \b NO when the socket is not open or failed.
+ * Check #error.
+ * @since 2.1
+ **/
+- (BOOL)enqueueStream:(SFStream *)stream;
+//}}}
+// - (intptr_t)flush;//{{{
+/**
+ * Sends as much of the write queue as the kernel takes.
+ * Many queued buffers are sent in a single \c writev() call. Files queued
+ * by #sendFile:offset:length: are sent with \c sendfile(). A buffer sent
+ * partially is continued from where it stopped in the next call. An
+ * SFSocketLoop calls this operation every time the socket becomes writable.
+ * @return The number of bytes sent, zero when the kernel buffer is full. -1
+ * when the connection failed. Check #error.
+ * @remarks The write queue is not thread safe. When the socket is registered
+ * in a running loop, use it only from the loop callbacks.
+ * @since 2.1
+ **/
+- (intptr_t)flush;
+//}}}
+// - (BOOL)sendFile:(NSFileHandle *)file offset:(off_t)offset length:(off_t)length;//{{{
+/**
+ * Adds a range of a file to the end of the write queue.
+ * The file is sent by the kernel with \c sendfile(), straight from the
+ * page cache to the socket: its bytes are never copied to user space. Files
+ * that can't be sent that way, like pipes, are copied through a small
+ * buffer. In both cases nothing is allocated for the bytes sent.
+ *
+ * The range is sent in order with the data queued before and after it.
+ * When the queue was empty the operation tries to send it right away. What
+ * is left is sent by #flush, so an SFSocketLoop continues the transfer as
+ * the socket becomes writable.
+ * @param file The file to send. It is retained until its bytes are sent and
+ * must not be closed before that.
+ * @param offset Position of the first byte to send.
+ * @param length Number of bytes to send. A negative value sends up to the
+ * end of the file.
+ * @return \b YES on success. \b NO when the socket is not open or failed.
+ * Check #error.
+ * @remarks The file must not shrink while it is queued. When it does the
+ * transfer fails with \c EIO.
+ * @since 2.1
+ **/
+- (BOOL)sendFile:(NSFileHandle *)file offset:(off_t)offset length:(off_t)length;
+//}}}
+//@}
+
 /** @name SFStream Support */ //@{
-// - (intptr_t)send:(SFStream *)stream length:(size_t)amount;//{{{
+// - (intptr_t)send:(id<SFStreamReaderProtocol>)stream length:(size_t)amount;//{{{
 /**
- * Sends data read from a SFStream object.
- * @param stream SFStream object with data to send. This object will be read
- * starting from its read position.
+ * Sends data read from a stream object.
+ * @param stream Stream object with data to send, like SFStream or
+ * SFRingStream. This object will be read starting from its read position.
  * @param amount Total number of bytes to send. This can be \c UINTPTR_MAX to
  * send all data, starting from the stream current reading position, to the
  * connected peer. If this value is zero, the function does nothing.
@@ -140,27 +590,30 @@
  * retrieved by the #error property. If \a stream was \b nil or \a amount was
  * zero, the result will be \c EINVAL. If \a stream is empty the function
  * returns 0, which is a valid value and doesn't mean an error.
- * @remarks If the operation fails in any way the \a stream reading position
- * will not be changed.
+ * @remarks The stream is read in parts of SFStreamContiguousLength(). If
+ * the operation fails in any way the \a stream reading position will not be
+ * changed by the part that failed. When some parts were already sent their total is returned.
  **/
-- (intptr_t)send:(SFStream *)stream length:(size_t)amount;
+- (intptr_t)send:(id<SFStreamReaderProtocol>)stream length:(size_t)amount;
 //}}}
-// - (intptr_t)readIntoStream:(SFStream *)stream;//{{{
+// - (intptr_t)readIntoStream:(id<SFStreamWriterProtocol>)stream;//{{{
 /**
  * Reads data from the communication port and writes it in the passed stream.
- * @param stream SFStream where the read data will be stored. Must not be \b
- * nil.
+ * @param stream Stream where the read data will be stored, like SFStream or
+ * SFRingStream. Must not be \b nil.
  * @return A value greater than or equals to 0 means success, representing the
  * total number of bytes read. Zero means that was no available data to be
  * read. When an error occurs, like when the connection was lost, the result
  * will be less than zero and the error condition can be retrieved by the
  * #error property.
  * @remarks The current write position is taken into account to write the data
- * in the passed stream. Memory is automaticaly allocated as needed. If the
- * function fails, nothing is written and, by so, the write position is not
- * changed.
+ * in the passed stream. Memory is automaticaly allocated as needed. Since
+ * version 2.1 the data is received directly in the stream buffer and the
+ * operation reads until the socket is empty, like #read:. When the
+ * operation fails, data read by previous \c recv() calls of the same
+ * operation is kept in the stream.
  **/
-- (intptr_t)readIntoStream:(SFStream *)stream;
+- (intptr_t)readIntoStream:(id<SFStreamWriterProtocol>)stream;
 //}}}
 //@}
 @end
@@ -14,6 +14,7 @@
  * may change it if you like. Or just use it as it is.
  */
 #include <stdlib.h>
+#include <limits.h>
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
@@ -21,8 +22,12 @@
 #include <sys/select.h>
 #include <sys/errno.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <poll.h>
 #include <unistd.h>
 
 #import "sfstd.h"
@@ -30,16 +35,240 @@
 #import "SFSocket.h"
 #import "sfdebug.h"
 #import "SFString.h"
+#import "SFResolver.h"
+
+/** Greatest number of queued buffers sent by a single \c writev() call. */
+#define SF_SOCKET_IOVEC_COUNT       64
+
+/** Size of the first read of a socket and the least read size. */
+#define SF_SOCKET_READ_SIZE         (16 * 1024)
+
+/** Greatest read size. Reached by sockets that keep filling their reads. */
+#define SF_SOCKET_READ_SIZE_MAX     (256 * 1024)
+
+/** Greatest number of connection attempts in progress at the same time. */
+#define SF_SOCKET_CONNECT_ATTEMPTS  8
+
+/** Default value of SFSocket::connectionAttemptDelay, in seconds. */
+#define SF_SOCKET_ATTEMPT_DELAY     0.25
+
+/** Size of the buffer used to copy files when \c sendfile() can't be used. */
+#define SF_SOCKET_FILE_BUFFER       (16 * 1024)
+
+/** Default value of SFSocket::highWatermark. */
+#define SF_SOCKET_HIGH_WATERMARK    (1024 * 1024)
+
+/** Default value of SFSocket::lowWatermark. */
+#define SF_SOCKET_LOW_WATERMARK     (256 * 1024)
+
+/* ===========================================================================
+ * SFSocketFile CLASS
+ * ======================================================================== */
+/**
+ * A range of a file kept in the write queue of a socket.
+ * Answers \c length as \c NSData does, so the queue handles both kinds of
+ * item in the same way.
+ **/
+@interface SFSocketFile : NSObject {
+@public
+    NSFileHandle *file;
+    off_t         offset;
+    size_t        length;
+}
+- (NSUInteger)length;
+@end
+
+@implementation SFSocketFile
+- (NSUInteger)length {
+    return (NSUInteger)length;
+}
+- (void)dealloc {
+    [file release];
+    [super dealloc];
+}
+@end
 
 /* ===========================================================================
  * SFSocket EXTENSION
  * ======================================================================== */
 @interface SFSocket () {
-    socket_t m_sd;
-    error_t  m_error;
+    socket_t  m_sd;
+    error_t   m_error;
+    SFStream *m_input;
+    BOOL      m_listening;
+
+    NSMutableArray *m_queue;        /* NSData or SFSocketFile objects.      */
+    size_t    m_sent;               /* Bytes already sent of the first one. */
+    size_t    m_queued;
+    size_t    m_highWatermark;
+    size_t    m_lowWatermark;
+    BOOL      m_congested;
+    id        m_watermarkTarget;
+    SEL       m_watermarkAction;
+
+    size_t    m_readSize;           /* Adapts to the amount received.       */
+    uint64_t  m_bytesReceived;
+    uint64_t  m_receiveCalls;
+    uint64_t  m_bytesSent;
+    uint64_t  m_sendCalls;
+
+    SFSocketProfile *m_profile;
+
+    NSMutableArray *m_addresses;    /* Not tried yet. nil when not racing.  */
+    socket_t  m_attempts[SF_SOCKET_CONNECT_ATTEMPTS];
+    int       m_attemptCount;
+    error_t   m_attemptError;
+    NSTimeInterval m_nextAttempt;
+    NSTimeInterval m_attemptDelay;
+    BOOL      m_connecting;         /* Single connection in progress.       */
 }
+// - (instancetype)initWithDescriptor:(socket_t)sd profile:(SFSocketProfile *)profile;//{{{
+/**
+ * Initializes the object with a socket already connected, applying a
+ * profile. Used by #accept, with the profile of the listening socket.
+ **/
+- (instancetype)initWithDescriptor:(socket_t)sd profile:(SFSocketProfile *)profile;
+//}}}
+// - (void)setOptions:(socket_t)sd;//{{{
+/**
+ * Sets the options used by every socket, non-blocking mode and no SIGPIPE,
+ * and the options of the profile.
+ **/
+- (void)setOptions:(socket_t)sd;
+//}}}
+// - (void)startAttempt;//{{{
+/**
+ * Starts a connection to the next address not tried yet.
+ * Addresses that fail right away are skipped. When one connects right away
+ * it becomes the socket descriptor.
+ **/
+- (void)startAttempt;
+//}}}
+// - (error_t)advanceAttempts;//{{{
+/**
+ * Checks the connection attempts without waiting, keeping the first one to
+ * succeed, and starts the next attempt when one failed or the delay passed.
+ * @return Zero when connected, \c EINPROGRESS or the error of the last
+ * attempt when all of them failed.
+ **/
+- (error_t)advanceAttempts;
+//}}}
+// - (void)cancelAttempts;//{{{
+/**
+ * Closes the attempts in progress and forgets the addresses not tried.
+ **/
+- (void)cancelAttempts;
+//}}}
+// - (ssize_t)receive:(void *)buffer length:(size_t)size;//{{{
+/**
+ * Calls \c recv() until it is not interrupted, updating the statistics.
+ **/
+- (ssize_t)receive:(void *)buffer length:(size_t)size;
+//}}}
+// - (ssize_t)writeBuffers:(const struct iovec *)buffers count:(int)count;//{{{
+/**
+ * Calls \c writev() until it is not interrupted, updating the statistics.
+ **/
+- (ssize_t)writeBuffers:(const struct iovec *)buffers count:(int)count;
+//}}}
+// - (ssize_t)sendFilePart:(SFSocketFile *)part requested:(size_t *)requested;//{{{
+/**
+ * Sends the remaining bytes of a queued file with \c sendfile(), or by
+ * copying them through a small buffer when the file can't be sent that way.
+ * The number of bytes tried is stored in \a requested, so a short write can
+ * be told from a complete one.
+ **/
+- (ssize_t)sendFilePart:(SFSocketFile *)part requested:(size_t *)requested;
+//}}}
+// - (void)adaptReadSize:(size_t)received;//{{{
+/**
+ * Grows the read size when a read was filled and shrinks it when reads
+ * are much smaller.
+ **/
+- (void)adaptReadSize:(size_t)received;
+//}}}
+// - (void)appendItem:(id)item;//{{{
+/**
+ * Adds an NSData or SFSocketFile at the end of the write queue, without
+ * sending it.
+ **/
+- (void)appendItem:(id)item;
+//}}}
+// - (void)consumeBytes:(size_t)count;//{{{
+/**
+ * Removes bytes sent from the start of the write queue.
+ **/
+- (void)consumeBytes:(size_t)count;
+//}}}
+// - (void)checkWatermarks;//{{{
+/**
+ * Updates the congested state and calls the watermark target when it
+ * changes.
+ **/
+- (void)checkWatermarks;
+//}}}
 @end
 
+/* ===========================================================================
+ * SFSocket STATIC FUNCTIONS
+ * ======================================================================== */
+// static NSMutableArray *SFSocketInterleave(NSArray *addresses);//{{{
+/**
+ * Orders addresses to be tried, alternating families as RFC 8305 asks.
+ * The family of the first address goes first. The order of each family is
+ * kept. Addresses that are not IPv4 or IPv6 are removed.
+ **/
+static NSMutableArray *SFSocketInterleave(NSArray *addresses)
+{
+    NSMutableArray *first  = [NSMutableArray arrayWithCapacity:[addresses count]];
+    NSMutableArray *second = [NSMutableArray arrayWithCapacity:[addresses count]];
+    NSMutableArray *result = [NSMutableArray arrayWithCapacity:[addresses count]];
+    sa_family_t family = AF_UNSPEC;
+    NSUInteger index;
+
+    for (NSData *address in addresses)
+    {
+        const struct sockaddr *addr = (const struct sockaddr *)[address bytes];
+
+        if (([address length] < sizeof(struct sockaddr)) || ((addr->sa_family != AF_INET) && (addr->sa_family != AF_INET6)))
+            continue;
+
+        if (family == AF_UNSPEC)
+            family = addr->sa_family;
+        [((addr->sa_family == family) ? first : second) addObject:address];
+    }
+
+    for (index = 0; (index < [first count]) || (index < [second count]); ++index)
+    {
+        if (index < [first count])  [result addObject:[first objectAtIndex:index]];
+        if (index < [second count]) [result addObject:[second objectAtIndex:index]];
+    }
+    return result;
+}
+//}}}
+
+/* ===========================================================================
+ * SFSocket STATIC DATA
+ * ======================================================================== */
+/** Profile of the sockets without their own. See SFSocket::defaultProfile. */
+static SFSocketProfile *sf_defaultProfile = nil;
+
+// static NSLock *SFSocketDefaultProfileLock();//{{{
+/**
+ * Gets the lock that guards \c sf_defaultProfile.
+ **/
+static NSLock *SFSocketDefaultProfileLock()
+{
+    static NSLock *lock = nil;
+    static dispatch_once_t once;
+
+    dispatch_once(&once, ^{
+        lock = [[NSLock alloc] init];
+    });
+    return lock;
+}
+//}}}
+
 /* ===========================================================================
  * SFSocket IMPLEMENTATION
  * ======================================================================== */
@@ -48,6 +277,98 @@
 // @property (nonatomic, readonly) error_t error;//{{{
 @synthesize error = m_error;
 //}}}
+// @property (nonatomic, readonly) socket_t descriptor;//{{{
+@synthesize descriptor = m_sd;
+//}}}
+// @property (nonatomic, readonly) SFStream *inputStream;//{{{
+- (SFStream *)inputStream
+{
+    if (m_input == nil)
+        m_input = [[SFStream alloc] init];
+    return m_input;
+}
+//}}}
+// @property (nonatomic, readonly, getter=isListening) BOOL listening;//{{{
+@synthesize listening = m_listening;
+//}}}
+// @property (nonatomic, readonly) NSUInteger localPort;//{{{
+- (NSUInteger)localPort
+{
+    struct sockaddr_storage addr;
+    socklen_t size = sizeof(addr);
+
+    if ((m_sd < 0) || (getsockname(m_sd, (struct sockaddr *)&addr, &size) < 0))
+        return 0;
+
+    if (addr.ss_family == AF_INET6)
+        return ntohs(((struct sockaddr_in6 *)&addr)->sin6_port);
+    return ntohs(((struct sockaddr_in *)&addr)->sin_port);
+}
+//}}}
+
+// @property (nonatomic, readonly) NSData *remoteAddress;//{{{
+- (NSData *)remoteAddress
+{
+    struct sockaddr_storage addr;
+    socklen_t size = sizeof(addr);
+
+    if ((m_sd < 0) || (getpeername(m_sd, (struct sockaddr *)&addr, &size) < 0))
+        return nil;
+
+    return [NSData dataWithBytes:&addr length:size];
+}
+//}}}
+// @property (nonatomic) NSTimeInterval connectionAttemptDelay;//{{{
+@synthesize connectionAttemptDelay = m_attemptDelay;
+//}}}
+
+// @property (nonatomic, readonly) size_t queuedBytes;//{{{
+@synthesize queuedBytes = m_queued;
+//}}}
+// @property (nonatomic) size_t highWatermark;//{{{
+@synthesize highWatermark = m_highWatermark;
+//}}}
+// @property (nonatomic) size_t lowWatermark;//{{{
+@synthesize lowWatermark = m_lowWatermark;
+//}}}
+// @property (nonatomic, readonly, getter=isCongested) BOOL congested;//{{{
+@synthesize congested = m_congested;
+//}}}
+// @property (nonatomic, readonly) uint64_t bytesReceived;//{{{
+@synthesize bytesReceived = m_bytesReceived;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfReceiveCalls;//{{{
+@synthesize numberOfReceiveCalls = m_receiveCalls;
+//}}}
+// @property (nonatomic, readonly) uint64_t bytesSent;//{{{
+@synthesize bytesSent = m_bytesSent;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfSendCalls;//{{{
+@synthesize numberOfSendCalls = m_sendCalls;
+//}}}
+
+// @property (nonatomic, copy) SFSocketProfile *profile;//{{{
+@synthesize profile = m_profile;
+- (void)setProfile:(SFSocketProfile *)profile
+{
+    if (profile == m_profile) return;
+
+    [m_profile release];
+    m_profile = [profile copy];
+
+    m_error = 0;
+    if ((m_sd >= 0) && (m_profile != nil))
+        m_error = [m_profile applyToDescriptor:m_sd];
+}
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithDescriptor:(socket_t)sd;//{{{
+- (instancetype)initWithDescriptor:(socket_t)sd
+{
+    return [self initWithDescriptor:sd profile:nil];
+}
+//}}}
 
 // Attributes
 // - (intptr_t)available;//{{{
@@ -69,49 +390,54 @@
 // - (error_t)open:(NSString*)address port:(NSUInteger)port;//{{{
 - (error_t)open:(NSString*)address port:(NSUInteger)port
 {
-    struct sockaddr_in in_addr;
-    error_t result;
-    int blockModeOff = TRUE;
+    NSArray *addresses;
 
-    const char* addr = [address utf8Array];     /* SFString */
+    /* Numeric addresses and names in the cache are not looked up. */
+    addresses = [[SFResolver sharedResolver] addressesForHost:address port:port error:&m_error];
+    if (addresses == nil)
+        return m_error;
 
-    m_error = 0;
+    if ([addresses count] == 1)
+        return [self openAddress:[addresses objectAtIndex:0]];
+    return [self openAddresses:addresses];
+}
+//}}}
+// - (error_t)openAddresses:(NSArray *)addresses;//{{{
+- (error_t)openAddresses:(NSArray *)addresses
+{
+    [self close];
 
-    /* Check where we have an URL or IP. */
-    if (isdigit(*addr))
-        in_addr.sin_addr.s_addr = inet_addr( addr );
-    else
-    {
-        struct hostent* host = gethostbyname( addr );
-        if (host == NULL) {
-            switch (h_errno) {
-            case HOST_NOT_FOUND: m_error = ENETDOWN; break;
-            case TRY_AGAIN:      m_error = EHOSTUNREACH; break;
-            case NO_RECOVERY:    m_error = ECONNREFUSED; break;
-            default:             m_error = ENETUNREACH;
-            }
-            return m_error;
-        }
-        in_addr.sin_addr.s_addr = *(uint32_t *)host->h_addr_list[0];
-    }
+    m_addresses = [SFSocketInterleave(addresses) retain];
+    m_attemptError = EAFNOSUPPORT;  /* When no address can be used. */
+    m_nextAttempt = 0;
 
-    /* Completes the connection address. */
-    in_addr.sin_port   = htons((uint16_t)port);
-    in_addr.sin_family = AF_INET;
+    return [self advanceAttempts];
+}
+//}}}
+// - (error_t)openAddress:(NSData *)address;//{{{
+- (error_t)openAddress:(NSData *)address
+{
+    const struct sockaddr *addr = (const struct sockaddr *)[address bytes];
+    char host[NI_MAXHOST], service[NI_MAXSERV];
+    error_t result;
 
-    m_sd = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+    m_error = 0;
+    if (([address length] < sizeof(struct sockaddr)) || ((addr->sa_family != AF_INET) && (addr->sa_family != AF_INET6)))
+        return m_error = EAFNOSUPPORT;
+
+    [self close];
+    m_sd = socket(addr->sa_family, SOCK_STREAM, IPPROTO_TCP);
     if (m_sd < 0) {
         return m_error = errno;
     }
 
-    /* Set the 'non-block' option so we connect in background. */
-    ioctl(m_sd, FIONBIO, &blockModeOff);
+    /* Non-blocking mode, so we connect in background. */
+    [self setOptions:m_sd];
 
-    /* In the iOS 5 and later, we need to cancel the SIGPIPE signal. */
-    setsockopt(m_sd, SOL_SOCKET, SO_NOSIGPIPE, &blockModeOff, sizeof(int));
+    if (getnameinfo(addr, (socklen_t)[address length], host, sizeof(host), service, sizeof(service), (NI_NUMERICHOST | NI_NUMERICSERV)) == 0)
+        sfdebug("SFSocket::connect('%s', %s)\n", host, service);
 
-    sfdebug("SFSocket::connect('%s', %u)\n", inet_ntoa(in_addr.sin_addr), port);
-    result = connect(m_sd, (struct sockaddr*)&in_addr, sizeof(struct sockaddr_in));
+    result = connect(m_sd, addr, (socklen_t)[address length]);
     if (result == 0) {
         return result;
     }
@@ -121,6 +447,7 @@
     }
 
     if ((result == EWOULDBLOCK) || (result == EINPROGRESS)) {
+        m_connecting = YES;
         m_error = EINPROGRESS;
         return m_error;
     }
@@ -138,6 +465,11 @@
     struct fd_set fdsw;             /* Write set. */
     struct fd_set fdse;             /* Error set. */
 
+    if (m_addresses != nil)
+        return [self advanceAttempts];
+    if (m_sd < 0)
+        return m_error = ENOTCONN;
+
     FD_ZERO( &fdse );
     FD_ZERO( &fdsw );
     FD_SET(m_sd, &fdse);
@@ -151,26 +483,192 @@
     }
     else if (m_error > 0)
     {
-        if (FD_ISSET(m_sd, &fdsw)) {
-            return m_error = 0;
-        } else {
-            int value = 0;
-            socklen_t size = sizeof(int);
+        int value = 0;
+        socklen_t size = sizeof(int);
 
-            m_error = getsockopt(m_sd, SOL_SOCKET, SO_ERROR, &value, &size);
-            if (m_error == 0) {
-                return m_error = value;
+        /* A failed connection is also writable. SO_ERROR tells them apart. */
+        m_connecting = NO;
+        if (getsockopt(m_sd, SOL_SOCKET, SO_ERROR, &value, &size) == 0)
+        {
+            if (value == 0) {
+                return m_error = 0;
             }
+            errno = value;
         }
     }
 
     /* An error was found. The connection could not be made. */
+    m_connecting = NO;
     m_error = errno;
     close(m_sd);
     m_sd = -1;
     return m_error;
 }
 //}}}
+// - (error_t)waitReady:(NSTimeInterval)timeout;//{{{
+- (error_t)waitReady:(NSTimeInterval)timeout
+{
+    [SFSocket waitSockets:[NSArray arrayWithObject:self] timeout:timeout];
+    return m_error;
+}
+//}}}
+// + (NSUInteger)waitSockets:(NSArray *)sockets timeout:(NSTimeInterval)timeout;//{{{
++ (NSUInteger)waitSockets:(NSArray *)sockets timeout:(NSTimeInterval)timeout
+{
+    NSTimeInterval limit = [NSDate timeIntervalSinceReferenceDate] + timeout;
+    NSUInteger connected = 0;
+    struct pollfd *fds;
+
+    fds = (struct pollfd *)calloc(([sockets count] * SF_SOCKET_CONNECT_ATTEMPTS) + 1, sizeof(struct pollfd));
+    if (fds == NULL) return 0;
+
+    for (;;)
+    {
+        NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+        NSTimeInterval wake = limit;
+        nfds_t used = 0;
+
+        connected = 0;
+        for (SFSocket *socket in sockets)
+        {
+            if ((socket->m_addresses != nil) || socket->m_connecting)
+                [socket isReady];
+
+            if (socket->m_addresses != nil)
+            {
+                int index;
+
+                for (index = 0; index < socket->m_attemptCount; ++index, ++used) {
+                    fds[used].fd = socket->m_attempts[index];
+                    fds[used].events = POLLOUT;
+                    fds[used].revents = 0;
+                }
+                /* Wakes up to start the next attempt. With all slots in
+                 * use only the end of an attempt can start another, and
+                 * poll() already waits for it. */
+                if (([socket->m_addresses count] > 0) && (socket->m_attemptCount < SF_SOCKET_CONNECT_ATTEMPTS) &&
+                    (socket->m_nextAttempt < wake))
+                    wake = socket->m_nextAttempt;
+            }
+            else if (socket->m_connecting)
+            {
+                fds[used].fd = socket->m_sd;
+                fds[used].events = POLLOUT;
+                fds[used].revents = 0;
+                used++;
+            }
+            else if ((socket->m_sd >= 0) && (socket->m_error == 0))
+                connected++;
+        }
+
+        if (used == 0) break;
+        if (now >= limit)
+        {
+            for (SFSocket *socket in sockets)
+            {
+                if ((socket->m_addresses == nil) && !socket->m_connecting)
+                    continue;
+
+                [socket close];
+                socket->m_error = ETIMEDOUT;
+            }
+            break;
+        }
+
+        poll(fds, used, ((wake > now) ? (int)((wake - now) * 1000.0) + 1 : 0));
+    }
+
+    free(fds);
+    return connected;
+}
+//}}}
+// - (void)close;//{{{
+- (void)close
+{
+    [self cancelAttempts];
+    m_connecting = NO;
+
+    if (m_sd >= 0) close(m_sd);
+    m_sd = -1;
+    m_listening = NO;
+
+    /* What was not sent is lost with the connection. */
+    [m_queue removeAllObjects];
+    m_sent = m_queued = 0;
+    m_congested = NO;
+}
+//}}}
+
+// Listening
+// - (error_t)listen:(NSString *)address port:(NSUInteger)port reusePort:(BOOL)reusePort;//{{{
+- (error_t)listen:(NSString *)address port:(NSUInteger)port reusePort:(BOOL)reusePort
+{
+    struct sockaddr_in in_addr;
+    const struct sockaddr *addr = (const struct sockaddr *)&in_addr;
+    socklen_t length = sizeof(struct sockaddr_in);
+    NSData *local = nil;
+    int optionOn = TRUE;
+
+    memset(&in_addr, 0, sizeof(in_addr));
+    in_addr.sin_len    = sizeof(struct sockaddr_in);
+    in_addr.sin_family = AF_INET;
+    in_addr.sin_port   = htons((uint16_t)port);
+    in_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    /* IPv6 addresses, like "::1", are accepted too. */
+    if (address != nil)
+    {
+        NSArray *addresses = [[SFResolver sharedResolver] addressesForHost:address port:port error:&m_error];
+
+        if (addresses == nil)
+            return m_error;
+
+        local  = [addresses objectAtIndex:0];
+        addr   = (const struct sockaddr *)[local bytes];
+        length = (socklen_t)[local length];
+    }
+
+    [self close];
+    m_sd = socket(addr->sa_family, SOCK_STREAM, IPPROTO_TCP);
+    if (m_sd < 0) {
+        return m_error = errno;
+    }
+
+    [self setOptions:m_sd];
+    setsockopt(m_sd, SOL_SOCKET, SO_REUSEADDR, &optionOn, sizeof(int));
+    if (reusePort)
+        setsockopt(m_sd, SOL_SOCKET, SO_REUSEPORT, &optionOn, sizeof(int));
+
+    if ((bind(m_sd, addr, length) < 0) ||
+        (listen(m_sd, SOMAXCONN) < 0))
+    {
+        m_error = errno;
+        [self close];
+        return m_error;
+    }
+
+    m_listening = YES;
+    return m_error = 0;
+}
+//}}}
+// - (SFSocket *)accept;//{{{
+- (SFSocket *)accept
+{
+    socket_t sd;
+
+    do {
+        sd = accept(m_sd, NULL, NULL);
+    } while ((sd < 0) && (errno == EINTR));
+
+    if (sd < 0) {
+        m_error = errno;
+        return nil;
+    }
+
+    m_error = 0;
+    return [[[SFSocket alloc] initWithDescriptor:sd profile:m_profile] autorelease];
+}
+//}}}
 
 // Communication
 // - (BOOL)send:(NSData*)data;//{{{
@@ -182,73 +680,443 @@
 // - (BOOL)send:(const void*)data ofLength:(size_t)length;//{{{
 - (BOOL)send:(const void*)data ofLength:(size_t)length
 {
-    m_error = 0;
-    if (send(m_sd, data, length, 0) < 0) {
-        m_error = errno;
-        return FALSE;
-    }
-    return TRUE;
+    struct iovec buffer = { (void *)data, length };
+
+    return ([self sendBuffers:&buffer count:1] >= 0);
 }
 //}}}
 // - (intptr_t)read:(void*)buffer ofLength:(size_t)size;//{{{
 - (intptr_t)read:(void*)buffer ofLength:(size_t)size
 {
-    intptr_t available = [self available];
-    if (available < 0) return -1;       /* The error property was already filled. */
-    if (available == 0) return 0;       /* Idem. */
+    ssize_t received;
 
-    if (size > (size_t)available)
-        size = (size_t)available;
-
-    available = recv(m_sd, buffer, size, 0);
-    if (available == 0)
+    m_error = 0;
+    received = [self receive:buffer length:size];
+    if (received == 0)
     {
         m_error = ESHUTDOWN;        /* Connection shutdown by the peer. */
         close(m_sd);
         m_sd = -1;
         return -1;
     }
-    else if (available < 0)
+    else if (received < 0)
+    {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            return 0;               /* Nothing to be read right now. */
         m_error = errno;            /* Another kind of error. */
-    return available;
+    }
+    return received;
 }
 //}}}
 // - (intptr_t)read:(NSMutableData*)buffer;//{{{
 - (intptr_t)read:(NSMutableData*)buffer
 {
-    intptr_t available = [self available];
+    size_t   used = [buffer length];
+    size_t   room = used;
+    intptr_t total = 0;
+
+    m_error = 0;
+    for (;;)
+    {
+        size_t  size;
+        ssize_t received;
 
-    if (available < 0) return -1;           /* The error property was already filled. */
-    if (available == 0) return 0;           /* Nothing to be read right now.   */
+        /* Reads in the tail of the object, no intermediate buffer. The
+         * object zero fills what it grows, so it only grows when the room
+         * reserved was filled. */
+        if (room == used) {
+            room = used + m_readSize;
+            [buffer setLength:room];
+        }
+        size = (room - used);
+        received = [self receive:((uint8_t *)[buffer mutableBytes] + used) length:size];
+
+        if (received > 0)
+        {
+            used  += (size_t)received;
+            total += received;
+            [self adaptReadSize:(size_t)received];
+
+            /* A short read emptied the socket. */
+            if ((size_t)received < size) break;
+        }
+        else if (received == 0)
+        {
+            if (total > 0) break;   /* The end is reported in the next call. */
+
+            m_error = ENOTCONN;     /* Connection lost.             */
+            close(m_sd);
+            m_sd = -1;
+            total = -1;
+            break;
+        }
+        else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            break;
+        else {
+            m_error = errno;
+            total = -1;
+            break;
+        }
+    }
 
-    uint8_t* mem = (uint8_t*)malloc(available);
-    if (mem == NULL) {
-        m_error = ENOMEM;                   /* No available memory.         */
+    /* Only the bytes received are kept. */
+    if (room != used) [buffer setLength:used];
+    return total;
+}
+//}}}
+
+// Scatter/Gather
+// - (intptr_t)sendBuffers:(const struct iovec *)buffers count:(NSUInteger)count;//{{{
+- (intptr_t)sendBuffers:(const struct iovec *)buffers count:(NSUInteger)count
+{
+    NSUInteger index = 0;
+    size_t total = 0, skip = 0;
+
+    m_error = 0;
+    if (m_sd < 0) {
+        m_error = ENOTCONN;
         return -1;
     }
 
-    available = recv(m_sd, mem, available, 0);
-    if (available > 0)
+    while (index < count)
+        total += buffers[index++].iov_len;
+
+    if (total == 0) return 0;
+
+    /* Data already queued must go first. */
+    index = 0;
+    while ((m_queued == 0) && (index < count))
+    {
+        int used = (int)(((count - index) < IOV_MAX) ? (count - index) : IOV_MAX);
+        ssize_t sent = [self writeBuffers:(buffers + index) count:used];
+
+        if (sent < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) break;
+
+            m_error = errno;
+            return -1;
+        }
+
+        while ((index < count) && ((size_t)sent >= buffers[index].iov_len))
+            sent -= buffers[index++].iov_len;
+
+        /* Stopped in the middle of a buffer: the kernel buffer is full. */
+        if (sent > 0) {
+            skip = (size_t)sent;
+            break;
+        }
+    }
+
+    if (index < count)
+    {
+        /* Keeps the remaining bytes for #flush, in a single copy. */
+        NSMutableData *rest = [NSMutableData dataWithCapacity:(total - skip)];
+
+        [rest appendBytes:((const uint8_t *)buffers[index].iov_base + skip) length:(buffers[index].iov_len - skip)];
+        while (++index < count)
+            [rest appendBytes:buffers[index].iov_base length:buffers[index].iov_len];
+
+        [self appendItem:rest];
+        [self checkWatermarks];
+    }
+    return (intptr_t)total;
+}
+//}}}
+// - (intptr_t)sendStreams:(NSArray *)streams;//{{{
+- (intptr_t)sendStreams:(NSArray *)streams
+{
+    struct iovec local[SF_SOCKET_IOVEC_COUNT];
+    struct iovec *buffers = local;
+    NSUInteger index, count = [streams count];
+    intptr_t result;
+
+    if (count > SF_SOCKET_IOVEC_COUNT)
     {
-        [buffer appendBytes:mem length:available];
+        buffers = (struct iovec *)malloc(count * sizeof(struct iovec));
+        if (buffers == NULL) {
+            m_error = ENOMEM;
+            return -1;
+        }
     }
-    else if (available == 0)
+
+    for (index = 0; index < count; ++index)
+        buffers[index] = SFStreamReadVector([streams objectAtIndex:index], SIZE_MAX);
+
+    result = [self sendBuffers:buffers count:count];
+    if (result >= 0)
     {
-        m_error = ENOTCONN;                 /* Connection lost.             */
+        for (index = 0; index < count; ++index)
+        {
+            id<SFStreamReaderProtocol> stream = [streams objectAtIndex:index];
+            [stream setReadPosition:([stream readPosition] + buffers[index].iov_len)];
+        }
+    }
+
+    if (buffers != local) free(buffers);
+    return result;
+}
+//}}}
+// - (intptr_t)readIntoStreams:(NSArray *)streams lengths:(const size_t *)lengths;//{{{
+- (intptr_t)readIntoStreams:(NSArray *)streams lengths:(const size_t *)lengths
+{
+    struct iovec local[SF_SOCKET_IOVEC_COUNT];
+    struct iovec *buffers = local;
+    NSUInteger index, count = [streams count];
+    ssize_t received = -1;
 
-        close(m_sd);                        /* Just in case.                */
+    m_error = 0;
+    if (m_sd < 0) {
+        m_error = ENOTCONN;
+        return -1;
+    }
+    if (count == 0) return 0;
+    if (count > SF_SOCKET_IOVEC_COUNT)
+    {
+        buffers = (struct iovec *)malloc(count * sizeof(struct iovec));
+        if (buffers == NULL) {
+            m_error = ENOMEM;
+            return -1;
+        }
+    }
+
+    for (index = 0; index < count; ++index)
+    {
+        buffers[index].iov_len  = lengths[index];
+        buffers[index].iov_base = ((lengths[index] > 0) ? [[streams objectAtIndex:index] bufferWithLength:lengths[index]] : NULL);
+
+        if ((lengths[index] > 0) && (buffers[index].iov_base == NULL)) {
+            m_error = ENOMEM;
+            goto done;
+        }
+    }
+
+    do {
+        received = readv(m_sd, buffers, (int)count);
+        m_receiveCalls++;
+    } while ((received < 0) && (errno == EINTR));
+
+    if (received > 0)
+        m_bytesReceived += (uint64_t)received;
+
+    if (received == 0)
+    {
+        m_error = ESHUTDOWN;        /* Connection shutdown by the peer. */
+        close(m_sd);
         m_sd = -1;
-        available = -1;
+        received = -1;
+    }
+    else if (received < 0)
+    {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            received = 0;           /* Nothing to be read right now. */
+        else
+            m_error = errno;
     }
+    else
+    {
+        size_t remaining = (size_t)received;
+
+        for (index = 0; (index < count) && (remaining > 0); ++index)
+        {
+            id<SFStreamWriterProtocol> stream = [streams objectAtIndex:index];
+            size_t part = ((remaining < lengths[index]) ? remaining : lengths[index]);
+
+            [stream setWritePosition:([stream writePosition] + part)];
+            remaining -= part;
+        }
+    }
+
+done:
+    if (buffers != local) free(buffers);
+    return (intptr_t)received;
+}
+//}}}
+
+// Tuning
+// + (SFSocketProfile *)defaultProfile;//{{{
++ (SFSocketProfile *)defaultProfile
+{
+    SFSocketProfile *profile;
+
+    [SFSocketDefaultProfileLock() lock];
+    profile = [sf_defaultProfile copy];
+    [SFSocketDefaultProfileLock() unlock];
+    return [profile autorelease];
+}
+//}}}
+// + (void)setDefaultProfile:(SFSocketProfile *)profile;//{{{
++ (void)setDefaultProfile:(SFSocketProfile *)profile
+{
+    SFSocketProfile *previous;
+
+    profile = [profile copy];
+    [SFSocketDefaultProfileLock() lock];
+    previous = sf_defaultProfile;
+    sf_defaultProfile = profile;
+    [SFSocketDefaultProfileLock() unlock];
+    [previous release];
+}
+//}}}
 
-    free(mem);
-    return available;
+// Statistics
+// - (void)resetStatistics;//{{{
+- (void)resetStatistics
+{
+    m_bytesReceived = m_receiveCalls = 0;
+    m_bytesSent = m_sendCalls = 0;
+}
+//}}}
+
+// Write Queue
+// - (void)setWatermarkTarget:(id)target selector:(SEL)action;//{{{
+- (void)setWatermarkTarget:(id)target selector:(SEL)action
+{
+    m_watermarkTarget = target;
+    m_watermarkAction = action;
+}
+//}}}
+// - (BOOL)enqueueData:(NSData *)data;//{{{
+- (BOOL)enqueueData:(NSData *)data
+{
+    BOOL wasEmpty = (m_queued == 0);
+
+    m_error = 0;
+    if (m_sd < 0) {
+        m_error = ENOTCONN;
+        return FALSE;
+    }
+    if ([data length] == 0) return TRUE;
+
+    data = [data copy];             /* Only mutable objects are copied. */
+    [self appendItem:data];
+    [data release];
+
+    if (wasEmpty)
+        return ([self flush] >= 0);
+
+    [self checkWatermarks];
+    return TRUE;
+}
+//}}}
+// - (BOOL)enqueueStream:(SFStream *)stream;//{{{
+- (BOOL)enqueueStream:(SFStream *)stream
+{
+    if (m_sd < 0) {
+        m_error = ENOTCONN;
+        return FALSE;
+    }
+
+    /* Shares the stream buffer. Nothing is copied. */
+    NSData *data = [stream dataFromReadingBytes:-1];
+    if (data == nil) {
+        m_error = 0;
+        return TRUE;
+    }
+    return [self enqueueData:data];
+}
+//}}}
+// - (intptr_t)flush;//{{{
+- (intptr_t)flush
+{
+    struct iovec iov[SF_SOCKET_IOVEC_COUNT];
+    intptr_t total = 0;
+
+    m_error = 0;
+    while (m_queued > 0)
+    {
+        NSUInteger index, count = [m_queue count];
+        id      head = [m_queue objectAtIndex:0];
+        size_t  requested = 0;
+        ssize_t sent;
+        int used = 0;
+
+        if ([head isKindOfClass:[SFSocketFile class]])
+        {
+            /* Files are sent alone, one part per iteration. The loop goes
+             * on while each part is sent whole. */
+            sent = [self sendFilePart:head requested:&requested];
+        }
+        else
+        {
+            for (index = 0; (index < count) && (used < SF_SOCKET_IOVEC_COUNT); ++index, ++used)
+            {
+                NSData *data = [m_queue objectAtIndex:index];
+                size_t  skip = ((index == 0) ? m_sent : 0);
+
+                if (![data isKindOfClass:[NSData class]]) break;
+
+                iov[used].iov_base = (void *)((const uint8_t *)[data bytes] + skip);
+                iov[used].iov_len  = [data length] - skip;
+                requested += iov[used].iov_len;
+            }
+            sent = [self writeBuffers:iov count:used];
+        }
+
+        if (sent < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) break;
+
+            m_error = errno;
+            total = -1;
+            break;
+        }
+
+        total += sent;
+        [self consumeBytes:(size_t)sent];
+
+        /* A short write means the kernel buffer is full. */
+        if ((size_t)sent < requested) break;
+    }
+
+    [self checkWatermarks];
+    return total;
+}
+//}}}
+// - (BOOL)sendFile:(NSFileHandle *)file offset:(off_t)offset length:(off_t)length;//{{{
+- (BOOL)sendFile:(NSFileHandle *)file offset:(off_t)offset length:(off_t)length
+{
+    BOOL wasEmpty = (m_queued == 0);
+    struct stat st;
+
+    m_error = 0;
+    if (m_sd < 0) {
+        m_error = ENOTCONN;
+        return FALSE;
+    }
+    if ((file == nil) || (offset < 0)) {
+        m_error = EINVAL;
+        return FALSE;
+    }
+
+    if (length < 0)
+    {
+        if (fstat([file fileDescriptor], &st) < 0) {
+            m_error = errno;
+            return FALSE;
+        }
+        length = ((st.st_size > offset) ? (st.st_size - offset) : 0);
+    }
+    if (length == 0) return TRUE;
+
+    SFSocketFile *part = [[SFSocketFile alloc] init];
+    part->file   = [file retain];
+    part->offset = offset;
+    part->length = (size_t)length;
+    [self appendItem:part];
+    [part release];
+
+    if (wasEmpty)
+        return ([self flush] >= 0);
+
+    [self checkWatermarks];
+    return TRUE;
 }
 //}}}
 
 // SFStream Support
-// - (intptr_t)send:(SFStream *)stream length:(size_t)amount;//{{{
-- (intptr_t)send:(SFStream *)stream length:(size_t)amount
+// - (intptr_t)send:(id<SFStreamReaderProtocol>)stream length:(size_t)amount;//{{{
+- (intptr_t)send:(id<SFStreamReaderProtocol>)stream length:(size_t)amount
 {
     if ((stream == nil) || (amount == 0)) {
         m_error = EINVAL;
@@ -256,44 +1124,77 @@
     }
 
     size_t size = [stream numberOfBytesAvailable];
+    size_t total = 0;
 
     size = ((amount > size) ? size : amount);
-    if (size == 0) return 0;
 
-    if (![self send:[stream bytes] ofLength:size])
-        return -1;
+    /* Only the contiguous part of the stream is read at once. */
+    while (total < size)
+    {
+        size_t part = SFStreamContiguousLength(stream);
+        const uint8_t *bytes = [stream bytes];
+
+        if ((part == 0) || (bytes == NULL)) {
+            if (total > 0) break;
+            m_error = EIO;
+            return -1;
+        }
+
+        if (part > (size - total)) part = (size - total);
+
+        if (![self send:bytes ofLength:part])
+            return ((total > 0) ? (intptr_t)total : -1);
 
-    [stream setReadPosition:([stream readPosition] + size)];
-    return size;
+        [stream setReadPosition:([stream readPosition] + part)];
+        total += part;
+    }
+    return total;
 }
 //}}}
-// - (intptr_t)readIntoStream:(SFStream *)stream;//{{{
-- (intptr_t)readIntoStream:(SFStream *)stream
+// - (intptr_t)readIntoStream:(id<SFStreamWriterProtocol>)stream;//{{{
+- (intptr_t)readIntoStream:(id<SFStreamWriterProtocol>)stream
 {
-    intptr_t available = [self available];
-    if (available < 0) return -1;       /* The error property was already filled. */
-    if (available == 0) return 0;       /* Idem. */
-
-    void *ptr = [stream bufferWithLength:available];
-    if (ptr == NULL) {
-        m_error = ENOMEM;
-        return -1;
-    }
+    intptr_t total = 0;
 
-    available = recv(m_sd, ptr, available, 0);
-    if (available == 0)
+    m_error = 0;
+    for (;;)
     {
-        m_error = ESHUTDOWN;        /* Connection shutdown by the peer. */
-        close(m_sd);
-        m_sd = -1;
-        return -1;
-    }
-    else if (available < 0)
-        m_error = errno;            /* Another kind of error. */
-    else
-        [stream setWritePosition:([stream writePosition] + available)];
+        size_t  size = m_readSize;
+        void   *ptr  = [stream bufferWithLength:size];
+        ssize_t received;
 
-    return available;
+        if (ptr == NULL) {
+            m_error = ENOMEM;
+            return -1;
+        }
+
+        received = [self receive:ptr length:size];
+        if (received > 0)
+        {
+            [stream setWritePosition:([stream writePosition] + (size_t)received)];
+            total += received;
+            [self adaptReadSize:(size_t)received];
+
+            /* A short read emptied the socket. */
+            if ((size_t)received < size) break;
+        }
+        else if (received == 0)
+        {
+            if (total > 0) break;   /* The end is reported in the next call. */
+
+            m_error = ESHUTDOWN;    /* Connection shutdown by the peer. */
+            close(m_sd);
+            m_sd = -1;
+            return -1;
+        }
+        else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            break;
+        else {
+            m_error = errno;        /* Another kind of error. */
+            return -1;
+        }
+    }
+    return total;
 }
 //}}}
 
@@ -302,16 +1203,295 @@
 - (id)init
 {
     self = [super init];
-    if (self) m_sd = -1;
+    if (self)
+    {
+        m_sd = -1;
+        m_highWatermark = SF_SOCKET_HIGH_WATERMARK;
+        m_lowWatermark  = SF_SOCKET_LOW_WATERMARK;
+        m_readSize      = SF_SOCKET_READ_SIZE;
+        m_attemptDelay  = SF_SOCKET_ATTEMPT_DELAY;
+    }
     return self;
 }
 //}}}
 // - (void)dealloc;//{{{
 - (void)dealloc
 {
+    [self cancelAttempts];
     if (m_sd >= 0) close(m_sd);
+    [m_input release];
+    [m_queue release];
+    [m_profile release];
     [super dealloc];
 }
 //}}}
+
+// Local Operations
+// - (instancetype)initWithDescriptor:(socket_t)sd profile:(SFSocketProfile *)profile;//{{{
+- (instancetype)initWithDescriptor:(socket_t)sd profile:(SFSocketProfile *)profile
+{
+    self = [self init];
+    if (self)
+    {
+        m_sd = sd;
+        m_profile = [profile copy];
+        [self setOptions:m_sd];
+    }
+    return self;
+}
+//}}}
+// - (void)setOptions:(socket_t)sd;//{{{
+- (void)setOptions:(socket_t)sd
+{
+    SFSocketProfile *profile = m_profile;
+    int blockModeOff = TRUE;
+
+    ioctl(sd, FIONBIO, &blockModeOff);
+
+    /* In the iOS 5 and later, we need to cancel the SIGPIPE signal. */
+    setsockopt(sd, SOL_SOCKET, SO_NOSIGPIPE, &blockModeOff, sizeof(int));
+
+    /* A failed option doesn't stop the socket. It is logged by the profile. */
+    if (profile == nil)
+        profile = [SFSocket defaultProfile];
+    [profile applyToDescriptor:sd];
+}
+//}}}
+// - (void)startAttempt;//{{{
+- (void)startAttempt
+{
+    while ((m_sd < 0) && ([m_addresses count] > 0) && (m_attemptCount < SF_SOCKET_CONNECT_ATTEMPTS))
+    {
+        NSData *address = [[m_addresses objectAtIndex:0] retain];
+        const struct sockaddr *addr = (const struct sockaddr *)[address bytes];
+        char host[NI_MAXHOST], service[NI_MAXSERV];
+        socket_t sd;
+
+        [m_addresses removeObjectAtIndex:0];
+        [address autorelease];
+
+        sd = socket(addr->sa_family, SOCK_STREAM, IPPROTO_TCP);
+        if (sd < 0) {
+            m_attemptError = errno;
+            continue;
+        }
+        [self setOptions:sd];
+
+        if (getnameinfo(addr, (socklen_t)[address length], host, sizeof(host), service, sizeof(service), (NI_NUMERICHOST | NI_NUMERICSERV)) == 0)
+            sfdebug("SFSocket::connect('%s', %s) attempt %d\n", host, service, m_attemptCount + 1);
+
+        if (connect(sd, addr, (socklen_t)[address length]) == 0)
+            m_sd = sd;
+        else if ((errno == EINPROGRESS) || (errno == EWOULDBLOCK))
+        {
+            m_attempts[m_attemptCount++] = sd;
+            m_nextAttempt = [NSDate timeIntervalSinceReferenceDate] + m_attemptDelay;
+            return;
+        }
+        else
+        {
+            m_attemptError = errno;
+            close(sd);
+        }
+    }
+}
+//}}}
+// - (error_t)advanceAttempts;//{{{
+- (error_t)advanceAttempts
+{
+    struct pollfd fds[SF_SOCKET_CONNECT_ATTEMPTS];
+    BOOL failed = NO;
+    int index, kept = 0;
+
+    for (index = 0; index < m_attemptCount; ++index) {
+        fds[index].fd = m_attempts[index];
+        fds[index].events = POLLOUT;
+        fds[index].revents = 0;
+    }
+
+    if ((m_attemptCount > 0) && (poll(fds, (nfds_t)m_attemptCount, 0) > 0))
+    {
+        for (index = 0; index < m_attemptCount; ++index)
+        {
+            int value = 0;
+            socklen_t size = sizeof(int);
+
+            if (fds[index].revents == 0) {
+                m_attempts[kept++] = fds[index].fd;
+                continue;
+            }
+
+            if (getsockopt(fds[index].fd, SOL_SOCKET, SO_ERROR, &value, &size) < 0)
+                value = errno;
+
+            /* The first to succeed is kept. */
+            if ((value == 0) && (m_sd < 0)) {
+                m_sd = fds[index].fd;
+                continue;
+            }
+
+            close(fds[index].fd);
+            if (value != 0) {
+                m_attemptError = value;
+                failed = YES;
+            }
+        }
+        m_attemptCount = kept;
+    }
+
+    /* A failure doesn't wait for the delay to try the next address. */
+    if ((m_sd < 0) && (failed || (m_attemptCount == 0) || ([NSDate timeIntervalSinceReferenceDate] >= m_nextAttempt)))
+        [self startAttempt];
+
+    if (m_sd >= 0) {
+        [self cancelAttempts];
+        return m_error = 0;
+    }
+    if ((m_attemptCount == 0) && ([m_addresses count] == 0)) {
+        [self cancelAttempts];
+        return m_error = m_attemptError;
+    }
+    return m_error = EINPROGRESS;
+}
+//}}}
+// - (void)cancelAttempts;//{{{
+- (void)cancelAttempts
+{
+    while (m_attemptCount > 0)
+        close(m_attempts[--m_attemptCount]);
+
+    [m_addresses release];
+    m_addresses = nil;
+}
+//}}}
+// - (ssize_t)receive:(void *)buffer length:(size_t)size;//{{{
+- (ssize_t)receive:(void *)buffer length:(size_t)size
+{
+    ssize_t received;
+
+    do {
+        received = recv(m_sd, buffer, size, 0);
+        m_receiveCalls++;
+    } while ((received < 0) && (errno == EINTR));
+
+    if (received > 0)
+        m_bytesReceived += (uint64_t)received;
+    return received;
+}
+//}}}
+// - (ssize_t)writeBuffers:(const struct iovec *)buffers count:(int)count;//{{{
+- (ssize_t)writeBuffers:(const struct iovec *)buffers count:(int)count
+{
+    ssize_t sent;
+
+    do {
+        sent = writev(m_sd, buffers, count);
+        m_sendCalls++;
+    } while ((sent < 0) && (errno == EINTR));
+
+    if (sent > 0)
+        m_bytesSent += (uint64_t)sent;
+    return sent;
+}
+//}}}
+// - (ssize_t)sendFilePart:(SFSocketFile *)part requested:(size_t *)requested;//{{{
+- (ssize_t)sendFilePart:(SFSocketFile *)part requested:(size_t *)requested
+{
+    uint8_t buffer[SF_SOCKET_FILE_BUFFER];
+    int     fd = [part->file fileDescriptor];
+    off_t   offset = part->offset + (off_t)m_sent;
+    size_t  remain = part->length - m_sent;
+    ssize_t count;
+
+#if defined(__APPLE__)
+    off_t length;
+    int   result;
+
+    *requested = remain;
+    do {
+        length = (off_t)remain;
+        result = sendfile(fd, m_sd, offset, &length, NULL, 0);
+        m_sendCalls++;
+    } while ((result < 0) && (errno == EINTR) && (length == 0));
+
+    /* On a non-blocking socket a partial send fails with EAGAIN, but the
+     * bytes were sent anyway. */
+    if (length > 0) {
+        m_bytesSent += (uint64_t)length;
+        return (ssize_t)length;
+    }
+    if (result == 0) {
+        errno = EIO;                /* The file is shorter than queued. */
+        return -1;
+    }
+    if ((errno != ENOTSUP) && (errno != EOPNOTSUPP) && (errno != ENOTSOCK) && (errno != EINVAL))
+        return -1;
+
+    /* Not a regular file. Falls back to the copy below. */
+#endif
+    do {
+        count = pread(fd, buffer, MIN(remain, sizeof(buffer)), offset);
+    } while ((count < 0) && (errno == EINTR));
+
+    if (count <= 0) {
+        if (count == 0) errno = EIO;
+        return -1;
+    }
+
+    struct iovec iov = { buffer, (size_t)count };
+    *requested = (size_t)count;
+    return [self writeBuffers:&iov count:1];
+}
+//}}}
+// - (void)adaptReadSize:(size_t)received;//{{{
+- (void)adaptReadSize:(size_t)received
+{
+    if ((received == m_readSize) && (m_readSize < SF_SOCKET_READ_SIZE_MAX))
+        m_readSize <<= 1;
+    else if ((received < (m_readSize >> 2)) && (m_readSize > SF_SOCKET_READ_SIZE))
+        m_readSize >>= 1;
+}
+//}}}
+// - (void)appendItem:(id)item;//{{{
+- (void)appendItem:(id)item
+{
+    if (m_queue == nil)
+        m_queue = [[NSMutableArray alloc] init];
+
+    [m_queue addObject:item];
+    m_queued += [item length];
+}
+//}}}
+// - (void)consumeBytes:(size_t)count;//{{{
+- (void)consumeBytes:(size_t)count
+{
+    m_queued -= count;
+    count += m_sent;
+
+    while (count > 0)
+    {
+        size_t length = [[m_queue objectAtIndex:0] length];
+
+        if (count < length) break;
+        [m_queue removeObjectAtIndex:0];
+        count -= length;
+    }
+    m_sent = count;
+}
+//}}}
+// - (void)checkWatermarks;//{{{
+- (void)checkWatermarks
+{
+    if (!m_congested && (m_queued > m_highWatermark))
+        m_congested = YES;
+    else if (m_congested && (m_queued <= m_lowWatermark))
+        m_congested = NO;
+    else
+        return;
+
+    if (m_watermarkTarget != nil)
+        [m_watermarkTarget performSelector:m_watermarkAction withObject:self];
+}
+//}}}
 @end
 // vim:syntax=objc.doxygen
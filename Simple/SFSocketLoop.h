@@ -0,0 +1,253 @@
+/**
+ * \file
+ * Declares the SFSocketLoop Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "sfstd.h"
+#import "SFSocket.h"
+
+@class SFSocketLoop;
+
+/**
+ * \ingroup sf_networking
+ * Callbacks of an SFSocketLoop.
+ * All methods are optional and are called in the thread running the loop.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@protocol SFSocketLoopDelegate <NSObject>
+@optional
+// - (void)socketLoop:(SFSocketLoop *)loop didConnect:(SFSocket *)socket;//{{{
+/**
+ * The socket is connected.
+ * Called once for each socket, in its first writable event: when a
+ * connection started with SFSocket::open:port: completes or right after a
+ * socket already connected is added.
+ * @param loop The loop.
+ * @param socket The socket connected.
+ **/
+- (void)socketLoop:(SFSocketLoop *)loop didConnect:(SFSocket *)socket;
+//}}}
+// - (void)socketLoop:(SFSocketLoop *)loop didAccept:(SFSocket *)socket from:(SFSocket *)listener;//{{{
+/**
+ * A connection was accepted by a listening socket.
+ * The new socket is already registered in the loop.
+ * @param loop The loop.
+ * @param socket The new connection.
+ * @param listener The listening socket.
+ * @since 2.1
+ **/
+- (void)socketLoop:(SFSocketLoop *)loop didAccept:(SFSocket *)socket from:(SFSocket *)listener;
+//}}}
+// - (void)socketLoop:(SFSocketLoop *)loop didReceive:(SFSocket *)socket;//{{{
+/**
+ * Data was received.
+ * All data available was already read into SFSocket::inputStream. Consume
+ * what is needed and purge the stream when convenient.
+ * @param loop The loop.
+ * @param socket The socket that received data.
+ **/
+- (void)socketLoop:(SFSocketLoop *)loop didReceive:(SFSocket *)socket;
+//}}}
+// - (void)socketLoop:(SFSocketLoop *)loop canSend:(SFSocket *)socket;//{{{
+/**
+ * The socket has room for more data in its sending buffer.
+ * Called once after the connection and then each time room is made after
+ * the buffer was full. Since version 2.1 the loop first sends the
+ * SFSocket write queue and calls this method only when the queue is empty.
+ * @param loop The loop.
+ * @param socket The socket ready to send.
+ **/
+- (void)socketLoop:(SFSocketLoop *)loop canSend:(SFSocket *)socket;
+//}}}
+// - (void)socketLoop:(SFSocketLoop *)loop didClose:(SFSocket *)socket error:(error_t)error;//{{{
+/**
+ * The connection was closed or could not be made.
+ * The socket was already removed from the loop and closed. Data received
+ * before the end is still in SFSocket::inputStream.
+ * @param loop The loop.
+ * @param socket The socket closed.
+ * @param error Zero when the peer closed the connection. Otherwise the
+ * error that ended it.
+ **/
+- (void)socketLoop:(SFSocketLoop *)loop didClose:(SFSocket *)socket error:(error_t)error;
+//}}}
+@end
+
+/**
+ * \ingroup sf_networking
+ * Multiplexes many sockets in a single thread.
+ * Sockets are registered in a kernel queue (\c kqueue) in edge triggered
+ * mode (\c EV_CLEAR), so the loop is woken only when something changes and
+ * the cost doesn't grow with the number of idle sockets. When a socket is
+ * readable, the loop reads everything available straight into its
+ * SFSocket::inputStream, with SFSocket::readIntoStream:, and then calls the
+ * delegate.
+ *
+ * The loop runs in a thread of its own, started by #start, or in the caller
+ * thread with #pollWithTimeout:. Sockets and timers can be added and removed
+ * from any thread. Changes requested from other threads are applied by the
+ * loop thread in its next iteration.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFSocketLoop : NSObject
+/** @name Properties */ //@{
+// @property (nonatomic, assign) id<SFSocketLoopDelegate> delegate;//{{{
+/**
+ * Gets or sets the object that receives the callbacks.
+ * It is not retained. Set it before starting the loop.
+ **/
+@property (nonatomic, assign) id<SFSocketLoopDelegate> delegate;
+//}}}
+// @property (nonatomic, readonly) NSUInteger numberOfSockets;//{{{
+/**
+ * Gets the number of sockets registered.
+ * Changes not yet applied by the loop thread are not counted.
+ **/
+@property (nonatomic, readonly) NSUInteger numberOfSockets;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfAccepts;//{{{
+/**
+ * Gets the number of connections accepted by the listening sockets of this
+ * loop.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfAccepts;
+//}}}
+// @property (nonatomic) NSInteger processor;//{{{
+/**
+ * Gets or sets the processor preferred by the loop thread.
+ * Applied when the thread starts, as an affinity tag: loops with different
+ * values are kept on different cores when the system can. -1, the default,
+ * leaves the choice to the system.
+ **/
+@property (nonatomic) NSInteger processor;
+//}}}
+// @property (nonatomic, readonly, getter=isRunning) BOOL running;//{{{
+/**
+ * Gets whether the loop thread is running.
+ **/
+@property (nonatomic, readonly, getter=isRunning) BOOL running;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)init;//{{{
+/**
+ * Initializes the object.
+ * @return This object initialized. \b nil when the kernel queue cannot be
+ * created.
+ **/
+- (instancetype)init;
+//}}}
+//@}
+
+/** @name Sockets */ //@{
+// - (BOOL)addSocket:(SFSocket *)socket;//{{{
+/**
+ * Registers a socket in the loop.
+ * The socket must be connected or connecting, as after SFSocket::open:port:
+ * returned \c EINPROGRESS, or listening. Connections of a listening socket
+ * are accepted and registered by the loop. When the connection completes the delegate
+ * receives \c socketLoop:didConnect:. A failed connection is reported
+ * with \c socketLoop:didClose:error:.
+ * @param socket The socket. It is retained until removed or closed.
+ * @return \b YES when the socket will be registered. \b NO when it is not
+ * open.
+ **/
+- (BOOL)addSocket:(SFSocket *)socket;
+//}}}
+// - (void)connectSocket:(SFSocket *)socket toHost:(NSString *)host port:(NSUInteger)port;//{{{
+/**
+ * Connects a socket to a host name without blocking, and registers it.
+ * The name is resolved in background by SFResolver::sharedResolver. Then
+ * the loop thread opens the connection and registers the socket, as
+ * #addSocket:. When the name has many addresses, IPv4 and IPv6, they are
+ * raced as in SFSocket::openAddresses:, and the socket is registered when
+ * one of them connects. The loop checks the race every 50 ms. The delegate
+ * receives \c socketLoop:didConnect: when the connection completes or \c
+ * socketLoop:didClose:error: when the name could not be resolved or all the
+ * addresses failed.
+ * @param socket The socket. It must not be open. It is retained until
+ * removed or closed.
+ * @param host The name or numeric address of the peer.
+ * @param port The port of the peer.
+ * @since 2.1
+ **/
+- (void)connectSocket:(SFSocket *)socket toHost:(NSString *)host port:(NSUInteger)port;
+//}}}
+// - (void)removeSocket:(SFSocket *)socket;//{{{
+/**
+ * Removes a socket from the loop.
+ * The socket is not closed.
+ * @param socket The socket to remove.
+ **/
+- (void)removeSocket:(SFSocket *)socket;
+//}}}
+//@}
+
+/** @name Timers */ //@{
+// - (uintptr_t)scheduleTimer:(NSTimeInterval)interval repeats:(BOOL)repeats target:(id)target selector:(SEL)action;//{{{
+/**
+ * Schedules a timer in the loop.
+ * @param interval Seconds until the timer fires.
+ * @param repeats \b YES to fire every \a interval seconds, until cancelled.
+ * \b NO to fire once.
+ * @param target The object to call. It is retained until the timer ends.
+ * @param action The selector to call. Must accept a single argument that is
+ * this loop.
+ * @return The timer identifier. Never zero.
+ **/
+- (uintptr_t)scheduleTimer:(NSTimeInterval)interval repeats:(BOOL)repeats target:(id)target selector:(SEL)action;
+//}}}
+// - (void)cancelTimer:(uintptr_t)timer;//{{{
+/**
+ * Cancels a timer.
+ * When called in the loop thread the timer doesn't fire anymore, even if
+ * it is already due.
+ * @param timer The identifier returned by
+ * #scheduleTimer:repeats:target:selector:.
+ **/
+- (void)cancelTimer:(uintptr_t)timer;
+//}}}
+//@}
+
+/** @name Running */ //@{
+// - (BOOL)start;//{{{
+/**
+ * Starts a thread that runs the loop until #stop is called.
+ * The thread retains the loop while running.
+ * @return \b YES when the thread was started. \b NO when it is already
+ * running.
+ **/
+- (BOOL)start;
+//}}}
+// - (void)stop;//{{{
+/**
+ * Stops the loop thread.
+ * When called from another thread, waits until the loop thread ends.
+ **/
+- (void)stop;
+//}}}
+// - (NSInteger)pollWithTimeout:(NSTimeInterval)timeout;//{{{
+/**
+ * Runs one iteration of the loop in the caller thread.
+ * Don't use while the loop thread is running.
+ * @param timeout Greatest number of seconds to wait for events. A negative
+ * value waits until an event arrives.
+ * @return The number of events handled. -1 when the kernel queue failed.
+ **/
+- (NSInteger)pollWithTimeout:(NSTimeInterval)timeout;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
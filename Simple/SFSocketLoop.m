@@ -0,0 +1,838 @@
+/**
+ * \file
+ * Defines the SFSocketLoop Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFSocketLoop.h"
+#import "SFResolver.h"
+#import "sfdebug.h"
+
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/socket.h>
+#include <sys/errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+
+/**
+ * Greatest number of events handled in one iteration.
+ **/
+#define SF_SOCKET_LOOP_EVENTS       256
+
+/**
+ * Conditions of the state lock.
+ **/
+#define SF_SOCKET_LOOP_IDLE         0
+#define SF_SOCKET_LOOP_RUNNING      1
+
+/**
+ * Identifier of the timer that advances connections racing many addresses.
+ * Timers scheduled by the user start at 1.
+ **/
+#define SF_SOCKET_LOOP_CONNECT_TIMER    0
+
+/**
+ * Microseconds between checks of connections racing many addresses.
+ **/
+#define SF_SOCKET_LOOP_CONNECT_INTERVAL 50000
+
+/* ===========================================================================
+ * SFSocketLoopEntry INTERFACE
+ * ======================================================================== */
+/**
+ * One socket registered in the loop. Used as the event user data.
+ **/
+@interface SFSocketLoopEntry : NSObject {
+@public
+    SFSocket *socket;
+    socket_t  sd;
+    BOOL      listening;
+    BOOL      connected;            /* The first writable event was seen.   */
+    BOOL      closed;               /* Events still queued are ignored.     */
+}
+@end
+
+@implementation SFSocketLoopEntry
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [socket release];
+    [super dealloc];
+}
+//}}}
+@end
+
+/* ===========================================================================
+ * SFSocketLoopConnect INTERFACE
+ * ======================================================================== */
+/**
+ * A connection whose name was resolved, waiting for the loop thread.
+ **/
+@interface SFSocketLoopConnect : NSObject {
+@public
+    SFSocket *socket;
+    NSArray  *addresses;
+    error_t   error;
+}
+@end
+
+@implementation SFSocketLoopConnect
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [socket release];
+    [addresses release];
+    [super dealloc];
+}
+//}}}
+@end
+
+/* ===========================================================================
+ * SFSocketLoopTimer INTERFACE
+ * ======================================================================== */
+/**
+ * One timer scheduled in the loop. Used as the event user data.
+ **/
+@interface SFSocketLoopTimer : NSObject {
+@public
+    id        target;
+    SEL       action;
+    uintptr_t ident;
+    int64_t   interval;             /* Microseconds.                        */
+    BOOL      repeats;
+    BOOL      cancelled;
+}
+@end
+
+@implementation SFSocketLoopTimer
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [target release];
+    [super dealloc];
+}
+//}}}
+@end
+
+/* ===========================================================================
+ * SFSocketLoop EXTENSION
+ * ======================================================================== */
+@interface SFSocketLoop () {
+    int m_kq;
+    id<SFSocketLoopDelegate> m_delegate;
+    NSLock *m_lock;                 /* Guards the pending changes.          */
+    NSMutableArray *m_added;
+    NSMutableArray *m_removed;
+    NSMutableArray *m_resolved;
+    NSMutableArray *m_scheduled;
+    NSMutableArray *m_cancelled;
+    uintptr_t m_nextTimer;
+    volatile BOOL m_dirty;
+    NSMutableDictionary *m_entries; /* Loop thread only.                    */
+    NSMutableDictionary *m_timers;  /* Loop thread only.                    */
+    NSMutableArray *m_racing;       /* Loop thread only. See openAddresses:. */
+    volatile NSUInteger m_count;
+    volatile uint64_t m_accepts;
+    NSInteger m_processor;
+    NSThread *m_thread;
+    NSConditionLock *m_state;
+    volatile BOOL m_stopping;
+    pthread_t m_owner;              /* Thread inside pollWithTimeout:.      */
+}
+// - (void)wake;//{{{
+/**
+ * Applies the pending changes now when called in the loop thread. Otherwise
+ * wakes the loop thread to apply them.
+ **/
+- (void)wake;
+//}}}
+// - (void)applyChanges;//{{{
+/**
+ * Registers and removes the sockets and timers requested.
+ **/
+- (void)applyChanges;
+//}}}
+// - (void)registerSocket:(SFSocket *)socket;//{{{
+/**
+ * Adds a socket in the kernel queue.
+ **/
+- (void)registerSocket:(SFSocket *)socket;
+//}}}
+// - (void)connect:(SFSocketLoopConnect *)pending;//{{{
+/**
+ * Opens the connection of a resolved name. When the name has many addresses
+ * they are raced with SFSocket::openAddresses:. The socket has no
+ * descriptor while it races, so it is kept apart and registered when the
+ * race is won.
+ **/
+- (void)connect:(SFSocketLoopConnect *)pending;
+//}}}
+// - (void)advanceConnections;//{{{
+/**
+ * Advances the races of the connections started by #connect:.
+ **/
+- (void)advanceConnections;
+//}}}
+// - (void)unregister:(SFSocketLoopEntry *)entry;//{{{
+/**
+ * Forgets a socket. Events already queued for it are ignored.
+ **/
+- (void)unregister:(SFSocketLoopEntry *)entry;
+//}}}
+// - (void)closeEntry:(SFSocketLoopEntry *)entry error:(error_t)error;//{{{
+/**
+ * Forgets and closes a socket, then calls the delegate.
+ **/
+- (void)closeEntry:(SFSocketLoopEntry *)entry error:(error_t)error;
+//}}}
+// - (void)receive:(SFSocketLoopEntry *)entry finished:(BOOL)eof;//{{{
+/**
+ * Reads everything available into the socket input stream.
+ **/
+- (void)receive:(SFSocketLoopEntry *)entry finished:(BOOL)eof;
+//}}}
+// - (void)acceptFrom:(SFSocketLoopEntry *)entry;//{{{
+/**
+ * Accepts and registers all pending connections of a listening socket.
+ **/
+- (void)acceptFrom:(SFSocketLoopEntry *)entry;
+//}}}
+// - (void)writable:(SFSocketLoopEntry *)entry;//{{{
+/**
+ * Completes a connection, flushes the write queue or tells the delegate it
+ * can send.
+ **/
+- (void)writable:(SFSocketLoopEntry *)entry;
+//}}}
+// - (void)fire:(SFSocketLoopTimer *)timer;//{{{
+/**
+ * Calls the target of a timer.
+ **/
+- (void)fire:(SFSocketLoopTimer *)timer;
+//}}}
+// - (void)threadMain:(id)unused;//{{{
+/**
+ * Body of the loop thread.
+ **/
+- (void)threadMain:(id)unused;
+//}}}
+@end
+
+/* ===========================================================================
+ * SFSocketLoop IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFSocketLoop
+// Properties
+// @property (nonatomic, assign) id<SFSocketLoopDelegate> delegate;//{{{
+@synthesize delegate = m_delegate;
+//}}}
+// @property (nonatomic, readonly) NSUInteger numberOfSockets;//{{{
+- (NSUInteger)numberOfSockets {
+    return m_count;
+}
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfAccepts;//{{{
+- (uint64_t)numberOfAccepts {
+    return m_accepts;
+}
+//}}}
+// @property (nonatomic) NSInteger processor;//{{{
+@synthesize processor = m_processor;
+//}}}
+// @property (nonatomic, readonly, getter=isRunning) BOOL running;//{{{
+- (BOOL)isRunning
+{
+    BOOL running;
+
+    [m_lock lock];
+    running = (m_thread != nil);
+    [m_lock unlock];
+    return running;
+}
+//}}}
+
+// Designated Initializers
+// - (instancetype)init;//{{{
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        struct kevent ev;
+
+        m_lock      = [NSLock new];
+        m_added     = [NSMutableArray new];
+        m_removed   = [NSMutableArray new];
+        m_resolved  = [NSMutableArray new];
+        m_scheduled = [NSMutableArray new];
+        m_cancelled = [NSMutableArray new];
+        m_entries   = [NSMutableDictionary new];
+        m_timers    = [NSMutableDictionary new];
+        m_racing    = [NSMutableArray new];
+        m_state     = [[NSConditionLock alloc] initWithCondition:SF_SOCKET_LOOP_IDLE];
+        m_processor = -1;
+
+        /* The user event wakes the loop when changes are requested. */
+        EV_SET(&ev, 0, EVFILT_USER, (EV_ADD | EV_CLEAR), 0, 0, NULL);
+        if (((m_kq = kqueue()) < 0) || (kevent(m_kq, &ev, 1, NULL, 0, NULL) < 0))
+        {
+            [self release];
+            return nil;
+        }
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    if (m_kq >= 0) close(m_kq);
+
+    [m_lock release];
+    [m_added release];
+    [m_removed release];
+    [m_resolved release];
+    [m_scheduled release];
+    [m_cancelled release];
+    [m_entries release];
+    [m_timers release];
+    [m_racing release];
+    [m_state release];
+    [super dealloc];
+}
+//}}}
+
+// Sockets
+// - (BOOL)addSocket:(SFSocket *)socket;//{{{
+- (BOOL)addSocket:(SFSocket *)socket
+{
+    if ((socket == nil) || ([socket descriptor] < 0))
+        return NO;
+
+    [m_lock lock];
+    [m_added addObject:socket];
+    m_dirty = YES;
+    [m_lock unlock];
+
+    [self wake];
+    return YES;
+}
+//}}}
+// - (void)removeSocket:(SFSocket *)socket;//{{{
+- (void)removeSocket:(SFSocket *)socket
+{
+    if (socket == nil) return;
+
+    [m_lock lock];
+    [m_removed addObject:socket];
+    m_dirty = YES;
+    [m_lock unlock];
+
+    [self wake];
+}
+//}}}
+
+// - (void)connectSocket:(SFSocket *)socket toHost:(NSString *)host port:(NSUInteger)port;//{{{
+- (void)connectSocket:(SFSocket *)socket toHost:(NSString *)host port:(NSUInteger)port
+{
+    [[SFResolver sharedResolver] resolveHost:host port:port completion:^(NSArray *addresses, error_t error) {
+        SFSocketLoopConnect *pending = [[SFSocketLoopConnect alloc] init];
+
+        pending->socket    = [socket retain];
+        pending->addresses = [addresses retain];
+        pending->error     = error;
+
+        [m_lock lock];
+        [m_resolved addObject:pending];
+        m_dirty = YES;
+        [m_lock unlock];
+
+        [pending release];
+        [self wake];
+    }];
+}
+//}}}
+
+// Timers
+// - (uintptr_t)scheduleTimer:(NSTimeInterval)interval repeats:(BOOL)repeats target:(id)target selector:(SEL)action;//{{{
+- (uintptr_t)scheduleTimer:(NSTimeInterval)interval repeats:(BOOL)repeats target:(id)target selector:(SEL)action
+{
+    SFSocketLoopTimer *timer = [[SFSocketLoopTimer alloc] init];
+    uintptr_t ident;
+
+    timer->target   = [target retain];
+    timer->action   = action;
+    timer->repeats  = repeats;
+    timer->interval = (int64_t)(((interval > 0.0) ? interval : 0.0) * 1e6);
+
+    [m_lock lock];
+    ident = timer->ident = ++m_nextTimer;
+    [m_scheduled addObject:timer];
+    m_dirty = YES;
+    [m_lock unlock];
+
+    [timer release];
+    [self wake];
+    return ident;
+}
+//}}}
+// - (void)cancelTimer:(uintptr_t)timer;//{{{
+- (void)cancelTimer:(uintptr_t)timer
+{
+    [m_lock lock];
+    [m_cancelled addObject:[NSNumber numberWithUnsignedLong:timer]];
+    m_dirty = YES;
+    [m_lock unlock];
+
+    [self wake];
+}
+//}}}
+
+// Running
+// - (BOOL)start;//{{{
+- (BOOL)start
+{
+    [m_lock lock];
+    if (m_thread != nil) {
+        [m_lock unlock];
+        return NO;
+    }
+
+    [m_state lock];
+    [m_state unlockWithCondition:SF_SOCKET_LOOP_RUNNING];
+
+    m_stopping = NO;
+    m_thread = [[NSThread alloc] initWithTarget:self selector:@selector(threadMain:) object:nil];
+    [m_thread setName:@"SFSocketLoop"];
+    [m_thread start];
+    [m_lock unlock];
+    return YES;
+}
+//}}}
+// - (void)stop;//{{{
+- (void)stop
+{
+    NSThread *thread;
+
+    [m_lock lock];
+    m_stopping = YES;
+    thread = [[m_thread retain] autorelease];
+    [m_lock unlock];
+
+    if (thread == nil) return;
+
+    [self wake];
+    if ([NSThread currentThread] != thread)
+    {
+        [m_state lockWhenCondition:SF_SOCKET_LOOP_IDLE];
+        [m_state unlock];
+    }
+}
+//}}}
+// - (NSInteger)pollWithTimeout:(NSTimeInterval)timeout;//{{{
+- (NSInteger)pollWithTimeout:(NSTimeInterval)timeout
+{
+    struct kevent events[SF_SOCKET_LOOP_EVENTS];
+    struct timespec ts, *pts = NULL;
+    int count, i;
+
+    if (timeout >= 0.0)
+    {
+        ts.tv_sec  = (time_t)timeout;
+        ts.tv_nsec = (long)((timeout - (double)ts.tv_sec) * 1e9);
+        pts = &ts;
+    }
+
+    @autoreleasepool
+    {
+        m_owner = pthread_self();
+        if (m_dirty) [self applyChanges];
+
+        count = kevent(m_kq, NULL, 0, events, SF_SOCKET_LOOP_EVENTS, pts);
+        if (count < 0)
+            count = ((errno == EINTR) ? 0 : -1);
+
+        for (i = 0; i < count; ++i)
+        {
+            struct kevent *ev = &events[i];
+            SFSocketLoopEntry *entry = (SFSocketLoopEntry *)ev->udata;
+
+            switch (ev->filter)
+            {
+            case EVFILT_TIMER:
+                if (ev->ident == SF_SOCKET_LOOP_CONNECT_TIMER)
+                    [self advanceConnections];
+                else
+                    [self fire:(SFSocketLoopTimer *)ev->udata];
+                break;
+            case EVFILT_READ:
+                if (entry->listening)
+                    [self acceptFrom:entry];
+                else if (!entry->closed)
+                    [self receive:entry finished:((ev->flags & EV_EOF) != 0)];
+                break;
+            case EVFILT_WRITE:
+                if (!entry->closed)
+                    [self writable:entry];
+                break;
+            default:                /* EVFILT_USER: changes are applied below. */
+                break;
+            }
+        }
+
+        if (m_dirty) [self applyChanges];
+        m_owner = NULL;
+    }
+    return count;
+}
+//}}}
+
+// Local Operations
+// - (void)wake;//{{{
+- (void)wake
+{
+    struct kevent ev;
+
+    if ((m_owner != NULL) && pthread_equal(m_owner, pthread_self()))
+    {
+        [self applyChanges];
+        return;
+    }
+
+    EV_SET(&ev, 0, EVFILT_USER, 0, NOTE_TRIGGER, 0, NULL);
+    kevent(m_kq, &ev, 1, NULL, 0, NULL);
+}
+//}}}
+// - (void)applyChanges;//{{{
+- (void)applyChanges
+{
+    NSArray *added, *removed, *resolved, *scheduled, *cancelled;
+    struct kevent ev;
+
+    [m_lock lock];
+    added     = [[m_added copy] autorelease];
+    removed   = [[m_removed copy] autorelease];
+    resolved  = [[m_resolved copy] autorelease];
+    scheduled = [[m_scheduled copy] autorelease];
+    cancelled = [[m_cancelled copy] autorelease];
+    [m_added removeAllObjects];
+    [m_removed removeAllObjects];
+    [m_resolved removeAllObjects];
+    [m_scheduled removeAllObjects];
+    [m_cancelled removeAllObjects];
+    m_dirty = NO;
+    [m_lock unlock];
+
+    for (SFSocket *socket in added)
+        [self registerSocket:socket];
+
+    for (SFSocketLoopConnect *pending in resolved)
+        [self connect:pending];
+
+    for (SFSocket *socket in removed)
+    {
+        SFSocketLoopEntry *entry = [m_entries objectForKey:[NSValue valueWithPointer:socket]];
+
+        if ([m_racing indexOfObjectIdenticalTo:socket] != NSNotFound)
+        {
+            /* Not closed: the caller can go on with isReady. */
+            [m_racing removeObjectIdenticalTo:socket];
+            if ([m_racing count] == 0) {
+                EV_SET(&ev, SF_SOCKET_LOOP_CONNECT_TIMER, EVFILT_TIMER, EV_DELETE, 0, 0, NULL);
+                kevent(m_kq, &ev, 1, NULL, 0, NULL);
+            }
+        }
+        if (entry == nil) continue;
+
+        EV_SET(&ev, entry->sd, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+        kevent(m_kq, &ev, 1, NULL, 0, NULL);
+        EV_SET(&ev, entry->sd, EVFILT_WRITE, EV_DELETE, 0, 0, NULL);
+        kevent(m_kq, &ev, 1, NULL, 0, NULL);
+        [self unregister:entry];
+    }
+
+    for (SFSocketLoopTimer *timer in scheduled)
+    {
+        EV_SET(&ev, timer->ident, EVFILT_TIMER, (EV_ADD | (timer->repeats ? 0 : EV_ONESHOT)),
+               NOTE_USECONDS, timer->interval, timer);
+        if (kevent(m_kq, &ev, 1, NULL, 0, NULL) == 0)
+            [m_timers setObject:timer forKey:[NSNumber numberWithUnsignedLong:timer->ident]];
+    }
+
+    for (NSNumber *key in cancelled)
+    {
+        SFSocketLoopTimer *timer = [m_timers objectForKey:key];
+        if (timer == nil) continue;
+
+        EV_SET(&ev, timer->ident, EVFILT_TIMER, EV_DELETE, 0, 0, NULL);
+        kevent(m_kq, &ev, 1, NULL, 0, NULL);
+
+        /* Kept alive until the events already received are handled. */
+        timer->cancelled = YES;
+        [[timer retain] autorelease];
+        [m_timers removeObjectForKey:key];
+    }
+}
+//}}}
+// - (void)registerSocket:(SFSocket *)socket;//{{{
+- (void)registerSocket:(SFSocket *)socket
+{
+    NSValue *key = [NSValue valueWithPointer:socket];
+    SFSocketLoopEntry *entry;
+    struct kevent changes[2];
+
+    if (([m_entries objectForKey:key] != nil) || ([socket descriptor] < 0))
+        return;
+
+    entry = [[[SFSocketLoopEntry alloc] init] autorelease];
+    entry->socket = [socket retain];
+    entry->sd = [socket descriptor];
+    entry->listening = [socket isListening];
+
+    EV_SET(&changes[0], entry->sd, EVFILT_READ, (EV_ADD | EV_CLEAR), 0, 0, entry);
+    EV_SET(&changes[1], entry->sd, EVFILT_WRITE, (EV_ADD | EV_CLEAR), 0, 0, entry);
+
+    [m_entries setObject:entry forKey:key];
+    m_count = [m_entries count];
+
+    /* Listening sockets are never writable. */
+    if (kevent(m_kq, changes, (entry->listening ? 1 : 2), NULL, 0, NULL) < 0)
+        [self closeEntry:entry error:errno];
+}
+//}}}
+// - (void)connect:(SFSocketLoopConnect *)pending;//{{{
+- (void)connect:(SFSocketLoopConnect *)pending
+{
+    SFSocket *socket = pending->socket;
+    error_t error = pending->error;
+    struct kevent ev;
+
+    if ((error == 0) && ([pending->addresses count] == 1))
+        error = [socket openAddress:[pending->addresses objectAtIndex:0]];
+    else if (error == 0)
+        error = [socket openAddresses:pending->addresses];
+
+    /* A single address connects in the descriptor registered. */
+    if ((error == 0) || ((error == EINPROGRESS) && ([socket descriptor] >= 0)))
+    {
+        [self registerSocket:socket];
+        return;
+    }
+
+    if (error != EINPROGRESS)
+    {
+        if ([m_delegate respondsToSelector:@selector(socketLoop:didClose:error:)])
+            [m_delegate socketLoop:self didClose:socket error:error];
+        return;
+    }
+
+    /* The attempts are private to the socket. A timer drives the race. */
+    if ([m_racing count] == 0)
+    {
+        EV_SET(&ev, SF_SOCKET_LOOP_CONNECT_TIMER, EVFILT_TIMER, EV_ADD, NOTE_USECONDS,
+               SF_SOCKET_LOOP_CONNECT_INTERVAL, NULL);
+        if (kevent(m_kq, &ev, 1, NULL, 0, NULL) < 0)
+        {
+            error = errno;
+            [socket close];
+            if ([m_delegate respondsToSelector:@selector(socketLoop:didClose:error:)])
+                [m_delegate socketLoop:self didClose:socket error:error];
+            return;
+        }
+    }
+    [m_racing addObject:socket];
+}
+//}}}
+// - (void)advanceConnections;//{{{
+- (void)advanceConnections
+{
+    NSArray *racing = [[m_racing copy] autorelease];
+    struct kevent ev;
+
+    for (SFSocket *socket in racing)
+    {
+        error_t error = [socket isReady];
+
+        if (error == EINPROGRESS)
+            continue;
+
+        [[socket retain] autorelease];
+        [m_racing removeObjectIdenticalTo:socket];
+
+        /* The connected socket is writable: didConnect: follows. */
+        if (error == 0)
+            [self registerSocket:socket];
+        else if ([m_delegate respondsToSelector:@selector(socketLoop:didClose:error:)])
+            [m_delegate socketLoop:self didClose:socket error:error];
+    }
+
+    if ([m_racing count] == 0) {
+        EV_SET(&ev, SF_SOCKET_LOOP_CONNECT_TIMER, EVFILT_TIMER, EV_DELETE, 0, 0, NULL);
+        kevent(m_kq, &ev, 1, NULL, 0, NULL);
+    }
+}
+//}}}
+// - (void)unregister:(SFSocketLoopEntry *)entry;//{{{
+- (void)unregister:(SFSocketLoopEntry *)entry
+{
+    /* Kept alive until the events already received are handled. */
+    entry->closed = YES;
+    [[entry retain] autorelease];
+    [m_entries removeObjectForKey:[NSValue valueWithPointer:entry->socket]];
+    m_count = [m_entries count];
+}
+//}}}
+// - (void)closeEntry:(SFSocketLoopEntry *)entry error:(error_t)error;//{{{
+- (void)closeEntry:(SFSocketLoopEntry *)entry error:(error_t)error
+{
+    SFSocket *socket = entry->socket;
+
+    [self unregister:entry];
+    [socket close];             /* Removes the events from the queue.   */
+
+    if ([m_delegate respondsToSelector:@selector(socketLoop:didClose:error:)])
+        [m_delegate socketLoop:self didClose:socket error:error];
+}
+//}}}
+// - (void)receive:(SFSocketLoopEntry *)entry finished:(BOOL)eof;//{{{
+- (void)receive:(SFSocketLoopEntry *)entry finished:(BOOL)eof
+{
+    SFSocket *socket = entry->socket;
+    SFStream *stream = [socket inputStream];
+    size_t   start = [stream writePosition];
+    intptr_t result;
+    error_t  error = 0;
+
+    /* Each call reads until the socket is empty. At the end, reads until
+     * the socket tells it. */
+    do {
+        result = [socket readIntoStream:stream];
+    } while ((result > 0) && eof);
+
+    /* A failed call may keep what it read before. */
+    if (([stream writePosition] != start) && [m_delegate respondsToSelector:@selector(socketLoop:didReceive:)])
+        [m_delegate socketLoop:self didReceive:socket];
+
+    if ((result < 0) && !entry->closed)
+    {
+        if ([socket error] != ESHUTDOWN)
+            error = [socket error];
+        [self closeEntry:entry error:error];
+    }
+}
+//}}}
+// - (void)acceptFrom:(SFSocketLoopEntry *)entry;//{{{
+- (void)acceptFrom:(SFSocketLoopEntry *)entry
+{
+    SFSocket *socket;
+
+    /* Other loops may share the listening socket. Who comes first takes
+     * the connection, the others get EWOULDBLOCK. */
+    while (!entry->closed && ((socket = [entry->socket accept]) != nil))
+    {
+        m_accepts++;
+        [self registerSocket:socket];
+
+        if ([m_delegate respondsToSelector:@selector(socketLoop:didAccept:from:)])
+            [m_delegate socketLoop:self didAccept:socket from:entry->socket];
+    }
+}
+//}}}
+// - (void)writable:(SFSocketLoopEntry *)entry;//{{{
+- (void)writable:(SFSocketLoopEntry *)entry
+{
+    if (!entry->connected)
+    {
+        int value = 0;
+        socklen_t size = sizeof(int);
+
+        if (getsockopt(entry->sd, SOL_SOCKET, SO_ERROR, &value, &size) < 0)
+            value = errno;
+
+        if (value != 0) {
+            [self closeEntry:entry error:value];
+            return;
+        }
+
+        entry->connected = YES;
+        if ([m_delegate respondsToSelector:@selector(socketLoop:didConnect:)])
+            [m_delegate socketLoop:self didConnect:entry->socket];
+
+        if (entry->closed) return;
+    }
+
+    /* The write queue goes first. The delegate is called when it is empty. */
+    if ([entry->socket queuedBytes] > 0)
+    {
+        if ([entry->socket flush] < 0) {
+            [self closeEntry:entry error:[entry->socket error]];
+            return;
+        }
+        if ([entry->socket queuedBytes] > 0) return;
+    }
+
+    if ([m_delegate respondsToSelector:@selector(socketLoop:canSend:)])
+        [m_delegate socketLoop:self canSend:entry->socket];
+}
+//}}}
+// - (void)fire:(SFSocketLoopTimer *)timer;//{{{
+- (void)fire:(SFSocketLoopTimer *)timer
+{
+    if (timer->cancelled) return;
+
+    /* Retained while the target runs: it can cancel the timer. */
+    [[timer retain] autorelease];
+    if (!timer->repeats)
+    {
+        timer->cancelled = YES;
+        [m_timers removeObjectForKey:[NSNumber numberWithUnsignedLong:timer->ident]];
+    }
+    [timer->target performSelector:timer->action withObject:self];
+}
+//}}}
+// - (void)threadMain:(id)unused;//{{{
+- (void)threadMain:(id)unused
+{
+    @autoreleasepool
+    {
+        if (m_processor >= 0)
+        {
+            /* Darwin has no hard pinning. Threads with different tags are
+             * kept on different cores when possible. */
+            thread_affinity_policy_data_t policy = { (integer_t)(m_processor + 1) };
+            thread_policy_set(pthread_mach_thread_np(pthread_self()), THREAD_AFFINITY_POLICY,
+                              (thread_policy_t)&policy, THREAD_AFFINITY_POLICY_COUNT);
+        }
+
+        while (!m_stopping)
+        {
+            if ([self pollWithTimeout:-1.0] < 0)
+                break;
+        }
+
+        [m_lock lock];
+        [m_thread autorelease];
+        m_thread = nil;
+        [m_lock unlock];
+    }
+
+    [m_state lock];
+    [m_state unlockWithCondition:SF_SOCKET_LOOP_IDLE];
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
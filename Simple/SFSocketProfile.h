@@ -0,0 +1,169 @@
+/**
+ * \file
+ * Declares the SFSocketProfile Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "sfstd.h"
+
+/**
+ * \ingroup sf_networking
+ * A set of socket options applied together.
+ * SFSocket applies its profile when it opens a connection, starts listening
+ * or accepts one. Every option has a value that keeps the system default:
+ * \b NO for flags and zero for sizes and times. So a profile only changes
+ * what it sets.
+ *
+ * Options the system doesn't have are ignored: #quickAck and
+ * #busyPollTime are Linux only. #userTimeout uses \c TCP_USER_TIMEOUT on
+ * Linux and \c TCP_RXT_CONNDROPTIME on Darwin.
+ *
+ * Presets are available by name through #profileNamed:. Objects are
+ * mutable: change a preset to build a custom profile.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFSocketProfile : NSObject <NSCopying>
+/** @name Properties */ //@{
+// @property (nonatomic, copy) NSString *name;//{{{
+/**
+ * Gets or sets the name of the profile. Only informative.
+ **/
+@property (nonatomic, copy) NSString *name;
+//}}}
+// @property (nonatomic) BOOL noDelay;//{{{
+/**
+ * Gets or sets whether the Nagle algorithm is disabled, with \c TCP_NODELAY.
+ * Small writes are sent right away instead of waiting for the
+ * acknowledgment of the data in flight.
+ **/
+@property (nonatomic) BOOL noDelay;
+//}}}
+// @property (nonatomic) BOOL quickAck;//{{{
+/**
+ * Gets or sets whether received data is acknowledged right away, with \c
+ * TCP_QUICKACK. Linux only.
+ **/
+@property (nonatomic) BOOL quickAck;
+//}}}
+// @property (nonatomic) int sendBufferSize;//{{{
+/**
+ * Gets or sets the size of the kernel send buffer, with \c SO_SNDBUF.
+ * Zero keeps the system default.
+ **/
+@property (nonatomic) int sendBufferSize;
+//}}}
+// @property (nonatomic) int receiveBufferSize;//{{{
+/**
+ * Gets or sets the size of the kernel receive buffer, with \c SO_RCVBUF.
+ * Zero keeps the system default.
+ * @remarks The receive window is negotiated in the handshake. Sizes above
+ * 64 KB are fully used only when set before the connection is made, as
+ * SFSocket does when the profile is set before opening the socket.
+ **/
+@property (nonatomic) int receiveBufferSize;
+//}}}
+// @property (nonatomic) NSUInteger busyPollTime;//{{{
+/**
+ * Gets or sets the number of microseconds a blocking read polls the device
+ * before sleeping, with \c SO_BUSY_POLL. Zero keeps the system default.
+ * Linux only.
+ **/
+@property (nonatomic) NSUInteger busyPollTime;
+//}}}
+// @property (nonatomic) NSTimeInterval userTimeout;//{{{
+/**
+ * Gets or sets the number of seconds sent data can stay unacknowledged
+ * before the connection is dropped. Zero keeps the system default.
+ **/
+@property (nonatomic) NSTimeInterval userTimeout;
+//}}}
+// @property (nonatomic) BOOL keepAlive;//{{{
+/**
+ * Gets or sets whether idle connections are probed, with \c SO_KEEPALIVE.
+ **/
+@property (nonatomic) BOOL keepAlive;
+//}}}
+// @property (nonatomic) NSTimeInterval keepAliveIdle;//{{{
+/**
+ * Gets or sets the number of idle seconds before the first probe.
+ * Used only when #keepAlive is \b YES. Zero keeps the system default.
+ **/
+@property (nonatomic) NSTimeInterval keepAliveIdle;
+//}}}
+// @property (nonatomic) NSTimeInterval keepAliveInterval;//{{{
+/**
+ * Gets or sets the number of seconds between probes not answered.
+ * Used only when #keepAlive is \b YES. Zero keeps the system default.
+ **/
+@property (nonatomic) NSTimeInterval keepAliveInterval;
+//}}}
+// @property (nonatomic) NSUInteger keepAliveCount;//{{{
+/**
+ * Gets or sets the number of probes not answered that drop the connection.
+ * Used only when #keepAlive is \b YES. Zero keeps the system default.
+ **/
+@property (nonatomic) NSUInteger keepAliveCount;
+//}}}
+//@}
+
+/** @name Operations */ //@{
+// - (error_t)applyToDescriptor:(socket_t)sd;//{{{
+/**
+ * Sets the options of this profile in a socket.
+ * All options are set, even when one of them fails.
+ * @param sd The socket descriptor. TCP options are set only in TCP
+ * sockets.
+ * @return Zero on success. Otherwise the error number of the first option
+ * that failed.
+ **/
+- (error_t)applyToDescriptor:(socket_t)sd;
+//}}}
+//@}
+
+/** @name Presets */ //@{
+// + (SFSocketProfile *)defaultProfile;//{{{
+/**
+ * Gets a profile named "default" that keeps all system defaults.
+ * @return A new profile object.
+ **/
++ (SFSocketProfile *)defaultProfile;
+//}}}
+// + (SFSocketProfile *)lowLatencyProfile;//{{{
+/**
+ * Gets a profile named "low-latency", for request and response traffic.
+ * Disables the Nagle algorithm and delayed acknowledgments, polls for 50
+ * microseconds before sleeping and detects dead peers in about 15 seconds.
+ * @return A new profile object.
+ **/
++ (SFSocketProfile *)lowLatencyProfile;
+//}}}
+// + (SFSocketProfile *)bulkThroughputProfile;//{{{
+/**
+ * Gets a profile named "bulk-throughput", for large transfers.
+ * Uses 4 MB kernel buffers and keeps the Nagle algorithm, so writes are
+ * sent in full segments.
+ * @return A new profile object.
+ **/
++ (SFSocketProfile *)bulkThroughputProfile;
+//}}}
+// + (SFSocketProfile *)profileNamed:(NSString *)name;//{{{
+/**
+ * Gets a preset by its name.
+ * @param name One of "default", "low-latency" or "bulk-throughput".
+ * @return A new profile object. \b nil when the name is not known.
+ **/
++ (SFSocketProfile *)profileNamed:(NSString *)name;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,275 @@
+/**
+ * \file
+ * Defines the SFSocketProfile Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFSocketProfile.h"
+#import "sfdebug.h"
+
+#include <sys/errno.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+/** Kernel buffer size of the "bulk-throughput" preset. */
+#define SF_PROFILE_BULK_BUFFER      (4 * 1024 * 1024)
+
+/* ===========================================================================
+ * SFSocketProfile EXTENSION
+ * ======================================================================== */
+@interface SFSocketProfile () {
+    NSString      *m_name;
+    BOOL           m_noDelay;
+    BOOL           m_quickAck;
+    int            m_sendBufferSize;
+    int            m_receiveBufferSize;
+    NSUInteger     m_busyPollTime;
+    NSTimeInterval m_userTimeout;
+    BOOL           m_keepAlive;
+    NSTimeInterval m_keepAliveIdle;
+    NSTimeInterval m_keepAliveInterval;
+    NSUInteger     m_keepAliveCount;
+}
+@end
+
+/* ===========================================================================
+ * SFSocketProfile STATIC FUNCTIONS
+ * ======================================================================== */
+// static error_t SFSocketProfileSet(socket_t sd, int level, int option, int value, error_t result);//{{{
+/**
+ * Sets an integer option.
+ * @return \a result when it is not zero, so the first error is kept.
+ * Otherwise zero or the error of this option.
+ **/
+static error_t SFSocketProfileSet(socket_t sd, int level, int option, int value, error_t result)
+{
+    if (setsockopt(sd, level, option, &value, sizeof(int)) < 0)
+    {
+        sfdebug("SFSocketProfile: option %d failed with %d\n", option, errno);
+        if (result == 0) result = errno;
+    }
+    return result;
+}
+//}}}
+// static BOOL SFSocketProfileIsTCP(socket_t sd);//{{{
+/**
+ * Checks whether a socket is a TCP socket.
+ **/
+static BOOL SFSocketProfileIsTCP(socket_t sd)
+{
+    struct sockaddr_storage addr;
+    socklen_t size = sizeof(addr);
+    int type = 0;
+    socklen_t typeSize = sizeof(int);
+
+    if ((getsockopt(sd, SOL_SOCKET, SO_TYPE, &type, &typeSize) < 0) || (type != SOCK_STREAM))
+        return NO;
+    if (getsockname(sd, (struct sockaddr *)&addr, &size) < 0)
+        return NO;
+    return ((addr.ss_family == AF_INET) || (addr.ss_family == AF_INET6));
+}
+//}}}
+
+/* ===========================================================================
+ * SFSocketProfile IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFSocketProfile
+// Properties
+// @property (nonatomic, copy) NSString *name;//{{{
+@synthesize name = m_name;
+//}}}
+// @property (nonatomic) BOOL noDelay;//{{{
+@synthesize noDelay = m_noDelay;
+//}}}
+// @property (nonatomic) BOOL quickAck;//{{{
+@synthesize quickAck = m_quickAck;
+//}}}
+// @property (nonatomic) int sendBufferSize;//{{{
+@synthesize sendBufferSize = m_sendBufferSize;
+//}}}
+// @property (nonatomic) int receiveBufferSize;//{{{
+@synthesize receiveBufferSize = m_receiveBufferSize;
+//}}}
+// @property (nonatomic) NSUInteger busyPollTime;//{{{
+@synthesize busyPollTime = m_busyPollTime;
+//}}}
+// @property (nonatomic) NSTimeInterval userTimeout;//{{{
+@synthesize userTimeout = m_userTimeout;
+//}}}
+// @property (nonatomic) BOOL keepAlive;//{{{
+@synthesize keepAlive = m_keepAlive;
+//}}}
+// @property (nonatomic) NSTimeInterval keepAliveIdle;//{{{
+@synthesize keepAliveIdle = m_keepAliveIdle;
+//}}}
+// @property (nonatomic) NSTimeInterval keepAliveInterval;//{{{
+@synthesize keepAliveInterval = m_keepAliveInterval;
+//}}}
+// @property (nonatomic) NSUInteger keepAliveCount;//{{{
+@synthesize keepAliveCount = m_keepAliveCount;
+//}}}
+
+// NSObject: Overrides
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [m_name release];
+    [super dealloc];
+}
+//}}}
+// - (NSString *)description;//{{{
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<SFSocketProfile %@: nodelay=%d quickack=%d sndbuf=%d rcvbuf=%d busypoll=%lu timeout=%.0f keepalive=%d (%.0f, %.0f, %lu)>",
+            m_name, m_noDelay, m_quickAck, m_sendBufferSize, m_receiveBufferSize,
+            (unsigned long)m_busyPollTime, m_userTimeout, m_keepAlive,
+            m_keepAliveIdle, m_keepAliveInterval, (unsigned long)m_keepAliveCount];
+}
+//}}}
+
+// NSCopying: Implementation
+// - (id)copyWithZone:(NSZone*)zone;//{{{
+- (id)copyWithZone:(NSZone*)zone
+{
+    SFSocketProfile *other = [[[self class] allocWithZone:zone] init];
+
+    other->m_name              = [m_name copy];
+    other->m_noDelay           = m_noDelay;
+    other->m_quickAck          = m_quickAck;
+    other->m_sendBufferSize    = m_sendBufferSize;
+    other->m_receiveBufferSize = m_receiveBufferSize;
+    other->m_busyPollTime      = m_busyPollTime;
+    other->m_userTimeout       = m_userTimeout;
+    other->m_keepAlive         = m_keepAlive;
+    other->m_keepAliveIdle     = m_keepAliveIdle;
+    other->m_keepAliveInterval = m_keepAliveInterval;
+    other->m_keepAliveCount    = m_keepAliveCount;
+    return other;
+}
+//}}}
+
+// Operations
+// - (error_t)applyToDescriptor:(socket_t)sd;//{{{
+- (error_t)applyToDescriptor:(socket_t)sd
+{
+    error_t result = 0;
+
+    if (m_sendBufferSize > 0)
+        result = SFSocketProfileSet(sd, SOL_SOCKET, SO_SNDBUF, m_sendBufferSize, result);
+    if (m_receiveBufferSize > 0)
+        result = SFSocketProfileSet(sd, SOL_SOCKET, SO_RCVBUF, m_receiveBufferSize, result);
+#ifdef SO_BUSY_POLL
+    if (m_busyPollTime > 0)
+        result = SFSocketProfileSet(sd, SOL_SOCKET, SO_BUSY_POLL, (int)m_busyPollTime, result);
+#endif
+    if (m_keepAlive)
+        result = SFSocketProfileSet(sd, SOL_SOCKET, SO_KEEPALIVE, TRUE, result);
+
+    if (!SFSocketProfileIsTCP(sd))
+        return result;
+
+    if (m_noDelay)
+        result = SFSocketProfileSet(sd, IPPROTO_TCP, TCP_NODELAY, TRUE, result);
+#ifdef TCP_QUICKACK
+    if (m_quickAck)
+        result = SFSocketProfileSet(sd, IPPROTO_TCP, TCP_QUICKACK, TRUE, result);
+#endif
+
+    if (m_userTimeout > 0)
+    {
+#if defined(TCP_USER_TIMEOUT)
+        result = SFSocketProfileSet(sd, IPPROTO_TCP, TCP_USER_TIMEOUT, (int)(m_userTimeout * 1000.0), result);
+#elif defined(TCP_RXT_CONNDROPTIME)
+        result = SFSocketProfileSet(sd, IPPROTO_TCP, TCP_RXT_CONNDROPTIME, (int)m_userTimeout, result);
+#endif
+    }
+
+    if (m_keepAlive)
+    {
+        /* Darwin names the idle time TCP_KEEPALIVE. */
+#if defined(TCP_KEEPIDLE)
+        if (m_keepAliveIdle > 0)
+            result = SFSocketProfileSet(sd, IPPROTO_TCP, TCP_KEEPIDLE, (int)m_keepAliveIdle, result);
+#elif defined(TCP_KEEPALIVE)
+        if (m_keepAliveIdle > 0)
+            result = SFSocketProfileSet(sd, IPPROTO_TCP, TCP_KEEPALIVE, (int)m_keepAliveIdle, result);
+#endif
+#ifdef TCP_KEEPINTVL
+        if (m_keepAliveInterval > 0)
+            result = SFSocketProfileSet(sd, IPPROTO_TCP, TCP_KEEPINTVL, (int)m_keepAliveInterval, result);
+#endif
+#ifdef TCP_KEEPCNT
+        if (m_keepAliveCount > 0)
+            result = SFSocketProfileSet(sd, IPPROTO_TCP, TCP_KEEPCNT, (int)m_keepAliveCount, result);
+#endif
+    }
+    return result;
+}
+//}}}
+
+// Presets
+// + (SFSocketProfile *)defaultProfile;//{{{
++ (SFSocketProfile *)defaultProfile
+{
+    SFSocketProfile *profile = [[SFSocketProfile alloc] init];
+
+    [profile setName:@"default"];
+    return [profile autorelease];
+}
+//}}}
+// + (SFSocketProfile *)lowLatencyProfile;//{{{
++ (SFSocketProfile *)lowLatencyProfile
+{
+    SFSocketProfile *profile = [[SFSocketProfile alloc] init];
+
+    [profile setName:@"low-latency"];
+    [profile setNoDelay:YES];
+    [profile setQuickAck:YES];
+    [profile setBusyPollTime:50];
+    [profile setUserTimeout:10.0];
+    [profile setKeepAlive:YES];
+    [profile setKeepAliveIdle:10.0];
+    [profile setKeepAliveInterval:2.0];
+    [profile setKeepAliveCount:3];
+    return [profile autorelease];
+}
+//}}}
+// + (SFSocketProfile *)bulkThroughputProfile;//{{{
++ (SFSocketProfile *)bulkThroughputProfile
+{
+    SFSocketProfile *profile = [[SFSocketProfile alloc] init];
+
+    [profile setName:@"bulk-throughput"];
+    [profile setSendBufferSize:SF_PROFILE_BULK_BUFFER];
+    [profile setReceiveBufferSize:SF_PROFILE_BULK_BUFFER];
+    [profile setKeepAlive:YES];
+    [profile setKeepAliveIdle:60.0];
+    [profile setKeepAliveInterval:10.0];
+    [profile setKeepAliveCount:5];
+    return [profile autorelease];
+}
+//}}}
+// + (SFSocketProfile *)profileNamed:(NSString *)name;//{{{
++ (SFSocketProfile *)profileNamed:(NSString *)name
+{
+    if ([name isEqualToString:@"default"])
+        return [SFSocketProfile defaultProfile];
+    if ([name isEqualToString:@"low-latency"])
+        return [SFSocketProfile lowLatencyProfile];
+    if ([name isEqualToString:@"bulk-throughput"])
+        return [SFSocketProfile bulkThroughputProfile];
+    return nil;
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
@@ -0,0 +1,113 @@
+/**
+ * \file
+ * Declares the SFSocketServer Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "sfstd.h"
+#import "SFSocketLoop.h"
+
+/**
+ * \ingroup sf_networking
+ * Accepts connections in several SFSocketLoop threads.
+ * Each loop accepts its own connections and handles them until they are
+ * closed, so the threads share nothing in the hot path and a connection is
+ * always served by the same thread. The delegate is shared by all loops and
+ * is called from all their threads: it must keep per connection state in
+ * the connection or be thread safe.
+ *
+ * When #reusePort is \b YES each loop listens in a socket of its own bound
+ * with \c SO_REUSEPORT, and the kernel spreads the connections among them.
+ * The Darwin kernel doesn't balance \c SO_REUSEPORT sockets, so the default
+ * is a single listening socket registered in every loop: all loops are woken
+ * by a new connection and the first one to accept it keeps it.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFSocketServer : NSObject
+/** @name Properties */ //@{
+// @property (nonatomic, assign) id<SFSocketLoopDelegate> delegate;//{{{
+/**
+ * Gets or sets the object that receives the callbacks of all loops.
+ * It is not retained. Set it before #listen:port:.
+ **/
+@property (nonatomic, assign) id<SFSocketLoopDelegate> delegate;
+//}}}
+// @property (nonatomic) BOOL reusePort;//{{{
+/**
+ * Gets or sets whether each loop has its own listening socket.
+ * Set it before #listen:port:. Default is \b NO.
+ **/
+@property (nonatomic) BOOL reusePort;
+//}}}
+// @property (nonatomic) BOOL pinsThreads;//{{{
+/**
+ * Gets or sets whether the loop threads are kept on different processors.
+ * See SFSocketLoop::processor. Set it before #listen:port:. Default is \b
+ * NO.
+ **/
+@property (nonatomic) BOOL pinsThreads;
+//}}}
+// @property (nonatomic, readonly) NSArray *loops;//{{{
+/**
+ * Gets the loops of this server.
+ **/
+@property (nonatomic, readonly) NSArray *loops;
+//}}}
+// @property (nonatomic, readonly) NSUInteger port;//{{{
+/**
+ * Gets the port accepting connections.
+ * Zero when the server is not listening.
+ **/
+@property (nonatomic, readonly) NSUInteger port;
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfAccepts;//{{{
+/**
+ * Gets the number of connections accepted by all loops.
+ **/
+@property (nonatomic, readonly) uint64_t numberOfAccepts;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithThreads:(NSUInteger)count;//{{{
+/**
+ * Initializes the object.
+ * @param count Number of loop threads. Zero uses one for each active
+ * processor.
+ * @return This object initialized. \b nil when the loops cannot be created.
+ **/
+- (instancetype)initWithThreads:(NSUInteger)count;
+//}}}
+//@}
+
+/** @name Operations */ //@{
+// - (error_t)listen:(NSString *)address port:(NSUInteger)port;//{{{
+/**
+ * Starts listening and the loop threads.
+ * @param address The IP of the local interface. \b nil to accept in all
+ * interfaces.
+ * @param port The port. Zero lets the system choose one. See #port.
+ * @return Zero on success. Otherwise the error number.
+ **/
+- (error_t)listen:(NSString *)address port:(NSUInteger)port;
+//}}}
+// - (void)stop;//{{{
+/**
+ * Stops the loop threads and closes the listening sockets.
+ * Connections accepted are left in their loops, not closed.
+ **/
+- (void)stop;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,171 @@
+/**
+ * \file
+ * Defines the SFSocketServer Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFSocketServer.h"
+#import "sfdebug.h"
+
+#include <sys/errno.h>
+
+/* ===========================================================================
+ * SFSocketServer EXTENSION
+ * ======================================================================== */
+@interface SFSocketServer () {
+    id<SFSocketLoopDelegate> m_delegate;
+    NSMutableArray *m_loops;
+    NSMutableArray *m_listeners;
+    BOOL m_reusePort;
+    BOOL m_pinsThreads;
+}
+@end
+
+/* ===========================================================================
+ * SFSocketServer IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFSocketServer
+// Properties
+// @property (nonatomic, assign) id<SFSocketLoopDelegate> delegate;//{{{
+@synthesize delegate = m_delegate;
+//}}}
+// @property (nonatomic) BOOL reusePort;//{{{
+@synthesize reusePort = m_reusePort;
+//}}}
+// @property (nonatomic) BOOL pinsThreads;//{{{
+@synthesize pinsThreads = m_pinsThreads;
+//}}}
+// @property (nonatomic, readonly) NSArray *loops;//{{{
+- (NSArray *)loops {
+    return [[m_loops copy] autorelease];
+}
+//}}}
+// @property (nonatomic, readonly) NSUInteger port;//{{{
+- (NSUInteger)port {
+    return (([m_listeners count] > 0) ? [[m_listeners objectAtIndex:0] localPort] : 0);
+}
+//}}}
+// @property (nonatomic, readonly) uint64_t numberOfAccepts;//{{{
+- (uint64_t)numberOfAccepts
+{
+    uint64_t total = 0;
+
+    for (SFSocketLoop *loop in m_loops)
+        total += [loop numberOfAccepts];
+    return total;
+}
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithThreads:(NSUInteger)count;//{{{
+- (instancetype)initWithThreads:(NSUInteger)count
+{
+    self = [super init];
+    if (self)
+    {
+        if (count == 0)
+            count = [[NSProcessInfo processInfo] activeProcessorCount];
+
+        m_loops = [[NSMutableArray alloc] initWithCapacity:count];
+        m_listeners = [NSMutableArray new];
+
+        while (count-- > 0)
+        {
+            SFSocketLoop *loop = [[SFSocketLoop alloc] init];
+            if (loop == nil)
+            {
+                [self release];
+                return nil;
+            }
+            [m_loops addObject:loop];
+            [loop release];
+        }
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [self stop];
+    [m_loops release];
+    [m_listeners release];
+    [super dealloc];
+}
+//}}}
+
+// Operations
+// - (error_t)listen:(NSString *)address port:(NSUInteger)port;//{{{
+- (error_t)listen:(NSString *)address port:(NSUInteger)port
+{
+    NSUInteger index, count = [m_loops count];
+    error_t error = 0;
+
+    if ([m_listeners count] > 0)
+        return EISCONN;
+
+    for (index = 0; index < count; ++index)
+    {
+        SFSocketLoop *loop = [m_loops objectAtIndex:index];
+        SFSocket *listener;
+
+        if ((index == 0) || m_reusePort)
+        {
+            listener = [[[SFSocket alloc] init] autorelease];
+
+            /* The following sockets use the port chosen for the first. */
+            error = [listener listen:address port:((index == 0) ? port : [self port]) reusePort:m_reusePort];
+            if (error != 0) break;
+
+            [m_listeners addObject:listener];
+        }
+        else
+            listener = [m_listeners objectAtIndex:0];
+
+        [loop setDelegate:m_delegate];
+        [loop setProcessor:(m_pinsThreads ? (NSInteger)index : -1)];
+        [loop addSocket:listener];
+    }
+
+    if (error != 0)
+    {
+        [self stop];
+        return error;
+    }
+
+    for (SFSocketLoop *loop in m_loops)
+        [loop start];
+
+    return 0;
+}
+//}}}
+// - (void)stop;//{{{
+- (void)stop
+{
+    for (SFSocketLoop *loop in m_loops)
+    {
+        for (SFSocket *listener in m_listeners)
+            [loop removeSocket:listener];
+
+        [loop stop];
+    }
+
+    for (SFSocket *listener in m_listeners)
+        [listener close];
+
+    [m_listeners removeAllObjects];
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
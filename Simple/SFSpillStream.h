@@ -0,0 +1,87 @@
+/**
+ * \file
+ * Declares the SFSpillStream Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "SFStream.h"
+
+/**
+ * \ingroup sf_networking
+ * A read-write stream that moves its data to a temporary file when it grows
+ * too large.
+ * While the stream length is under the #threshold the data is kept in memory,
+ * exactly as in SFStream. When a write would pass the threshold the content
+ * is moved to an anonymous temporary file and the memory is released. From
+ * then on writes are collected in a buffer and written to the file in blocks
+ * aligned to the block size. Reads are served from a window loaded from the
+ * file. So the memory used stays bounded whatever the size of the data.
+ *
+ * When #purgeReadBytes leaves less data than the threshold the rest is
+ * loaded back to memory and the file is closed.
+ *
+ * #bytes, #bytesAtIndex: and #bufferWithLength: keep working after the
+ * spill. The addresses returned by the first two are valid up to the end of
+ * the read window, at least 64 KB or the end of the stream, and
+ * #numberOfContiguousBytes gives the size of that window. All addresses are
+ * valid until the next operation on the stream.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFSpillStream : NSObject <SFStreamProtocol, SFStreamReaderProtocol, SFStreamWriterProtocol>
+/** @name Properties */ //@{
+// @property (nonatomic, readonly) size_t threshold;//{{{
+/**
+ * Gets the greatest number of bytes kept in memory.
+ **/
+@property (nonatomic, readonly) size_t threshold;
+//}}}
+// @property (nonatomic, readonly, getter=isSpilled) BOOL spilled;//{{{
+/**
+ * Gets whether the data is currently stored in the temporary file.
+ **/
+@property (nonatomic, readonly, getter=isSpilled) BOOL spilled;
+//}}}
+// @property (nonatomic, readonly) error_t error;//{{{
+/**
+ * Gets the error number of the last failed file operation.
+ * Reading and writing operations that fail because of the file return zero
+ * bytes processed and set this property.
+ **/
+@property (nonatomic, readonly) error_t error;
+//}}}
+//@}
+
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithThreshold:(size_t)threshold;//{{{
+/**
+ * Initializes an empty stream.
+ * @param threshold The greatest number of bytes kept in memory. Zero makes
+ * the stream use the file from the first byte written.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithThreshold:(size_t)threshold;
+//}}}
+//@}
+
+/** @name Reseting */ //@{
+// - (void)reset;//{{{
+/**
+ * Resets both read and write position.
+ * Also the function sets the length of the stream to zero and closes the
+ * temporary file, if any.
+ **/
+- (void)reset;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
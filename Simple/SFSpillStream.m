@@ -0,0 +1,886 @@
+/**
+ * \file
+ * Defines the SFSpillStream Objective-C interface class.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFSpillStream.h"
+#import "sfdebug.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/errno.h>
+#include <libkern/OSByteOrder.h>
+
+/**
+ * Threshold used by SFSpillStream::init.
+ **/
+#define SFSPILL_DEFAULT_THRESHOLD   (8 * 1024 * 1024)
+
+/**
+ * Growth factor of the memory buffer.
+ **/
+#define SFSPILL_GROWTH_FACTOR       2.0f
+
+/**
+ * Size and alignment of the blocks written to the file. Also the size of the
+ * read window. Must be a power of two.
+ **/
+#define SFSPILL_BLOCK_SIZE          (64 * 1024)
+
+/* ===========================================================================
+ * FILE FUNCTIONS
+ * ======================================================================== */
+// static BOOL spill_pwrite(int fd, const uint8_t *data, size_t length, off_t offset);//{{{
+/**
+ * Writes all bytes in the file, retrying partial writes.
+ **/
+static BOOL spill_pwrite(int fd, const uint8_t *data, size_t length, off_t offset)
+{
+    while (length > 0)
+    {
+        ssize_t done = pwrite(fd, data, length, offset);
+
+        if (done < 0)
+        {
+            if (errno == EINTR) continue;
+            return NO;
+        }
+        data += done; offset += done; length -= (size_t)done;
+    }
+    return YES;
+}
+//}}}
+// static BOOL spill_pread(int fd, uint8_t *data, size_t length, off_t offset);//{{{
+/**
+ * Reads exactly \a length bytes from the file.
+ **/
+static BOOL spill_pread(int fd, uint8_t *data, size_t length, off_t offset)
+{
+    while (length > 0)
+    {
+        ssize_t done = pread(fd, data, length, offset);
+
+        if (done <= 0)
+        {
+            if ((done < 0) && (errno == EINTR)) continue;
+            if (done == 0) errno = EIO;
+            return NO;
+        }
+        data += done; offset += done; length -= (size_t)done;
+    }
+    return YES;
+}
+//}}}
+
+/* ===========================================================================
+ * SFSpillStream EXTENSION
+ * ======================================================================== */
+@interface SFSpillStream () {
+    stream_t m_stream;              /* Memory data and all the positions.   */
+    size_t   m_threshold;
+    int      m_fd;                  /* Temporary file or -1.                */
+    off_t    m_base;                /* File offset of the stream start.     */
+    uint8_t *m_wbuf;                /* Bytes waiting to be written.         */
+    size_t   m_wcap;
+    size_t   m_wlen;
+    size_t   m_wlimit;              /* Bytes until the next aligned block.  */
+    off_t    m_wstart;              /* File offset of m_wbuf.               */
+    uint8_t *m_rbuf;                /* Read window.                         */
+    size_t   m_rcap;
+    size_t   m_rlen;
+    off_t    m_rstart;              /* File offset of m_rbuf.               */
+    size_t   m_staged;              /* Bytes given by bufferWithLength:.    */
+    error_t  m_error;
+}
+// - (BOOL)spill;//{{{
+/**
+ * Moves the data in memory to a new temporary file.
+ **/
+- (BOOL)spill;
+//}}}
+// - (void)unspill;//{{{
+/**
+ * Moves the data in the file back to memory and closes the file.
+ **/
+- (void)unspill;
+//}}}
+// - (void)closeFile;//{{{
+/**
+ * Closes the temporary file and releases the file buffers.
+ **/
+- (void)closeFile;
+//}}}
+// - (BOOL)flush;//{{{
+/**
+ * Writes the pending bytes in the file.
+ **/
+- (BOOL)flush;
+//}}}
+// - (void)startWriteAt:(off_t)offset;//{{{
+/**
+ * Starts collecting writes at a file offset.
+ **/
+- (void)startWriteAt:(off_t)offset;
+//}}}
+// - (const uint8_t *)windowAt:(size_t)offset length:(size_t)length;//{{{
+/**
+ * Gets \a length contiguous bytes from the file, through the read window.
+ **/
+- (const uint8_t *)windowAt:(size_t)offset length:(size_t)length;
+//}}}
+// - (size_t)fileRead:(void *)buffer length:(size_t)length;//{{{
+/**
+ * Reads from the file at the read position.
+ **/
+- (size_t)fileRead:(void *)buffer length:(size_t)length;
+//}}}
+// - (size_t)fileWrite:(const void *)data length:(size_t)length;//{{{
+/**
+ * Writes in the file at the write position.
+ **/
+- (size_t)fileWrite:(const void *)data length:(size_t)length;
+//}}}
+@end
+
+/* ===========================================================================
+ * SFSpillStream IMPLEMENTATION
+ * ======================================================================== */
+@implementation SFSpillStream
+// static inline BOOL spill_read(SFSpillStream *self, void *dest, size_t size);//{{{
+/**
+ * Reads exactly \a size bytes. Nothing is read if there is not enough data.
+ **/
+static inline BOOL spill_read(SFSpillStream *self, void *dest, size_t size)
+{
+    if (self->m_fd < 0)
+        return (SFStreamRead(&self->m_stream, dest, size) == size);
+
+    if ((self->m_stream.length - self->m_stream.nextRead) < size)
+        return NO;
+
+    return ([self fileRead:dest length:size] == size);
+}
+//}}}
+
+// Properties
+// @property (nonatomic, readonly) size_t threshold;//{{{
+@synthesize threshold = m_threshold;
+//}}}
+// @property (nonatomic, readonly, getter=isSpilled) BOOL spilled;//{{{
+- (BOOL)isSpilled {
+    return (m_fd >= 0);
+}
+//}}}
+// @property (nonatomic, readonly) error_t error;//{{{
+@synthesize error = m_error;
+//}}}
+
+// Designated Initializers
+// - (instancetype)initWithThreshold:(size_t)threshold;//{{{
+- (instancetype)initWithThreshold:(size_t)threshold
+{
+    self = [super init];
+    if (self)
+    {
+        m_fd = -1;
+        m_threshold = threshold;
+        m_stream.growthFactor = SFSPILL_GROWTH_FACTOR;
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (id)init;//{{{
+- (id)init
+{
+    return [self initWithThreshold:SFSPILL_DEFAULT_THRESHOLD];
+}
+//}}}
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [self closeFile];
+    SFStreamRealloc(&m_stream, 0);
+    [super dealloc];
+}
+//}}}
+
+// Local Operations
+// - (BOOL)spill;//{{{
+- (BOOL)spill
+{
+    NSString *pattern = [NSTemporaryDirectory() stringByAppendingPathComponent:@"sfspill.XXXXXX"];
+    char *path = strdup([pattern fileSystemRepresentation]);
+
+    if (path == NULL) {
+        m_error = ENOMEM;
+        return NO;
+    }
+
+    m_fd = mkstemp(path);
+    if (m_fd >= 0) unlink(path);        /* Removed when closed. */
+    free(path);
+
+    m_wbuf = (uint8_t *)malloc(SFSPILL_BLOCK_SIZE);
+    m_rbuf = (uint8_t *)malloc(SFSPILL_BLOCK_SIZE);
+    m_wcap = m_rcap = SFSPILL_BLOCK_SIZE;
+
+    if ((m_wbuf == NULL) || (m_rbuf == NULL))
+        errno = ENOMEM;
+
+    /* On failure the data stays in memory. */
+    if ((m_fd < 0) || (m_wbuf == NULL) || (m_rbuf == NULL) ||
+        !spill_pwrite(m_fd, m_stream.buffer, m_stream.length, 0))
+    {
+        m_error = errno;
+        [self closeFile];
+        return NO;
+    }
+
+    m_base = 0;
+    m_wlen = m_rlen = 0;
+    m_staged = 0;
+    [self startWriteAt:(off_t)m_stream.nextWrite];
+
+    SFStreamRealloc(&m_stream, 0);
+    return YES;
+}
+//}}}
+// - (void)unspill;//{{{
+- (void)unspill
+{
+    size_t length = m_stream.length;
+
+    /* The file is kept when there is no memory or it cannot be read. */
+    if ((length > 0) && ![self flush])
+        return;
+    if ((length > 0) && !SFStreamRealloc(&m_stream, length))
+        return;
+    if ((length > 0) && !spill_pread(m_fd, m_stream.buffer, length, m_base))
+    {
+        m_error = errno;
+        SFStreamRealloc(&m_stream, 0);
+        return;
+    }
+    [self closeFile];
+}
+//}}}
+// - (void)closeFile;//{{{
+- (void)closeFile
+{
+    if (m_fd >= 0) close(m_fd);
+    if (m_wbuf != NULL) free(m_wbuf);
+    if (m_rbuf != NULL) free(m_rbuf);
+
+    m_fd = -1;
+    m_wbuf = m_rbuf = NULL;
+    m_wcap = m_wlen = m_rcap = m_rlen = 0;
+    m_staged = 0;
+    m_base = 0;
+}
+//}}}
+// - (BOOL)flush;//{{{
+- (BOOL)flush
+{
+    if (m_wlen == 0)
+        return YES;
+
+    if (!spill_pwrite(m_fd, m_wbuf, m_wlen, m_wstart))
+    {
+        m_error = errno;
+        return NO;
+    }
+
+    /* The read window may have old copies of these bytes. */
+    if ((m_rlen > 0) && (m_wstart < (m_rstart + (off_t)m_rlen)) && ((m_wstart + (off_t)m_wlen) > m_rstart))
+        m_rlen = 0;
+
+    [self startWriteAt:(m_wstart + (off_t)m_wlen)];
+    return YES;
+}
+//}}}
+// - (void)startWriteAt:(off_t)offset;//{{{
+- (void)startWriteAt:(off_t)offset
+{
+    m_wstart = offset;
+    m_wlen = 0;
+    m_wlimit = (SFSPILL_BLOCK_SIZE - (size_t)(offset & (SFSPILL_BLOCK_SIZE - 1)));
+    if (m_wlimit > m_wcap) m_wlimit = m_wcap;
+}
+//}}}
+// - (const uint8_t *)windowAt:(size_t)offset length:(size_t)length;//{{{
+- (const uint8_t *)windowAt:(size_t)offset length:(size_t)length
+{
+    off_t start = (m_base + (off_t)offset);
+
+    if ((m_rlen > 0) && (start >= m_rstart) && ((start + (off_t)length) <= (m_rstart + (off_t)m_rlen)))
+        return (m_rbuf + (start - m_rstart));
+
+    /* Pending writes must be in the file before it is read. */
+    if (![self flush])
+        return NULL;
+
+    if (length > m_rcap)
+    {
+        uint8_t *ptr = (uint8_t *)realloc(m_rbuf, length);
+
+        if (ptr == NULL) {
+            m_error = ENOMEM;
+            return NULL;
+        }
+        m_rbuf = ptr;
+        m_rcap = length;
+    }
+
+    size_t amount = (m_stream.length - offset);
+    if (amount > m_rcap) amount = m_rcap;
+
+    m_rlen = 0;
+    if (!spill_pread(m_fd, m_rbuf, amount, start))
+    {
+        m_error = errno;
+        return NULL;
+    }
+
+    m_rstart = start;
+    m_rlen = amount;
+    return m_rbuf;
+}
+//}}}
+// - (size_t)fileRead:(void *)buffer length:(size_t)length;//{{{
+- (size_t)fileRead:(void *)buffer length:(size_t)length
+{
+    size_t available = (m_stream.length - m_stream.nextRead);
+    uint8_t *out = (uint8_t *)buffer;
+    size_t total = 0;
+
+    if (length > available) length = available;
+
+    while (total < length)
+    {
+        size_t part = (length - total);
+        if (part > m_rcap) part = m_rcap;
+
+        const uint8_t *ptr = [self windowAt:m_stream.nextRead length:part];
+        if (ptr == NULL) break;
+
+        memcpy((out + total), ptr, part);
+        total += part;
+        m_stream.nextRead += part;
+    }
+    return total;
+}
+//}}}
+// - (size_t)fileWrite:(const void *)data length:(size_t)length;//{{{
+- (size_t)fileWrite:(const void *)data length:(size_t)length
+{
+    const uint8_t *in = (const uint8_t *)data;
+    off_t at = (m_base + (off_t)m_stream.nextWrite);
+    size_t total = 0;
+
+    if ((m_wstart + (off_t)m_wlen) != at)
+    {
+        if (![self flush]) return 0;
+        [self startWriteAt:at];
+    }
+
+    /* Writes over the read window make it old. */
+    if ((m_rlen > 0) && (at < (m_rstart + (off_t)m_rlen)) && ((at + (off_t)length) > m_rstart))
+        m_rlen = 0;
+
+    while (total < length)
+    {
+        size_t part = (m_wlimit - m_wlen);
+        if (part > (length - total)) part = (length - total);
+
+        memcpy((m_wbuf + m_wlen), (in + total), part);
+        m_wlen += part;
+        total += part;
+
+        if ((m_wlen >= m_wlimit) && ![self flush])
+            break;
+    }
+
+    __SFStreamCommit(&m_stream, total);
+    return total;
+}
+//}}}
+
+// SFStreamProtocol: Properties Implementation
+// - (size_t)capacity;//{{{
+- (size_t)capacity {
+    return ((m_fd < 0) ? m_stream.capacity : m_stream.length);
+}
+//}}}
+// - (size_t)length;//{{{
+- (size_t)length {
+    return m_stream.length;
+}
+//}}}
+
+// SFStreamReaderProtocol Reading Information
+// - (size_t)readPosition;//{{{
+- (size_t)readPosition {
+    return m_stream.nextRead;
+}
+//}}}
+// - (size_t)numberOfBytesAvailable;//{{{
+- (size_t)numberOfBytesAvailable {
+    return SFStreamAvailable(&m_stream);
+}
+//}}}
+// - (BOOL)setReadPosition:(size_t)offset;//{{{
+- (BOOL)setReadPosition:(size_t)offset
+{
+    if (offset > m_stream.length) return NO;
+    m_stream.nextRead = offset;
+    return YES;
+}
+//}}}
+
+// SFStreamReaderProtocol Direct Access
+// - (const uint8_t *)bytes;//{{{
+- (const uint8_t *)bytes
+{
+    if (m_fd < 0)
+        return (m_stream.buffer + m_stream.nextRead);
+
+    if (m_stream.nextRead >= m_stream.length)
+        return NULL;
+
+    return [self bytesAtIndex:m_stream.nextRead];
+}
+//}}}
+// - (const uint8_t *)bytesAtIndex:(size_t)offset;//{{{
+- (const uint8_t *)bytesAtIndex:(size_t)offset
+{
+    sfassert(offset < m_stream.length, "SFSpillStream::bytesAtIndex[] offset greater than length\n");
+    if (offset >= m_stream.length) return NULL;
+
+    if (m_fd < 0)
+        return (m_stream.buffer + offset);
+
+    size_t length = (m_stream.length - offset);
+    return [self windowAt:offset length:((length < m_rcap) ? length : m_rcap)];
+}
+//}}}
+// - (size_t)numberOfContiguousBytes;//{{{
+- (size_t)numberOfContiguousBytes
+{
+    size_t available = SFStreamAvailable(&m_stream);
+
+    if (m_fd < 0)
+        return available;
+
+    /* #bytes loads a window of, at most, m_rcap bytes. */
+    return ((available < m_rcap) ? available : m_rcap);
+}
+//}}}
+
+// SFStreamReaderProtocol Basic Reading Operations
+// - (size_t)read:(void *)buffer length:(size_t)length;//{{{
+- (size_t)read:(void *)buffer length:(size_t)length
+{
+    if (m_fd < 0)
+        return SFStreamRead(&m_stream, buffer, length);
+
+    if (buffer == NULL)
+        return 0;
+
+    return [self fileRead:buffer length:length];
+}
+//}}}
+// - (uint8_t)readByte;//{{{
+- (uint8_t)readByte
+{
+    uint8_t value = 0;
+
+    spill_read(self, &value, sizeof(uint8_t));
+    return value;
+}
+//}}}
+// - (uint16_t)readShort;//{{{
+- (uint16_t)readShort
+{
+    uint16_t value = 0;
+
+    spill_read(self, &value, sizeof(uint16_t));
+    return value;
+}
+//}}}
+// - (uint32_t)readInt;//{{{
+- (uint32_t)readInt
+{
+    uint32_t value = 0;
+
+    spill_read(self, &value, sizeof(uint32_t));
+    return value;
+}
+//}}}
+// - (uint64_t)readLong;//{{{
+- (uint64_t)readLong
+{
+    uint64_t value = 0;
+
+    spill_read(self, &value, sizeof(uint64_t));
+    return value;
+}
+//}}}
+// - (float)readFloat;//{{{
+- (float)readFloat
+{
+    float value = 0.0f;
+
+    spill_read(self, &value, sizeof(float));
+    return value;
+}
+//}}}
+// - (double)readDouble;//{{{
+- (double)readDouble
+{
+    double value = 0.0;
+
+    spill_read(self, &value, sizeof(double));
+    return value;
+}
+//}}}
+// - (void)purgeReadBytes;//{{{
+- (void)purgeReadBytes
+{
+    size_t purged = m_stream.nextRead;
+
+    if (purged == 0)
+        return;
+
+    if (m_fd < 0)
+    {
+        memmove(m_stream.buffer, (m_stream.buffer + purged), SFStreamAvailable(&m_stream));
+    }
+    else
+    {
+        /* Nothing is moved in the file. Its start is moved instead. */
+        m_base += (off_t)purged;
+        m_staged = 0;
+    }
+
+    m_stream.nextWrite = ((m_stream.nextWrite > purged) ? (m_stream.nextWrite - purged) : 0);
+    m_stream.length -= purged;
+    m_stream.purged += purged;
+    m_stream.nextRead = 0;
+
+    if ((m_fd >= 0) && (m_stream.length <= m_threshold))
+        [self unspill];
+}
+//}}}
+
+// SFStreamReaderProtocol Big-Endian to Host Conversions
+// - (uint16_t)readBigEndianShort;//{{{
+- (uint16_t)readBigEndianShort
+{
+    return OSSwapBigToHostInt16([self readShort]);
+}
+//}}}
+// - (uint32_t)readBigEndianInt;//{{{
+- (uint32_t)readBigEndianInt
+{
+    return OSSwapBigToHostInt32([self readInt]);
+}
+//}}}
+// - (uint64_t)readBigEndignLong;//{{{
+- (uint64_t)readBigEndignLong
+{
+    return OSSwapBigToHostInt64([self readLong]);
+}
+//}}}
+// - (float)readBigEndianFloat;//{{{
+- (float)readBigEndianFloat
+{
+    NSSwappedFloat swappedFloat = { 0 };
+
+    spill_read(self, &swappedFloat, sizeof(NSSwappedFloat));
+    return NSSwapBigFloatToHost(swappedFloat);
+}
+//}}}
+// - (double)readBigEndianDouble;//{{{
+- (double)readBigEndianDouble
+{
+    NSSwappedDouble swappedDouble = { 0 };
+
+    spill_read(self, &swappedDouble, sizeof(NSSwappedDouble));
+    return NSSwapBigDoubleToHost(swappedDouble);
+}
+//}}}
+
+// SFStreamReaderProtocol Little-Endian to Host Conversions
+// - (uint16_t)readLittleEndianShort;//{{{
+- (uint16_t)readLittleEndianShort
+{
+    return OSSwapLittleToHostInt16([self readShort]);
+}
+//}}}
+// - (uint32_t)readLittleEndianInt;//{{{
+- (uint32_t)readLittleEndianInt
+{
+    return OSSwapLittleToHostInt32([self readInt]);
+}
+//}}}
+// - (uint64_t)readLittleEndianLong;//{{{
+- (uint64_t)readLittleEndianLong
+{
+    return OSSwapLittleToHostInt64([self readLong]);
+}
+//}}}
+// - (float)readLittleEndianFloat;//{{{
+- (float)readLittleEndianFloat
+{
+    NSSwappedFloat swappedFloat = { 0 };
+
+    spill_read(self, &swappedFloat, sizeof(NSSwappedFloat));
+    return NSSwapLittleFloatToHost(swappedFloat);
+}
+//}}}
+// - (double)readLittleEndianDouble;//{{{
+- (double)readLittleEndianDouble
+{
+    NSSwappedDouble swappedDouble = { 0 };
+
+    spill_read(self, &swappedDouble, sizeof(NSSwappedDouble));
+    return NSSwapLittleDoubleToHost(swappedDouble);
+}
+//}}}
+
+// SFStreamWriterProtocol Writting Information
+// - (size_t)writePosition;//{{{
+- (size_t)writePosition {
+    return m_stream.nextWrite;
+}
+//}}}
+// - (BOOL)setWritePosition:(size_t)offset;//{{{
+- (BOOL)setWritePosition:(size_t)offset
+{
+    if (m_fd < 0)
+    {
+        if (offset > m_stream.capacity) return NO;
+
+        if (offset > m_stream.nextWrite)
+            __SFStreamCommit(&m_stream, (offset - m_stream.nextWrite));
+        else
+            m_stream.nextWrite = offset;
+        return YES;
+    }
+
+    /* Bytes stored in the buffer given by bufferWithLength:. */
+    if ((m_staged > 0) && (offset > m_stream.nextWrite) && ((offset - m_stream.nextWrite) <= m_staged))
+    {
+        size_t amount = (offset - m_stream.nextWrite);
+
+        m_wlen += amount;
+        m_staged = 0;
+        __SFStreamCommit(&m_stream, amount);
+
+        if (m_wlen >= m_wlimit) [self flush];
+        return YES;
+    }
+
+    if (offset > m_stream.length) return NO;
+
+    m_staged = 0;
+    m_stream.nextWrite = offset;
+    return YES;
+}
+//}}}
+
+// SFStreamWriterProtocol Direct Access
+// - (void *)bufferWithLength:(size_t)length;//{{{
+- (void *)bufferWithLength:(size_t)length
+{
+    if ((length == 0) || (length > (SIZE_MAX - m_stream.nextWrite)))
+        return NULL;
+
+    if (m_fd < 0)
+    {
+        if ((m_stream.nextWrite + length) <= m_threshold)
+            return (void *)__SFStreamReserve(&m_stream, length);
+
+        if (![self spill])
+            return NULL;
+    }
+
+    off_t at = (m_base + (off_t)m_stream.nextWrite);
+
+    /* The region must be contiguous in the write buffer. */
+    if (((m_wstart + (off_t)m_wlen) != at) || ((m_wcap - m_wlen) < length))
+    {
+        if (![self flush]) return NULL;
+        [self startWriteAt:at];
+    }
+
+    if (length > m_wcap)
+    {
+        uint8_t *ptr = (uint8_t *)realloc(m_wbuf, length);
+
+        if (ptr == NULL) {
+            m_error = ENOMEM;
+            return NULL;
+        }
+        m_wbuf = ptr;
+        m_wcap = length;
+    }
+
+    if ((m_rlen > 0) && (at < (m_rstart + (off_t)m_rlen)) && ((at + (off_t)length) > m_rstart))
+        m_rlen = 0;
+
+    m_staged = length;
+    return (m_wbuf + m_wlen);
+}
+//}}}
+
+// SFStreamWriterProtocol Basic Writting Operations
+// - (size_t)write:(const void*)data length:(size_t)size;//{{{
+- (size_t)write:(const void*)data length:(size_t)size
+{
+    if ((data == NULL) || (size == 0))
+        return 0;
+
+    if (m_fd < 0)
+    {
+        if ((size <= m_threshold) && (m_stream.nextWrite <= (m_threshold - size)))
+            return SFStreamWrite(&m_stream, data, size);
+
+        if (![self spill])
+            return 0;
+    }
+
+    m_staged = 0;
+    return [self fileWrite:data length:size];
+}
+//}}}
+// - (void)writeByte:(uint8_t)data;//{{{
+- (void)writeByte:(uint8_t)data
+{
+    [self write:&data length:sizeof(uint8_t)];
+}
+//}}}
+// - (void)writeShort:(uint16_t)data;//{{{
+- (void)writeShort:(uint16_t)data
+{
+    [self write:&data length:sizeof(uint16_t)];
+}
+//}}}
+// - (void)writeInt:(uint32_t)data;//{{{
+- (void)writeInt:(uint32_t)data
+{
+    [self write:&data length:sizeof(uint32_t)];
+}
+//}}}
+// - (void)writeLong:(uint64_t)data;//{{{
+- (void)writeLong:(uint64_t)data
+{
+    [self write:&data length:sizeof(uint64_t)];
+}
+//}}}
+// - (void)writeFloat:(float)data;//{{{
+- (void)writeFloat:(float)data
+{
+    [self write:&data length:sizeof(float)];
+}
+//}}}
+// - (void)writeDouble:(double)data;//{{{
+- (void)writeDouble:(double)data
+{
+    [self write:&data length:sizeof(double)];
+}
+//}}}
+
+// SFStreamWriterProtocol Host to Big-Endian Conversions
+// - (void)writeBigEndianShort:(uint16_t)data;//{{{
+- (void)writeBigEndianShort:(uint16_t)data
+{
+    [self writeShort:OSSwapHostToBigInt16(data)];
+}
+//}}}
+// - (void)writeBigEndianInt:(uint32_t)data;//{{{
+- (void)writeBigEndianInt:(uint32_t)data
+{
+    [self writeInt:OSSwapHostToBigInt32(data)];
+}
+//}}}
+// - (void)writeBigEndianLong:(uint64_t)data;//{{{
+- (void)writeBigEndianLong:(uint64_t)data
+{
+    [self writeLong:OSSwapHostToBigInt64(data)];
+}
+//}}}
+// - (void)writeBigEndianFloat:(float)data;//{{{
+- (void)writeBigEndianFloat:(float)data
+{
+    NSSwappedFloat swappedFloat = NSSwapHostFloatToBig(data);
+    [self write:&swappedFloat length:sizeof(NSSwappedFloat)];
+}
+//}}}
+// - (void)writeBigEndianDouble:(double)data;//{{{
+- (void)writeBigEndianDouble:(double)data
+{
+    NSSwappedDouble swappedDouble = NSSwapHostDoubleToBig(data);
+    [self write:&swappedDouble length:sizeof(NSSwappedDouble)];
+}
+//}}}
+
+// SFStreamWriterProtocol Host to Little-Endian Conversions
+// - (void)writeLittleEndianShort:(uint16_t)data;//{{{
+- (void)writeLittleEndianShort:(uint16_t)data
+{
+    [self writeShort:OSSwapHostToLittleInt16(data)];
+}
+//}}}
+// - (void)writeLittleEndianInt:(uint32_t)data;//{{{
+- (void)writeLittleEndianInt:(uint32_t)data
+{
+    [self writeInt:OSSwapHostToLittleInt32(data)];
+}
+//}}}
+// - (void)writeLittleEndianLong:(uint64_t)data;//{{{
+- (void)writeLittleEndianLong:(uint64_t)data
+{
+    [self writeLong:OSSwapHostToLittleInt64(data)];
+}
+//}}}
+// - (void)writeLittleEndianFloat:(float)data;//{{{
+- (void)writeLittleEndianFloat:(float)data
+{
+    NSSwappedFloat swappedFloat = NSSwapHostFloatToLittle(data);
+    [self write:&swappedFloat length:sizeof(NSSwappedFloat)];
+}
+//}}}
+// - (void)writeLittleEndianDouble:(double)data;//{{{
+- (void)writeLittleEndianDouble:(double)data
+{
+    NSSwappedDouble swappedDouble = NSSwapHostDoubleToLittle(data);
+    [self write:&swappedDouble length:sizeof(NSSwappedDouble)];
+}
+//}}}
+
+// Reseting
+// - (void)reset;//{{{
+- (void)reset
+{
+    [self closeFile];
+
+    m_stream.nextRead = 0;
+    m_stream.nextWrite = 0;
+    m_stream.length = 0;
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
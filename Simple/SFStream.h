@@ -15,6 +15,7 @@
  * may change it if you like. Or just use it as it is.
  */
 #import <Foundation/Foundation.h>
+#import "sfstreamio.h"
 
 /**
  * \ingroup sf_networking
@@ -110,6 +111,21 @@
  **/
 - (const uint8_t *)bytesAtIndex:(size_t)offset;
 //}}}
+@optional
+// - (size_t)numberOfContiguousBytes;//{{{
+/**
+ * Gets the number of bytes that can be accessed through #bytes.
+ * @return The number of bytes, starting at the reading position, stored
+ * contiguously at the address returned by #bytes. Streams that keep only a
+ * part of their data in memory, like a spilled SFSpillStream, return less
+ * than #numberOfBytesAvailable. Zero when there is no data available.
+ * @remarks Optional. Streams that don't implement it must keep all bytes
+ * available contiguous. Use SFStreamContiguousLength() to query any stream.
+ * @since 2.1
+ **/
+- (size_t)numberOfContiguousBytes;
+//}}}
+@required
 //@}
 
 /** @name Basic Reading Operations */ //@{
@@ -300,6 +316,26 @@
 //@}
 @end
 
+// NS_INLINE size_t SFStreamContiguousLength(id<SFStreamReaderProtocol> stream);//{{{
+/**
+ * Gets the number of bytes that can be read from the address returned by
+ * SFStreamReaderProtocol::bytes.
+ * Code that reads a stream through its address must use this value instead
+ * of SFStreamReaderProtocol::numberOfBytesAvailable.
+ * @param stream The stream.
+ * @return SFStreamReaderProtocol::numberOfContiguousBytes when the stream
+ * implements it. Otherwise SFStreamReaderProtocol::numberOfBytesAvailable.
+ * @since 2.1
+ **/
+NS_INLINE size_t SFStreamContiguousLength(id<SFStreamReaderProtocol> stream)
+{
+    if ([(id)stream respondsToSelector:@selector(numberOfContiguousBytes)])
+        return [stream numberOfContiguousBytes];
+
+    return [stream numberOfBytesAvailable];
+}
+//}}}
+
 /**
  * \ingroup sf_networking
  * The stream writer protocol.
@@ -320,9 +356,12 @@
 /**
  * Changes the write position.
  * @param offset An offset, from the start of the stream, to position the next
- * write operation. This canno be greater than the length of the stream. If so
- * the operation will fail and the write position will not be changed.
+ * write operation. This canno be greater than the capacity of the stream. If
+ * so the operation will fail and the write position will not be changed.
  * @return \b YES when the position is changed. Otherwise \b NO.
+ * @remarks Moving the write position after the length of the stream extends
+ * it. This is how bytes written through #bufferWithLength: become part of the
+ * stream.
  **/
 - (BOOL)setWritePosition:(size_t)offset;
 //}}}
@@ -521,22 +560,125 @@
 //@}
 @end
 
-/*
- * A readonly memory stream.
+/**
+ * \ingroup sf_networking
+ * A read-only stream over memory it doesn't own.
+ * The object reads the bytes where they are. Nothing is copied and no memory
+ * is allocated, besides the object itself. So it is the cheapest way to
+ * parse a buffer received from elsewhere with the SFStreamReaderProtocol
+ * messages.
+ * @since 2.1
  *//* --------------------------------------------------------------------- */
-// @interface SFStreamReader : NSObject <SFStreamProtocol, SFStreamReaderProtocol>
-// Initialization
-//- (instancetype)initWithBytes:(const void*)data length:(size_t)size;
-//- (instancetype)initWithData:(NSData *)data;
-//@end
+@interface SFStreamReader : NSObject <SFStreamProtocol, SFStreamReaderProtocol>
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithBytes:(const void*)data length:(size_t)size;//{{{
+/**
+ * Initializes the object reading from a memory location.
+ * @param data Memory location of the data. It is not copied and must stay
+ * valid and unchanged while this object is alive.
+ * @param size Amount of bytes in \a data.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithBytes:(const void*)data length:(size_t)size;
+//}}}
+// - (instancetype)initWithData:(NSData *)data;//{{{
+/**
+ * Initializes the object reading from a NSData object.
+ * @param data NSData object with the content. The object keeps it alive.
+ * Immutable objects are only retained. A \c NSMutableData is copied once, so
+ * later changes in it are not seen by this stream.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithData:(NSData *)data;
+//}}}
+//@}
 
-/*
+/** @name C Level Access */ //@{
+// - (stream_t *)handle;//{{{
+/**
+ * Gets the C structure used by this stream.
+ * The structure can be used with the reading functions declared in
+ * sfstreamio.h. Its buffer must never be written.
+ * @return The address of the structure. It is valid while this object is
+ * alive.
+ **/
+- (stream_t *)handle;
+//}}}
+//@}
+@end
+
+/**
+ * \ingroup sf_networking
  * A write only memory stream.
+ * The buffer grows geometrically, as in SFStream, so appending small values
+ * costs an amortized constant time. When the data is complete #detachData
+ * gives the buffer to a NSData object without copying it.
+ * @since 2.1
  *//* --------------------------------------------------------------------- */
-//@interface SFStreamWriter : NSObject <SFStreamProtocol, SFStreamWriterProtocol>
-// Initialization
-//- (instancetype)initWithCapacity:(size_t)capacity;
-//@end
+@interface SFStreamWriter : NSObject <SFStreamProtocol, SFStreamWriterProtocol>
+/** @name Designated Initializers */ //@{
+// - (instancetype)initWithCapacity:(size_t)capacity;//{{{
+/**
+ * Initializes the object with an initial buffer capacity.
+ * @param capacity The initial memory capacity for this stream.
+ * @return This object initialized.
+ **/
+- (instancetype)initWithCapacity:(size_t)capacity;
+//}}}
+//@}
+
+/** @name Memory Management */ //@{
+// @property (nonatomic) float growthFactor;//{{{
+/**
+ * Gets or sets the factor used to grow the stream buffer.
+ * See SFStream::growthFactor. The default value is 2.0.
+ **/
+@property (nonatomic) float growthFactor;
+//}}}
+// - (BOOL)reserveCapacity:(size_t)capacity;//{{{
+/**
+ * Garantees that the stream buffer has, at least, the requested capacity.
+ * @param capacity The total capacity, in bytes, required.
+ * @return \b YES when the stream has the requested capacity. \b NO when
+ * there is no memory available.
+ **/
+- (BOOL)reserveCapacity:(size_t)capacity;
+//}}}
+// - (NSData *)detachData;//{{{
+/**
+ * Gives the written bytes to a NSData object.
+ * The object takes the buffer of this stream, without copying it. The stream
+ * becomes empty, with no capacity, and can be used again.
+ * @return A temporary \c NSData object with #length bytes. An empty object
+ * when nothing was written.
+ **/
+- (NSData *)detachData;
+//}}}
+//@}
+
+/** @name C Level Access */ //@{
+// - (stream_t *)handle;//{{{
+/**
+ * Gets the C structure used by this stream.
+ * The structure can be used with the writing functions declared in
+ * sfstreamio.h.
+ * @return The address of the structure. It is valid while this object is
+ * alive. Don't release or reallocate its buffer directly.
+ **/
+- (stream_t *)handle;
+//}}}
+//@}
+
+/** @name Reseting */ //@{
+// - (void)reset;//{{{
+/**
+ * Sets the write position and the length of the stream to zero.
+ * The capacity remains the same.
+ **/
+- (void)reset;
+//}}}
+//@}
+@end
 
 /**
  * \ingroup sf_networking
@@ -563,11 +705,12 @@
 //}}}
 // - (instancetype)initWithStream:(SFStream *)stream;//{{{
 /**
- * Initializes the object copying data from another SFStream object.
+ * Initializes the object with data from another SFStream object.
  * @param stream SFStrem with data to copy.
  * @return This object initialized.
- * @remarks The copy will start at the current read position. All available
- * bytes will be read.
+ * @remarks The data starts at the current read position. All available
+ * bytes will be read. Since version 2.1 the bytes are not copied. Both
+ * streams share the same buffer until one of them changes it.
  **/
 - (instancetype)initWithStream:(SFStream *)stream;
 //}}}
@@ -593,7 +736,9 @@
  * reads 0 bytes or there is no data available in this stream, the operation
  * returns \b nil.
  * @remarks The read position will be updated with the final amount of data
- * read.
+ * read. Since version 2.1 the bytes are not copied. The \c NSData object
+ * references the stream buffer, which stays alive while the object is alive.
+ * The stream copies its buffer before changing any of those bytes.
  **/
 - (NSData *)dataFromReadingBytes:(intptr_t)amount;
 //}}}
@@ -631,10 +776,28 @@
  * returning \b nil.
  *
  * The read position will be updated with the total number of bytes read after
- * this operation returns.
+ * this operation returns. The bytes are shared as in #streamWithRange:.
  **/
 - (SFStream *)streamFromReadingBytes:(intptr_t)amount;
 //}}}
+// - (SFStream *)streamWithRange:(NSRange)range;//{{{
+/**
+ * Build another SFStream object that is a slice of this stream.
+ * @param range The region of this stream, in bytes from the start of the
+ * stream, that the new object will have.
+ * @return A temporary \c SFStream object with the bytes of \a range. Its read
+ * position is zero. When \a range goes beyond the length of this stream the
+ * function returns \b nil.
+ * @remarks No byte is copied. Both streams reference the same buffer, which
+ * is released with the last one. A stream copies the buffer only when it is
+ * about to change a shared byte (copy-on-write). This stream can still append
+ * data in place after all shared bytes, while its capacity allows.
+ *
+ * The read position of this stream is not changed.
+ * @since 2.1
+ **/
+- (SFStream *)streamWithRange:(NSRange)range;
+//}}}
 // - (size_t)writeStream:(SFStream *)stream length:(size_t)amount;//{{{
 /**
  * Writes data from another SFStream object to this stream.
@@ -652,12 +815,94 @@
 //}}}
 //@}
 
+/** @name Memory Management */ //@{
+// @property (nonatomic) float growthFactor;//{{{
+/**
+ * Gets or sets the factor used to grow the stream buffer.
+ * When a write operation needs more memory than the current capacity the
+ * buffer is reallocated to, at least, the current capacity multiplied by this
+ * factor. This makes a sequence of small writes cost an amortized constant
+ * time instead of one reallocation each. Large buffers are also rounded up to
+ * the system page size.
+ *
+ * The default value is 2.0. Values less than 1.0 are taken as 1.0, which
+ * makes the buffer grow only by the exact amount needed.
+ * @since 2.1
+ **/
+@property (nonatomic) float growthFactor;
+//}}}
+// @property (nonatomic, readonly) size_t highWaterMark;//{{{
+/**
+ * Gets the greatest length this stream has reached.
+ * This value is not changed by #reset nor by #purgeReadBytes. So an encoder
+ * can check it after some work and use it in #reserveCapacity: or
+ * #initWithCapacity: to pre-size the next streams only once.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly) size_t highWaterMark;
+//}}}
+// - (BOOL)reserveCapacity:(size_t)capacity;//{{{
+/**
+ * Garantees that the stream buffer has, at least, the requested capacity.
+ * @param capacity The total capacity, in bytes, required. If the current
+ * capacity is equal or greater than this value the operation does nothing.
+ * @return  YES when the stream has the requested capacity.  NO when
+ * there is no memory available. In this case the buffer is not changed.
+ * @remarks The growth factor is not applied in this operation. The buffer
+ * will have exactly  capacity bytes.
+ * @since 2.1
+ **/
+- (BOOL)reserveCapacity:(size_t)capacity;
+//}}}
+// - (void)shrinkToFit;//{{{
+/**
+ * Releases the memory not used by the stream data.
+ * The capacity will become equal to the stream #length. If the stream is
+ * empty all memory is released.
+ * @remarks The read and write positions are not changed. If the write
+ * position was beyond the length of the stream it will be moved back to the
+ * end of the data.
+ * @since 2.1
+ **/
+- (void)shrinkToFit;
+//}}}
+// @property (nonatomic, readonly, getter=isShared) BOOL shared;//{{{
+/**
+ * Gets whether the buffer of this stream is shared with other objects.
+ * This happens after #streamWithRange:, #streamFromReadingBytes:,
+ * #dataFromReadingBytes: or #initWithStream:. Writing in a shared region
+ * will copy the buffer first.
+ * @since 2.1
+ **/
+@property (nonatomic, readonly, getter=isShared) BOOL shared;
+//}}}
+//@}
+
+/** @name C Level Access */ //@{
+// - (stream_t *)handle;//{{{
+/**
+ * Gets the C structure that holds the buffer of this stream.
+ * The structure can be used with the inline functions declared in
+ * sfstreamio.h, reading and writing primitive values without sending one
+ * message for each value. All the reading and writing messages of this
+ * interface are implemented with the same functions, so both ways can be
+ * mixed freely.
+ * @return The address of the structure. It is valid while this object is
+ * alive. Don't release or reallocate its buffer directly.
+ * @since 2.1
+ **/
+- (stream_t *)handle;
+//}}}
+//@}
+
 /** @name Reseting */ //@{
 // - (void)reset;//{{{
 /**
  * Resets both read and write position.
  * Also the function sets the length of the stream to zero. Still, memory will
  * not be dealocated. The capacity remains the same.
+ * @remarks When the buffer is shared (see #shared) this stream drops its
+ * reference and the capacity becomes zero.
  **/
 - (void)reset;
 //}}}
@@ -14,25 +14,17 @@
 
 #include <stdlib.h>
 
+/**
+ * Default value of the SFStream::growthFactor property.
+ **/
+#define SFSTREAM_DEFAULT_GROWTH_FACTOR  2.0f
+
 /* ===========================================================================
  * SFStream EXTENSION
  * ======================================================================== */
 @interface SFStream () {
-    uint8_t *m_buffer;
-    size_t   m_length;
-    size_t   m_capacity;
-    size_t   m_nextRead;
-    size_t   m_nextWrite;
+    stream_t m_stream;
 }
-// Memory Management
-// - (BOOL)increaseCapacityBy:(size_t)amount;//{{{
-/**
- * Increases the size of the internal buffer when needed.
- * @param amount Amount of bytes to increase the current buffer capacity.
- * @return \b true if the operation succeed. \b false otherwise.
- **/
-- (BOOL)increaseCapacityBy:(size_t)amount;
-//}}}
 @end
 /* ---------------------------------------------------------------------------
  * SFStream Implementation 
@@ -59,11 +51,14 @@
 // - (instancetype)initWithStream:(SFStream *)stream;//{{{
 - (instancetype)initWithStream:(SFStream *)stream
 {
-    size_t amount = [stream numberOfBytesAvailable];
+    stream_t *source = [stream handle];
     
-    self = [self initWithCapacity:amount];
-    if (self) {
-        [self writeStream:stream length:amount];
+    self = [self initWithCapacity:0];
+    if (self && (source != NULL))
+    {
+        /* The bytes are shared, not copied. */
+        if (SFStreamSlice(&m_stream, source, source->nextRead, SFStreamAvailable(source)))
+            source->nextRead = source->length;
     }
     return self;
 }
@@ -74,68 +69,106 @@
     self = [super init];
     if (self)
     {
-        [self increaseCapacityBy:capacity];
+        m_stream.growthFactor = SFSTREAM_DEFAULT_GROWTH_FACTOR;
+        [self reserveCapacity:capacity];
     }
     return self;
 }
 //}}}
 
 // NSObject: Overrides
+// - (id)init;//{{{
+- (id)init
+{
+    return [self initWithCapacity:0];
+}
+//}}}
 // - (void)dealloc;//{{{
 - (void)dealloc
 {
-    if (m_buffer != NULL)
-        free(m_buffer);
-
+    SFStreamRealloc(&m_stream, 0);
     [super dealloc];
 }
 //}}}
 
 // Memory Management
-// - (BOOL)increaseCapacityBy:(size_t)amount;//{{{
-- (BOOL)increaseCapacityBy:(size_t)amount
+// @property (nonatomic) float growthFactor;//{{{
+- (float)growthFactor {
+    return m_stream.growthFactor;
+}
+- (void)setGrowthFactor:(float)growthFactor {
+    m_stream.growthFactor = growthFactor;
+}
+//}}}
+// @property (nonatomic, readonly) size_t highWaterMark;//{{{
+- (size_t)highWaterMark {
+    return m_stream.highWater;
+}
+//}}}
+// - (BOOL)reserveCapacity:(size_t)capacity;//{{{
+- (BOOL)reserveCapacity:(size_t)capacity
 {
-    size_t total = m_capacity + amount;
-    uint8_t *ptr = NULL;
+    if (capacity <= m_stream.capacity)
+        return YES;
+
+    return SFStreamRealloc(&m_stream, capacity);
+}
+//}}}
+// - (void)shrinkToFit;//{{{
+- (void)shrinkToFit
+{
+    if (m_stream.length == m_stream.capacity)
+        return;
 
-    ptr = (uint8_t *)realloc(m_buffer, total);
-    if (ptr == NULL)
-        return FALSE;
+    if (!SFStreamRealloc(&m_stream, m_stream.length))
+        return;             /* Keeps the larger buffer. Nothing is lost. */
 
-    m_buffer = ptr;
-    m_capacity = total;
-    return TRUE;
+    if (m_stream.nextWrite > m_stream.length)
+        m_stream.nextWrite = m_stream.length;
+}
+//}}}
+
+// @property (nonatomic, readonly, getter=isShared) BOOL shared;//{{{
+- (BOOL)isShared {
+    return (m_stream.storage != NULL);
+}
+//}}}
+
+// C Level Access
+// - (stream_t *)handle;//{{{
+- (stream_t *)handle {
+    return &m_stream;
 }
 //}}}
 
 // SFStreamProtocol: Properties Implementation
 // - (size_t)capacity;//{{{
 - (size_t)capacity {
-    return m_capacity;
+    return m_stream.capacity;
 }
 //}}}
 // - (size_t)length;//{{{
 - (size_t)length {
-    return m_length;
+    return m_stream.length;
 }
 //}}}
 
 // SFStreamReaderProtocol Reading Information
 // - (size_t)readPosition;//{{{
 - (size_t)readPosition {
-    return m_nextRead;
+    return m_stream.nextRead;
 }
 //}}}
 // - (size_t)numberOfBytesAvailable;//{{{
 - (size_t)numberOfBytesAvailable {
-    return (m_length - m_nextRead);
+    return SFStreamAvailable(&m_stream);
 }
 //}}}
 // - (BOOL)setReadPosition:(size_t)offset;//{{{
 - (BOOL)setReadPosition:(size_t)offset
 {
-    if (offset > m_length) return NO;
-    m_nextRead = offset;
+    if (offset > m_stream.length) return NO;
+    m_stream.nextRead = offset;
     return YES;
 }
 //}}}
@@ -144,16 +177,21 @@
 // - (const uint8_t *)bytes;//{{{
 - (const uint8_t *)bytes
 {
-    return (m_buffer + m_nextRead);
+    return (m_stream.buffer + m_stream.nextRead);
 }
 //}}}
 // - (const uint8_t *)bytesAtIndex:(size_t)offset;//{{{
 - (const uint8_t *)bytesAtIndex:(size_t)offset
 {
-    sfassert(offset < m_length, "SFStream::bytesAtIndex[] offset greater than length\n");
-    if (offset >= m_length) return NULL;
+    sfassert(offset < m_stream.length, "SFStream::bytesAtIndex[] offset greater than length\n");
+    if (offset >= m_stream.length) return NULL;
 
-    return (m_buffer + offset);
+    return (m_stream.buffer + offset);
+}
+//}}}
+// - (size_t)numberOfContiguousBytes;//{{{
+- (size_t)numberOfContiguousBytes {
+    return SFStreamAvailable(&m_stream);
 }
 //}}}
 
@@ -161,98 +199,87 @@
 // - (size_t)read:(void *)buffer length:(size_t)length;//{{{
 - (size_t)read:(void *)buffer length:(size_t)length
 {
-    if ((buffer == NULL) || (length == 0) || (m_buffer == NULL))
-        return 0;
-
-    if (length > [self numberOfBytesAvailable])
-        length = [self numberOfBytesAvailable];
-
-    memcpy(buffer, (m_buffer + m_nextRead), length);
-    m_nextRead += length;
-
-    return length;
+    return SFStreamRead(&m_stream, buffer, length);
 }
 //}}}
 // - (uint8_t)readByte;//{{{
 - (uint8_t)readByte
 {
-    uint8_t buffer = (uint8_t)0;
+    uint8_t value = 0;
 
-    [self read:&buffer length:sizeof(uint8_t)];
-    return buffer;
+    SFStreamReadByte(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (uint16_t)readShort;//{{{
 - (uint16_t)readShort
 {
-    uint16_t buffer;
-
-    if ([self read:&buffer length:sizeof(uint16_t)] == sizeof(uint16_t))
-        return buffer;
+    uint16_t value = 0;
 
-    return (uint16_t)0;
+    SFStreamReadShort(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (uint32_t)readInt;//{{{
 - (uint32_t)readInt
 {
-    uint32_t buffer;
-
-    if ([self read:&buffer length:sizeof(uint32_t)] == sizeof(uint32_t))
-        return buffer;
+    uint32_t value = 0;
 
-    return (uint32_t)0;
+    SFStreamReadInt(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (uint64_t)readLong;//{{{
 - (uint64_t)readLong
 {
-    uint64_t buffer;
+    uint64_t value = 0;
 
-    if ([self read:&buffer length:sizeof(uint64_t)] == sizeof(uint64_t))
-        return buffer;
-
-    return (uint64_t)0;
+    SFStreamReadLong(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (float)readFloat;//{{{
 - (float)readFloat
 {
-    float buffer;
-
-    if ([self read:&buffer length:sizeof(float)] == sizeof(float))
-        return buffer;
+    float value = 0.0f;
 
-    return (float)0.0;
+    SFStreamReadFloat(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (double)readDouble;//{{{
 - (double)readDouble
 {
-    double buffer;
+    double value = 0.0;
 
-    if ([self read:&buffer length:sizeof(double)] == sizeof(double))
-        return buffer;
-
-    return 0.0;
+    SFStreamReadDouble(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (void)purgeReadBytes;//{{{
 - (void)purgeReadBytes
 {
-    size_t bytesToMove = [self numberOfBytesAvailable];
+    size_t bytesToMove = SFStreamAvailable(&m_stream);
 
-    if ((m_buffer == NULL) || (m_nextRead == 0))
+    if ((m_stream.buffer == NULL) || (m_stream.nextRead == 0))
         return;
 
-    memmove(m_buffer, (m_buffer + m_nextRead), bytesToMove);
-    if (m_nextWrite <= m_nextRead)
-        m_nextWrite = 0;
+    /* Bytes of a shared buffer cannot be moved. Its start is moved instead. */
+    if (m_stream.storage != NULL)
+    {
+        m_stream.buffer   += m_stream.nextRead;
+        m_stream.capacity -= m_stream.nextRead;
+    }
+    else
+        memmove(m_stream.buffer, (m_stream.buffer + m_stream.nextRead), bytesToMove);
+    if (m_stream.nextWrite <= m_stream.nextRead)
+        m_stream.nextWrite = 0;
     else
-        m_nextWrite -= m_nextRead;
+        m_stream.nextWrite -= m_stream.nextRead;
 
-    m_length -= m_nextRead;
-    m_nextRead = 0;
+    m_stream.purged += m_stream.nextRead;
+    m_stream.length -= m_stream.nextRead;
+    m_stream.nextRead = 0;
 }
 //}}}
 
@@ -260,37 +287,46 @@
 // - (uint16_t)readBigEndianShort;//{{{
 - (uint16_t)readBigEndianShort
 {
-    return NSSwapBigShortToHost([self readShort]);
+    uint16_t value = 0;
+
+    SFStreamReadBigEndianShort(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (uint32_t)readBigEndianInt;//{{{
 - (uint32_t)readBigEndianInt
 {
-    return NSSwapBigIntToHost([self readInt]);
+    uint32_t value = 0;
+
+    SFStreamReadBigEndianInt(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (uint64_t)readBigEndignLong;//{{{
 - (uint64_t)readBigEndignLong
 {
-    return NSSwapBigLongLongToHost([self readLong]);
+    uint64_t value = 0;
+
+    SFStreamReadBigEndianLong(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (float)readBigEndianFloat;//{{{
 - (float)readBigEndianFloat
 {
-    NSSwappedFloat swappedFloat = { 0 };
+    float value = 0.0f;
 
-    [self read:&swappedFloat length:sizeof(NSSwappedFloat)];
-    return NSSwapBigFloatToHost(swappedFloat);
+    SFStreamReadBigEndianFloat(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (double)readBigEndianDouble;//{{{
 - (double)readBigEndianDouble
 {
-    NSSwappedDouble swappedDouble = { 0 };
+    double value = 0.0;
 
-    [self read:&swappedDouble length:sizeof(NSSwappedDouble)];
-    return NSSwapBigDoubleToHost(swappedDouble);
+    SFStreamReadBigEndianDouble(&m_stream, &value);
+    return value;
 }
 //}}}
 
@@ -298,51 +334,65 @@
 // - (uint16_t)readLittleEndianShort;//{{{
 - (uint16_t)readLittleEndianShort
 {
-    return NSSwapLittleShortToHost([self readShort]);
+    uint16_t value = 0;
+
+    SFStreamReadLittleEndianShort(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (uint32_t)readLittleEndianInt;//{{{
 - (uint32_t)readLittleEndianInt
 {
-    return NSSwapLittleIntToHost([self readInt]);
+    uint32_t value = 0;
+
+    SFStreamReadLittleEndianInt(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (uint64_t)readLittleEndianLong;//{{{
 - (uint64_t)readLittleEndianLong
 {
-    return NSSwapLittleLongLongToHost([self readLong]);
+    uint64_t value = 0;
+
+    SFStreamReadLittleEndianLong(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (float)readLittleEndianFloat;//{{{
 - (float)readLittleEndianFloat
 {
-    NSSwappedFloat swappedFloat = { 0 };
+    float value = 0.0f;
 
-    [self read:&swappedFloat length:sizeof(NSSwappedFloat)];
-    return NSSwapLittleFloatToHost(swappedFloat);
+    SFStreamReadLittleEndianFloat(&m_stream, &value);
+    return value;
 }
 //}}}
 // - (double)readLittleEndianDouble;//{{{
 - (double)readLittleEndianDouble
 {
-    NSSwappedDouble swappedDouble = { 0 };
+    double value = 0.0;
 
-    [self read:&swappedDouble length:sizeof(NSSwappedDouble)];
-    return NSSwapLittleDoubleToHost(swappedDouble);
+    SFStreamReadLittleEndianDouble(&m_stream, &value);
+    return value;
 }
 //}}}
 
 // SFStreamWriterProtocol Writting Information
 // - (size_t)writePosition;//{{{
 - (size_t)writePosition {
-    return m_nextWrite;
+    return m_stream.nextWrite;
 }
 //}}}
 // - (BOOL)setWritePosition:(size_t)offset;//{{{
 - (BOOL)setWritePosition:(size_t)offset
 {
-    if (offset > m_capacity) return NO;
-    m_nextWrite = offset;
+    if (offset > m_stream.capacity) return NO;
+
+    /* Commits bytes written through bufferWithLength:. */
+    if (offset > m_stream.nextWrite)
+        __SFStreamCommit(&m_stream, (offset - m_stream.nextWrite));
+    else
+        m_stream.nextWrite = offset;
     return YES;
 }
 //}}}
@@ -353,11 +403,8 @@
 {
     if (length == 0)
         return NULL;
-    else if (length > (m_capacity - m_nextWrite)) {
-        if (![self increaseCapacityBy:(length - (m_capacity - m_nextWrite))])
-            return NULL;
-    }
-    return (void *)(m_buffer + m_nextWrite);
+
+    return (void *)__SFStreamReserve(&m_stream, length);
 }
 //}}}
 
@@ -365,58 +412,43 @@
 // - (size_t)write:(const void*)data length:(size_t)size;//{{{
 - (size_t)write:(const void*)data length:(size_t)size
 {
-    if ((data == NULL) || (size == 0))
-        return 0;
-
-    size_t available = (m_capacity - m_nextWrite);
-
-    if (size > available)
-    {
-        if (![self increaseCapacityBy:(size - available)])
-            return (size_t)0;
-    }
-
-    memcpy((m_buffer + m_nextWrite), data, size);
-    m_nextWrite += size;
-    if (m_nextWrite > m_length)
-        m_length = m_nextWrite;
-    return size;
+    return SFStreamWrite(&m_stream, data, size);
 }
 //}}}
 // - (void)writeByte:(uint8_t)data;//{{{
 - (void)writeByte:(uint8_t)data
 {
-    [self write:&data length:sizeof(uint8_t)];
+    SFStreamWriteByte(&m_stream, data);
 }
 //}}}
 // - (void)writeShort:(uint16_t)data;//{{{
 - (void)writeShort:(uint16_t)data
 {
-    [self write:&data length:sizeof(uint16_t)];
+    SFStreamWriteShort(&m_stream, data);
 }
 //}}}
 // - (void)writeInt:(uint32_t)data;//{{{
 - (void)writeInt:(uint32_t)data
 {
-    [self write:&data length:sizeof(uint32_t)];
+    SFStreamWriteInt(&m_stream, data);
 }
 //}}}
 // - (void)writeLong:(uint64_t)data;//{{{
 - (void)writeLong:(uint64_t)data
 {
-    [self write:&data length:sizeof(uint64_t)];
+    SFStreamWriteLong(&m_stream, data);
 }
 //}}}
 // - (void)writeFloat:(float)data;//{{{
 - (void)writeFloat:(float)data
 {
-    [self write:&data length:sizeof(float)];
+    SFStreamWriteFloat(&m_stream, data);
 }
 //}}}
 // - (void)writeDouble:(double)data;//{{{
 - (void)writeDouble:(double)data
 {
-    [self write:&data length:sizeof(double)];
+    SFStreamWriteDouble(&m_stream, data);
 }
 //}}}
 
@@ -424,33 +456,31 @@
 // - (void)writeBigEndianShort:(uint16_t)data;//{{{
 - (void)writeBigEndianShort:(uint16_t)data
 {
-    [self writeShort:NSSwapHostShortToBig(data)];
+    SFStreamWriteBigEndianShort(&m_stream, data);
 }
 //}}}
 // - (void)writeBigEndianInt:(uint32_t)data;//{{{
 - (void)writeBigEndianInt:(uint32_t)data
 {
-    [self writeInt:NSSwapHostIntToBig(data)];
+    SFStreamWriteBigEndianInt(&m_stream, data);
 }
 //}}}
 // - (void)writeBigEndianLong:(uint64_t)data;//{{{
 - (void)writeBigEndianLong:(uint64_t)data
 {
-    [self writeLong:NSSwapHostLongLongToBig(data)];
+    SFStreamWriteBigEndianLong(&m_stream, data);
 }
 //}}}
 // - (void)writeBigEndianFloat:(float)data;//{{{
 - (void)writeBigEndianFloat:(float)data
 {
-    NSSwappedFloat swappedFloat = NSSwapHostFloatToBig(data);
-    [self write:&swappedFloat length:sizeof(NSSwappedFloat)];
+    SFStreamWriteBigEndianFloat(&m_stream, data);
 }
 //}}}
 // - (void)writeBigEndianDouble:(double)data;//{{{
 - (void)writeBigEndianDouble:(double)data
 {
-    NSSwappedDouble swappedDouble = NSSwapHostDoubleToBig(data);
-    [self write:&swappedDouble length:sizeof(NSSwappedDouble)];
+    SFStreamWriteBigEndianDouble(&m_stream, data);
 }
 //}}}
 
@@ -458,33 +488,31 @@
 // - (void)writeLittleEndianShort:(uint16_t)data;//{{{
 - (void)writeLittleEndianShort:(uint16_t)data
 {
-    [self writeShort:NSSwapHostShortToLittle(data)];
+    SFStreamWriteLittleEndianShort(&m_stream, data);
 }
 //}}}
 // - (void)writeLittleEndianInt:(uint32_t)data;//{{{
 - (void)writeLittleEndianInt:(uint32_t)data
 {
-    [self writeInt:NSSwapHostIntToLittle(data)];
+    SFStreamWriteLittleEndianInt(&m_stream, data);
 }
 //}}}
 // - (void)writeLittleEndianLong:(uint64_t)data;//{{{
 - (void)writeLittleEndianLong:(uint64_t)data
 {
-    [self writeLong:NSSwapHostLongLongToLittle(data)];
+    SFStreamWriteLittleEndianLong(&m_stream, data);
 }
 //}}}
 // - (void)writeLittleEndianFloat:(float)data;//{{{
 - (void)writeLittleEndianFloat:(float)data
 {
-    NSSwappedFloat swappedFloat = NSSwapHostFloatToLittle(data);
-    [self write:&swappedFloat length:sizeof(NSSwappedFloat)];
+    SFStreamWriteLittleEndianFloat(&m_stream, data);
 }
 //}}}
 // - (void)writeLittleEndianDouble:(double)data;//{{{
 - (void)writeLittleEndianDouble:(double)data
 {
-    NSSwappedDouble swappedDouble = NSSwapHostDoubleToLittle(data);
-    [self write:&swappedDouble length:sizeof(NSSwappedDouble)];
+    SFStreamWriteLittleEndianDouble(&m_stream, data);
 }
 //}}}
 
@@ -500,9 +528,18 @@
     if ((total > available) || (total == 0) || (available == 0))
         return nil;
 
-    NSData *data = [NSData dataWithBytes:(m_buffer + m_nextRead) length:total];
+    struct SF_STREAM_STORAGE *storage = SFStreamShare(&m_stream, m_stream.nextRead, total);
+    NSData *data = nil;
+
+    if (storage == NULL)
+        return nil;
+
+    /* The object keeps a reference to the buffer until it is released. */
+    data = [NSData dataWithBytesNoCopy:(m_stream.buffer + m_stream.nextRead) length:total deallocator:^(void *bytes, NSUInteger length) {
+        SFStreamStorageRelease(storage);
+    }];
 
-    m_nextRead += total;
+    m_stream.nextRead += total;
     return data;
 }
 //}}}
@@ -533,9 +570,24 @@
             total = (size_t)amount;
     }
 
-    SFStream *stream = [[SFStream alloc] initWithBytes:(m_buffer + m_nextRead) length:total];
-    m_nextRead += total;
+    SFStream *stream = [self streamWithRange:NSMakeRange(m_stream.nextRead, total)];
+
+    if (stream != nil)
+        m_stream.nextRead += total;
+
+    return stream;
+}
+//}}}
+// - (SFStream *)streamWithRange:(NSRange)range;//{{{
+- (SFStream *)streamWithRange:(NSRange)range
+{
+    SFStream *stream = [[SFStream alloc] initWithCapacity:0];
 
+    if (!SFStreamSlice([stream handle], &m_stream, range.location, range.length))
+    {
+        [stream release];
+        return nil;
+    }
     return [stream autorelease];
 }
 //}}}
@@ -549,10 +601,9 @@
     if (amount == 0)
         return 0;
 
-    if (amount > (m_capacity - m_nextWrite)) {
-        if (![self increaseCapacityBy:(amount - (m_capacity - m_nextWrite))])
-            return 0;
-    }
+    /* Grows the buffer before getting the source address. */
+    if (__SFStreamReserve(&m_stream, amount) == NULL)
+        return 0;
 
     amount = [self write:[stream bytes] length:amount];
     [stream setReadPosition:([stream readPosition] + amount)];
@@ -565,9 +616,543 @@
 // - (void)reset;//{{{
 - (void)reset
 {
-    m_nextRead = 0;
-    m_nextWrite = 0;
-    m_length = 0;
+    /* Other objects may still read a shared buffer. It is dropped. */
+    if (m_stream.storage != NULL)
+        SFStreamRealloc(&m_stream, 0);
+
+    m_stream.nextRead = 0;
+    m_stream.nextWrite = 0;
+    m_stream.length = 0;
+}
+//}}}
+@end
+
+/* ===========================================================================
+ * SFStreamReader EXTENSION
+ * ======================================================================== */
+@interface SFStreamReader () {
+    stream_t m_stream;              /* Borrowed buffer. Never freed.        */
+    NSData  *m_data;
+}
+@end
+/* ---------------------------------------------------------------------------
+ * SFStreamReader Implementation
+ * ------------------------------------------------------------------------ */
+@implementation SFStreamReader
+// Designated Initializers
+// - (instancetype)initWithBytes:(const void*)data length:(size_t)size;//{{{
+- (instancetype)initWithBytes:(const void*)data length:(size_t)size
+{
+    self = [super init];
+    if (self)
+    {
+        m_stream.buffer   = (uint8_t *)data;
+        m_stream.length   = ((data != NULL) ? size : 0);
+        m_stream.capacity = m_stream.length;
+    }
+    return self;
+}
+//}}}
+// - (instancetype)initWithData:(NSData *)data;//{{{
+- (instancetype)initWithData:(NSData *)data
+{
+    NSData *content = [data copy];
+
+    self = [self initWithBytes:[content bytes] length:[content length]];
+    if (self)
+        m_data = content;
+    else
+        [content release];
+
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (id)init;//{{{
+- (id)init
+{
+    return [self initWithBytes:NULL length:0];
+}
+//}}}
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    [m_data release];
+    [super dealloc];
+}
+//}}}
+
+// C Level Access
+// - (stream_t *)handle;//{{{
+- (stream_t *)handle {
+    return &m_stream;
+}
+//}}}
+
+// SFStreamProtocol: Properties Implementation
+// - (size_t)capacity;//{{{
+- (size_t)capacity {
+    return m_stream.capacity;
+}
+//}}}
+// - (size_t)length;//{{{
+- (size_t)length {
+    return m_stream.length;
+}
+//}}}
+
+// SFStreamReaderProtocol Reading Information
+// - (size_t)readPosition;//{{{
+- (size_t)readPosition {
+    return m_stream.nextRead;
+}
+//}}}
+// - (size_t)numberOfBytesAvailable;//{{{
+- (size_t)numberOfBytesAvailable {
+    return SFStreamAvailable(&m_stream);
+}
+//}}}
+// - (BOOL)setReadPosition:(size_t)offset;//{{{
+- (BOOL)setReadPosition:(size_t)offset
+{
+    if (offset > m_stream.length) return NO;
+    m_stream.nextRead = offset;
+    return YES;
+}
+//}}}
+
+// SFStreamReaderProtocol Direct Access
+// - (const uint8_t *)bytes;//{{{
+- (const uint8_t *)bytes
+{
+    return (m_stream.buffer + m_stream.nextRead);
+}
+//}}}
+// - (const uint8_t *)bytesAtIndex:(size_t)offset;//{{{
+- (const uint8_t *)bytesAtIndex:(size_t)offset
+{
+    sfassert(offset < m_stream.length, "SFStreamReader::bytesAtIndex[] offset greater than length\n");
+    if (offset >= m_stream.length) return NULL;
+
+    return (m_stream.buffer + offset);
+}
+//}}}
+// - (size_t)numberOfContiguousBytes;//{{{
+- (size_t)numberOfContiguousBytes {
+    return SFStreamAvailable(&m_stream);
+}
+//}}}
+
+// SFStreamReaderProtocol Basic Reading Operations
+// - (size_t)read:(void *)buffer length:(size_t)length;//{{{
+- (size_t)read:(void *)buffer length:(size_t)length
+{
+    return SFStreamRead(&m_stream, buffer, length);
+}
+//}}}
+// - (uint8_t)readByte;//{{{
+- (uint8_t)readByte
+{
+    uint8_t value = 0;
+
+    SFStreamReadByte(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (uint16_t)readShort;//{{{
+- (uint16_t)readShort
+{
+    uint16_t value = 0;
+
+    SFStreamReadShort(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (uint32_t)readInt;//{{{
+- (uint32_t)readInt
+{
+    uint32_t value = 0;
+
+    SFStreamReadInt(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (uint64_t)readLong;//{{{
+- (uint64_t)readLong
+{
+    uint64_t value = 0;
+
+    SFStreamReadLong(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (float)readFloat;//{{{
+- (float)readFloat
+{
+    float value = 0.0f;
+
+    SFStreamReadFloat(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (double)readDouble;//{{{
+- (double)readDouble
+{
+    double value = 0.0;
+
+    SFStreamReadDouble(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (void)purgeReadBytes;//{{{
+- (void)purgeReadBytes
+{
+    /* The bytes are not ours. The start of the stream is moved instead. */
+    m_stream.buffer   += m_stream.nextRead;
+    m_stream.capacity -= m_stream.nextRead;
+    m_stream.length   -= m_stream.nextRead;
+    m_stream.purged   += m_stream.nextRead;
+    m_stream.nextRead  = 0;
+}
+//}}}
+
+// SFStreamReaderProtocol Big-Endian to Host Conversions
+// - (uint16_t)readBigEndianShort;//{{{
+- (uint16_t)readBigEndianShort
+{
+    uint16_t value = 0;
+
+    SFStreamReadBigEndianShort(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (uint32_t)readBigEndianInt;//{{{
+- (uint32_t)readBigEndianInt
+{
+    uint32_t value = 0;
+
+    SFStreamReadBigEndianInt(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (uint64_t)readBigEndignLong;//{{{
+- (uint64_t)readBigEndignLong
+{
+    uint64_t value = 0;
+
+    SFStreamReadBigEndianLong(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (float)readBigEndianFloat;//{{{
+- (float)readBigEndianFloat
+{
+    float value = 0.0f;
+
+    SFStreamReadBigEndianFloat(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (double)readBigEndianDouble;//{{{
+- (double)readBigEndianDouble
+{
+    double value = 0.0;
+
+    SFStreamReadBigEndianDouble(&m_stream, &value);
+    return value;
+}
+//}}}
+
+// SFStreamReaderProtocol Little-Endian to Host Conversions
+// - (uint16_t)readLittleEndianShort;//{{{
+- (uint16_t)readLittleEndianShort
+{
+    uint16_t value = 0;
+
+    SFStreamReadLittleEndianShort(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (uint32_t)readLittleEndianInt;//{{{
+- (uint32_t)readLittleEndianInt
+{
+    uint32_t value = 0;
+
+    SFStreamReadLittleEndianInt(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (uint64_t)readLittleEndianLong;//{{{
+- (uint64_t)readLittleEndianLong
+{
+    uint64_t value = 0;
+
+    SFStreamReadLittleEndianLong(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (float)readLittleEndianFloat;//{{{
+- (float)readLittleEndianFloat
+{
+    float value = 0.0f;
+
+    SFStreamReadLittleEndianFloat(&m_stream, &value);
+    return value;
+}
+//}}}
+// - (double)readLittleEndianDouble;//{{{
+- (double)readLittleEndianDouble
+{
+    double value = 0.0;
+
+    SFStreamReadLittleEndianDouble(&m_stream, &value);
+    return value;
+}
+//}}}
+@end
+
+/* ===========================================================================
+ * SFStreamWriter EXTENSION
+ * ======================================================================== */
+@interface SFStreamWriter () {
+    stream_t m_stream;
+}
+@end
+/* ---------------------------------------------------------------------------
+ * SFStreamWriter Implementation
+ * ------------------------------------------------------------------------ */
+@implementation SFStreamWriter
+// Designated Initializers
+// - (instancetype)initWithCapacity:(size_t)capacity;//{{{
+- (instancetype)initWithCapacity:(size_t)capacity
+{
+    self = [super init];
+    if (self)
+    {
+        m_stream.growthFactor = SFSTREAM_DEFAULT_GROWTH_FACTOR;
+        [self reserveCapacity:capacity];
+    }
+    return self;
+}
+//}}}
+
+// NSObject: Overrides
+// - (id)init;//{{{
+- (id)init
+{
+    return [self initWithCapacity:0];
+}
+//}}}
+// - (void)dealloc;//{{{
+- (void)dealloc
+{
+    SFStreamRealloc(&m_stream, 0);
+    [super dealloc];
+}
+//}}}
+
+// Memory Management
+// @property (nonatomic) float growthFactor;//{{{
+- (float)growthFactor {
+    return m_stream.growthFactor;
+}
+- (void)setGrowthFactor:(float)growthFactor {
+    m_stream.growthFactor = growthFactor;
+}
+//}}}
+// - (BOOL)reserveCapacity:(size_t)capacity;//{{{
+- (BOOL)reserveCapacity:(size_t)capacity
+{
+    if (capacity <= m_stream.capacity)
+        return YES;
+
+    return SFStreamRealloc(&m_stream, capacity);
+}
+//}}}
+// - (NSData *)detachData;//{{{
+- (NSData *)detachData
+{
+    NSData *data;
+
+    if (m_stream.length == 0)
+        return [NSData data];
+
+    /* The buffer was allocated with realloc(). NSData frees it. */
+    data = [NSData dataWithBytesNoCopy:m_stream.buffer length:m_stream.length freeWhenDone:YES];
+
+    m_stream.buffer    = NULL;
+    m_stream.capacity  = 0;
+    m_stream.length    = 0;
+    m_stream.nextWrite = 0;
+    return data;
+}
+//}}}
+
+// C Level Access
+// - (stream_t *)handle;//{{{
+- (stream_t *)handle {
+    return &m_stream;
+}
+//}}}
+
+// SFStreamProtocol: Properties Implementation
+// - (size_t)capacity;//{{{
+- (size_t)capacity {
+    return m_stream.capacity;
+}
+//}}}
+// - (size_t)length;//{{{
+- (size_t)length {
+    return m_stream.length;
+}
+//}}}
+
+// SFStreamWriterProtocol Writting Information
+// - (size_t)writePosition;//{{{
+- (size_t)writePosition {
+    return m_stream.nextWrite;
+}
+//}}}
+// - (BOOL)setWritePosition:(size_t)offset;//{{{
+- (BOOL)setWritePosition:(size_t)offset
+{
+    if (offset > m_stream.capacity) return NO;
+
+    /* Commits bytes written through bufferWithLength:. */
+    if (offset > m_stream.nextWrite)
+        __SFStreamCommit(&m_stream, (offset - m_stream.nextWrite));
+    else
+        m_stream.nextWrite = offset;
+    return YES;
+}
+//}}}
+
+// SFStreamWriterProtocol Direct Access
+// - (void *)bufferWithLength:(size_t)length;//{{{
+- (void *)bufferWithLength:(size_t)length
+{
+    if (length == 0)
+        return NULL;
+
+    return (void *)__SFStreamReserve(&m_stream, length);
+}
+//}}}
+
+// SFStreamWriterProtocol Basic Writting Operations
+// - (size_t)write:(const void*)data length:(size_t)size;//{{{
+- (size_t)write:(const void*)data length:(size_t)size
+{
+    return SFStreamWrite(&m_stream, data, size);
+}
+//}}}
+// - (void)writeByte:(uint8_t)data;//{{{
+- (void)writeByte:(uint8_t)data
+{
+    SFStreamWriteByte(&m_stream, data);
+}
+//}}}
+// - (void)writeShort:(uint16_t)data;//{{{
+- (void)writeShort:(uint16_t)data
+{
+    SFStreamWriteShort(&m_stream, data);
+}
+//}}}
+// - (void)writeInt:(uint32_t)data;//{{{
+- (void)writeInt:(uint32_t)data
+{
+    SFStreamWriteInt(&m_stream, data);
+}
+//}}}
+// - (void)writeLong:(uint64_t)data;//{{{
+- (void)writeLong:(uint64_t)data
+{
+    SFStreamWriteLong(&m_stream, data);
+}
+//}}}
+// - (void)writeFloat:(float)data;//{{{
+- (void)writeFloat:(float)data
+{
+    SFStreamWriteFloat(&m_stream, data);
+}
+//}}}
+// - (void)writeDouble:(double)data;//{{{
+- (void)writeDouble:(double)data
+{
+    SFStreamWriteDouble(&m_stream, data);
+}
+//}}}
+
+// SFStreamWriterProtocol Host to Big-Endian Conversions
+// - (void)writeBigEndianShort:(uint16_t)data;//{{{
+- (void)writeBigEndianShort:(uint16_t)data
+{
+    SFStreamWriteBigEndianShort(&m_stream, data);
+}
+//}}}
+// - (void)writeBigEndianInt:(uint32_t)data;//{{{
+- (void)writeBigEndianInt:(uint32_t)data
+{
+    SFStreamWriteBigEndianInt(&m_stream, data);
+}
+//}}}
+// - (void)writeBigEndianLong:(uint64_t)data;//{{{
+- (void)writeBigEndianLong:(uint64_t)data
+{
+    SFStreamWriteBigEndianLong(&m_stream, data);
+}
+//}}}
+// - (void)writeBigEndianFloat:(float)data;//{{{
+- (void)writeBigEndianFloat:(float)data
+{
+    SFStreamWriteBigEndianFloat(&m_stream, data);
+}
+//}}}
+// - (void)writeBigEndianDouble:(double)data;//{{{
+- (void)writeBigEndianDouble:(double)data
+{
+    SFStreamWriteBigEndianDouble(&m_stream, data);
+}
+//}}}
+
+// SFStreamWriterProtocol Host to Little-Endian Conversions
+// - (void)writeLittleEndianShort:(uint16_t)data;//{{{
+- (void)writeLittleEndianShort:(uint16_t)data
+{
+    SFStreamWriteLittleEndianShort(&m_stream, data);
+}
+//}}}
+// - (void)writeLittleEndianInt:(uint32_t)data;//{{{
+- (void)writeLittleEndianInt:(uint32_t)data
+{
+    SFStreamWriteLittleEndianInt(&m_stream, data);
+}
+//}}}
+// - (void)writeLittleEndianLong:(uint64_t)data;//{{{
+- (void)writeLittleEndianLong:(uint64_t)data
+{
+    SFStreamWriteLittleEndianLong(&m_stream, data);
+}
+//}}}
+// - (void)writeLittleEndianFloat:(float)data;//{{{
+- (void)writeLittleEndianFloat:(float)data
+{
+    SFStreamWriteLittleEndianFloat(&m_stream, data);
+}
+//}}}
+// - (void)writeLittleEndianDouble:(double)data;//{{{
+- (void)writeLittleEndianDouble:(double)data
+{
+    SFStreamWriteLittleEndianDouble(&m_stream, data);
+}
+//}}}
+
+// Reseting
+// - (void)reset;//{{{
+- (void)reset
+{
+    m_stream.nextWrite = 0;
+    m_stream.length = 0;
 }
 //}}}
 @end
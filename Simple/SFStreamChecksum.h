@@ -0,0 +1,75 @@
+/**
+ * \file
+ * Declares the SFChecksum Objective-C category extension for SFStream
+ * interface.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "SFStream.h"
+#import "sfchecksum.h"
+
+/**
+ * \ingroup sf_networking
+ * SFStream checksum additions.
+ * The operations work on the stream buffer directly and never move the read
+ * or write positions. So a frame can be checked before it is parsed, and the
+ * checksums of an outgoing message can be computed while it is written. See
+ * sfchecksum.h for the algorithms.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFStream (SFChecksum)
+/** @name Available Bytes */ //@{
+// - (uint32_t)crc32cOfLength:(size_t)length;//{{{
+/**
+ * Computes the CRC32C of the next bytes to be read.
+ * @param length Number of bytes, starting at the read position. It is
+ * limited to the number of bytes available.
+ * @return The CRC32C of the bytes. The read position is not changed.
+ **/
+- (uint32_t)crc32cOfLength:(size_t)length;
+//}}}
+// - (uint64_t)hash64OfLength:(size_t)length seed:(uint64_t)seed;//{{{
+/**
+ * Computes the 64 bits hash of the next bytes to be read.
+ * @param length Number of bytes, starting at the read position. It is
+ * limited to the number of bytes available.
+ * @param seed Seed of the hash.
+ * @return The hash of the bytes. The read position is not changed.
+ **/
+- (uint64_t)hash64OfLength:(size_t)length seed:(uint64_t)seed;
+//}}}
+//@}
+
+/** @name Written Bytes */ //@{
+// - (void)startChecksum:(stream_checksum_t *)checksum seed:(uint64_t)seed;//{{{
+/**
+ * Starts the checksums of the next bytes written in this stream.
+ * @param checksum The structure that keeps the checksums.
+ * @param seed Seed of the 64 bits hash.
+ * @remarks After each write send #updateChecksum:. The results are in the
+ * \c crc member and in SFHash64Final() of the \c hash member.
+ **/
+- (void)startChecksum:(stream_checksum_t *)checksum seed:(uint64_t)seed;
+//}}}
+// - (void)updateChecksum:(stream_checksum_t *)checksum;//{{{
+/**
+ * Adds the bytes written since the last call to the checksums.
+ * @param checksum The structure initialized by #startChecksum:seed:.
+ * @remarks #purgeReadBytes can be called between updates. Only bytes
+ * already processed by this method can be purged.
+ **/
+- (void)updateChecksum:(stream_checksum_t *)checksum;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
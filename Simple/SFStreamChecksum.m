@@ -0,0 +1,59 @@
+/**
+ * \file
+ * Defines the SFChecksum Objective-C category extension for SFStream
+ * interface.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFStreamChecksum.h"
+
+/* ===========================================================================
+ * SFChecksum CATEGORY EXTENSION
+ * ======================================================================== */
+@implementation SFStream (SFChecksum)
+// Available Bytes
+// - (uint32_t)crc32cOfLength:(size_t)length;//{{{
+- (uint32_t)crc32cOfLength:(size_t)length
+{
+    stream_t *s = [self handle];
+    size_t available = SFStreamAvailable(s);
+
+    if (length > available) length = available;
+    return SFCrc32c(0, (s->buffer + s->nextRead), length);
+}
+//}}}
+// - (uint64_t)hash64OfLength:(size_t)length seed:(uint64_t)seed;//{{{
+- (uint64_t)hash64OfLength:(size_t)length seed:(uint64_t)seed
+{
+    stream_t *s = [self handle];
+    size_t available = SFStreamAvailable(s);
+
+    if (length > available) length = available;
+    return SFHash64((s->buffer + s->nextRead), length, seed);
+}
+//}}}
+
+// Written Bytes
+// - (void)startChecksum:(stream_checksum_t *)checksum seed:(uint64_t)seed;//{{{
+- (void)startChecksum:(stream_checksum_t *)checksum seed:(uint64_t)seed
+{
+    SFStreamChecksumStart(checksum, [self handle], seed);
+}
+//}}}
+// - (void)updateChecksum:(stream_checksum_t *)checksum;//{{{
+- (void)updateChecksum:(stream_checksum_t *)checksum
+{
+    SFStreamChecksumUpdate(checksum, [self handle]);
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
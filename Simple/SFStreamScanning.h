@@ -0,0 +1,83 @@
+/**
+ * \file
+ * Declares the SFScanning Objective-C category extension for SFStream
+ * interface.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "SFStream.h"
+#import "sfscan.h"
+
+/**
+ * \ingroup sf_networking
+ * SFStream search additions.
+ * Finds delimiters in the stream buffer with the vectorized functions of
+ * sfscan.h, instead of reading one byte per message. Positions are offsets
+ * from the start of the stream, as in SFStreamReaderProtocol::readPosition.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFStream (SFScanning)
+/** @name Searching */ //@{
+// - (size_t)indexOfByte:(uint8_t)value fromPosition:(size_t)position;//{{{
+/**
+ * Finds a byte in the stream.
+ * @param value The byte to find.
+ * @param position Offset where the search starts.
+ * @return The offset of the first \a value at or after \a position. \c
+ * NSNotFound when there is none.
+ **/
+- (size_t)indexOfByte:(uint8_t)value fromPosition:(size_t)position;
+//}}}
+// - (size_t)indexOfBytes:(const void *)bytes length:(size_t)length fromPosition:(size_t)position;//{{{
+/**
+ * Finds a byte sequence in the stream.
+ * @param bytes The sequence to find.
+ * @param length Number of bytes in \a bytes.
+ * @param position Offset where the search starts.
+ * @return The offset of the first byte of the first sequence found at or
+ * after \a position. \c NSNotFound when there is none or \a length is zero.
+ **/
+- (size_t)indexOfBytes:(const void *)bytes length:(size_t)length fromPosition:(size_t)position;
+//}}}
+//@}
+
+/** @name Reading */ //@{
+// - (SFStream *)readUntilDelimiter:(NSData *)delimiter;//{{{
+/**
+ * Reads the bytes before a delimiter.
+ * @param delimiter The delimiter, like \c "\r\n".
+ * @return A temporary \c SFStream object with the bytes from the read
+ * position up to the delimiter, not including it. The bytes are shared, as
+ * in SFStream::streamWithRange:. \b nil when the delimiter is not found. In
+ * this case the read position doesn't change.
+ * @remarks The read position is moved after the delimiter.
+ **/
+- (SFStream *)readUntilDelimiter:(NSData *)delimiter;
+//}}}
+// - (SFStream *)readUntilDelimiter:(NSData *)delimiter resume:(size_t *)resume;//{{{
+/**
+ * Reads the bytes before a delimiter, resuming a previous search.
+ * @param delimiter The delimiter.
+ * @param resume Number of bytes after the read position already searched.
+ * Start with zero. When the delimiter is not found the operation stores
+ * where the next search must start, so bytes are not searched again when
+ * more data arrives. When it is found the value becomes zero.
+ * @return The same as #readUntilDelimiter:.
+ * @remarks The value in \a resume is relative to the read position. So it
+ * stays valid after #purgeReadBytes.
+ **/
+- (SFStream *)readUntilDelimiter:(NSData *)delimiter resume:(size_t *)resume;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
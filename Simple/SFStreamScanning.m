@@ -0,0 +1,89 @@
+/**
+ * \file
+ * Defines the SFScanning Objective-C category extension for SFStream
+ * interface.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFStreamScanning.h"
+
+/* ===========================================================================
+ * SFScanning CATEGORY EXTENSION
+ * ======================================================================== */
+@implementation SFStream (SFScanning)
+// Searching
+// - (size_t)indexOfByte:(uint8_t)value fromPosition:(size_t)position;//{{{
+- (size_t)indexOfByte:(uint8_t)value fromPosition:(size_t)position
+{
+    stream_t *s = [self handle];
+
+    if (position >= s->length)
+        return NSNotFound;
+
+    const uint8_t *ptr = SFScanByte((s->buffer + position), (s->length - position), value);
+    return ((ptr != NULL) ? (size_t)(ptr - s->buffer) : NSNotFound);
+}
+//}}}
+// - (size_t)indexOfBytes:(const void *)bytes length:(size_t)length fromPosition:(size_t)position;//{{{
+- (size_t)indexOfBytes:(const void *)bytes length:(size_t)length fromPosition:(size_t)position
+{
+    stream_t *s = [self handle];
+
+    if ((bytes == NULL) || (length == 0) || (position >= s->length))
+        return NSNotFound;
+
+    const uint8_t *ptr = SFScanBytes((s->buffer + position), (s->length - position), (const uint8_t *)bytes, length);
+    return ((ptr != NULL) ? (size_t)(ptr - s->buffer) : NSNotFound);
+}
+//}}}
+
+// Reading
+// - (SFStream *)readUntilDelimiter:(NSData *)delimiter;//{{{
+- (SFStream *)readUntilDelimiter:(NSData *)delimiter
+{
+    return [self readUntilDelimiter:delimiter resume:NULL];
+}
+//}}}
+// - (SFStream *)readUntilDelimiter:(NSData *)delimiter resume:(size_t *)resume;//{{{
+- (SFStream *)readUntilDelimiter:(NSData *)delimiter resume:(size_t *)resume
+{
+    stream_t *s = [self handle];
+    size_t count = [delimiter length];
+    size_t available = SFStreamAvailable(s);
+    size_t searched = ((resume != NULL) ? *resume : 0);
+
+    if (count == 0)
+        return nil;
+
+    if (searched > available) searched = available;
+
+    size_t index = [self indexOfBytes:[delimiter bytes] length:count fromPosition:(s->nextRead + searched)];
+    if (index == NSNotFound)
+    {
+        /* A delimiter may start in the last count - 1 bytes. */
+        if (resume != NULL)
+            *resume = ((available >= count) ? (available - count + 1) : 0);
+        return nil;
+    }
+
+    SFStream *stream = [self streamWithRange:NSMakeRange(s->nextRead, (index - s->nextRead))];
+    if (stream == nil)
+        return nil;
+
+    s->nextRead = (index + count);
+    if (resume != NULL) *resume = 0;
+
+    return stream;
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
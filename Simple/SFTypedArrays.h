@@ -0,0 +1,243 @@
+/**
+ * \file
+ * Declares the SFTypedArrays Objective-C category extension for
+ * SFStream interface.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "SFStream.h"
+#import "sfbyteswap.h"
+
+/**
+ * \ingroup sf_networking
+ * SFStream typed array additions.
+ * Each operation checks the bounds once and copies the whole array between
+ * the caller memory and the stream buffer, reversing the byte order with
+ * vector instructions when needed (see sfbyteswap.h). Decoding large arrays
+ * this way avoids one message and one bounds check per element.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+@interface SFStream (SFTypedArrays)
+/** @name Reading Big-Endian Arrays */ //@{
+// - (BOOL)readBigEndianInt16Array:(uint16_t *)values count:(size_t)count;//{{{
+/**
+ * Reads an array of \c uint16_t values stored in big-endian order.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ **/
+- (BOOL)readBigEndianInt16Array:(uint16_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)readBigEndianInt32Array:(uint32_t *)values count:(size_t)count;//{{{
+/**
+ * Reads an array of \c uint32_t values stored in big-endian order.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ **/
+- (BOOL)readBigEndianInt32Array:(uint32_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)readBigEndianInt64Array:(uint64_t *)values count:(size_t)count;//{{{
+/**
+ * Reads an array of \c uint64_t values stored in big-endian order.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ **/
+- (BOOL)readBigEndianInt64Array:(uint64_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)readBigEndianFloatArray:(float *)values count:(size_t)count;//{{{
+/**
+ * Reads an array of \c float values stored in big-endian order.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ **/
+- (BOOL)readBigEndianFloatArray:(float *)values count:(size_t)count;
+//}}}
+// - (BOOL)readBigEndianDoubleArray:(double *)values count:(size_t)count;//{{{
+/**
+ * Reads an array of \c double values stored in big-endian order.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ **/
+- (BOOL)readBigEndianDoubleArray:(double *)values count:(size_t)count;
+//}}}
+//@}
+
+/** @name Reading Little-Endian Arrays */ //@{
+// - (BOOL)readLittleEndianInt16Array:(uint16_t *)values count:(size_t)count;//{{{
+/**
+ * Reads an array of \c uint16_t values stored in little-endian order.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ **/
+- (BOOL)readLittleEndianInt16Array:(uint16_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)readLittleEndianInt32Array:(uint32_t *)values count:(size_t)count;//{{{
+/**
+ * Reads an array of \c uint32_t values stored in little-endian order.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ **/
+- (BOOL)readLittleEndianInt32Array:(uint32_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)readLittleEndianInt64Array:(uint64_t *)values count:(size_t)count;//{{{
+/**
+ * Reads an array of \c uint64_t values stored in little-endian order.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ **/
+- (BOOL)readLittleEndianInt64Array:(uint64_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)readLittleEndianFloatArray:(float *)values count:(size_t)count;//{{{
+/**
+ * Reads an array of \c float values stored in little-endian order.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ **/
+- (BOOL)readLittleEndianFloatArray:(float *)values count:(size_t)count;
+//}}}
+// - (BOOL)readLittleEndianDoubleArray:(double *)values count:(size_t)count;//{{{
+/**
+ * Reads an array of \c double values stored in little-endian order.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ **/
+- (BOOL)readLittleEndianDoubleArray:(double *)values count:(size_t)count;
+//}}}
+//@}
+
+/** @name Writing Big-Endian Arrays */ //@{
+// - (BOOL)writeBigEndianInt16Array:(const uint16_t *)values count:(size_t)count;//{{{
+/**
+ * Writes an array of \c uint16_t values in big-endian order.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeBigEndianInt16Array:(const uint16_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)writeBigEndianInt32Array:(const uint32_t *)values count:(size_t)count;//{{{
+/**
+ * Writes an array of \c uint32_t values in big-endian order.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeBigEndianInt32Array:(const uint32_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)writeBigEndianInt64Array:(const uint64_t *)values count:(size_t)count;//{{{
+/**
+ * Writes an array of \c uint64_t values in big-endian order.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeBigEndianInt64Array:(const uint64_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)writeBigEndianFloatArray:(const float *)values count:(size_t)count;//{{{
+/**
+ * Writes an array of \c float values in big-endian order.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeBigEndianFloatArray:(const float *)values count:(size_t)count;
+//}}}
+// - (BOOL)writeBigEndianDoubleArray:(const double *)values count:(size_t)count;//{{{
+/**
+ * Writes an array of \c double values in big-endian order.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeBigEndianDoubleArray:(const double *)values count:(size_t)count;
+//}}}
+//@}
+
+/** @name Writing Little-Endian Arrays */ //@{
+// - (BOOL)writeLittleEndianInt16Array:(const uint16_t *)values count:(size_t)count;//{{{
+/**
+ * Writes an array of \c uint16_t values in little-endian order.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeLittleEndianInt16Array:(const uint16_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)writeLittleEndianInt32Array:(const uint32_t *)values count:(size_t)count;//{{{
+/**
+ * Writes an array of \c uint32_t values in little-endian order.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeLittleEndianInt32Array:(const uint32_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)writeLittleEndianInt64Array:(const uint64_t *)values count:(size_t)count;//{{{
+/**
+ * Writes an array of \c uint64_t values in little-endian order.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeLittleEndianInt64Array:(const uint64_t *)values count:(size_t)count;
+//}}}
+// - (BOOL)writeLittleEndianFloatArray:(const float *)values count:(size_t)count;//{{{
+/**
+ * Writes an array of \c float values in little-endian order.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeLittleEndianFloatArray:(const float *)values count:(size_t)count;
+//}}}
+// - (BOOL)writeLittleEndianDoubleArray:(const double *)values count:(size_t)count;//{{{
+/**
+ * Writes an array of \c double values in little-endian order.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ **/
+- (BOOL)writeLittleEndianDoubleArray:(const double *)values count:(size_t)count;
+//}}}
+//@}
+@end
+// vim:ft=objc syntax=objc.doxygen
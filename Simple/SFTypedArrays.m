@@ -0,0 +1,151 @@
+/**
+ * \file
+ * Defines the SFTypedArrays Objective-C category extension for
+ * SFStream interface.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "SFTypedArrays.h"
+
+/* ===========================================================================
+ * SFTypedArrays CATEGORY EXTENSION
+ * ======================================================================== */
+@implementation SFStream (SFTypedArrays)
+// Reading Big-Endian Arrays
+// - (BOOL)readBigEndianInt16Array:(uint16_t *)values count:(size_t)count;//{{{
+- (BOOL)readBigEndianInt16Array:(uint16_t *)values count:(size_t)count
+{
+    return SFStreamReadArray([self handle], values, count, sizeof(uint16_t), YES);
+}
+//}}}
+// - (BOOL)readBigEndianInt32Array:(uint32_t *)values count:(size_t)count;//{{{
+- (BOOL)readBigEndianInt32Array:(uint32_t *)values count:(size_t)count
+{
+    return SFStreamReadArray([self handle], values, count, sizeof(uint32_t), YES);
+}
+//}}}
+// - (BOOL)readBigEndianInt64Array:(uint64_t *)values count:(size_t)count;//{{{
+- (BOOL)readBigEndianInt64Array:(uint64_t *)values count:(size_t)count
+{
+    return SFStreamReadArray([self handle], values, count, sizeof(uint64_t), YES);
+}
+//}}}
+// - (BOOL)readBigEndianFloatArray:(float *)values count:(size_t)count;//{{{
+- (BOOL)readBigEndianFloatArray:(float *)values count:(size_t)count
+{
+    return SFStreamReadArray([self handle], values, count, sizeof(float), YES);
+}
+//}}}
+// - (BOOL)readBigEndianDoubleArray:(double *)values count:(size_t)count;//{{{
+- (BOOL)readBigEndianDoubleArray:(double *)values count:(size_t)count
+{
+    return SFStreamReadArray([self handle], values, count, sizeof(double), YES);
+}
+//}}}
+
+// Reading Little-Endian Arrays
+// - (BOOL)readLittleEndianInt16Array:(uint16_t *)values count:(size_t)count;//{{{
+- (BOOL)readLittleEndianInt16Array:(uint16_t *)values count:(size_t)count
+{
+    return SFStreamReadArray([self handle], values, count, sizeof(uint16_t), NO);
+}
+//}}}
+// - (BOOL)readLittleEndianInt32Array:(uint32_t *)values count:(size_t)count;//{{{
+- (BOOL)readLittleEndianInt32Array:(uint32_t *)values count:(size_t)count
+{
+    return SFStreamReadArray([self handle], values, count, sizeof(uint32_t), NO);
+}
+//}}}
+// - (BOOL)readLittleEndianInt64Array:(uint64_t *)values count:(size_t)count;//{{{
+- (BOOL)readLittleEndianInt64Array:(uint64_t *)values count:(size_t)count
+{
+    return SFStreamReadArray([self handle], values, count, sizeof(uint64_t), NO);
+}
+//}}}
+// - (BOOL)readLittleEndianFloatArray:(float *)values count:(size_t)count;//{{{
+- (BOOL)readLittleEndianFloatArray:(float *)values count:(size_t)count
+{
+    return SFStreamReadArray([self handle], values, count, sizeof(float), NO);
+}
+//}}}
+// - (BOOL)readLittleEndianDoubleArray:(double *)values count:(size_t)count;//{{{
+- (BOOL)readLittleEndianDoubleArray:(double *)values count:(size_t)count
+{
+    return SFStreamReadArray([self handle], values, count, sizeof(double), NO);
+}
+//}}}
+
+// Writing Big-Endian Arrays
+// - (BOOL)writeBigEndianInt16Array:(const uint16_t *)values count:(size_t)count;//{{{
+- (BOOL)writeBigEndianInt16Array:(const uint16_t *)values count:(size_t)count
+{
+    return SFStreamWriteArray([self handle], values, count, sizeof(uint16_t), YES);
+}
+//}}}
+// - (BOOL)writeBigEndianInt32Array:(const uint32_t *)values count:(size_t)count;//{{{
+- (BOOL)writeBigEndianInt32Array:(const uint32_t *)values count:(size_t)count
+{
+    return SFStreamWriteArray([self handle], values, count, sizeof(uint32_t), YES);
+}
+//}}}
+// - (BOOL)writeBigEndianInt64Array:(const uint64_t *)values count:(size_t)count;//{{{
+- (BOOL)writeBigEndianInt64Array:(const uint64_t *)values count:(size_t)count
+{
+    return SFStreamWriteArray([self handle], values, count, sizeof(uint64_t), YES);
+}
+//}}}
+// - (BOOL)writeBigEndianFloatArray:(const float *)values count:(size_t)count;//{{{
+- (BOOL)writeBigEndianFloatArray:(const float *)values count:(size_t)count
+{
+    return SFStreamWriteArray([self handle], values, count, sizeof(float), YES);
+}
+//}}}
+// - (BOOL)writeBigEndianDoubleArray:(const double *)values count:(size_t)count;//{{{
+- (BOOL)writeBigEndianDoubleArray:(const double *)values count:(size_t)count
+{
+    return SFStreamWriteArray([self handle], values, count, sizeof(double), YES);
+}
+//}}}
+
+// Writing Little-Endian Arrays
+// - (BOOL)writeLittleEndianInt16Array:(const uint16_t *)values count:(size_t)count;//{{{
+- (BOOL)writeLittleEndianInt16Array:(const uint16_t *)values count:(size_t)count
+{
+    return SFStreamWriteArray([self handle], values, count, sizeof(uint16_t), NO);
+}
+//}}}
+// - (BOOL)writeLittleEndianInt32Array:(const uint32_t *)values count:(size_t)count;//{{{
+- (BOOL)writeLittleEndianInt32Array:(const uint32_t *)values count:(size_t)count
+{
+    return SFStreamWriteArray([self handle], values, count, sizeof(uint32_t), NO);
+}
+//}}}
+// - (BOOL)writeLittleEndianInt64Array:(const uint64_t *)values count:(size_t)count;//{{{
+- (BOOL)writeLittleEndianInt64Array:(const uint64_t *)values count:(size_t)count
+{
+    return SFStreamWriteArray([self handle], values, count, sizeof(uint64_t), NO);
+}
+//}}}
+// - (BOOL)writeLittleEndianFloatArray:(const float *)values count:(size_t)count;//{{{
+- (BOOL)writeLittleEndianFloatArray:(const float *)values count:(size_t)count
+{
+    return SFStreamWriteArray([self handle], values, count, sizeof(float), NO);
+}
+//}}}
+// - (BOOL)writeLittleEndianDoubleArray:(const double *)values count:(size_t)count;//{{{
+- (BOOL)writeLittleEndianDoubleArray:(const double *)values count:(size_t)count
+{
+    return SFStreamWriteArray([self handle], values, count, sizeof(double), NO);
+}
+//}}}
+@end
+// vim:syntax=objc.doxygen
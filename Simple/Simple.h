@@ -37,8 +37,32 @@ FOUNDATION_EXPORT const unsigned char SimpleVersionString[];
 #import "SFColor.h"
 
 // Networking:
+#import "sfstreamio.h"
+#import "sfvarint.h"
+#import "sfbyteswap.h"
+#import "sfchecksum.h"
+#import "sflz.h"
+#import "sfscan.h"
+#import "sfbits.h"
 #import "SFStream.h"
+#import "SFFraming.h"
+#import "SFTypedArrays.h"
+#import "SFStreamChecksum.h"
+#import "SFCompression.h"
+#import "SFStreamScanning.h"
+#import "SFBitStream.h"
+#import "SFRingStream.h"
+#import "SFChunkPool.h"
+#import "SFSegmentedStream.h"
+#import "SFMappedStream.h"
+#import "SFSpillStream.h"
+#import "SFSocketProfile.h"
 #import "SFSocket.h"
+#import "SFSocketLoop.h"
+#import "SFSocketServer.h"
+#import "SFDatagramSocket.h"
+#import "SFResolver.h"
+#import "SFConnectionPool.h"
 #import "SFReachability.h"
 
 // XML Support:
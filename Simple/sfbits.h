@@ -0,0 +1,393 @@
+/**
+ * \file
+ * Declares the C level bit reading and writing functions.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import <libkern/OSByteOrder.h>
+#import "sfstreamio.h"
+
+/**
+ * \ingroup sf_networking
+ * \defgroup sf_networking_bits Bit Fields
+ * Functions to read and write fields of any number of bits.
+ * Bits are stored most significant first, the order used by network and
+ * media formats. The reader keeps up to 64 bits in a register and refills it
+ * with a single unaligned 64 bits load, so most reads are a shift and a
+ * compare. The writer collects bits the same way and stores whole bytes only
+ * when the register is full.
+ *
+ * The reader takes bytes from the stream as it refills. Use
+ * SFBitReaderSync() before reading bytes from the stream directly. The
+ * writer stores bytes only when it drains. Use SFBitWriterFlush() before
+ * using the stream data.
+ * @since 2.1
+ * @{ *//* ---------------------------------------------------------------- */
+
+/**
+ * State of a bit reader. Initialize with SFBitReaderInit().
+ **/
+struct SF_BIT_READER {
+    stream_t *stream;               /**< The stream read.                   */
+    uint64_t  cache;                /**< Bits not read, left aligned.       */
+    unsigned  count;                /**< Number of valid bits in \c cache.  */
+};
+typedef struct SF_BIT_READER bitreader_t;
+
+/**
+ * State of a bit writer. Initialize with SFBitWriterInit().
+ **/
+struct SF_BIT_WRITER {
+    stream_t *stream;               /**< The stream written.                */
+    uint64_t  cache;                /**< Bits not stored, left aligned.     */
+    unsigned  count;                /**< Number of valid bits in \c cache.  */
+};
+typedef struct SF_BIT_WRITER bitwriter_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @name Variable Length Codes */ //@{
+// BOOL SFBitReaderReadUnary(bitreader_t *r, uint64_t *value);//{{{
+/**
+ * Reads an unary code: \a value zero bits followed by a one bit.
+ * @param r The reader.
+ * @param value Receives the number of zero bits.
+ * @return \b YES on success. \b NO when the stream ends before the one bit.
+ * In this case nothing is read.
+ * @since 2.1
+ **/
+BOOL SFBitReaderReadUnary(bitreader_t *r, uint64_t *value);
+//}}}
+// BOOL SFBitReaderReadExpGolomb(bitreader_t *r, uint64_t *value);//{{{
+/**
+ * Reads an unsigned exp-Golomb code of order zero.
+ * @param r The reader.
+ * @param value Receives the value.
+ * @return \b YES on success. \b NO when the code is incomplete or longer
+ * than 64 bits of value. In this case nothing is read.
+ * @since 2.1
+ **/
+BOOL SFBitReaderReadExpGolomb(bitreader_t *r, uint64_t *value);
+//}}}
+// BOOL SFBitReaderReadSignedExpGolomb(bitreader_t *r, int64_t *value);//{{{
+/**
+ * Reads a signed exp-Golomb code of order zero.
+ * Values 0, 1, -1, 2, -2... are coded as 0, 1, 2, 3, 4...
+ * @param r The reader.
+ * @param value Receives the value.
+ * @return \b YES on success. \b NO when the code is incomplete. In this case
+ * nothing is read.
+ * @since 2.1
+ **/
+BOOL SFBitReaderReadSignedExpGolomb(bitreader_t *r, int64_t *value);
+//}}}
+// BOOL SFBitWriterWriteUnary(bitwriter_t *w, uint64_t value);//{{{
+/**
+ * Writes an unary code.
+ * @param w The writer.
+ * @param value Number of zero bits before the one bit.
+ * @return \b YES on success. \b NO when there is no memory available.
+ * @since 2.1
+ **/
+BOOL SFBitWriterWriteUnary(bitwriter_t *w, uint64_t value);
+//}}}
+// BOOL SFBitWriterWriteExpGolomb(bitwriter_t *w, uint64_t value);//{{{
+/**
+ * Writes an unsigned exp-Golomb code of order zero.
+ * @param w The writer.
+ * @param value The value.
+ * @return \b YES on success. \b NO when there is no memory available or
+ * \a value is \c UINT64_MAX, that cannot be coded.
+ * @since 2.1
+ **/
+BOOL SFBitWriterWriteExpGolomb(bitwriter_t *w, uint64_t value);
+//}}}
+// BOOL SFBitWriterWriteSignedExpGolomb(bitwriter_t *w, int64_t value);//{{{
+/**
+ * Writes a signed exp-Golomb code of order zero.
+ * @param w The writer.
+ * @param value The value.
+ * @return \b YES on success. \b NO when there is no memory available or
+ * \a value is \c INT64_MIN, that cannot be coded.
+ * @since 2.1
+ **/
+BOOL SFBitWriterWriteSignedExpGolomb(bitwriter_t *w, int64_t value);
+//}}}
+//@}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @cond SF_PRIVATE */
+NS_INLINE uint64_t __SFBitShift(uint64_t value, unsigned bits)
+{
+    return ((bits < 64) ? (value << bits) : 0);
+}
+
+NS_INLINE uint64_t __SFBitTake(bitreader_t *r, unsigned n)
+{
+    uint64_t value = (r->cache >> (64 - n));
+
+    r->cache = __SFBitShift(r->cache, n);
+    r->count -= n;
+    return value;
+}
+
+NS_INLINE void __SFBitPut(bitwriter_t *w, uint64_t value, unsigned n)
+{
+    w->cache |= (value << (64 - w->count - n));
+    w->count += n;
+}
+/** @endcond */
+
+/** @name Reading */ //@{
+// void SFBitReaderInit(bitreader_t *r, stream_t *s);//{{{
+/**
+ * Initializes a bit reader.
+ * @param r The reader.
+ * @param s The stream to read. Bits start at its read position.
+ * @since 2.1
+ **/
+NS_INLINE void SFBitReaderInit(bitreader_t *r, stream_t *s)
+{
+    r->stream = s;
+    r->cache = 0;
+    r->count = 0;
+}
+//}}}
+// void SFBitReaderRefill(bitreader_t *r);//{{{
+/**
+ * Loads as many bytes as possible into the reader register.
+ * The reading functions call this when needed.
+ * @param r The reader.
+ * @since 2.1
+ **/
+NS_INLINE void SFBitReaderRefill(bitreader_t *r)
+{
+    stream_t *s = r->stream;
+    size_t available = (s->length - s->nextRead);
+    const uint8_t *ptr = (s->buffer + s->nextRead);
+
+    if (r->count > 56)
+        return;
+
+    if (available >= 8)
+    {
+        /* Bits after the whole bytes taken are loaded again next time. */
+        unsigned bytes = ((63 - r->count) >> 3);
+
+        r->cache |= (OSReadBigInt64(ptr, 0) >> r->count);
+        r->count += (bytes << 3);
+        s->nextRead += bytes;
+        return;
+    }
+
+    while ((r->count <= 56) && (available-- > 0))
+    {
+        r->cache |= ((uint64_t)(*ptr++) << (56 - r->count));
+        r->count += 8;
+        s->nextRead++;
+    }
+}
+//}}}
+// size_t SFBitReaderAvailable(const bitreader_t *r);//{{{
+/**
+ * Gets the number of bits that can still be read.
+ * @param r The reader.
+ * @return Number of bits in the register and in the stream.
+ * @since 2.1
+ **/
+NS_INLINE size_t SFBitReaderAvailable(const bitreader_t *r)
+{
+    return (r->count + ((r->stream->length - r->stream->nextRead) << 3));
+}
+//}}}
+// BOOL SFBitReaderRead(bitreader_t *r, unsigned n, uint64_t *value);//{{{
+/**
+ * Reads a field.
+ * @param r The reader.
+ * @param n Number of bits, from 0 to 64.
+ * @param value Receives the field, right aligned.
+ * @return \b YES on success. \b NO when there are not enough bits. In this
+ * case nothing is read.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFBitReaderRead(bitreader_t *r, unsigned n, uint64_t *value)
+{
+    if (n == 0) {
+        *value = 0;
+        return YES;
+    }
+
+    if (r->count < n)
+    {
+        SFBitReaderRefill(r);
+        if (r->count < n)
+        {
+            /* Wide fields don't fit in one refill. */
+            if ((n <= 56) || (n > 64) || (SFBitReaderAvailable(r) < n))
+                return NO;
+
+            uint64_t high = __SFBitTake(r, (n - 32));
+            SFBitReaderRefill(r);
+            *value = ((high << 32) | __SFBitTake(r, 32));
+            return YES;
+        }
+    }
+
+    *value = __SFBitTake(r, n);
+    return YES;
+}
+//}}}
+// BOOL SFBitReaderAlign(bitreader_t *r);//{{{
+/**
+ * Skips the bits up to the next byte boundary.
+ * @param r The reader.
+ * @return \b YES. The operation cannot fail.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFBitReaderAlign(bitreader_t *r)
+{
+    unsigned extra = (r->count & 7);
+
+    r->cache <<= extra;
+    r->count -= extra;
+    return YES;
+}
+//}}}
+// void SFBitReaderSync(bitreader_t *r);//{{{
+/**
+ * Gives back to the stream the whole bytes in the register.
+ * After this the read position of the stream is just after the byte that
+ * has the next bit to read. When the reader is aligned the stream can be
+ * read directly from there.
+ * @param r The reader.
+ * @since 2.1
+ **/
+NS_INLINE void SFBitReaderSync(bitreader_t *r)
+{
+    r->stream->nextRead -= (r->count >> 3);
+    r->count &= 7;
+    r->cache &= ~(UINT64_MAX >> r->count);
+    if (r->count == 0) r->cache = 0;
+}
+//}}}
+//@}
+
+/** @name Writing */ //@{
+// void SFBitWriterInit(bitwriter_t *w, stream_t *s);//{{{
+/**
+ * Initializes a bit writer.
+ * @param w The writer.
+ * @param s The stream to write. Bits start at its write position.
+ * @since 2.1
+ **/
+NS_INLINE void SFBitWriterInit(bitwriter_t *w, stream_t *s)
+{
+    w->stream = s;
+    w->cache = 0;
+    w->count = 0;
+}
+//}}}
+// BOOL SFBitWriterDrain(bitwriter_t *w);//{{{
+/**
+ * Stores the whole bytes of the register in the stream.
+ * The writing functions call this when needed.
+ * @param w The writer.
+ * @return \b YES on success. \b NO when there is no memory available.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFBitWriterDrain(bitwriter_t *w)
+{
+    unsigned bytes = (w->count >> 3);
+    uint8_t *ptr = __SFStreamReserve(w->stream, sizeof(uint64_t));
+    uint64_t word;
+
+    if (ptr == NULL)
+        return NO;
+
+    /* Exactly the whole bytes, so data after the position is kept. */
+    OSWriteBigInt64(&word, 0, w->cache);
+    memcpy(ptr, &word, bytes);
+    __SFStreamCommit(w->stream, bytes);
+
+    w->cache = __SFBitShift(w->cache, (bytes << 3));
+    w->count &= 7;
+    return YES;
+}
+//}}}
+// BOOL SFBitWriterWrite(bitwriter_t *w, uint64_t value, unsigned n);//{{{
+/**
+ * Writes a field.
+ * @param w The writer.
+ * @param value The field, right aligned. Bits above \a n are ignored.
+ * @param n Number of bits, from 0 to 64.
+ * @return \b YES on success. \b NO when there is no memory available.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFBitWriterWrite(bitwriter_t *w, uint64_t value, unsigned n)
+{
+    if ((n == 0) || (n > 64))
+        return (n == 0);
+
+    if (n < 64) value &= ((1ULL << n) - 1);
+
+    if (((w->count + n) > 64) && !SFBitWriterDrain(w))
+        return NO;
+
+    /* After a drain less than 8 bits remain. Wide fields go in two parts. */
+    if ((w->count + n) > 64)
+    {
+        __SFBitPut(w, (value >> 32), (n - 32));
+        if (!SFBitWriterDrain(w)) return NO;
+        __SFBitPut(w, (value & 0xFFFFFFFFULL), 32);
+        return YES;
+    }
+
+    __SFBitPut(w, value, n);
+    return YES;
+}
+//}}}
+// BOOL SFBitWriterAlign(bitwriter_t *w);//{{{
+/**
+ * Writes zero bits up to the next byte boundary.
+ * @param w The writer.
+ * @return \b YES. The operation cannot fail.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFBitWriterAlign(bitwriter_t *w)
+{
+    w->count = ((w->count + 7) & ~7U);
+    return YES;
+}
+//}}}
+// BOOL SFBitWriterFlush(bitwriter_t *w);//{{{
+/**
+ * Aligns the writer and stores all its bits in the stream.
+ * @param w The writer.
+ * @return \b YES on success. \b NO when there is no memory available.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFBitWriterFlush(bitwriter_t *w)
+{
+    SFBitWriterAlign(w);
+    return SFBitWriterDrain(w);
+}
+//}}}
+//@}
+
+///@} sf_networking_bits
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,161 @@
+/**
+ * \file
+ * Defines the C level variable length bit codes.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "sfbits.h"
+#import "sfdebug.h"
+
+/**
+ * Greatest number of leading zeros in an exp-Golomb code.
+ **/
+#define SF_BITS_MAX_ZEROS       63
+
+/* ===========================================================================
+ * LOCAL FUNCTIONS
+ * ======================================================================== */
+// static inline uint64_t SFBitReaderValid(const bitreader_t *r);//{{{
+/**
+ * Gets the register without the bits loaded after the valid ones.
+ **/
+static inline uint64_t SFBitReaderValid(const bitreader_t *r)
+{
+    if (r->count >= 64) return r->cache;
+    return (r->cache & ~(UINT64_MAX >> r->count));
+}
+//}}}
+// static BOOL SFBitReaderZeros(bitreader_t *r, uint64_t limit, uint64_t *zeros);//{{{
+/**
+ * Counts and skips zero bits up to a one bit, also skipped.
+ * The reader is not restored on failure.
+ **/
+static BOOL SFBitReaderZeros(bitreader_t *r, uint64_t limit, uint64_t *zeros)
+{
+    uint64_t valid, total = 0;
+    unsigned lead;
+
+    for (;;)
+    {
+        SFBitReaderRefill(r);
+        if (r->count == 0) return NO;
+
+        if ((valid = SFBitReaderValid(r)) != 0)
+            break;
+
+        total += r->count;
+        if (total > limit) return NO;
+
+        r->cache = 0;
+        r->count = 0;
+    }
+
+    lead = (unsigned)__builtin_clzll(valid);
+    total += lead;
+    if (total > limit) return NO;
+
+    r->cache = __SFBitShift(r->cache, (lead + 1));
+    r->count -= (lead + 1);
+    *zeros = total;
+    return YES;
+}
+//}}}
+
+/* ===========================================================================
+ * VARIABLE LENGTH CODES
+ * ======================================================================== */
+// BOOL SFBitReaderReadUnary(bitreader_t *r, uint64_t *value);//{{{
+BOOL SFBitReaderReadUnary(bitreader_t *r, uint64_t *value)
+{
+    bitreader_t saved = *r;
+    size_t nextRead = r->stream->nextRead;
+
+    if (SFBitReaderZeros(r, UINT64_MAX, value))
+        return YES;
+
+    *r = saved;
+    r->stream->nextRead = nextRead;
+    return NO;
+}
+//}}}
+// BOOL SFBitReaderReadExpGolomb(bitreader_t *r, uint64_t *value);//{{{
+BOOL SFBitReaderReadExpGolomb(bitreader_t *r, uint64_t *value)
+{
+    bitreader_t saved = *r;
+    size_t nextRead = r->stream->nextRead;
+    uint64_t zeros, bits;
+
+    if (SFBitReaderZeros(r, SF_BITS_MAX_ZEROS, &zeros) &&
+        SFBitReaderRead(r, (unsigned)zeros, &bits))
+    {
+        *value = (((1ULL << zeros) | bits) - 1);
+        return YES;
+    }
+
+    *r = saved;
+    r->stream->nextRead = nextRead;
+    return NO;
+}
+//}}}
+// BOOL SFBitReaderReadSignedExpGolomb(bitreader_t *r, int64_t *value);//{{{
+BOOL SFBitReaderReadSignedExpGolomb(bitreader_t *r, int64_t *value)
+{
+    uint64_t code;
+
+    if (!SFBitReaderReadExpGolomb(r, &code))
+        return NO;
+
+    if (code & 1)
+        *value = (int64_t)((code >> 1) + 1);
+    else
+        *value = -(int64_t)(code >> 1);
+    return YES;
+}
+//}}}
+// BOOL SFBitWriterWriteUnary(bitwriter_t *w, uint64_t value);//{{{
+BOOL SFBitWriterWriteUnary(bitwriter_t *w, uint64_t value)
+{
+    while (value >= 32)
+    {
+        if (!SFBitWriterWrite(w, 0, 32)) return NO;
+        value -= 32;
+    }
+    return SFBitWriterWrite(w, 1, (unsigned)(value + 1));
+}
+//}}}
+// BOOL SFBitWriterWriteExpGolomb(bitwriter_t *w, uint64_t value);//{{{
+BOOL SFBitWriterWriteExpGolomb(bitwriter_t *w, uint64_t value)
+{
+    unsigned bits;
+
+    if (value == UINT64_MAX)
+        return NO;
+
+    value++;
+    bits = (unsigned)(64 - __builtin_clzll(value));
+
+    return (SFBitWriterWrite(w, 0, (bits - 1)) && SFBitWriterWrite(w, value, bits));
+}
+//}}}
+// BOOL SFBitWriterWriteSignedExpGolomb(bitwriter_t *w, int64_t value);//{{{
+BOOL SFBitWriterWriteSignedExpGolomb(bitwriter_t *w, int64_t value)
+{
+    if (value == INT64_MIN)
+        return NO;
+
+    if (value > 0)
+        return SFBitWriterWriteExpGolomb(w, (((uint64_t)value << 1) - 1));
+    else
+        return SFBitWriterWriteExpGolomb(w, ((uint64_t)(-value) << 1));
+}
+//}}}
+// vim:syntax=objc.doxygen
@@ -0,0 +1,109 @@
+/**
+ * \file
+ * Declares the C level functions to copy arrays of values between a host
+ * and a stream byte order.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "sfstreamio.h"
+
+/**
+ * \ingroup sf_networking
+ * \defgroup sf_networking_byteswap Typed Arrays
+ * Functions to read and write arrays of fixed width values.
+ * The byte order is reversed with vector instructions when the target has
+ * them: NEON on ARM, AVX2 or SSSE3 on Intel. Other targets use a scalar
+ * loop. Values don't need to be aligned, neither in the stream nor in the
+ * caller array.
+ * @since 2.1
+ * @{ *//* ---------------------------------------------------------------- */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @name Byte Swapping */ //@{
+// void SFByteSwap16(void *dest, const void *src, size_t count);//{{{
+/**
+ * Copies 16 bits values reversing the order of their bytes.
+ * @param dest Destination of the values.
+ * @param src Source of the values. Can be equal to \a dest but the two
+ * arrays cannot overlap partially.
+ * @param count Number of values.
+ * @since 2.1
+ **/
+void SFByteSwap16(void *dest, const void *src, size_t count);
+//}}}
+// void SFByteSwap32(void *dest, const void *src, size_t count);//{{{
+/**
+ * Copies 32 bits values reversing the order of their bytes.
+ * @param dest Destination of the values.
+ * @param src Source of the values. Can be equal to \a dest but the two
+ * arrays cannot overlap partially.
+ * @param count Number of values.
+ * @since 2.1
+ **/
+void SFByteSwap32(void *dest, const void *src, size_t count);
+//}}}
+// void SFByteSwap64(void *dest, const void *src, size_t count);//{{{
+/**
+ * Copies 64 bits values reversing the order of their bytes.
+ * @param dest Destination of the values.
+ * @param src Source of the values. Can be equal to \a dest but the two
+ * arrays cannot overlap partially.
+ * @param count Number of values.
+ * @since 2.1
+ **/
+void SFByteSwap64(void *dest, const void *src, size_t count);
+//}}}
+//@}
+
+/** @name Stream Arrays */ //@{
+// BOOL SFStreamReadArray(stream_t *s, void *values, size_t count, size_t width, BOOL bigEndian);//{{{
+/**
+ * Reads an array of values from the stream.
+ * @param s The stream to read from.
+ * @param values Array that receives the values in host byte order.
+ * @param count Number of values to read.
+ * @param width Size of each value: 1, 2, 4 or 8 bytes.
+ * @param bigEndian \b YES when the values are stored in big-endian order.
+ * \b NO for little-endian order.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case nothing is read.
+ * @since 2.1
+ **/
+BOOL SFStreamReadArray(stream_t *s, void *values, size_t count, size_t width, BOOL bigEndian);
+//}}}
+// BOOL SFStreamWriteArray(stream_t *s, const void *values, size_t count, size_t width, BOOL bigEndian);//{{{
+/**
+ * Writes an array of values in the stream.
+ * @param s The stream to write in.
+ * @param values Array of values in host byte order.
+ * @param count Number of values to write.
+ * @param width Size of each value: 1, 2, 4 or 8 bytes.
+ * @param bigEndian \b YES to store the values in big-endian order. \b NO
+ * for little-endian order.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ * @since 2.1
+ **/
+BOOL SFStreamWriteArray(stream_t *s, const void *values, size_t count, size_t width, BOOL bigEndian);
+//}}}
+//@}
+
+#ifdef __cplusplus
+}
+#endif
+
+///@} sf_networking_byteswap
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,204 @@
+/**
+ * \file
+ * Defines the C level functions to copy arrays of values between a host
+ * and a stream byte order.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "sfbyteswap.h"
+#import "sfdebug.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   include <arm_neon.h>
+#   define SF_BYTESWAP_NEON
+#elif defined(__AVX2__)
+#   include <immintrin.h>
+#   define SF_BYTESWAP_AVX2
+#elif defined(__SSSE3__)
+#   include <tmmintrin.h>
+#   define SF_BYTESWAP_SSSE3
+#endif
+
+#if defined(__BIG_ENDIAN__) || (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__))
+#   define SF_HOST_BIG_ENDIAN       YES
+#else
+#   define SF_HOST_BIG_ENDIAN       NO
+#endif
+
+/* ===========================================================================
+ * VECTOR FUNCTIONS
+ * ======================================================================== */
+#if defined(SF_BYTESWAP_AVX2) || defined(SF_BYTESWAP_SSSE3)
+/**
+ * Shuffle masks reversing each group of 2, 4 and 8 bytes.
+ **/
+static const int8_t __sf_mask16[16] = { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 };
+static const int8_t __sf_mask32[16] = { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 };
+static const int8_t __sf_mask64[16] = { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 };
+#endif
+
+// static size_t SFByteSwapVector(uint8_t *dest, const uint8_t *src, size_t size, size_t width);//{{{
+/**
+ * Swaps the bytes of as many whole vectors as possible.
+ * @param dest Destination address.
+ * @param src Source address.
+ * @param size Number of bytes.
+ * @param width Size of each value: 2, 4 or 8.
+ * @return The number of bytes processed. The rest must be done by the scalar
+ * loop.
+ **/
+static size_t SFByteSwapVector(uint8_t *dest, const uint8_t *src, size_t size, size_t width)
+{
+    size_t done = 0;
+
+#if defined(SF_BYTESWAP_NEON)
+    for (; (size - done) >= 16; done += 16)
+    {
+        uint8x16_t v = vld1q_u8(src + done);
+
+        switch (width)
+        {
+        case 2:  v = vrev16q_u8(v); break;
+        case 4:  v = vrev32q_u8(v); break;
+        default: v = vrev64q_u8(v); break;
+        }
+        vst1q_u8((dest + done), v);
+    }
+#elif defined(SF_BYTESWAP_AVX2) || defined(SF_BYTESWAP_SSSE3)
+    const int8_t *table = ((width == 2) ? __sf_mask16 : ((width == 4) ? __sf_mask32 : __sf_mask64));
+    __m128i mask = _mm_loadu_si128((const __m128i *)table);
+
+#   if defined(SF_BYTESWAP_AVX2)
+    __m256i wide = _mm256_broadcastsi128_si256(mask);
+
+    for (; (size - done) >= 32; done += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src + done));
+        _mm256_storeu_si256((__m256i *)(dest + done), _mm256_shuffle_epi8(v, wide));
+    }
+#   endif
+    for (; (size - done) >= 16; done += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + done));
+        _mm_storeu_si128((__m128i *)(dest + done), _mm_shuffle_epi8(v, mask));
+    }
+#else
+    (void)dest; (void)src; (void)size; (void)width;
+#endif
+    return done;
+}
+//}}}
+
+/* ===========================================================================
+ * BYTE SWAPPING
+ * ======================================================================== */
+// void SFByteSwap16(void *dest, const void *src, size_t count);//{{{
+void SFByteSwap16(void *dest, const void *src, size_t count)
+{
+    size_t i = (SFByteSwapVector((uint8_t *)dest, (const uint8_t *)src, (count * sizeof(uint16_t)), sizeof(uint16_t)) / sizeof(uint16_t));
+    uint16_t value;
+
+    for (; i < count; ++i)
+    {
+        memcpy(&value, ((const uint8_t *)src + (i * sizeof(uint16_t))), sizeof(uint16_t));
+        value = OSSwapInt16(value);
+        memcpy(((uint8_t *)dest + (i * sizeof(uint16_t))), &value, sizeof(uint16_t));
+    }
+}
+//}}}
+// void SFByteSwap32(void *dest, const void *src, size_t count);//{{{
+void SFByteSwap32(void *dest, const void *src, size_t count)
+{
+    size_t i = (SFByteSwapVector((uint8_t *)dest, (const uint8_t *)src, (count * sizeof(uint32_t)), sizeof(uint32_t)) / sizeof(uint32_t));
+    uint32_t value;
+
+    for (; i < count; ++i)
+    {
+        memcpy(&value, ((const uint8_t *)src + (i * sizeof(uint32_t))), sizeof(uint32_t));
+        value = OSSwapInt32(value);
+        memcpy(((uint8_t *)dest + (i * sizeof(uint32_t))), &value, sizeof(uint32_t));
+    }
+}
+//}}}
+// void SFByteSwap64(void *dest, const void *src, size_t count);//{{{
+void SFByteSwap64(void *dest, const void *src, size_t count)
+{
+    size_t i = (SFByteSwapVector((uint8_t *)dest, (const uint8_t *)src, (count * sizeof(uint64_t)), sizeof(uint64_t)) / sizeof(uint64_t));
+    uint64_t value;
+
+    for (; i < count; ++i)
+    {
+        memcpy(&value, ((const uint8_t *)src + (i * sizeof(uint64_t))), sizeof(uint64_t));
+        value = OSSwapInt64(value);
+        memcpy(((uint8_t *)dest + (i * sizeof(uint64_t))), &value, sizeof(uint64_t));
+    }
+}
+//}}}
+
+/* ===========================================================================
+ * STREAM ARRAYS
+ * ======================================================================== */
+// static void SFByteSwapCopy(void *dest, const void *src, size_t count, size_t width, BOOL swap);//{{{
+/**
+ * Copies an array of values swapping their bytes when needed.
+ **/
+static void SFByteSwapCopy(void *dest, const void *src, size_t count, size_t width, BOOL swap)
+{
+    if (!swap || (width == 1))
+    {
+        memcpy(dest, src, (count * width));
+        return;
+    }
+
+    switch (width)
+    {
+    case 2:  SFByteSwap16(dest, src, count); break;
+    case 4:  SFByteSwap32(dest, src, count); break;
+    default: SFByteSwap64(dest, src, count); break;
+    }
+}
+//}}}
+// BOOL SFStreamReadArray(stream_t *s, void *values, size_t count, size_t width, BOOL bigEndian);//{{{
+BOOL SFStreamReadArray(stream_t *s, void *values, size_t count, size_t width, BOOL bigEndian)
+{
+    sfassert((width == 1) || (width == 2) || (width == 4) || (width == 8), "SFStreamReadArray: invalid width %zu\n", width);
+
+    if ((count == 0) || (width == 0))
+        return YES;
+
+    if ((count > (SIZE_MAX / width)) || ((s->length - s->nextRead) < (count * width)))
+        return NO;
+
+    SFByteSwapCopy(values, (s->buffer + s->nextRead), count, width, (bigEndian != SF_HOST_BIG_ENDIAN));
+    s->nextRead += (count * width);
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteArray(stream_t *s, const void *values, size_t count, size_t width, BOOL bigEndian);//{{{
+BOOL SFStreamWriteArray(stream_t *s, const void *values, size_t count, size_t width, BOOL bigEndian)
+{
+    uint8_t *ptr;
+
+    sfassert((width == 1) || (width == 2) || (width == 4) || (width == 8), "SFStreamWriteArray: invalid width %zu\n", width);
+
+    if ((count == 0) || (width == 0))
+        return YES;
+
+    if ((count > (SIZE_MAX / width)) || ((ptr = __SFStreamReserve(s, (count * width))) == NULL))
+        return NO;
+
+    SFByteSwapCopy(ptr, values, count, width, (bigEndian != SF_HOST_BIG_ENDIAN));
+    __SFStreamCommit(s, (count * width));
+    return YES;
+}
+//}}}
+// vim:syntax=objc.doxygen
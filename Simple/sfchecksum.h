@@ -0,0 +1,149 @@
+/**
+ * \file
+ * Declares the C level checksum and hash functions.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "sfstreamio.h"
+
+/**
+ * \ingroup sf_networking
+ * \defgroup sf_networking_checksum Checksums
+ * Functions to check the integrity of data.
+ * CRC32C (Castagnoli polynomial) uses the \c crc32 instruction of SSE 4.2 or
+ * ARMv8 when the target has it. Other targets use slicing-by-8 tables, eight
+ * bytes per step. The 64 bits hash is xxHash64, which processes 32 bytes per
+ * step in four independent lanes. All functions are incremental: the data
+ * can be given in any number of pieces with the same result.
+ * @since 2.1
+ * @{ *//* ---------------------------------------------------------------- */
+
+/**
+ * State of an incremental 64 bits hash.
+ * Treat it as opaque. Use SFHash64Init() before anything else.
+ **/
+struct SF_HASH64 {
+    uint64_t lanes[4];              /**< Accumulators.                      */
+    uint64_t total;                 /**< Number of bytes hashed.            */
+    uint64_t seed;                  /**< Initial seed.                      */
+    uint8_t  tail[32];              /**< Bytes of an incomplete step.       */
+    size_t   tailLength;            /**< Number of bytes in \c tail.        */
+};
+typedef struct SF_HASH64 hash64_t;
+
+/**
+ * Checksums of the bytes written in a stream.
+ * Use SFStreamChecksumStart() to mark where the data starts and
+ * SFStreamChecksumUpdate() after each write. Bytes are processed once, while
+ * they are still in the processor cache. The stream can be purged between
+ * updates, as long as the bytes purged were already processed.
+ **/
+struct SF_STREAM_CHECKSUM {
+    size_t   offset;                /**< Next byte to process, counting the
+                                         bytes purged from the stream.      */
+    uint32_t crc;                   /**< CRC32C of the bytes processed.     */
+    hash64_t hash;                  /**< Hash of the bytes processed.       */
+};
+typedef struct SF_STREAM_CHECKSUM stream_checksum_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @name CRC32C */ //@{
+// uint32_t SFCrc32c(uint32_t crc, const void *data, size_t length);//{{{
+/**
+ * Computes or continues a CRC32C.
+ * @param crc Result of the previous piece. Zero for the first one.
+ * @param data Bytes to process.
+ * @param length Number of bytes in \a data.
+ * @return The CRC32C of all pieces given so far.
+ * @since 2.1
+ **/
+uint32_t SFCrc32c(uint32_t crc, const void *data, size_t length);
+//}}}
+//@}
+
+/** @name 64 Bits Hash */ //@{
+// void SFHash64Init(hash64_t *h, uint64_t seed);//{{{
+/**
+ * Initializes an incremental hash.
+ * @param h The hash state.
+ * @param seed Seed of the hash. Different seeds give unrelated results.
+ * @since 2.1
+ **/
+void SFHash64Init(hash64_t *h, uint64_t seed);
+//}}}
+// void SFHash64Update(hash64_t *h, const void *data, size_t length);//{{{
+/**
+ * Adds bytes to an incremental hash.
+ * @param h The hash state.
+ * @param data Bytes to process.
+ * @param length Number of bytes in \a data.
+ * @since 2.1
+ **/
+void SFHash64Update(hash64_t *h, const void *data, size_t length);
+//}}}
+// uint64_t SFHash64Final(const hash64_t *h);//{{{
+/**
+ * Gets the hash of the bytes given so far.
+ * @param h The hash state. It is not changed, so more bytes can be added.
+ * @return The hash value.
+ * @since 2.1
+ **/
+uint64_t SFHash64Final(const hash64_t *h);
+//}}}
+// uint64_t SFHash64(const void *data, size_t length, uint64_t seed);//{{{
+/**
+ * Computes the hash of a memory region.
+ * @param data Bytes to process.
+ * @param length Number of bytes in \a data.
+ * @param seed Seed of the hash.
+ * @return The hash value.
+ * @since 2.1
+ **/
+uint64_t SFHash64(const void *data, size_t length, uint64_t seed);
+//}}}
+//@}
+
+/** @name Stream Checksums */ //@{
+// void SFStreamChecksumStart(stream_checksum_t *c, const stream_t *s, uint64_t seed);//{{{
+/**
+ * Starts the checksums of the next bytes written in a stream.
+ * @param c The checksum structure.
+ * @param s The stream. The data starts at its current write position.
+ * @param seed Seed of the 64 bits hash.
+ * @since 2.1
+ **/
+void SFStreamChecksumStart(stream_checksum_t *c, const stream_t *s, uint64_t seed);
+//}}}
+// void SFStreamChecksumUpdate(stream_checksum_t *c, const stream_t *s);//{{{
+/**
+ * Processes the bytes added to a stream since the last call.
+ * @param c The checksum structure.
+ * @param s The stream. Every byte up to its length is processed.
+ * @remarks Bytes already processed must not change. The stream can be
+ * purged between updates: \c stream_t::purged keeps the position. Only bytes
+ * not yet processed must not be purged, since they would be lost.
+ * @since 2.1
+ **/
+void SFStreamChecksumUpdate(stream_checksum_t *c, const stream_t *s);
+//}}}
+//@}
+
+#ifdef __cplusplus
+}
+#endif
+
+///@} sf_networking_checksum
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,340 @@
+/**
+ * \file
+ * Defines the C level checksum and hash functions.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "sfchecksum.h"
+#import "sfdebug.h"
+
+#include <libkern/OSByteOrder.h>
+
+#if defined(__ARM_FEATURE_CRC32)
+#   include <arm_acle.h>
+#   define SF_CRC32C_ARM
+#elif defined(__SSE4_2__)
+#   include <nmmintrin.h>
+#   define SF_CRC32C_SSE42
+#else
+#   include <dispatch/dispatch.h>
+#   define SF_CRC32C_TABLES
+#endif
+
+/**
+ * CRC32C polynomial, in reversed bit order.
+ **/
+#define SF_CRC32C_POLYNOMIAL    0x82F63B78U
+
+/**
+ * xxHash64 primes.
+ **/
+#define SF_HASH64_PRIME1        0x9E3779B185EBCA87ULL
+#define SF_HASH64_PRIME2        0xC2B2AE3D27D4EB4FULL
+#define SF_HASH64_PRIME3        0x165667B19E3779F9ULL
+#define SF_HASH64_PRIME4        0x85EBCA77C2B2AE63ULL
+#define SF_HASH64_PRIME5        0x27D4EB2F165667C5ULL
+
+/* ===========================================================================
+ * CRC32C LOCAL FUNCTIONS
+ * ======================================================================== */
+#if defined(SF_CRC32C_TABLES)
+/**
+ * Slicing-by-8 tables. Table \c k gives the CRC of a byte followed by \c k
+ * zero bytes.
+ **/
+static uint32_t __sf_crc32c_table[8][256];
+
+// static void SFCrc32cBuildTables(void);//{{{
+/**
+ * Fills the slicing-by-8 tables, only once.
+ **/
+static void SFCrc32cBuildTables(void)
+{
+    static dispatch_once_t once;
+
+    dispatch_once(&once, ^{
+        uint32_t i, k, crc;
+
+        for (i = 0; i < 256; ++i)
+        {
+            crc = i;
+            for (k = 0; k < 8; ++k)
+                crc = ((crc & 1) ? ((crc >> 1) ^ SF_CRC32C_POLYNOMIAL) : (crc >> 1));
+            __sf_crc32c_table[0][i] = crc;
+        }
+        for (i = 0; i < 256; ++i)
+        {
+            crc = __sf_crc32c_table[0][i];
+            for (k = 1; k < 8; ++k)
+            {
+                crc = ((crc >> 8) ^ __sf_crc32c_table[0][crc & 0xFF]);
+                __sf_crc32c_table[k][i] = crc;
+            }
+        }
+    });
+}
+//}}}
+#endif
+
+// static uint32_t SFCrc32cUpdate(uint32_t crc, const uint8_t *ptr, size_t length);//{{{
+/**
+ * Processes bytes over the inverted CRC register.
+ **/
+static uint32_t SFCrc32cUpdate(uint32_t crc, const uint8_t *ptr, size_t length)
+{
+#if defined(SF_CRC32C_ARM)
+    while (length >= 8)
+    {
+        crc = __crc32cd(crc, OSReadLittleInt64(ptr, 0));
+        ptr += 8; length -= 8;
+    }
+    while (length-- > 0)
+        crc = __crc32cb(crc, *ptr++);
+#elif defined(SF_CRC32C_SSE42)
+#   if defined(__x86_64__)
+    uint64_t crc64 = crc;
+
+    while (length >= 8)
+    {
+        crc64 = _mm_crc32_u64(crc64, OSReadLittleInt64(ptr, 0));
+        ptr += 8; length -= 8;
+    }
+    crc = (uint32_t)crc64;
+#   else
+    while (length >= 4)
+    {
+        crc = _mm_crc32_u32(crc, OSReadLittleInt32(ptr, 0));
+        ptr += 4; length -= 4;
+    }
+#   endif
+    while (length-- > 0)
+        crc = _mm_crc32_u8(crc, *ptr++);
+#else
+    const uint32_t (*t)[256] = (const uint32_t (*)[256])__sf_crc32c_table;
+    uint32_t high;
+
+    SFCrc32cBuildTables();
+    while (length >= 8)
+    {
+        crc ^= OSReadLittleInt32(ptr, 0);
+        high = OSReadLittleInt32(ptr, 4);
+        crc = (t[7][crc & 0xFF] ^ t[6][(crc >> 8) & 0xFF] ^
+               t[5][(crc >> 16) & 0xFF] ^ t[4][crc >> 24] ^
+               t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^
+               t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24]);
+        ptr += 8; length -= 8;
+    }
+    while (length-- > 0)
+        crc = ((crc >> 8) ^ t[0][(crc ^ *ptr++) & 0xFF]);
+#endif
+    return crc;
+}
+//}}}
+
+/* ===========================================================================
+ * HASH LOCAL FUNCTIONS
+ * ======================================================================== */
+// static inline uint64_t SFRotateLeft(uint64_t value, int bits);//{{{
+static inline uint64_t SFRotateLeft(uint64_t value, int bits)
+{
+    return ((value << bits) | (value >> (64 - bits)));
+}
+//}}}
+// static inline uint64_t SFHash64Round(uint64_t lane, uint64_t input);//{{{
+static inline uint64_t SFHash64Round(uint64_t lane, uint64_t input)
+{
+    lane += (input * SF_HASH64_PRIME2);
+    return (SFRotateLeft(lane, 31) * SF_HASH64_PRIME1);
+}
+//}}}
+// static inline uint64_t SFHash64Merge(uint64_t hash, uint64_t lane);//{{{
+static inline uint64_t SFHash64Merge(uint64_t hash, uint64_t lane)
+{
+    hash ^= SFHash64Round(0, lane);
+    return ((hash * SF_HASH64_PRIME1) + SF_HASH64_PRIME4);
+}
+//}}}
+// static const uint8_t *SFHash64Steps(uint64_t *lanes, const uint8_t *ptr, size_t steps);//{{{
+/**
+ * Processes whole steps of 32 bytes.
+ **/
+static const uint8_t *SFHash64Steps(uint64_t *lanes, const uint8_t *ptr, size_t steps)
+{
+    uint64_t v1 = lanes[0], v2 = lanes[1], v3 = lanes[2], v4 = lanes[3];
+
+    while (steps-- > 0)
+    {
+        v1 = SFHash64Round(v1, OSReadLittleInt64(ptr, 0));
+        v2 = SFHash64Round(v2, OSReadLittleInt64(ptr, 8));
+        v3 = SFHash64Round(v3, OSReadLittleInt64(ptr, 16));
+        v4 = SFHash64Round(v4, OSReadLittleInt64(ptr, 24));
+        ptr += 32;
+    }
+    lanes[0] = v1; lanes[1] = v2; lanes[2] = v3; lanes[3] = v4;
+    return ptr;
+}
+//}}}
+
+/* ===========================================================================
+ * CRC32C
+ * ======================================================================== */
+// uint32_t SFCrc32c(uint32_t crc, const void *data, size_t length);//{{{
+uint32_t SFCrc32c(uint32_t crc, const void *data, size_t length)
+{
+    if ((data == NULL) || (length == 0))
+        return crc;
+
+    return ~SFCrc32cUpdate(~crc, (const uint8_t *)data, length);
+}
+//}}}
+
+/* ===========================================================================
+ * 64 BITS HASH
+ * ======================================================================== */
+// void SFHash64Init(hash64_t *h, uint64_t seed);//{{{
+void SFHash64Init(hash64_t *h, uint64_t seed)
+{
+    h->lanes[0] = (seed + SF_HASH64_PRIME1 + SF_HASH64_PRIME2);
+    h->lanes[1] = (seed + SF_HASH64_PRIME2);
+    h->lanes[2] = seed;
+    h->lanes[3] = (seed - SF_HASH64_PRIME1);
+    h->total = 0;
+    h->seed = seed;
+    h->tailLength = 0;
+}
+//}}}
+// void SFHash64Update(hash64_t *h, const void *data, size_t length);//{{{
+void SFHash64Update(hash64_t *h, const void *data, size_t length)
+{
+    const uint8_t *ptr = (const uint8_t *)data;
+
+    if ((ptr == NULL) || (length == 0))
+        return;
+
+    h->total += length;
+
+    /* Completes a step started by a previous piece. */
+    if (h->tailLength > 0)
+    {
+        size_t part = (sizeof(h->tail) - h->tailLength);
+
+        if (part > length) part = length;
+        memcpy((h->tail + h->tailLength), ptr, part);
+        h->tailLength += part;
+        ptr += part; length -= part;
+
+        if (h->tailLength < sizeof(h->tail))
+            return;
+
+        SFHash64Steps(h->lanes, h->tail, 1);
+        h->tailLength = 0;
+    }
+
+    ptr = SFHash64Steps(h->lanes, ptr, (length / 32));
+    length %= 32;
+
+    if (length > 0)
+    {
+        memcpy(h->tail, ptr, length);
+        h->tailLength = length;
+    }
+}
+//}}}
+// uint64_t SFHash64Final(const hash64_t *h);//{{{
+uint64_t SFHash64Final(const hash64_t *h)
+{
+    const uint8_t *ptr = h->tail;
+    size_t length = h->tailLength;
+    uint64_t hash;
+
+    if (h->total >= 32)
+    {
+        hash = (SFRotateLeft(h->lanes[0], 1) + SFRotateLeft(h->lanes[1], 7) +
+                SFRotateLeft(h->lanes[2], 12) + SFRotateLeft(h->lanes[3], 18));
+        hash = SFHash64Merge(hash, h->lanes[0]);
+        hash = SFHash64Merge(hash, h->lanes[1]);
+        hash = SFHash64Merge(hash, h->lanes[2]);
+        hash = SFHash64Merge(hash, h->lanes[3]);
+    }
+    else
+        hash = (h->seed + SF_HASH64_PRIME5);
+
+    hash += h->total;
+
+    while (length >= 8)
+    {
+        hash ^= SFHash64Round(0, OSReadLittleInt64(ptr, 0));
+        hash = ((SFRotateLeft(hash, 27) * SF_HASH64_PRIME1) + SF_HASH64_PRIME4);
+        ptr += 8; length -= 8;
+    }
+    if (length >= 4)
+    {
+        hash ^= ((uint64_t)OSReadLittleInt32(ptr, 0) * SF_HASH64_PRIME1);
+        hash = ((SFRotateLeft(hash, 23) * SF_HASH64_PRIME2) + SF_HASH64_PRIME3);
+        ptr += 4; length -= 4;
+    }
+    while (length-- > 0)
+    {
+        hash ^= ((uint64_t)(*ptr++) * SF_HASH64_PRIME5);
+        hash = (SFRotateLeft(hash, 11) * SF_HASH64_PRIME1);
+    }
+
+    /* Final avalanche. */
+    hash ^= (hash >> 33);
+    hash *= SF_HASH64_PRIME2;
+    hash ^= (hash >> 29);
+    hash *= SF_HASH64_PRIME3;
+    hash ^= (hash >> 32);
+    return hash;
+}
+//}}}
+// uint64_t SFHash64(const void *data, size_t length, uint64_t seed);//{{{
+uint64_t SFHash64(const void *data, size_t length, uint64_t seed)
+{
+    hash64_t h;
+
+    SFHash64Init(&h, seed);
+    SFHash64Update(&h, data, length);
+    return SFHash64Final(&h);
+}
+//}}}
+
+/* ===========================================================================
+ * STREAM CHECKSUMS
+ * ======================================================================== */
+// void SFStreamChecksumStart(stream_checksum_t *c, const stream_t *s, uint64_t seed);//{{{
+void SFStreamChecksumStart(stream_checksum_t *c, const stream_t *s, uint64_t seed)
+{
+    c->offset = (s->purged + s->nextWrite);
+    c->crc = 0;
+    SFHash64Init(&c->hash, seed);
+}
+//}}}
+// void SFStreamChecksumUpdate(stream_checksum_t *c, const stream_t *s);//{{{
+void SFStreamChecksumUpdate(stream_checksum_t *c, const stream_t *s)
+{
+    /* The offset counts purged bytes, so purges don't move it. */
+    sfassert(c->offset >= s->purged, "SFStreamChecksumUpdate() bytes purged before being processed\n");
+    sfassert((c->offset - s->purged) <= s->length, "SFStreamChecksumUpdate() stream shorter than the processed data\n");
+    if ((c->offset < s->purged) || ((c->offset - s->purged) >= s->length))
+        return;
+
+    size_t start = (c->offset - s->purged);
+    const uint8_t *ptr = (s->buffer + start);
+    size_t length = (s->length - start);
+
+    c->crc = SFCrc32c(c->crc, ptr, length);
+    SFHash64Update(&c->hash, ptr, length);
+    c->offset = (s->purged + s->length);
+}
+//}}}
+// vim:syntax=objc.doxygen
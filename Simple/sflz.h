@@ -0,0 +1,85 @@
+/**
+ * \file
+ * Declares the C level functions of the built-in LZ codec.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+
+/**
+ * \ingroup sf_networking
+ * \defgroup sf_networking_lz LZ Codec
+ * A fast LZ77 block codec.
+ * Blocks use the LZ4 block format: sequences of literal bytes followed by a
+ * copy of 4 or more bytes from up to 64 KB back. Matches are found with a
+ * single hash table lookup, so compression runs at hundreds of megabytes per
+ * second. Decompression checks every length and offset against the buffers,
+ * so malformed input is reported instead of read or written out of bounds.
+ * @since 2.1
+ * @{ *//* ---------------------------------------------------------------- */
+
+/**
+ * Number of entries in the table used by SFLZCompress().
+ **/
+#define SF_LZ_TABLE_SIZE        4096
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @name Blocks */ //@{
+// size_t SFLZCompressBound(size_t length);//{{{
+/**
+ * Gets the greatest compressed size of a block.
+ * @param length Number of bytes of the uncompressed block.
+ * @return The capacity the destination of SFLZCompress() needs to never
+ * fail.
+ * @since 2.1
+ **/
+size_t SFLZCompressBound(size_t length);
+//}}}
+// size_t SFLZCompress(const uint8_t *src, size_t length, uint8_t *dest, size_t capacity, uint32_t *table);//{{{
+/**
+ * Compresses a block.
+ * @param src Bytes to compress.
+ * @param length Number of bytes in \a src.
+ * @param dest Where to store the compressed block.
+ * @param capacity Number of bytes available in \a dest.
+ * @param table Work memory with \c SF_LZ_TABLE_SIZE entries. Its content is
+ * not used between calls, so one table can be reused for every block.
+ * @return The size of the compressed block. Zero when it doesn't fit in \a
+ * capacity bytes.
+ * @since 2.1
+ **/
+size_t SFLZCompress(const uint8_t *src, size_t length, uint8_t *dest, size_t capacity, uint32_t *table);
+//}}}
+// intptr_t SFLZDecompress(const uint8_t *src, size_t length, uint8_t *dest, size_t capacity);//{{{
+/**
+ * Decompresses a block.
+ * @param src The compressed block.
+ * @param length Number of bytes in \a src.
+ * @param dest Where to store the uncompressed bytes.
+ * @param capacity Number of bytes available in \a dest.
+ * @return The number of bytes stored in \a dest. -1 when the block is
+ * malformed or doesn't fit in \a capacity bytes.
+ * @since 2.1
+ **/
+intptr_t SFLZDecompress(const uint8_t *src, size_t length, uint8_t *dest, size_t capacity);
+//}}}
+//@}
+
+#ifdef __cplusplus
+}
+#endif
+
+///@} sf_networking_lz
+// vim:ft=objc syntax=objc.doxygen
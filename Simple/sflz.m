@@ -0,0 +1,224 @@
+/**
+ * \file
+ * Defines the C level functions of the built-in LZ codec.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "sflz.h"
+#import "sfdebug.h"
+
+#include <libkern/OSByteOrder.h>
+
+/**
+ * Format limits. Matches have at least \c SF_LZ_MIN_MATCH bytes. The last
+ * \c SF_LZ_LAST_LITERALS bytes of a block are always literals and the last
+ * match starts at least \c SF_LZ_MATCH_LIMIT bytes before the end.
+ **/
+#define SF_LZ_MIN_MATCH         4
+#define SF_LZ_LAST_LITERALS     5
+#define SF_LZ_MATCH_LIMIT       12
+#define SF_LZ_MAX_OFFSET        65535
+#define SF_LZ_HASH_BITS         12
+
+/* ===========================================================================
+ * LOCAL FUNCTIONS
+ * ======================================================================== */
+// static inline uint32_t SFLZHash(uint32_t sequence);//{{{
+static inline uint32_t SFLZHash(uint32_t sequence)
+{
+    return ((sequence * 2654435761U) >> (32 - SF_LZ_HASH_BITS));
+}
+//}}}
+// static inline uint8_t *SFLZWriteLength(uint8_t *op, size_t length);//{{{
+/**
+ * Writes the bytes that extend a length greater than 14.
+ **/
+static inline uint8_t *SFLZWriteLength(uint8_t *op, size_t length)
+{
+    while (length >= 255)
+    {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (uint8_t)length;
+    return op;
+}
+//}}}
+// static inline BOOL SFLZReadLength(const uint8_t **ip, const uint8_t *end, size_t *length);//{{{
+/**
+ * Reads the bytes that extend a length.
+ **/
+static inline BOOL SFLZReadLength(const uint8_t **ip, const uint8_t *end, size_t *length)
+{
+    const uint8_t *ptr = *ip;
+    uint8_t value;
+
+    do {
+        if (ptr >= end) return NO;
+        value = *ptr++;
+        *length += value;
+    } while (value == 255);
+
+    *ip = ptr;
+    return YES;
+}
+//}}}
+// static uint8_t *SFLZSequence(uint8_t *op, uint8_t *oend, const uint8_t *literals, size_t count, size_t offset, size_t match);//{{{
+/**
+ * Writes one sequence. \a match is zero in the last sequence.
+ * @return The end of the sequence or \b NULL when it doesn't fit.
+ **/
+static uint8_t *SFLZSequence(uint8_t *op, uint8_t *oend, const uint8_t *literals, size_t count, size_t offset, size_t match)
+{
+    size_t extra = (match ? (match - SF_LZ_MIN_MATCH) : 0);
+    size_t needed = (1 + (count / 255) + 1 + count + 2 + (extra / 255) + 1);
+    uint8_t *token = op++;
+
+    if (needed > (size_t)(oend - token))
+        return NULL;
+
+    *token = (uint8_t)(((count < 15) ? count : 15) << 4);
+    if (count >= 15) op = SFLZWriteLength(op, (count - 15));
+
+    memcpy(op, literals, count);
+    op += count;
+
+    if (match == 0)
+        return op;
+
+    OSWriteLittleInt16(op, 0, (uint16_t)offset);
+    op += 2;
+
+    *token |= (uint8_t)((extra < 15) ? extra : 15);
+    if (extra >= 15) op = SFLZWriteLength(op, (extra - 15));
+
+    return op;
+}
+//}}}
+
+/* ===========================================================================
+ * BLOCKS
+ * ======================================================================== */
+// size_t SFLZCompressBound(size_t length);//{{{
+size_t SFLZCompressBound(size_t length)
+{
+    return (length + (length / 255) + 16);
+}
+//}}}
+// size_t SFLZCompress(const uint8_t *src, size_t length, uint8_t *dest, size_t capacity, uint32_t *table);//{{{
+size_t SFLZCompress(const uint8_t *src, size_t length, uint8_t *dest, size_t capacity, uint32_t *table)
+{
+    const uint8_t *ip = src, *anchor = src, *end = (src + length);
+    uint8_t *op = dest, *oend = (dest + capacity);
+
+    if (length > SF_LZ_MATCH_LIMIT)
+    {
+        const uint8_t *mflimit = (end - SF_LZ_MATCH_LIMIT);
+        const uint8_t *matchlimit = (end - SF_LZ_LAST_LITERALS);
+
+        memset(table, 0, (SF_LZ_TABLE_SIZE * sizeof(uint32_t)));
+        ip++;
+
+        while (ip < mflimit)
+        {
+            uint32_t sequence = OSReadLittleInt32(ip, 0);
+            uint32_t h = SFLZHash(sequence);
+            const uint8_t *ref = (src + table[h]);
+
+            table[h] = (uint32_t)(ip - src);
+
+            if (((size_t)(ip - ref) > SF_LZ_MAX_OFFSET) || (OSReadLittleInt32(ref, 0) != sequence))
+            {
+                /* Skips faster over data that doesn't compress. */
+                ip += (1 + ((size_t)(ip - anchor) >> 6));
+                continue;
+            }
+
+            /* Extends the match in both directions. */
+            while ((ip > anchor) && (ref > src) && (ip[-1] == ref[-1])) {
+                ip--; ref--;
+            }
+
+            const uint8_t *mp = (ip + SF_LZ_MIN_MATCH), *rp = (ref + SF_LZ_MIN_MATCH);
+            while ((mp < matchlimit) && (*mp == *rp)) {
+                mp++; rp++;
+            }
+
+            op = SFLZSequence(op, oend, anchor, (size_t)(ip - anchor), (size_t)(ip - ref), (size_t)(mp - ip));
+            if (op == NULL) return 0;
+
+            anchor = ip = mp;
+            if (ip < mflimit)
+                table[SFLZHash(OSReadLittleInt32((ip - 2), 0))] = (uint32_t)(ip - 2 - src);
+        }
+    }
+
+    op = SFLZSequence(op, oend, anchor, (size_t)(end - anchor), 0, 0);
+    return ((op == NULL) ? 0 : (size_t)(op - dest));
+}
+//}}}
+// intptr_t SFLZDecompress(const uint8_t *src, size_t length, uint8_t *dest, size_t capacity);//{{{
+intptr_t SFLZDecompress(const uint8_t *src, size_t length, uint8_t *dest, size_t capacity)
+{
+    const uint8_t *ip = src, *iend = (src + length);
+    uint8_t *op = dest, *oend = (dest + capacity);
+
+    while (ip < iend)
+    {
+        uint8_t token = *ip++;
+        size_t count = (token >> 4);
+        size_t match = (token & 0x0F);
+        size_t offset;
+
+        if ((count == 15) && !SFLZReadLength(&ip, iend, &count))
+            return -1;
+        if ((count > (size_t)(iend - ip)) || (count > (size_t)(oend - op)))
+            return -1;
+
+        memcpy(op, ip, count);
+        op += count;
+        ip += count;
+
+        if (ip == iend)
+            break;                  /* The last sequence has no match. */
+
+        if ((iend - ip) < 2)
+            return -1;
+
+        offset = OSReadLittleInt16(ip, 0);
+        ip += 2;
+
+        if ((offset == 0) || (offset > (size_t)(op - dest)))
+            return -1;
+        if ((match == 15) && !SFLZReadLength(&ip, iend, &match))
+            return -1;
+
+        match += SF_LZ_MIN_MATCH;
+        if (match > (size_t)(oend - op))
+            return -1;
+
+        const uint8_t *ref = (op - offset);
+        if (offset >= match)
+            memcpy(op, ref, match);
+        else
+        {
+            /* Overlapping copy repeats the last offset bytes. */
+            size_t i;
+            for (i = 0; i < match; ++i)
+                op[i] = ref[i];
+        }
+        op += match;
+    }
+    return (intptr_t)(op - dest);
+}
+//}}}
+// vim:syntax=objc.doxygen
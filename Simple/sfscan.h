@@ -0,0 +1,67 @@
+/**
+ * \file
+ * Declares the C level byte and pattern search functions.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+
+/**
+ * \ingroup sf_networking
+ * \defgroup sf_networking_scan Searching
+ * Functions to find bytes and byte sequences in memory.
+ * A single byte is searched comparing whole vectors at once: 32 bytes with
+ * AVX2, 16 bytes with SSE2 or NEON. Short patterns, as line terminators,
+ * are found searching their first byte the same way and comparing the rest
+ * at each candidate. Longer patterns use the Boyer-Moore-Horspool algorithm,
+ * which skips up to the pattern length on each mismatch.
+ * @since 2.1
+ * @{ *//* ---------------------------------------------------------------- */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @name Searching */ //@{
+// const uint8_t *SFScanByte(const uint8_t *ptr, size_t length, uint8_t value);//{{{
+/**
+ * Finds the first occurrence of a byte.
+ * @param ptr Memory to search.
+ * @param length Number of bytes in \a ptr.
+ * @param value The byte to find.
+ * @return The address of the first \a value in \a ptr. \b NULL when there
+ * is none.
+ * @since 2.1
+ **/
+const uint8_t *SFScanByte(const uint8_t *ptr, size_t length, uint8_t value);
+//}}}
+// const uint8_t *SFScanBytes(const uint8_t *ptr, size_t length, const uint8_t *pattern, size_t count);//{{{
+/**
+ * Finds the first occurrence of a byte sequence.
+ * @param ptr Memory to search.
+ * @param length Number of bytes in \a ptr.
+ * @param pattern The sequence to find.
+ * @param count Number of bytes in \a pattern.
+ * @return The address of the first byte of the first \a pattern in \a ptr.
+ * \b NULL when there is none. \a ptr when \a count is zero.
+ * @since 2.1
+ **/
+const uint8_t *SFScanBytes(const uint8_t *ptr, size_t length, const uint8_t *pattern, size_t count);
+//}}}
+//@}
+
+#ifdef __cplusplus
+}
+#endif
+
+///@} sf_networking_scan
+// vim:ft=objc syntax=objc.doxygen
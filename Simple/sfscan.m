@@ -0,0 +1,133 @@
+/**
+ * \file
+ * Defines the C level byte and pattern search functions.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "sfscan.h"
+#import "sfdebug.h"
+
+#include <string.h>
+
+#if defined(__aarch64__) || defined(__arm64__)
+#   include <arm_neon.h>
+#   define SF_SCAN_NEON
+#elif defined(__AVX2__)
+#   include <immintrin.h>
+#   define SF_SCAN_AVX2
+#elif defined(__SSE2__)
+#   include <emmintrin.h>
+#   define SF_SCAN_SSE2
+#endif
+
+/**
+ * Patterns up to this length are searched by their first byte. Longer ones
+ * use Horspool.
+ **/
+#define SF_SCAN_SHORT_PATTERN   8
+
+/* ===========================================================================
+ * SEARCHING
+ * ======================================================================== */
+// const uint8_t *SFScanByte(const uint8_t *ptr, size_t length, uint8_t value);//{{{
+const uint8_t *SFScanByte(const uint8_t *ptr, size_t length, uint8_t value)
+{
+    if ((ptr == NULL) || (length == 0))
+        return NULL;
+
+#if defined(SF_SCAN_AVX2)
+    const __m256i needle = _mm256_set1_epi8((char)value);
+
+    while (length >= 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)ptr);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+
+        if (mask != 0)
+            return (ptr + __builtin_ctz(mask));
+
+        ptr += 32; length -= 32;
+    }
+#elif defined(SF_SCAN_SSE2)
+    const __m128i needle = _mm_set1_epi8((char)value);
+
+    while (length >= 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)ptr);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+
+        if (mask != 0)
+            return (ptr + __builtin_ctz(mask));
+
+        ptr += 16; length -= 16;
+    }
+#elif defined(SF_SCAN_NEON)
+    const uint8x16_t needle = vdupq_n_u8(value);
+
+    /* NEON has no movemask. The matching vector is searched by memchr(). */
+    while (length >= 16)
+    {
+        if (vmaxvq_u8(vceqq_u8(vld1q_u8(ptr), needle)) != 0)
+            break;
+
+        ptr += 16; length -= 16;
+    }
+#endif
+    return (const uint8_t *)memchr(ptr, value, length);
+}
+//}}}
+// const uint8_t *SFScanBytes(const uint8_t *ptr, size_t length, const uint8_t *pattern, size_t count);//{{{
+const uint8_t *SFScanBytes(const uint8_t *ptr, size_t length, const uint8_t *pattern, size_t count)
+{
+    if (count == 0)
+        return ptr;
+    if ((ptr == NULL) || (count > length))
+        return NULL;
+    if (count == 1)
+        return SFScanByte(ptr, length, pattern[0]);
+
+    if (count <= SF_SCAN_SHORT_PATTERN)
+    {
+        const uint8_t *end = (ptr + (length - count) + 1);   /* Last start + 1. */
+        const uint8_t *candidate;
+
+        while ((candidate = SFScanByte(ptr, (size_t)(end - ptr), pattern[0])) != NULL)
+        {
+            if (memcmp((candidate + 1), (pattern + 1), (count - 1)) == 0)
+                return candidate;
+            ptr = (candidate + 1);
+        }
+        return NULL;
+    }
+
+    /* Horspool: shift by the distance of the last byte to the pattern end. */
+    size_t skip[256];
+    size_t i, position = 0, last = (count - 1);
+
+    for (i = 0; i < 256; ++i)
+        skip[i] = count;
+    for (i = 0; i < last; ++i)
+        skip[pattern[i]] = (last - i);
+
+    while (position <= (length - count))
+    {
+        uint8_t tail = ptr[position + last];
+
+        if ((tail == pattern[last]) && (memcmp((ptr + position), pattern, last) == 0))
+            return (ptr + position);
+
+        position += skip[tail];
+    }
+    return NULL;
+}
+//}}}
+// vim:syntax=objc.doxygen
@@ -0,0 +1,942 @@
+/**
+ * \file
+ * Declares the C level access to stream buffers.
+ * The functions in this file are the fast path used by SFStream. They
+ * operate directly on the \c stream_t structure kept by a SFStream object
+ * and, being inlined, don't pay the Objective-C message dispatching for
+ * every primitive value read or written. Hot loops can retrieve the
+ * structure once, with SFStream::handle, and use these functions for each
+ * value.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#include <libkern/OSByteOrder.h>
+#include <string.h>
+
+/**
+ * \ingroup sf_networking
+ * \defgroup sf_networking_streamio Stream Buffers
+ * Inline functions to read and write fixed width values in a stream buffer.
+ * Every function does a single bounds check before copying the value. Reading
+ * functions never change the read position when there are not enough bytes
+ * available. Writing functions grow the buffer using the stream growth factor
+ * when needed, and copy it first when its bytes are shared with other streams.
+ *
+ * The structure can be changed only through these functions or through the
+ * SFStream object that owns it. Never release the buffer directly.
+ * @since 2.1
+ * @{ *//* ---------------------------------------------------------------- */
+
+/**
+ * Memory block shared by streams and data objects.
+ * A stream buffer becomes shared when a slice of it is given to another
+ * stream or to a \c NSData object. The block is released when the last
+ * reference is gone. Writes into shared bytes copy them first.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+struct SF_STREAM_STORAGE {
+    uint8_t *memory;                /**< The allocated block.               */
+    size_t   size;                  /**< Size of the block.                 */
+    size_t   sharedEnd;             /**< End of the bytes seen by slices.   */
+    volatile int32_t references;    /**< Number of owners.                  */
+};
+
+/**
+ * Memory buffer of a stream.
+ * @since 2.1
+ *//* --------------------------------------------------------------------- */
+struct SF_STREAM {
+    uint8_t *buffer;                /**< Allocated memory.                  */
+    size_t   length;                /**< Number of valid bytes.             */
+    size_t   capacity;              /**< Allocated bytes.                   */
+    size_t   nextRead;              /**< Next reading offset.               */
+    size_t   nextWrite;             /**< Next writing offset.               */
+    size_t   highWater;             /**< Greatest length reached.           */
+    size_t   purged;                /**< Bytes removed by purges.           */
+    float    growthFactor;          /**< Capacity multiplier when growing.  */
+    struct SF_STREAM_STORAGE *storage;  /**< Shared block or \b NULL.      */
+};
+typedef struct SF_STREAM stream_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @name Memory Management */ //@{
+// BOOL SFStreamRealloc(stream_t *s, size_t capacity);//{{{
+/**
+ * Reallocates the stream buffer to an exact capacity.
+ * @param s The stream structure.
+ * @param capacity New capacity of the buffer, in bytes. When zero the buffer
+ * is released.
+ * @return \b YES on success. \b NO when there is no memory available. In this
+ * case the buffer is not changed.
+ * @remarks The length and the positions are not adjusted by this function.
+ * @since 2.1
+ **/
+BOOL SFStreamRealloc(stream_t *s, size_t capacity);
+//}}}
+// BOOL SFStreamGrow(stream_t *s, size_t required);//{{{
+/**
+ * Increases the capacity of the stream buffer when needed.
+ * The new capacity is computed with the stream_t::growthFactor so a sequence
+ * of small writes don't reallocate the buffer every time. Large buffers are
+ * rounded up to the system page size. When the buffer is shared the stream
+ * gets a private copy, unless the write position is after all shared bytes.
+ * @param s The stream structure.
+ * @param required The minimum capacity needed.
+ * @return \b YES when the buffer has, at least, \a required bytes. \b NO
+ * when there is no memory available.
+ * @since 2.1
+ **/
+BOOL SFStreamGrow(stream_t *s, size_t required);
+//}}}
+//@}
+
+/** @name Shared Buffers */ //@{
+// struct SF_STREAM_STORAGE *SFStreamShare(stream_t *s, size_t offset, size_t length);//{{{
+/**
+ * Shares a region of the stream buffer.
+ * After this call the stream will copy the shared bytes before changing
+ * them. Bytes written after the shared region, while the capacity allows,
+ * are still written in place.
+ * @param s The stream structure.
+ * @param offset Start of the region, relative to the stream buffer.
+ * @param length Number of bytes in the region.
+ * @return The block holding the buffer, with one more reference that belongs
+ * to the caller. Release it with SFStreamStorageRelease(). \b NULL when there
+ * is no memory available or the stream has no buffer.
+ * @since 2.1
+ **/
+struct SF_STREAM_STORAGE *SFStreamShare(stream_t *s, size_t offset, size_t length);
+//}}}
+// void SFStreamStorageRelease(struct SF_STREAM_STORAGE *storage);//{{{
+/**
+ * Releases one reference of a shared block.
+ * @param storage The shared block. The memory is freed with the last
+ * reference.
+ * @since 2.1
+ **/
+void SFStreamStorageRelease(struct SF_STREAM_STORAGE *storage);
+//}}}
+// BOOL SFStreamSlice(stream_t *dest, stream_t *src, size_t offset, size_t length);//{{{
+/**
+ * Makes a stream a view of a region of another stream buffer.
+ * No byte is copied. Both streams reference the same memory block until one
+ * of them changes a shared byte.
+ * @param dest The stream that will hold the view. Its current buffer is
+ * released. The view starts with read position zero and length equals to
+ * \a length.
+ * @param src The stream with the data.
+ * @param offset Start of the region in \a src.
+ * @param length Number of bytes in the region.
+ * @return \b YES on success. \b NO when the region is out of the \a src
+ * length or there is no memory available.
+ * @since 2.1
+ **/
+BOOL SFStreamSlice(stream_t *dest, stream_t *src, size_t offset, size_t length);
+//}}}
+//@}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @cond SF_PRIVATE */
+NS_INLINE uint8_t *__SFStreamReserve(stream_t *s, size_t size)
+{
+    if (((s->capacity - s->nextWrite) < size) || (s->storage != NULL))
+    {
+        if ((size > (SIZE_MAX - s->nextWrite)) || !SFStreamGrow(s, (s->nextWrite + size)))
+            return NULL;
+    }
+    return (s->buffer + s->nextWrite);
+}
+
+NS_INLINE void __SFStreamCommit(stream_t *s, size_t size)
+{
+    s->nextWrite += size;
+    if (s->nextWrite > s->length)
+    {
+        s->length = s->nextWrite;
+        if (s->length > s->highWater)
+            s->highWater = s->length;
+    }
+}
+/** @endcond */
+
+/** @name Information */ //@{
+// size_t SFStreamAvailable(const stream_t *s);//{{{
+/**
+ * Gets the number of bytes available to read.
+ * @param s The stream structure.
+ * @return The number of bytes between the read position and the stream
+ * length.
+ * @since 2.1
+ **/
+NS_INLINE size_t SFStreamAvailable(const stream_t *s)
+{
+    return (s->length - s->nextRead);
+}
+//}}}
+//@}
+
+/** @name Basic Operations */ //@{
+// size_t SFStreamRead(stream_t *s, void *buffer, size_t length);//{{{
+/**
+ * Reads one or more bytes starting from the current reading position.
+ * @param s The stream to read from.
+ * @param buffer Address to store the read bytes.
+ * @param length Number of bytes to read. When greater than the number of
+ * bytes available only the available bytes are read.
+ * @return The number of bytes stored in \a buffer.
+ * @since 2.1
+ **/
+NS_INLINE size_t SFStreamRead(stream_t *s, void *buffer, size_t length)
+{
+    size_t available = (s->length - s->nextRead);
+
+    if (length > available) length = available;
+    if ((buffer == NULL) || (length == 0))
+        return 0;
+
+    memcpy(buffer, (s->buffer + s->nextRead), length);
+    s->nextRead += length;
+    return length;
+}
+//}}}
+// size_t SFStreamWrite(stream_t *s, const void *data, size_t size);//{{{
+/**
+ * Writes bytes in the stream.
+ * @param s The stream to write in.
+ * @param data Address of the bytes to write.
+ * @param size Number of bytes to write.
+ * @return The number of bytes written. This will be zero when there is no
+ * memory available.
+ * @since 2.1
+ **/
+NS_INLINE size_t SFStreamWrite(stream_t *s, const void *data, size_t size)
+{
+    uint8_t *ptr;
+
+    if ((data == NULL) || (size == 0))
+        return 0;
+
+    if ((ptr = __SFStreamReserve(s, size)) == NULL)
+        return 0;
+
+    memcpy(ptr, data, size);
+    __SFStreamCommit(s, size);
+    return size;
+}
+//}}}
+//@}
+
+/** @name Reading: Host Byte Order */ //@{
+// BOOL SFStreamReadByte(stream_t *s, uint8_t *value);//{{{
+/**
+ * Reads one byte from the stream.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadByte(stream_t *s, uint8_t *value)
+{
+    if ((s->length - s->nextRead) < sizeof(uint8_t))
+        return NO;
+
+    memcpy(value, (s->buffer + s->nextRead), sizeof(uint8_t));
+    s->nextRead += sizeof(uint8_t);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadShort(stream_t *s, uint16_t *value);//{{{
+/**
+ * Reads an unsigned short value (2 bytes) from the stream.
+ * The value is read in host byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadShort(stream_t *s, uint16_t *value)
+{
+    if ((s->length - s->nextRead) < sizeof(uint16_t))
+        return NO;
+
+    memcpy(value, (s->buffer + s->nextRead), sizeof(uint16_t));
+    s->nextRead += sizeof(uint16_t);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadInt(stream_t *s, uint32_t *value);//{{{
+/**
+ * Reads an unsigned int value (4 bytes) from the stream.
+ * The value is read in host byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadInt(stream_t *s, uint32_t *value)
+{
+    if ((s->length - s->nextRead) < sizeof(uint32_t))
+        return NO;
+
+    memcpy(value, (s->buffer + s->nextRead), sizeof(uint32_t));
+    s->nextRead += sizeof(uint32_t);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadLong(stream_t *s, uint64_t *value);//{{{
+/**
+ * Reads an unsigned long long value (8 bytes) from the stream.
+ * The value is read in host byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadLong(stream_t *s, uint64_t *value)
+{
+    if ((s->length - s->nextRead) < sizeof(uint64_t))
+        return NO;
+
+    memcpy(value, (s->buffer + s->nextRead), sizeof(uint64_t));
+    s->nextRead += sizeof(uint64_t);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadFloat(stream_t *s, float *value);//{{{
+/**
+ * Reads a float value (4 bytes) from the stream.
+ * The value is read in host byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadFloat(stream_t *s, float *value)
+{
+    if ((s->length - s->nextRead) < sizeof(float))
+        return NO;
+
+    memcpy(value, (s->buffer + s->nextRead), sizeof(float));
+    s->nextRead += sizeof(float);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadDouble(stream_t *s, double *value);//{{{
+/**
+ * Reads a double value (8 bytes) from the stream.
+ * The value is read in host byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadDouble(stream_t *s, double *value)
+{
+    if ((s->length - s->nextRead) < sizeof(double))
+        return NO;
+
+    memcpy(value, (s->buffer + s->nextRead), sizeof(double));
+    s->nextRead += sizeof(double);
+    return YES;
+}
+//}}}
+//@}
+
+/** @name Reading: Big-Endian */ //@{
+// BOOL SFStreamReadBigEndianShort(stream_t *s, uint16_t *value);//{{{
+/**
+ * Reads an unsigned short value (2 bytes) from the stream.
+ * The value is stored in \b big-endian byte order and is converted to host
+ * byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadBigEndianShort(stream_t *s, uint16_t *value)
+{
+    if ((s->length - s->nextRead) < sizeof(uint16_t))
+        return NO;
+
+    uint16_t raw;
+
+    memcpy(&raw, (s->buffer + s->nextRead), sizeof(uint16_t));
+    raw = OSSwapBigToHostInt16(raw);
+    *value = raw;
+    s->nextRead += sizeof(uint16_t);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadBigEndianInt(stream_t *s, uint32_t *value);//{{{
+/**
+ * Reads an unsigned int value (4 bytes) from the stream.
+ * The value is stored in \b big-endian byte order and is converted to host
+ * byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadBigEndianInt(stream_t *s, uint32_t *value)
+{
+    if ((s->length - s->nextRead) < sizeof(uint32_t))
+        return NO;
+
+    uint32_t raw;
+
+    memcpy(&raw, (s->buffer + s->nextRead), sizeof(uint32_t));
+    raw = OSSwapBigToHostInt32(raw);
+    *value = raw;
+    s->nextRead += sizeof(uint32_t);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadBigEndianLong(stream_t *s, uint64_t *value);//{{{
+/**
+ * Reads an unsigned long long value (8 bytes) from the stream.
+ * The value is stored in \b big-endian byte order and is converted to host
+ * byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadBigEndianLong(stream_t *s, uint64_t *value)
+{
+    if ((s->length - s->nextRead) < sizeof(uint64_t))
+        return NO;
+
+    uint64_t raw;
+
+    memcpy(&raw, (s->buffer + s->nextRead), sizeof(uint64_t));
+    raw = OSSwapBigToHostInt64(raw);
+    *value = raw;
+    s->nextRead += sizeof(uint64_t);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadBigEndianFloat(stream_t *s, float *value);//{{{
+/**
+ * Reads a float value (4 bytes) from the stream.
+ * The value is stored in \b big-endian byte order and is converted to host
+ * byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadBigEndianFloat(stream_t *s, float *value)
+{
+    if ((s->length - s->nextRead) < sizeof(float))
+        return NO;
+
+    uint32_t raw;
+
+    memcpy(&raw, (s->buffer + s->nextRead), sizeof(uint32_t));
+    raw = OSSwapBigToHostInt32(raw);
+    memcpy(value, &raw, sizeof(float));
+    s->nextRead += sizeof(float);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadBigEndianDouble(stream_t *s, double *value);//{{{
+/**
+ * Reads a double value (8 bytes) from the stream.
+ * The value is stored in \b big-endian byte order and is converted to host
+ * byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadBigEndianDouble(stream_t *s, double *value)
+{
+    if ((s->length - s->nextRead) < sizeof(double))
+        return NO;
+
+    uint64_t raw;
+
+    memcpy(&raw, (s->buffer + s->nextRead), sizeof(uint64_t));
+    raw = OSSwapBigToHostInt64(raw);
+    memcpy(value, &raw, sizeof(double));
+    s->nextRead += sizeof(double);
+    return YES;
+}
+//}}}
+//@}
+
+/** @name Reading: Little-Endian */ //@{
+// BOOL SFStreamReadLittleEndianShort(stream_t *s, uint16_t *value);//{{{
+/**
+ * Reads an unsigned short value (2 bytes) from the stream.
+ * The value is stored in \b little-endian byte order and is converted to host
+ * byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadLittleEndianShort(stream_t *s, uint16_t *value)
+{
+    if ((s->length - s->nextRead) < sizeof(uint16_t))
+        return NO;
+
+    uint16_t raw;
+
+    memcpy(&raw, (s->buffer + s->nextRead), sizeof(uint16_t));
+    raw = OSSwapLittleToHostInt16(raw);
+    *value = raw;
+    s->nextRead += sizeof(uint16_t);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadLittleEndianInt(stream_t *s, uint32_t *value);//{{{
+/**
+ * Reads an unsigned int value (4 bytes) from the stream.
+ * The value is stored in \b little-endian byte order and is converted to host
+ * byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadLittleEndianInt(stream_t *s, uint32_t *value)
+{
+    if ((s->length - s->nextRead) < sizeof(uint32_t))
+        return NO;
+
+    uint32_t raw;
+
+    memcpy(&raw, (s->buffer + s->nextRead), sizeof(uint32_t));
+    raw = OSSwapLittleToHostInt32(raw);
+    *value = raw;
+    s->nextRead += sizeof(uint32_t);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadLittleEndianLong(stream_t *s, uint64_t *value);//{{{
+/**
+ * Reads an unsigned long long value (8 bytes) from the stream.
+ * The value is stored in \b little-endian byte order and is converted to host
+ * byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadLittleEndianLong(stream_t *s, uint64_t *value)
+{
+    if ((s->length - s->nextRead) < sizeof(uint64_t))
+        return NO;
+
+    uint64_t raw;
+
+    memcpy(&raw, (s->buffer + s->nextRead), sizeof(uint64_t));
+    raw = OSSwapLittleToHostInt64(raw);
+    *value = raw;
+    s->nextRead += sizeof(uint64_t);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadLittleEndianFloat(stream_t *s, float *value);//{{{
+/**
+ * Reads a float value (4 bytes) from the stream.
+ * The value is stored in \b little-endian byte order and is converted to host
+ * byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadLittleEndianFloat(stream_t *s, float *value)
+{
+    if ((s->length - s->nextRead) < sizeof(float))
+        return NO;
+
+    uint32_t raw;
+
+    memcpy(&raw, (s->buffer + s->nextRead), sizeof(uint32_t));
+    raw = OSSwapLittleToHostInt32(raw);
+    memcpy(value, &raw, sizeof(float));
+    s->nextRead += sizeof(float);
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadLittleEndianDouble(stream_t *s, double *value);//{{{
+/**
+ * Reads a double value (8 bytes) from the stream.
+ * The value is stored in \b little-endian byte order and is converted to host
+ * byte order.
+ * @param s The stream to read from.
+ * @param value Where the value will be stored.
+ * @return \b YES on success. \b NO when there are not enough bytes
+ * available. In this case neither \a value nor the read position change.
+ **/
+NS_INLINE BOOL SFStreamReadLittleEndianDouble(stream_t *s, double *value)
+{
+    if ((s->length - s->nextRead) < sizeof(double))
+        return NO;
+
+    uint64_t raw;
+
+    memcpy(&raw, (s->buffer + s->nextRead), sizeof(uint64_t));
+    raw = OSSwapLittleToHostInt64(raw);
+    memcpy(value, &raw, sizeof(double));
+    s->nextRead += sizeof(double);
+    return YES;
+}
+//}}}
+//@}
+
+/** @name Writing: Host Byte Order */ //@{
+// BOOL SFStreamWriteByte(stream_t *s, uint8_t value);//{{{
+/**
+ * Writes one byte in the stream.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteByte(stream_t *s, uint8_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(uint8_t));
+
+    if (ptr == NULL) return NO;
+
+    memcpy(ptr, &value, sizeof(uint8_t));
+    __SFStreamCommit(s, sizeof(uint8_t));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteShort(stream_t *s, uint16_t value);//{{{
+/**
+ * Writes an unsigned short value (2 bytes) in the stream.
+ * The value is written in host byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteShort(stream_t *s, uint16_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(uint16_t));
+
+    if (ptr == NULL) return NO;
+
+    memcpy(ptr, &value, sizeof(uint16_t));
+    __SFStreamCommit(s, sizeof(uint16_t));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteInt(stream_t *s, uint32_t value);//{{{
+/**
+ * Writes an unsigned int value (4 bytes) in the stream.
+ * The value is written in host byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteInt(stream_t *s, uint32_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(uint32_t));
+
+    if (ptr == NULL) return NO;
+
+    memcpy(ptr, &value, sizeof(uint32_t));
+    __SFStreamCommit(s, sizeof(uint32_t));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteLong(stream_t *s, uint64_t value);//{{{
+/**
+ * Writes an unsigned long long value (8 bytes) in the stream.
+ * The value is written in host byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteLong(stream_t *s, uint64_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(uint64_t));
+
+    if (ptr == NULL) return NO;
+
+    memcpy(ptr, &value, sizeof(uint64_t));
+    __SFStreamCommit(s, sizeof(uint64_t));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteFloat(stream_t *s, float value);//{{{
+/**
+ * Writes a float value (4 bytes) in the stream.
+ * The value is written in host byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteFloat(stream_t *s, float value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(float));
+
+    if (ptr == NULL) return NO;
+
+    memcpy(ptr, &value, sizeof(float));
+    __SFStreamCommit(s, sizeof(float));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteDouble(stream_t *s, double value);//{{{
+/**
+ * Writes a double value (8 bytes) in the stream.
+ * The value is written in host byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteDouble(stream_t *s, double value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(double));
+
+    if (ptr == NULL) return NO;
+
+    memcpy(ptr, &value, sizeof(double));
+    __SFStreamCommit(s, sizeof(double));
+    return YES;
+}
+//}}}
+//@}
+
+/** @name Writing: Big-Endian */ //@{
+// BOOL SFStreamWriteBigEndianShort(stream_t *s, uint16_t value);//{{{
+/**
+ * Writes an unsigned short value (2 bytes) in the stream.
+ * The value is converted from host byte order to \b big-endian byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteBigEndianShort(stream_t *s, uint16_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(uint16_t));
+
+    if (ptr == NULL) return NO;
+
+    uint16_t raw = OSSwapHostToBigInt16(value);
+    memcpy(ptr, &raw, sizeof(uint16_t));
+    __SFStreamCommit(s, sizeof(uint16_t));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteBigEndianInt(stream_t *s, uint32_t value);//{{{
+/**
+ * Writes an unsigned int value (4 bytes) in the stream.
+ * The value is converted from host byte order to \b big-endian byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteBigEndianInt(stream_t *s, uint32_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(uint32_t));
+
+    if (ptr == NULL) return NO;
+
+    uint32_t raw = OSSwapHostToBigInt32(value);
+    memcpy(ptr, &raw, sizeof(uint32_t));
+    __SFStreamCommit(s, sizeof(uint32_t));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteBigEndianLong(stream_t *s, uint64_t value);//{{{
+/**
+ * Writes an unsigned long long value (8 bytes) in the stream.
+ * The value is converted from host byte order to \b big-endian byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteBigEndianLong(stream_t *s, uint64_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(uint64_t));
+
+    if (ptr == NULL) return NO;
+
+    uint64_t raw = OSSwapHostToBigInt64(value);
+    memcpy(ptr, &raw, sizeof(uint64_t));
+    __SFStreamCommit(s, sizeof(uint64_t));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteBigEndianFloat(stream_t *s, float value);//{{{
+/**
+ * Writes a float value (4 bytes) in the stream.
+ * The value is converted from host byte order to \b big-endian byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteBigEndianFloat(stream_t *s, float value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(float));
+
+    if (ptr == NULL) return NO;
+
+    uint32_t raw;
+
+    memcpy(&raw, &value, sizeof(uint32_t));
+    raw = OSSwapHostToBigInt32(raw);
+    memcpy(ptr, &raw, sizeof(uint32_t));
+    __SFStreamCommit(s, sizeof(float));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteBigEndianDouble(stream_t *s, double value);//{{{
+/**
+ * Writes a double value (8 bytes) in the stream.
+ * The value is converted from host byte order to \b big-endian byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteBigEndianDouble(stream_t *s, double value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(double));
+
+    if (ptr == NULL) return NO;
+
+    uint64_t raw;
+
+    memcpy(&raw, &value, sizeof(uint64_t));
+    raw = OSSwapHostToBigInt64(raw);
+    memcpy(ptr, &raw, sizeof(uint64_t));
+    __SFStreamCommit(s, sizeof(double));
+    return YES;
+}
+//}}}
+//@}
+
+/** @name Writing: Little-Endian */ //@{
+// BOOL SFStreamWriteLittleEndianShort(stream_t *s, uint16_t value);//{{{
+/**
+ * Writes an unsigned short value (2 bytes) in the stream.
+ * The value is converted from host byte order to \b little-endian byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteLittleEndianShort(stream_t *s, uint16_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(uint16_t));
+
+    if (ptr == NULL) return NO;
+
+    uint16_t raw = OSSwapHostToLittleInt16(value);
+    memcpy(ptr, &raw, sizeof(uint16_t));
+    __SFStreamCommit(s, sizeof(uint16_t));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteLittleEndianInt(stream_t *s, uint32_t value);//{{{
+/**
+ * Writes an unsigned int value (4 bytes) in the stream.
+ * The value is converted from host byte order to \b little-endian byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteLittleEndianInt(stream_t *s, uint32_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(uint32_t));
+
+    if (ptr == NULL) return NO;
+
+    uint32_t raw = OSSwapHostToLittleInt32(value);
+    memcpy(ptr, &raw, sizeof(uint32_t));
+    __SFStreamCommit(s, sizeof(uint32_t));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteLittleEndianLong(stream_t *s, uint64_t value);//{{{
+/**
+ * Writes an unsigned long long value (8 bytes) in the stream.
+ * The value is converted from host byte order to \b little-endian byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteLittleEndianLong(stream_t *s, uint64_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(uint64_t));
+
+    if (ptr == NULL) return NO;
+
+    uint64_t raw = OSSwapHostToLittleInt64(value);
+    memcpy(ptr, &raw, sizeof(uint64_t));
+    __SFStreamCommit(s, sizeof(uint64_t));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteLittleEndianFloat(stream_t *s, float value);//{{{
+/**
+ * Writes a float value (4 bytes) in the stream.
+ * The value is converted from host byte order to \b little-endian byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteLittleEndianFloat(stream_t *s, float value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(float));
+
+    if (ptr == NULL) return NO;
+
+    uint32_t raw;
+
+    memcpy(&raw, &value, sizeof(uint32_t));
+    raw = OSSwapHostToLittleInt32(raw);
+    memcpy(ptr, &raw, sizeof(uint32_t));
+    __SFStreamCommit(s, sizeof(float));
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteLittleEndianDouble(stream_t *s, double value);//{{{
+/**
+ * Writes a double value (8 bytes) in the stream.
+ * The value is converted from host byte order to \b little-endian byte order.
+ * @param s The stream to write in.
+ * @param value The value to be written.
+ * @return \b YES on success. \b NO when the buffer could not grow.
+ **/
+NS_INLINE BOOL SFStreamWriteLittleEndianDouble(stream_t *s, double value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, sizeof(double));
+
+    if (ptr == NULL) return NO;
+
+    uint64_t raw;
+
+    memcpy(&raw, &value, sizeof(uint64_t));
+    raw = OSSwapHostToLittleInt64(raw);
+    memcpy(ptr, &raw, sizeof(uint64_t));
+    __SFStreamCommit(s, sizeof(double));
+    return YES;
+}
+//}}}
+//@}
+
+///@} sf_networking_streamio
+// vim:ft=objc syntax=objc.doxygen
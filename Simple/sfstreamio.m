@@ -0,0 +1,255 @@
+/**
+ * \file
+ * Defines the C level functions to manage stream buffers.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "sfstreamio.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <libkern/OSAtomic.h>
+
+/**
+ * Buffers with this capacity or greater are rounded to the system page size
+ * when they grow.
+ **/
+#define SFSTREAM_PAGE_ROUND_THRESHOLD   (64 * 1024)
+
+/**
+ * Minimum capacity allocated when an empty stream grows.
+ **/
+#define SFSTREAM_MINIMUM_CAPACITY       64
+
+/* ===========================================================================
+ * LOCAL FUNCTIONS
+ * ======================================================================== */
+// static size_t SFStreamGrowSize(const stream_t *s, size_t required);//{{{
+/**
+ * Computes the capacity of a buffer that must hold \a required bytes.
+ **/
+static size_t SFStreamGrowSize(const stream_t *s, size_t required)
+{
+    float factor = ((s->growthFactor < 1.0f) ? 1.0f : s->growthFactor);
+    double grown = ((double)s->capacity * factor);
+    size_t total = ((grown >= (double)SIZE_MAX) ? SIZE_MAX : (size_t)grown);
+
+    if (total < required) total = required;
+    if (total < SFSTREAM_MINIMUM_CAPACITY) total = SFSTREAM_MINIMUM_CAPACITY;
+
+    if (total >= SFSTREAM_PAGE_ROUND_THRESHOLD)
+    {
+        size_t page = (size_t)getpagesize();
+        size_t rounded = ((total + (page - 1)) & ~(page - 1));
+
+        if (rounded > total) total = rounded;   /* Don't overflow. */
+    }
+    return total;
+}
+//}}}
+// static void SFStreamReclaim(stream_t *s);//{{{
+/**
+ * Takes back the ownership of a shared block with a single reference.
+ * The stream data is moved to the start of the block.
+ **/
+static void SFStreamReclaim(stream_t *s)
+{
+    struct SF_STREAM_STORAGE *storage = s->storage;
+
+    if (s->buffer != storage->memory)
+        memmove(storage->memory, s->buffer, s->length);
+
+    s->buffer   = storage->memory;
+    s->capacity = storage->size;
+    s->storage  = NULL;
+    free(storage);
+}
+//}}}
+// static BOOL SFStreamDetach(stream_t *s, size_t capacity);//{{{
+/**
+ * Copies the data of a shared buffer into private memory.
+ * @param s The stream.
+ * @param capacity Capacity of the new buffer. Only the bytes that fit are
+ * copied.
+ **/
+static BOOL SFStreamDetach(stream_t *s, size_t capacity)
+{
+    uint8_t *ptr = (uint8_t *)malloc(capacity);
+
+    if (ptr == NULL)
+        return NO;
+
+    memcpy(ptr, s->buffer, ((s->length < capacity) ? s->length : capacity));
+    SFStreamStorageRelease(s->storage);
+
+    s->buffer   = ptr;
+    s->capacity = capacity;
+    s->storage  = NULL;
+    return YES;
+}
+//}}}
+// static BOOL SFStreamGrowShared(stream_t *s, size_t required);//{{{
+/**
+ * Prepares a shared buffer to be written from the write position.
+ **/
+static BOOL SFStreamGrowShared(stream_t *s, size_t required)
+{
+    struct SF_STREAM_STORAGE *storage = s->storage;
+
+    if (storage->references == 1)
+    {
+        SFStreamReclaim(s);
+        return SFStreamGrow(s, required);
+    }
+
+    /* Bytes after every shared region can be written in place. */
+    if ((required <= s->capacity) && ((s->buffer + s->nextWrite) >= (storage->memory + storage->sharedEnd)))
+        return YES;
+
+    if (required <= s->capacity)
+        return SFStreamDetach(s, s->capacity);
+
+    size_t total = SFStreamGrowSize(s, required);
+    if (SFStreamDetach(s, total))
+        return YES;
+
+    return ((total > required) && SFStreamDetach(s, required));
+}
+//}}}
+
+/* ===========================================================================
+ * PUBLIC FUNCTIONS
+ * ======================================================================== */
+// BOOL SFStreamRealloc(stream_t *s, size_t capacity);//{{{
+BOOL SFStreamRealloc(stream_t *s, size_t capacity)
+{
+    uint8_t *ptr = NULL;
+
+    if (s->storage != NULL)
+    {
+        if (capacity == 0)
+        {
+            SFStreamStorageRelease(s->storage);
+            s->storage = NULL;
+            s->buffer = NULL;
+            s->capacity = 0;
+            return YES;
+        }
+
+        if (s->storage->references > 1)
+            return SFStreamDetach(s, capacity);
+
+        SFStreamReclaim(s);
+    }
+
+    if (capacity == 0)
+    {
+        if (s->buffer != NULL) free(s->buffer);
+        s->buffer = NULL;
+        s->capacity = 0;
+        return YES;
+    }
+
+    ptr = (uint8_t *)realloc(s->buffer, capacity);
+    if (ptr == NULL)
+        return NO;
+
+    s->buffer = ptr;
+    s->capacity = capacity;
+    return YES;
+}
+//}}}
+// BOOL SFStreamGrow(stream_t *s, size_t required);//{{{
+BOOL SFStreamGrow(stream_t *s, size_t required)
+{
+    if (s->storage != NULL)
+        return SFStreamGrowShared(s, required);
+
+    if (required <= s->capacity)
+        return YES;
+
+    size_t total = SFStreamGrowSize(s, required);
+
+    /* When the geometric growth cannot be allocated try the exact amount
+     * before failing. */
+    if (SFStreamRealloc(s, total))
+        return YES;
+
+    return ((total > required) && SFStreamRealloc(s, required));
+}
+//}}}
+// struct SF_STREAM_STORAGE *SFStreamShare(stream_t *s, size_t offset, size_t length);//{{{
+struct SF_STREAM_STORAGE *SFStreamShare(stream_t *s, size_t offset, size_t length)
+{
+    struct SF_STREAM_STORAGE *storage = s->storage;
+
+    if (s->buffer == NULL)
+        return NULL;
+
+    if (storage == NULL)
+    {
+        storage = (struct SF_STREAM_STORAGE *)malloc(sizeof(struct SF_STREAM_STORAGE));
+        if (storage == NULL) return NULL;
+
+        storage->memory = s->buffer;
+        storage->size = s->capacity;
+        storage->sharedEnd = 0;
+        storage->references = 1;
+        s->storage = storage;
+    }
+
+    size_t end = ((size_t)(s->buffer - storage->memory) + offset + length);
+    if (end > storage->sharedEnd)
+        storage->sharedEnd = end;
+
+    OSAtomicIncrement32Barrier(&storage->references);
+    return storage;
+}
+//}}}
+// void SFStreamStorageRelease(struct SF_STREAM_STORAGE *storage);//{{{
+void SFStreamStorageRelease(struct SF_STREAM_STORAGE *storage)
+{
+    if (storage == NULL) return;
+
+    if (OSAtomicDecrement32Barrier(&storage->references) == 0)
+    {
+        free(storage->memory);
+        free(storage);
+    }
+}
+//}}}
+// BOOL SFStreamSlice(stream_t *dest, stream_t *src, size_t offset, size_t length);//{{{
+BOOL SFStreamSlice(stream_t *dest, stream_t *src, size_t offset, size_t length)
+{
+    struct SF_STREAM_STORAGE *storage = NULL;
+
+    if ((dest == src) || (offset > src->length) || (length > (src->length - offset)))
+        return NO;
+
+    if ((length > 0) && ((storage = SFStreamShare(src, offset, length)) == NULL))
+        return NO;
+
+    SFStreamRealloc(dest, 0);
+
+    dest->buffer    = ((storage != NULL) ? (src->buffer + offset) : NULL);
+    dest->storage   = storage;
+    dest->capacity  = length;
+    dest->length    = length;
+    dest->nextRead  = 0;
+    dest->nextWrite = length;
+    if (dest->highWater < length)
+        dest->highWater = length;
+
+    return YES;
+}
+//}}}
+// vim:syntax=objc.doxygen
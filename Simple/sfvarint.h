@@ -0,0 +1,348 @@
+/**
+ * \file
+ * Declares the C level varint encoding and frame functions.
+ * Integers are encoded in LEB128: seven bits per byte, least significant
+ * group first, with the high bit set in every byte except the last. Signed
+ * integers are mapped to unsigned ones with zigzag encoding first, so small
+ * negative values are also short. Frames are a varint with the payload
+ * length followed by the payload.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import <Foundation/Foundation.h>
+#import "sfstreamio.h"
+
+/**
+ * \ingroup sf_networking
+ * \defgroup sf_networking_varint Varint and Frames
+ * Inline functions to encode variable length integers and length prefixed
+ * frames, on memory buffers and on stream buffers. Decoding functions never
+ * consume partial data: when the bytes available don't hold a complete value
+ * or frame nothing is changed, so the caller can wait for more data and try
+ * again.
+ * @since 2.1
+ * @{ *//* ---------------------------------------------------------------- */
+
+/**
+ * Maximum number of bytes of an encoded 64 bits integer.
+ **/
+#define SF_VARINT_MAX_SIZE      10
+
+/**
+ * Result of the frame checking functions.
+ **/
+typedef NS_ENUM(int, SFFrameStatus) {
+    SFFrameMalformed = -1,          /**< Invalid or too long length prefix. */
+    SFFrameIncomplete = 0,          /**< More bytes are needed.             */
+    SFFrameComplete = 1             /**< A whole frame is available.        */
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @name Bulk Decoding */ //@{
+// size_t SFVarintDecodeArray(const uint8_t *src, size_t length, uint64_t *values, size_t count, size_t *consumed);//{{{
+/**
+ * Decodes a sequence of varints.
+ * Groups of eight values encoded in a single byte each, the most common case
+ * in arrays of small numbers, are decoded with one 64 bits test.
+ * @param src Encoded bytes.
+ * @param length Number of bytes in \a src.
+ * @param values Array that receives the decoded values.
+ * @param count Maximum number of values to decode.
+ * @param consumed Receives the number of bytes decoded from \a src. Can be
+ * \b NULL.
+ * @return The number of values stored in \a values. Decoding stops at the
+ * first incomplete or malformed value.
+ * @since 2.1
+ **/
+size_t SFVarintDecodeArray(const uint8_t *src, size_t length, uint64_t *values, size_t count, size_t *consumed);
+//}}}
+//@}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @name Zigzag Encoding */ //@{
+// uint64_t SFZigZagEncode(int64_t value);//{{{
+/**
+ * Maps a signed integer to an unsigned one.
+ * Values 0, -1, 1, -2, 2... become 0, 1, 2, 3, 4...
+ * @param value The signed value.
+ * @return The zigzag encoded value.
+ * @since 2.1
+ **/
+NS_INLINE uint64_t SFZigZagEncode(int64_t value)
+{
+    return (((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+//}}}
+// int64_t SFZigZagDecode(uint64_t value);//{{{
+/**
+ * Reverts the zigzag encoding.
+ * @param value The encoded value.
+ * @return The original signed value.
+ * @since 2.1
+ **/
+NS_INLINE int64_t SFZigZagDecode(uint64_t value)
+{
+    return (int64_t)((value >> 1) ^ (0 - (value & 1)));
+}
+//}}}
+//@}
+
+/** @name Memory Buffers */ //@{
+// size_t SFVarintSize(uint64_t value);//{{{
+/**
+ * Gets the number of bytes needed to encode a value.
+ * @param value The value.
+ * @return A number between 1 and \c SF_VARINT_MAX_SIZE.
+ * @since 2.1
+ **/
+NS_INLINE size_t SFVarintSize(uint64_t value)
+{
+    size_t size = 1;
+
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+//}}}
+// size_t SFVarintEncode(uint8_t *dest, uint64_t value);//{{{
+/**
+ * Encodes a value.
+ * @param dest Where to store the encoded bytes. Must have room for, at
+ * least, SFVarintSize() bytes.
+ * @param value The value.
+ * @return The number of bytes stored.
+ * @since 2.1
+ **/
+NS_INLINE size_t SFVarintEncode(uint8_t *dest, uint64_t value)
+{
+    size_t size = 0;
+
+    while (value >= 0x80)
+    {
+        dest[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    dest[size++] = (uint8_t)value;
+    return size;
+}
+//}}}
+// int SFVarintDecode(const uint8_t *src, size_t length, uint64_t *value);//{{{
+/**
+ * Decodes a value.
+ * @param src Encoded bytes.
+ * @param length Number of bytes available in \a src.
+ * @param value Receives the decoded value.
+ * @return The number of bytes decoded, from 1 to \c SF_VARINT_MAX_SIZE. Zero
+ * when \a src ends before the last byte of the value. -1 when the encoding
+ * is longer than \c SF_VARINT_MAX_SIZE bytes or overflows 64 bits. \a value
+ * is changed only on success.
+ * @since 2.1
+ **/
+NS_INLINE int SFVarintDecode(const uint8_t *src, size_t length, uint64_t *value)
+{
+    uint64_t result = 0;
+    size_t i, limit = ((length < SF_VARINT_MAX_SIZE) ? length : SF_VARINT_MAX_SIZE);
+
+    /* Single byte values are the common case. */
+    if ((length > 0) && (src[0] < 0x80)) {
+        *value = src[0];
+        return 1;
+    }
+
+    for (i = 0; i < limit; ++i)
+    {
+        result |= ((uint64_t)(src[i] & 0x7F) << (7 * i));
+        if (src[i] < 0x80)
+        {
+            if ((i == (SF_VARINT_MAX_SIZE - 1)) && (src[i] > 1))
+                return -1;          /* More than 64 bits. */
+
+            *value = result;
+            return (int)(i + 1);
+        }
+    }
+    return ((limit == SF_VARINT_MAX_SIZE) ? -1 : 0);
+}
+//}}}
+//@}
+
+/** @name Stream Buffers */ //@{
+// BOOL SFStreamWriteVarint(stream_t *s, uint64_t value);//{{{
+/**
+ * Writes a varint in the stream.
+ * @param s The stream to write in.
+ * @param value The value.
+ * @return \b YES on success. \b NO when there is no memory available.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFStreamWriteVarint(stream_t *s, uint64_t value)
+{
+    uint8_t *ptr = __SFStreamReserve(s, SF_VARINT_MAX_SIZE);
+
+    if (ptr == NULL)
+        return NO;
+
+    __SFStreamCommit(s, SFVarintEncode(ptr, value));
+    return YES;
+}
+//}}}
+// BOOL SFStreamReadVarint(stream_t *s, uint64_t *value);//{{{
+/**
+ * Reads a varint from the stream.
+ * @param s The stream to read from.
+ * @param value Receives the value.
+ * @return \b YES on success. \b NO when the value is incomplete or
+ * malformed. In this case neither \a value nor the read position change.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFStreamReadVarint(stream_t *s, uint64_t *value)
+{
+    int size = SFVarintDecode((s->buffer + s->nextRead), (s->length - s->nextRead), value);
+
+    if (size <= 0)
+        return NO;
+
+    s->nextRead += (size_t)size;
+    return YES;
+}
+//}}}
+// BOOL SFStreamWriteSignedVarint(stream_t *s, int64_t value);//{{{
+/**
+ * Writes a zigzag encoded varint in the stream.
+ * @param s The stream to write in.
+ * @param value The value.
+ * @return \b YES on success. \b NO when there is no memory available.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFStreamWriteSignedVarint(stream_t *s, int64_t value)
+{
+    return SFStreamWriteVarint(s, SFZigZagEncode(value));
+}
+//}}}
+// BOOL SFStreamReadSignedVarint(stream_t *s, int64_t *value);//{{{
+/**
+ * Reads a zigzag encoded varint from the stream.
+ * @param s The stream to read from.
+ * @param value Receives the value.
+ * @return \b YES on success. \b NO when the value is incomplete or
+ * malformed. In this case neither \a value nor the read position change.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFStreamReadSignedVarint(stream_t *s, int64_t *value)
+{
+    uint64_t encoded;
+
+    if (!SFStreamReadVarint(s, &encoded))
+        return NO;
+
+    *value = SFZigZagDecode(encoded);
+    return YES;
+}
+//}}}
+//@}
+
+/** @name Frames */ //@{
+// BOOL SFStreamWriteFrame(stream_t *s, const void *data, size_t length);//{{{
+/**
+ * Writes a length prefixed frame.
+ * @param s The stream to write in.
+ * @param data The payload. Can be \b NULL when \a length is zero.
+ * @param length Number of bytes in \a data.
+ * @return \b YES on success. \b NO when there is no memory available. In
+ * this case nothing is written.
+ * @since 2.1
+ **/
+NS_INLINE BOOL SFStreamWriteFrame(stream_t *s, const void *data, size_t length)
+{
+    size_t header = SFVarintSize(length);
+    uint8_t *ptr;
+
+    if ((length > (SIZE_MAX - header)) || ((ptr = __SFStreamReserve(s, (header + length))) == NULL))
+        return NO;
+
+    SFVarintEncode(ptr, length);
+    if (length > 0) memcpy((ptr + header), data, length);
+    __SFStreamCommit(s, (header + length));
+    return YES;
+}
+//}}}
+// SFFrameStatus SFStreamPeekFrame(const stream_t *s, size_t maximum, size_t *header, size_t *length);//{{{
+/**
+ * Checks whether a whole frame is available at the read position.
+ * Nothing is consumed. The check costs the decoding of the length prefix
+ * only, so it can be repeated after every read from the network.
+ * @param s The stream to check.
+ * @param maximum Greatest payload length accepted. Longer frames are
+ * reported as malformed, so a corrupted prefix doesn't make the caller wait
+ * for gigabytes. Pass \c SIZE_MAX to accept any length.
+ * @param header Receives the size of the length prefix. Can be \b NULL.
+ * @param length Receives the payload length. Can be \b NULL. Both are set
+ * when the prefix is complete, even if the payload is not.
+ * @return One of the \c SFFrameStatus values.
+ * @since 2.1
+ **/
+NS_INLINE SFFrameStatus SFStreamPeekFrame(const stream_t *s, size_t maximum, size_t *header, size_t *length)
+{
+    size_t available = (s->length - s->nextRead);
+    uint64_t payload = 0;
+    int size = SFVarintDecode((s->buffer + s->nextRead), available, &payload);
+
+    if (size < 0)
+        return SFFrameMalformed;
+    if (size == 0)
+        return SFFrameIncomplete;
+    if (payload > (uint64_t)maximum)
+        return SFFrameMalformed;
+
+    if (header != NULL) *header = (size_t)size;
+    if (length != NULL) *length = (size_t)payload;
+
+    return (((available - (size_t)size) >= payload) ? SFFrameComplete : SFFrameIncomplete);
+}
+//}}}
+// const uint8_t *SFStreamReadFrame(stream_t *s, size_t maximum, size_t *length);//{{{
+/**
+ * Reads a whole frame from the stream without copying it.
+ * @param s The stream to read from.
+ * @param maximum Greatest payload length accepted. See SFStreamPeekFrame().
+ * @param length Receives the payload length.
+ * @return The address of the payload in the stream buffer. It is valid
+ * until the stream buffer changes. \b NULL when there is no whole frame
+ * available. In this case the read position doesn't change.
+ * @since 2.1
+ **/
+NS_INLINE const uint8_t *SFStreamReadFrame(stream_t *s, size_t maximum, size_t *length)
+{
+    size_t header = 0, payload = 0;
+    const uint8_t *ptr;
+
+    if (SFStreamPeekFrame(s, maximum, &header, &payload) != SFFrameComplete)
+        return NULL;
+
+    ptr = (s->buffer + s->nextRead + header);
+    s->nextRead += (header + payload);
+    *length = payload;
+    return ptr;
+}
+//}}}
+//@}
+
+///@} sf_networking_varint
+// vim:ft=objc syntax=objc.doxygen
@@ -0,0 +1,65 @@
+/**
+ * \file
+ * Defines the C level varint functions that are not inlined.
+ *
+ * \author Alessandro Antonello aantonello@paralaxe.com.br
+ * \date   October 16, 2026
+ * \since  Simple Framework 2.1
+ *
+ * \copyright
+ * This file is provided in hope that it will be useful to someone. It is
+ * offered in public domain. You may use, modify or distribute it freely.
+ *
+ * The code is provided "AS IS". There is no warranty at all, of any kind. You
+ * may change it if you like. Or just use it as it is.
+ */
+#import "sfvarint.h"
+
+/**
+ * The high bit of every byte in a 64 bits word.
+ **/
+#define SF_VARINT_CONTINUATION_BITS     0x8080808080808080ULL
+
+// size_t SFVarintDecodeArray(const uint8_t *src, size_t length, uint64_t *values, size_t count, size_t *consumed);//{{{
+size_t SFVarintDecodeArray(const uint8_t *src, size_t length, uint64_t *values, size_t count, size_t *consumed)
+{
+    size_t offset = 0, total = 0;
+    uint64_t word, marks;
+    int size;
+
+    while (total < count)
+    {
+        /* Eight bytes are tested at once. Every byte before the first one
+         * with the high bit set is a whole value. */
+        while (((length - offset) >= sizeof(uint64_t)) && ((count - total) >= sizeof(uint64_t)))
+        {
+            memcpy(&word, (src + offset), sizeof(uint64_t));
+            word = OSSwapLittleToHostInt64(word);
+            marks = (word & SF_VARINT_CONTINUATION_BITS);
+
+            size_t singles = ((marks == 0) ? sizeof(uint64_t) : ((size_t)__builtin_ctzll(marks) >> 3));
+            for (size_t i = 0; i < singles; ++i)
+                values[total + i] = ((word >> (i * 8)) & 0xFF);
+
+            total += singles;
+            offset += singles;
+            if (singles < sizeof(uint64_t))
+                break;
+        }
+
+        if (total >= count)
+            break;
+
+        size = SFVarintDecode((src + offset), (length - offset), (values + total));
+        if (size <= 0)
+            break;
+
+        offset += (size_t)size;
+        total++;
+    }
+
+    if (consumed != NULL) *consumed = offset;
+    return total;
+}
+//}}}
+// vim:syntax=objc.doxygen
@@ -0,0 +1,1665 @@
+//
+//  SFSocketTests.m
+//  SimpleTests
+//
+//  Tests and benchmarks for the SFSocket family of interfaces.
+//
+
+#import <XCTest/XCTest.h>
+#import <Simple/Simple.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <poll.h>
+
+/** Number of connections in the event loop benchmark. */
+#define LOOP_BENCHMARK_CONNECTIONS  200
+
+/** Number of round trips made by each connection in the loop benchmark. */
+#define LOOP_BENCHMARK_MESSAGES     500
+
+/** Size of each message in the loop benchmark. */
+#define LOOP_MESSAGE_SIZE           64
+
+/** Greatest number of threads in the server scaling benchmark. */
+#define SERVER_BENCHMARK_THREADS    4
+
+/** Bytes sent by the write queue test, with a small kernel buffer. */
+#define QUEUE_TEST_SIZE             (8 * 1024 * 1024)
+
+/** Bytes sent by the write queue benchmark. */
+#define QUEUE_BENCHMARK_SIZE        (512 * 1024 * 1024)
+
+/** Size of each buffer queued in the write queue benchmark. */
+#define QUEUE_CHUNK_SIZE            (64 * 1024)
+
+/** Size of the file sent by the sendFile benchmark. */
+#define FILE_BENCHMARK_SIZE         (256 * 1024 * 1024)
+
+/** Round trips made with each profile in the tuning benchmark. */
+#define PROFILE_BENCHMARK_ROUNDS    200
+
+/** Bytes sent with each profile in the tuning benchmark. */
+#define PROFILE_BENCHMARK_SIZE      (256 * 1024 * 1024)
+
+/** Connections made by each strategy in the Happy Eyeballs benchmark. */
+#define CONNECT_BENCHMARK_ATTEMPTS  20
+
+/** Seconds the sequential strategy waits for each address. */
+#define CONNECT_BENCHMARK_TIMEOUT   1.0
+
+/** Datagrams sent of each size by the datagram benchmark. */
+#define DATAGRAM_BENCHMARK_COUNT    200000
+
+/** Number of requests made by the connection pool benchmark. */
+#define POOL_BENCHMARK_REQUESTS     1000
+
+/** Number of messages sent by the scatter/gather benchmark. */
+#define GATHER_BENCHMARK_MESSAGES   200000
+
+/** Header and payload sizes of the scatter/gather benchmark messages. */
+#define GATHER_HEADER_SIZE          16
+#define GATHER_PAYLOAD_SIZE         48
+
+/**
+ * Resolver whose lookups take 50 ms and answer 127.0.0.1 for every name,
+ * except "missing.test", that is not found.
+ **/
+@interface SFStubResolver : SFResolver {
+@public
+    volatile int32_t lookups;
+}
+@end
+
+@implementation SFStubResolver
+// - (error_t)lookupHost:(NSString *)host port:(NSUInteger)port addresses:(NSArray **)addresses;//{{{
+- (error_t)lookupHost:(NSString *)host port:(NSUInteger)port addresses:(NSArray **)addresses
+{
+    __sync_fetch_and_add(&lookups, 1);
+    usleep(50000);
+
+    if ([host isEqualToString:@"missing.test"])
+        return ENETDOWN;
+    return [super lookupHost:@"127.0.0.1" port:port addresses:addresses];
+}
+//}}}
+@end
+
+@interface SFSocketTests : XCTestCase <SFSocketLoopDelegate> {
+    NSSet *m_clients;               /* Not changed while loops run.         */
+    volatile NSInteger m_connected;
+    volatile NSInteger m_received;
+    volatile NSInteger m_finished;
+    volatile NSInteger m_closed;
+    volatile NSInteger m_ticks;
+    volatile NSInteger m_watermarks;
+    volatile NSInteger m_sunk;      /* Bytes discarded when m_sink is set.  */
+    BOOL m_sink;
+}
+@end
+
+@implementation SFSocketTests
+// Helpers
+// - (socket_t)listenerWithPort:(uint16_t *)port;//{{{
+/**
+ * Creates a socket listening in a random port of 127.0.0.1.
+ **/
+- (socket_t)listenerWithPort:(uint16_t *)port
+{
+    struct sockaddr_in addr;
+    socklen_t size = sizeof(addr);
+    socket_t sd = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_len = sizeof(addr);
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    XCTAssertEqual(bind(sd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+    XCTAssertEqual(listen(sd, 1024), 0);
+    getsockname(sd, (struct sockaddr *)&addr, &size);
+    *port = ntohs(addr.sin_port);
+    return sd;
+}
+//}}}
+// - (BOOL)waitFor:(volatile NSInteger *)counter value:(NSInteger)value;//{{{
+/**
+ * Waits up to 30 seconds for a counter updated by the loop thread.
+ **/
+- (BOOL)waitFor:(volatile NSInteger *)counter value:(NSInteger)value
+{
+    NSDate *limit = [NSDate dateWithTimeIntervalSinceNow:30.0];
+
+    while ((*counter < value) && ([limit timeIntervalSinceNow] > 0))
+        usleep(1000);
+
+    return (*counter >= value);
+}
+//}}}
+// - (SFSocket *)connectedClient:(uint16_t)port;//{{{
+/**
+ * Opens a client to a local port and waits until it is connected.
+ **/
+- (SFSocket *)connectedClient:(uint16_t)port
+{
+    SFSocket *client = [[SFSocket alloc] init];
+    error_t error = [client open:@"127.0.0.1" port:port];
+
+    while (error == EINPROGRESS) {
+        usleep(100);
+        error = [client isReady];
+    }
+    XCTAssertEqual(error, 0);
+    return client;
+}
+//}}}
+// - (BOOL)waitWritable:(SFSocket *)socket;//{{{
+/**
+ * Waits up to one second for room in the kernel buffer of a socket and
+ * flushes its write queue.
+ **/
+- (BOOL)waitWritable:(SFSocket *)socket
+{
+    struct pollfd pfd = { [socket descriptor], POLLOUT, 0 };
+
+    poll(&pfd, 1, 1000);
+    return ([socket flush] >= 0);
+}
+//}}}
+// - (NSFileHandle *)temporaryFileWithData:(NSData *)data;//{{{
+/**
+ * Writes data to a temporary file and opens it for reading.
+ * The file is removed when the handle is closed.
+ **/
+- (NSFileHandle *)temporaryFileWithData:(NSData *)data
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    NSFileHandle *file;
+
+    XCTAssertTrue([data writeToFile:path atomically:NO]);
+    file = [NSFileHandle fileHandleForReadingAtPath:path];
+    unlink([path fileSystemRepresentation]);
+    return file;
+}
+//}}}
+// - (SFSocket *)profiledServer:(SFSocketProfile *)profile client:(SFSocket **)client;//{{{
+/**
+ * Opens a listening socket and a client to it, both with a profile set
+ * before they open, and accepts the connection.
+ * @return The accepted peer. The listening socket is closed.
+ **/
+- (SFSocket *)profiledServer:(SFSocketProfile *)profile client:(SFSocket **)client
+{
+    SFSocket *server = [[SFSocket alloc] init];
+    SFSocket *other  = [[SFSocket alloc] init];
+    struct pollfd pfd;
+    error_t error;
+
+    [server setProfile:profile];
+    [other setProfile:profile];
+    XCTAssertEqual([server listen:@"127.0.0.1" port:0 reusePort:NO], 0);
+
+    error = [other open:@"127.0.0.1" port:[server localPort]];
+    while (error == EINPROGRESS) {
+        usleep(100);
+        error = [other isReady];
+    }
+    XCTAssertEqual(error, 0);
+
+    pfd.fd = [server descriptor];
+    pfd.events = POLLIN;
+    poll(&pfd, 1, 1000);
+
+    SFSocket *peer = [server accept];
+    XCTAssertNotNil(peer);
+    [server close];
+
+    *client = other;
+    return peer;
+}
+//}}}
+// - (BOOL)receive:(uint8_t *)buffer length:(size_t)length from:(SFSocket *)socket;//{{{
+/**
+ * Reads exactly \a length bytes from a non-blocking socket, waiting up to
+ * one second for each part.
+ **/
+- (BOOL)receive:(uint8_t *)buffer length:(size_t)length from:(SFSocket *)socket
+{
+    struct pollfd pfd = { [socket descriptor], POLLIN, 0 };
+    size_t total = 0;
+
+    while (total < length)
+    {
+        intptr_t count;
+
+        if (poll(&pfd, 1, 1000) <= 0) return NO;
+        count = [socket read:(buffer + total) ofLength:(length - total)];
+        if (count < 0) return NO;
+        total += (size_t)count;
+    }
+    return YES;
+}
+//}}}
+// - (NSData *)addressOf:(NSString *)host port:(NSUInteger)port;//{{{
+/**
+ * Gets the \c sockaddr of a numeric address.
+ **/
+- (NSData *)addressOf:(NSString *)host port:(NSUInteger)port
+{
+    return [[[SFResolver sharedResolver] addressesForHost:host port:port error:NULL] firstObject];
+}
+//}}}
+// - (NSData *)blackholeOn:(NSString *)host listener:(socket_t *)listener fillers:(NSMutableArray *)fillers;//{{{
+/**
+ * Creates a listener that never accepts and fills its backlog, so new
+ * connections to it get no answer at all.
+ * @return The address of the listener.
+ **/
+- (NSData *)blackholeOn:(NSString *)host listener:(socket_t *)listener fillers:(NSMutableArray *)fillers
+{
+    NSMutableData *address = [[self addressOf:host port:0] mutableCopy];
+    struct sockaddr *addr = (struct sockaddr *)[address mutableBytes];
+    socklen_t size = (socklen_t)[address length];
+    socket_t sd = socket(addr->sa_family, SOCK_STREAM, IPPROTO_TCP);
+
+    XCTAssertEqual(bind(sd, addr, size), 0);
+    XCTAssertEqual(listen(sd, 0), 0);
+    getsockname(sd, addr, &size);
+    *listener = sd;
+
+    /* Connections are made until one gets no answer: the backlog is full. */
+    for (int index = 0; index < 64; ++index)
+    {
+        SFSocket *filler = [[SFSocket alloc] init];
+        error_t error = [filler openAddress:address];
+
+        [fillers addObject:filler];
+        if (error == EINPROGRESS)
+            error = [filler waitReady:0.2];
+        if (error == ETIMEDOUT)
+            break;
+    }
+    return address;
+}
+//}}}
+// - (NSData *)refusedOn:(NSString *)host socket:(socket_t *)sd;//{{{
+/**
+ * Binds a socket that doesn't listen, so connections to it are refused.
+ * @return The address of the socket.
+ **/
+- (NSData *)refusedOn:(NSString *)host socket:(socket_t *)sd
+{
+    NSMutableData *address = [[self addressOf:host port:0] mutableCopy];
+    struct sockaddr *addr = (struct sockaddr *)[address mutableBytes];
+    socklen_t size = (socklen_t)[address length];
+
+    *sd = socket(addr->sa_family, SOCK_STREAM, IPPROTO_TCP);
+    XCTAssertEqual(bind(*sd, addr, size), 0);
+    getsockname(*sd, addr, &size);
+    return address;
+}
+//}}}
+
+// - (NSArray *)clientsWithCount:(NSUInteger)count;//{{{
+/**
+ * Creates the benchmark clients, not connected, and makes them the
+ * m_clients set.
+ **/
+- (NSArray *)clientsWithCount:(NSUInteger)count
+{
+    NSMutableArray *clients = [NSMutableArray arrayWithCapacity:count];
+
+    while (count-- > 0)
+        [clients addObject:[[SFSocket alloc] init]];
+
+    m_clients = [NSSet setWithArray:clients];
+    return clients;
+}
+//}}}
+
+// SFSocketLoopDelegate
+// - (void)socketLoop:(SFSocketLoop *)loop didConnect:(SFSocket *)socket;//{{{
+- (void)socketLoop:(SFSocketLoop *)loop didConnect:(SFSocket *)socket
+{
+    uint8_t message[LOOP_MESSAGE_SIZE] = { 0 };
+
+    /* Clients start the round trips. Peers only answer. */
+    if ([m_clients containsObject:socket])
+    {
+        m_connected++;
+        [socket send:message ofLength:sizeof(message)];
+    }
+}
+//}}}
+// - (void)socketLoop:(SFSocketLoop *)loop didReceive:(SFSocket *)socket;//{{{
+- (void)socketLoop:(SFSocketLoop *)loop didReceive:(SFSocket *)socket
+{
+    SFStream *input = [socket inputStream];
+    BOOL client = [m_clients containsObject:socket];
+
+    if (m_sink)
+    {
+        m_sunk += [input numberOfBytesAvailable];
+        [input setReadPosition:([input readPosition] + [input numberOfBytesAvailable])];
+        [input purgeReadBytes];
+        return;
+    }
+
+    while ([input numberOfBytesAvailable] >= LOOP_MESSAGE_SIZE)
+    {
+        const uint8_t *message = [input bytes];
+        uint8_t reply[LOOP_MESSAGE_SIZE];
+
+        /* The first two bytes count the round trips of the connection. */
+        memcpy(reply, message, sizeof(reply));
+        [input setReadPosition:([input readPosition] + LOOP_MESSAGE_SIZE)];
+
+        if (client)
+        {
+            uint16_t count = (uint16_t)(OSReadLittleInt16(reply, 0) + 1);
+
+            m_received++;
+            if (count >= LOOP_BENCHMARK_MESSAGES) {
+                m_finished++;
+                continue;
+            }
+            OSWriteLittleInt16(reply, 0, count);
+        }
+        [socket send:reply ofLength:sizeof(reply)];
+    }
+    [input purgeReadBytes];
+}
+//}}}
+// - (void)socketLoop:(SFSocketLoop *)loop didClose:(SFSocket *)socket error:(error_t)error;//{{{
+- (void)socketLoop:(SFSocketLoop *)loop didClose:(SFSocket *)socket error:(error_t)error
+{
+    m_closed++;
+}
+//}}}
+// - (void)tick:(SFSocketLoop *)loop;//{{{
+- (void)tick:(SFSocketLoop *)loop
+{
+    m_ticks++;
+}
+//}}}
+// - (void)watermark:(SFSocket *)socket;//{{{
+- (void)watermark:(SFSocket *)socket
+{
+    m_watermarks++;
+}
+//}}}
+
+// Event Loop
+// - (void)testSocketLoopTimers;//{{{
+- (void)testSocketLoopTimers
+{
+    SFSocketLoop *loop = [[SFSocketLoop alloc] init];
+    uintptr_t timer;
+
+    m_ticks = 0;
+    timer = [loop scheduleTimer:0.005 repeats:YES target:self selector:@selector(tick:)];
+    [loop scheduleTimer:0.001 repeats:NO target:self selector:@selector(tick:)];
+    XCTAssertNotEqual(timer, (uintptr_t)0);
+
+    XCTAssertTrue([loop start]);
+    XCTAssertFalse([loop start]);
+    XCTAssertTrue([self waitFor:&m_ticks value:4]);
+
+    [loop cancelTimer:timer];
+    usleep(20000);
+    NSInteger ticks = m_ticks;
+    usleep(50000);
+    XCTAssertEqual(m_ticks, ticks);
+
+    [loop stop];
+    XCTAssertFalse([loop isRunning]);
+}
+//}}}
+// - (void)testSocketLoopClose;//{{{
+- (void)testSocketLoopClose
+{
+    SFSocketLoop *loop = [[SFSocketLoop alloc] init];
+    SFSocket *client = [[SFSocket alloc] init];
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+
+    /* Not a benchmark client: nothing is sent when connected. */
+    [loop setDelegate:self];
+    m_clients = [NSSet set];
+    m_closed = 0;
+
+    [client open:@"127.0.0.1" port:port];
+    XCTAssertTrue([loop addSocket:client]);
+    socket_t peer = accept(listener, NULL, NULL);
+    XCTAssertTrue(peer >= 0);
+
+    /* The peer sends half a message and closes. */
+    write(peer, "abc", 3);
+    close(peer);
+
+    for (int i = 0; (i < 100) && (m_closed == 0); ++i)
+        [loop pollWithTimeout:0.1];
+
+    XCTAssertEqual(m_closed, (NSInteger)1);
+    XCTAssertEqual([client descriptor], (socket_t)-1);
+    XCTAssertEqual([[client inputStream] numberOfBytesAvailable], (size_t)3);
+    XCTAssertEqual([loop numberOfSockets], (NSUInteger)0);
+    close(listener);
+}
+//}}}
+
+// Resolver
+// - (void)testResolverHosts;//{{{
+/**
+ * Resolves names of the hosts file and numeric addresses.
+ **/
+- (void)testResolverHosts
+{
+    SFResolver *resolver = [[SFResolver alloc] initWithThreads:1];
+    error_t error = -1;
+
+    NSArray *addresses = [resolver addressesForHost:@"localhost" port:80 error:&error];
+    XCTAssertEqual(error, 0);
+    XCTAssertTrue([addresses count] > 0);
+    XCTAssertEqual([resolver numberOfMisses], (uint64_t)1);
+
+    XCTAssertEqualObjects([resolver addressesForHost:@"LOCALHOST" port:80 error:NULL], addresses);
+    XCTAssertEqualObjects([resolver cachedAddressesForHost:@"localhost" port:80], addresses);
+    XCTAssertNil([resolver cachedAddressesForHost:@"localhost" port:81]);
+    XCTAssertEqual([resolver numberOfHits], (uint64_t)1);
+    XCTAssertEqualWithAccuracy([resolver hitRate], 0.5, 0.001);
+
+    /* Numeric addresses are not cached nor counted. */
+    addresses = [resolver addressesForHost:@"127.0.0.1" port:8080 error:&error];
+    XCTAssertEqual([addresses count], (NSUInteger)1);
+    const struct sockaddr_in *addr = (const struct sockaddr_in *)[[addresses firstObject] bytes];
+    XCTAssertEqual(addr->sin_family, AF_INET);
+    XCTAssertEqual(ntohs(addr->sin_port), 8080);
+    XCTAssertEqual([resolver numberOfMisses] + [resolver numberOfHits], (uint64_t)2);
+
+    [resolver stop];
+    XCTAssertNil([resolver addressesForHost:@"other.test" port:80 error:&error]);
+    XCTAssertEqual(error, ECANCELED);
+}
+//}}}
+// - (void)testResolverCache;//{{{
+/**
+ * Checks coalescing, negative caching and expiration with a stub.
+ **/
+- (void)testResolverCache
+{
+    SFStubResolver *resolver = [[SFStubResolver alloc] initWithThreads:2];
+    __block volatile int32_t answered = 0;
+    error_t error;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        [resolver resolveHost:@"service.test" port:443 completion:^(NSArray *addresses, error_t code) {
+            if ((code == 0) && ([addresses count] == 1))
+                __sync_fetch_and_add(&answered, 1);
+        }];
+    }
+    for (int i = 0; (i < 1000) && (answered < 10); ++i)
+        usleep(1000);
+
+    XCTAssertEqual(answered, 10);
+    XCTAssertEqual(resolver->lookups, 1);
+    XCTAssertEqual([resolver numberOfMisses], (uint64_t)1);
+    XCTAssertEqual([resolver numberOfCoalesced], (uint64_t)9);
+
+    /* Failures are cached too. */
+    XCTAssertNil([resolver addressesForHost:@"missing.test" port:443 error:&error]);
+    XCTAssertEqual(error, ENETDOWN);
+    XCTAssertNil([resolver addressesForHost:@"missing.test" port:443 error:&error]);
+    XCTAssertEqual(error, ENETDOWN);
+    XCTAssertEqual(resolver->lookups, 2);
+
+    /* Expired entries are looked up again. */
+    [resolver setTimeToLive:0.0];
+    [resolver removeAllEntries];
+    XCTAssertNotNil([resolver addressesForHost:@"service.test" port:443 error:NULL]);
+    XCTAssertNotNil([resolver addressesForHost:@"service.test" port:443 error:NULL]);
+    XCTAssertEqual(resolver->lookups, 4);
+    [resolver stop];
+}
+//}}}
+// - (void)testSocketLoopConnectHost;//{{{
+/**
+ * Connects through the loop to a name of the hosts file and to a name that
+ * doesn't exist. "localhost" has ::1 and 127.0.0.1, but only IPv4 listens:
+ * the refused address must not stop the connection.
+ **/
+- (void)testSocketLoopConnectHost
+{
+    SFSocketLoop *loop = [[SFSocketLoop alloc] init];
+    SFSocket *client = [[SFSocket alloc] init];
+    SFSocket *dual = [[SFSocket alloc] init];
+    SFSocket *lost = [[SFSocket alloc] init];
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+
+    m_clients = [NSSet setWithObjects:client, dual, nil];
+    m_connected = m_closed = 0;
+    [loop setDelegate:self];
+    XCTAssertTrue([loop start]);
+
+    [loop connectSocket:client toHost:@"127.0.0.1" port:port];
+    [loop connectSocket:dual toHost:@"localhost" port:port];
+    [loop connectSocket:lost toHost:@"missing.invalid" port:port];
+
+    XCTAssertTrue([self waitFor:&m_connected value:2]);
+    XCTAssertTrue([self waitFor:&m_closed value:1]);
+    XCTAssertEqual([lost descriptor], (socket_t)-1);
+    XCTAssertEqual(((const struct sockaddr *)[[dual remoteAddress] bytes])->sa_family, AF_INET);
+    XCTAssertEqual([loop numberOfSockets], (NSUInteger)2);
+
+    [loop stop];
+    close(listener);
+}
+//}}}
+
+// Connection Pool
+// - (void)testConnectionPoolReuse;//{{{
+- (void)testConnectionPoolReuse
+{
+    SFConnectionPool *pool = [[SFConnectionPool alloc] init];
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+    error_t error = -1;
+
+    /* The handshake completes in the backlog: no need to accept. */
+    SFSocket *first = [pool connectionToHost:@"127.0.0.1" port:port error:&error];
+    XCTAssertNotNil(first);
+    XCTAssertEqual(error, 0);
+    [pool releaseConnection:first];
+
+    SFSocket *again = [pool connectionToHost:@"127.0.0.1" port:port error:&error];
+    XCTAssertEqual(again, first);
+    XCTAssertEqual([pool numberOfHandshakes], (uint64_t)1);
+    XCTAssertEqual([pool numberOfHits], (uint64_t)1);
+    XCTAssertEqualWithAccuracy([pool hitRate], 0.5, 0.001);
+
+    /* A connection closed by the peer is not reused. */
+    socket_t peer = accept(listener, NULL, NULL);
+    [pool releaseConnection:again];
+    close(peer);
+    usleep(20000);
+
+    SFSocket *fresh = [pool connectionToHost:@"127.0.0.1" port:port error:&error];
+    XCTAssertNotNil(fresh);
+    XCTAssertNotEqual(fresh, first);
+    XCTAssertEqual([pool numberOfHandshakes], (uint64_t)2);
+    XCTAssertEqual([pool numberOfEvictions], (uint64_t)1);
+    [pool discardConnection:fresh];
+    XCTAssertEqual([fresh descriptor], (socket_t)-1);
+
+    [pool closeAllConnections];
+    close(listener);
+}
+//}}}
+// - (void)testConnectionPoolLimits;//{{{
+- (void)testConnectionPoolLimits
+{
+    SFConnectionPool *pool = [[SFConnectionPool alloc] init];
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+    error_t error;
+
+    [pool setMaximumConnections:2];
+    [pool setMaximumIdleConnections:2];
+    [pool setConnectTimeout:0.2];
+
+    /* Pre-warming is limited by the idle connections. */
+    XCTAssertEqual([pool prewarmHost:@"127.0.0.1" port:port count:5], (NSUInteger)2);
+    XCTAssertEqual([pool numberOfHandshakes], (uint64_t)2);
+
+    SFSocket *a = [pool connectionToHost:@"127.0.0.1" port:port error:&error];
+    SFSocket *b = [pool connectionToHost:@"127.0.0.1" port:port error:&error];
+    XCTAssertNotNil(a);
+    XCTAssertNotNil(b);
+    XCTAssertEqual([pool numberOfHits], (uint64_t)2);
+
+    /* Every connection is in use. */
+    XCTAssertNil([pool connectionToHost:@"127.0.0.1" port:port error:&error]);
+    XCTAssertEqual(error, ETIMEDOUT);
+
+    /* A request waits for a connection given back. */
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, 20 * NSEC_PER_MSEC), dispatch_get_global_queue(0, 0), ^{
+        [pool releaseConnection:a];
+    });
+    XCTAssertEqual([pool connectionToHost:@"127.0.0.1" port:port error:&error], a);
+    XCTAssertEqual([pool numberOfHandshakes], (uint64_t)2);
+    [pool releaseConnection:a];
+    [pool releaseConnection:b];
+
+    /* Idle connections expire. */
+    [pool setIdleTimeout:0.0];
+    XCTAssertEqual([pool evictIdleConnections], (NSUInteger)2);
+    XCTAssertEqual([a descriptor], (socket_t)-1);
+    close(listener);
+}
+//}}}
+
+// Write Queue
+// - (void)testWriteQueueKeepsData;//{{{
+/**
+ * Sends more than the kernel buffer holds to a peer that is not reading and
+ * checks that nothing is lost.
+ **/
+- (void)testWriteQueueKeepsData
+{
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+    SFSocket *client = [self connectedClient:port];
+    socket_t peer = accept(listener, NULL, NULL);
+    int bufferSize = 64 * 1024;
+    NSMutableData *sent = [NSMutableData dataWithLength:QUEUE_TEST_SIZE];
+    NSMutableData *received = [NSMutableData dataWithLength:QUEUE_TEST_SIZE];
+    uint8_t *bytes = (uint8_t *)[sent mutableBytes];
+    size_t index, total = 0;
+
+    for (index = 0; index < QUEUE_TEST_SIZE; ++index)
+        bytes[index] = (uint8_t)(index * 7 + (index >> 12));
+
+    setsockopt([client descriptor], SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(int));
+    [client setWatermarkTarget:self selector:@selector(watermark:)];
+    m_watermarks = 0;
+
+    /* The peer doesn't read yet: most of the data stays in the queue. */
+    XCTAssertTrue([client send:bytes ofLength:QUEUE_TEST_SIZE]);
+    XCTAssertTrue([client queuedBytes] > [client highWatermark]);
+    XCTAssertTrue([client isCongested]);
+    XCTAssertEqual(m_watermarks, (NSInteger)1);
+
+    /* Queued data goes after the queue, never before. */
+    XCTAssertTrue([client send:"end" ofLength:3]);
+    XCTAssertTrue([client flush] >= 0);
+
+    while (total < QUEUE_TEST_SIZE)
+    {
+        ssize_t count = recv(peer, (uint8_t *)[received mutableBytes] + total, (QUEUE_TEST_SIZE - total), 0);
+
+        XCTAssertTrue(count > 0);
+        if (count <= 0) break;
+        total += (size_t)count;
+        XCTAssertTrue([client flush] >= 0);
+    }
+    XCTAssertEqualObjects(received, sent);
+
+    char tail[3];
+    XCTAssertEqual(recv(peer, tail, sizeof(tail), MSG_WAITALL), (ssize_t)3);
+    XCTAssertEqual(memcmp(tail, "end", 3), 0);
+    XCTAssertEqual([client queuedBytes], (size_t)0);
+    XCTAssertFalse([client isCongested]);
+    XCTAssertEqual(m_watermarks, (NSInteger)2);
+
+    [client close];
+    close(peer);
+    close(listener);
+}
+//}}}
+// - (void)testSendFile;//{{{
+- (void)testSendFile
+{
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+    SFSocket *client = [self connectedClient:port];
+    socket_t peer = accept(listener, NULL, NULL);
+    int bufferSize = 64 * 1024;
+    NSMutableData *sent = [NSMutableData dataWithLength:QUEUE_TEST_SIZE];
+    NSMutableData *received = [NSMutableData dataWithLength:QUEUE_TEST_SIZE];
+    uint8_t *bytes = (uint8_t *)[sent mutableBytes];
+    size_t index, total = 0;
+
+    for (index = 0; index < QUEUE_TEST_SIZE; ++index)
+        bytes[index] = (uint8_t)(index * 13 + (index >> 10));
+
+    NSFileHandle *file = [self temporaryFileWithData:sent];
+    XCTAssertNotNil(file);
+    setsockopt([client descriptor], SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(int));
+
+    /* The file goes between the data queued before and after it. */
+    XCTAssertTrue([client send:"head" ofLength:4]);
+    XCTAssertTrue([client sendFile:file offset:0 length:-1]);
+    XCTAssertTrue([client send:"tail" ofLength:4]);
+    XCTAssertTrue([client sendFile:file offset:16 length:4]);
+    XCTAssertTrue([client queuedBytes] > 0);
+
+    char head[4];
+    XCTAssertEqual(recv(peer, head, sizeof(head), MSG_WAITALL), (ssize_t)4);
+    XCTAssertEqual(memcmp(head, "head", 4), 0);
+
+    while (total < QUEUE_TEST_SIZE)
+    {
+        XCTAssertTrue([client flush] >= 0);
+
+        ssize_t count = recv(peer, (uint8_t *)[received mutableBytes] + total, (QUEUE_TEST_SIZE - total), 0);
+
+        XCTAssertTrue(count > 0);
+        if (count <= 0) break;
+        total += (size_t)count;
+    }
+    XCTAssertEqualObjects(received, sent);
+
+    char tail[8];
+    while ([client queuedBytes] > 0)
+        XCTAssertTrue([self waitWritable:client]);
+    XCTAssertEqual(recv(peer, tail, sizeof(tail), MSG_WAITALL), (ssize_t)8);
+    XCTAssertEqual(memcmp(tail, "tail", 4), 0);
+    XCTAssertEqual(memcmp(tail + 4, bytes + 16, 4), 0);
+
+    /* Closed sockets don't take files. */
+    [client close];
+    XCTAssertFalse([client sendFile:file offset:0 length:-1]);
+    XCTAssertEqual([client error], (error_t)ENOTCONN);
+
+    [file closeFile];
+    close(peer);
+    close(listener);
+}
+//}}}
+
+// Receiving
+// - (void)testReceiveStatistics;//{{{
+- (void)testReceiveStatistics
+{
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+    SFSocket *client = [self connectedClient:port];
+    socket_t peer = accept(listener, NULL, NULL);
+    struct pollfd pfd = { [client descriptor], POLLIN, 0 };
+    NSMutableData *data = [NSMutableData dataWithBytes:"head" length:4];
+    SFStream *stream = [[SFStream alloc] init];
+    uint8_t block[100000];
+
+    /* A short read ends the operation: a single system call. */
+    XCTAssertEqual(write(peer, "0123456789", 10), (ssize_t)10);
+    poll(&pfd, 1, 1000);
+    XCTAssertEqual([client read:data], (intptr_t)10);
+    XCTAssertEqualObjects(data, [NSData dataWithBytes:"head0123456789" length:14]);
+    XCTAssertEqual([client numberOfReceiveCalls], (uint64_t)1);
+    XCTAssertEqual([client bytesReceived], (uint64_t)10);
+
+    /* Nothing to read: EAGAIN is counted too. */
+    XCTAssertEqual([client readIntoStream:stream], (intptr_t)0);
+    XCTAssertEqual([client error], 0);
+    XCTAssertEqual([client numberOfReceiveCalls], (uint64_t)2);
+
+    /* Larger blocks take several reads, all in the same operation. */
+    memset(block, 0x5A, sizeof(block));
+    XCTAssertEqual(write(peer, block, sizeof(block)), (ssize_t)sizeof(block));
+    size_t total = 0;
+    while (total < sizeof(block))
+    {
+        intptr_t count;
+
+        poll(&pfd, 1, 1000);
+        count = [client readIntoStream:stream];
+        XCTAssertTrue(count >= 0);
+        if (count < 0) break;
+        total += (size_t)count;
+    }
+    XCTAssertEqual([stream numberOfBytesAvailable], sizeof(block));
+    XCTAssertEqual([client bytesReceived], (uint64_t)(10 + sizeof(block)));
+
+    /* Data before the end is returned. The end comes in the next call. */
+    [client resetStatistics];
+    XCTAssertEqual(write(peer, "xyz", 3), (ssize_t)3);
+    close(peer);
+    usleep(10000);
+    XCTAssertEqual([client read:data], (intptr_t)3);
+    XCTAssertEqual([client read:data], (intptr_t)-1);
+    XCTAssertEqual([client error], ENOTCONN);
+    XCTAssertEqual([client bytesReceived], (uint64_t)3);
+    XCTAssertEqual([data length], (NSUInteger)17);
+    close(listener);
+}
+//}}}
+
+// Scatter/Gather
+// - (void)testScatterGather;//{{{
+- (void)testScatterGather
+{
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+    SFSocket *client = [self connectedClient:port];
+    socket_t peer = accept(listener, NULL, NULL);
+    SFStream *header = [[SFStream alloc] init];
+    SFStream *payload = [[SFStream alloc] init];
+    char message[32];
+
+    [header writeBigEndianInt:5];
+    [payload write:"hello" length:5];
+    XCTAssertEqual([client sendStreams:@[header, payload]], (intptr_t)9);
+    XCTAssertEqual([header numberOfBytesAvailable], (size_t)0);
+    XCTAssertEqual([payload numberOfBytesAvailable], (size_t)0);
+
+    XCTAssertEqual(recv(peer, message, 9, MSG_WAITALL), (ssize_t)9);
+    XCTAssertEqual(memcmp(message, "\0\0\0\5hello", 9), 0);
+
+    /* Raw buffers and stream regions in the same call. */
+    [payload write:"world" length:5];
+    struct iovec buffers[2] = { { "abc", 3 }, SFStreamReadVector(payload, 2) };
+    XCTAssertEqual([client sendBuffers:buffers count:2], (intptr_t)5);
+    XCTAssertEqual(recv(peer, message, 5, MSG_WAITALL), (ssize_t)5);
+    XCTAssertEqual(memcmp(message, "abcwo", 5), 0);
+
+    /* The peer answers a header and a payload, read in one call. */
+    SFStream *inHeader = [[SFStream alloc] init];
+    SFStream *inPayload = [[SFStream alloc] init];
+    size_t lengths[2] = { 4, 16 };
+    struct pollfd pfd = { [client descriptor], POLLIN, 0 };
+
+    XCTAssertEqual([client readIntoStreams:@[inHeader, inPayload] lengths:lengths], (intptr_t)0);
+    XCTAssertEqual(write(peer, "\0\0\0\6answer", 10), (ssize_t)10);
+    poll(&pfd, 1, 1000);
+    XCTAssertEqual([client readIntoStreams:@[inHeader, inPayload] lengths:lengths], (intptr_t)10);
+    XCTAssertEqual([inHeader readBigEndianInt], (uint32_t)6);
+    XCTAssertEqual([inPayload numberOfBytesAvailable], (size_t)6);
+    XCTAssertEqual(memcmp([inPayload bytes], "answer", 6), 0);
+
+    close(peer);
+    poll(&pfd, 1, 1000);
+    XCTAssertEqual([client readIntoStreams:@[inHeader, inPayload] lengths:lengths], (intptr_t)-1);
+    XCTAssertEqual([client error], ESHUTDOWN);
+
+    /* A closed socket doesn't touch the streams. */
+    size_t before = [inPayload writePosition];
+    XCTAssertEqual([client readIntoStreams:@[inHeader, inPayload] lengths:lengths], (intptr_t)-1);
+    XCTAssertEqual([client error], ENOTCONN);
+    XCTAssertEqual([inPayload writePosition], before);
+    close(listener);
+}
+//}}}
+// - (void)testSendSpilledStream;//{{{
+/**
+ * Sends streams spilled to disk, larger than their read window.
+ **/
+- (void)testSendSpilledStream
+{
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+    SFSocket *client = [self connectedClient:port];
+    socket_t peer = accept(listener, NULL, NULL);
+    SFSpillStream *first = [[SFSpillStream alloc] initWithThreshold:1024];
+    SFSpillStream *second = [[SFSpillStream alloc] initWithThreshold:1024];
+    const size_t size = (200 * 1024);
+    NSMutableData *sent = [NSMutableData dataWithLength:(size * 2)];
+    NSMutableData *received = [NSMutableData dataWithLength:(size * 2)];
+    uint8_t *bytes = (uint8_t *)[sent mutableBytes];
+    size_t index, total = 0;
+
+    for (index = 0; index < (size * 2); ++index)
+        bytes[index] = (uint8_t)(index * 7 + (index >> 12));
+
+    [first write:bytes length:size];
+    [second write:(bytes + size) length:size];
+    XCTAssertTrue([first isSpilled]);
+    XCTAssertTrue([second isSpilled]);
+
+    /* The whole stream goes, one window at a time. */
+    XCTAssertEqual([client send:first length:SIZE_MAX], (intptr_t)size);
+    XCTAssertEqual([first numberOfBytesAvailable], (size_t)0);
+
+    /* Each call takes no more than the read window. */
+    while ([second numberOfBytesAvailable] > 0)
+    {
+        intptr_t count = [client sendStreams:@[second]];
+
+        XCTAssertTrue((count > 0) && (count <= (intptr_t)(64 * 1024)));
+        if (count <= 0) break;
+    }
+
+    while (total < (size * 2))
+    {
+        ssize_t count = recv(peer, (uint8_t *)[received mutableBytes] + total, ((size * 2) - total), 0);
+
+        XCTAssertTrue(count > 0);
+        if (count <= 0) break;
+        total += (size_t)count;
+        XCTAssertTrue([client flush] >= 0);
+    }
+    XCTAssertEqualObjects(received, sent);
+    XCTAssertEqual([first error], 0);
+    XCTAssertEqual([second error], 0);
+
+    [client close];
+    close(peer);
+    close(listener);
+}
+//}}}
+
+// Happy Eyeballs
+// - (void)testHappyEyeballs;//{{{
+- (void)testHappyEyeballs
+{
+    NSMutableArray *fillers = [NSMutableArray array];
+    SFSocket *server4 = [[SFSocket alloc] init];
+    SFSocket *server6 = [[SFSocket alloc] init];
+    SFSocket *client  = [[SFSocket alloc] init];
+    socket_t blackhole, refusing;
+    NSTimeInterval elapsed;
+    NSDate *start;
+    error_t error;
+
+    XCTAssertEqual([server4 listen:@"127.0.0.1" port:0 reusePort:NO], 0);
+    XCTAssertEqual([server6 listen:@"::1" port:0 reusePort:NO], 0);
+
+    NSData *dead6 = [self blackholeOn:@"::1" listener:&blackhole fillers:fillers];
+    NSData *refused4 = [self refusedOn:@"127.0.0.1" socket:&refusing];
+    NSData *live4 = [self addressOf:@"127.0.0.1" port:[server4 localPort]];
+    NSData *live6 = [self addressOf:@"::1" port:[server6 localPort]];
+
+    /* The silent IPv6 address is tried first. IPv4 starts after the delay. */
+    [client setConnectionAttemptDelay:0.1];
+    start = [NSDate date];
+    error = [client openAddresses:@[ dead6, live4 ]];
+    XCTAssertEqual([client descriptor], (socket_t)-1);
+    if (error == EINPROGRESS)
+        error = [client waitReady:5.0];
+    elapsed = -[start timeIntervalSinceNow];
+
+    XCTAssertEqual(error, 0);
+    XCTAssertTrue((elapsed >= 0.1) && (elapsed < 1.0));
+    XCTAssertEqual(((const struct sockaddr *)[[client remoteAddress] bytes])->sa_family, AF_INET);
+    [client close];
+
+    /* A refused address doesn't wait for the delay. */
+    [client setConnectionAttemptDelay:2.0];
+    start = [NSDate date];
+    error = [client openAddresses:@[ refused4, live6 ]];
+    if (error == EINPROGRESS)
+        error = [client waitReady:5.0];
+    elapsed = -[start timeIntervalSinceNow];
+
+    XCTAssertEqual(error, 0);
+    XCTAssertTrue(elapsed < 1.0);
+    XCTAssertEqual(((const struct sockaddr *)[[client remoteAddress] bytes])->sa_family, AF_INET6);
+    [client close];
+
+    /* When every address fails the error of the last one is reported. */
+    error = [client openAddresses:@[ refused4 ]];
+    if (error == EINPROGRESS)
+        error = [client waitReady:5.0];
+    XCTAssertEqual(error, ECONNREFUSED);
+
+    /* Time out while nothing answers. */
+    error = [client openAddresses:@[ dead6 ]];
+    if (error == EINPROGRESS)
+        error = [client waitReady:0.2];
+    XCTAssertEqual(error, ETIMEDOUT);
+    XCTAssertEqual([client descriptor], (socket_t)-1);
+
+    for (SFSocket *filler in fillers)
+        [filler close];
+    close(blackhole);
+    close(refusing);
+    [server4 close];
+    [server6 close];
+}
+//}}}
+
+// Datagrams
+// - (void)testDatagramBatch;//{{{
+- (void)testDatagramBatch
+{
+    SFDatagramSocket *receiver = [[SFDatagramSocket alloc] initWithBatchSize:8 datagramSize:256];
+    SFDatagramSocket *sender = [[SFDatagramSocket alloc] init];
+    struct pollfd pfd;
+    struct iovec buffers[10];
+    uint8_t contents[10][100];
+    NSUInteger index, total = 0;
+
+    XCTAssertEqual([receiver bind:@"127.0.0.1" port:0], 0);
+    XCTAssertEqual([sender connect:@"127.0.0.1" port:[receiver localPort]], 0);
+    XCTAssertEqual([receiver receiveBatch], (intptr_t)0);
+
+    for (index = 0; index < 10; ++index)
+    {
+        memset(contents[index], (int)index, sizeof(contents[index]));
+        OSWriteBigInt32(contents[index], 0, (uint32_t)index);
+        buffers[index].iov_base = contents[index];
+        buffers[index].iov_len  = 10 + (index * 9);
+    }
+    XCTAssertEqual([sender sendBuffers:buffers count:10], (intptr_t)10);
+    XCTAssertEqual([sender datagramsSent], (uint64_t)10);
+
+    /* The slab holds 8 datagrams: two batches are needed. */
+    pfd.fd = [receiver descriptor];
+    pfd.events = POLLIN;
+    while ((total < 10) && (poll(&pfd, 1, 1000) > 0))
+    {
+        intptr_t count = [receiver receiveBatch];
+
+        XCTAssertTrue((count > 0) && (count <= 8));
+        if (count <= 0) break;
+
+        for (index = 0; index < (NSUInteger)count; ++index, ++total)
+        {
+            SFStreamReader *datagram = [receiver datagramAtIndex:index];
+            NSData *address = [receiver addressOfDatagramAtIndex:index];
+
+            XCTAssertEqual([receiver lengthOfDatagramAtIndex:index], (size_t)(10 + (total * 9)));
+            XCTAssertEqual([datagram numberOfBytesAvailable], (size_t)(10 + (total * 9)));
+            XCTAssertEqual([datagram readBigEndianInt], (uint32_t)total);
+            XCTAssertEqual([receiver bytesOfDatagramAtIndex:index][4], (uint8_t)total);
+            XCTAssertFalse([receiver isDatagramTruncatedAtIndex:index]);
+            XCTAssertEqual(ntohs(((const struct sockaddr_in *)[address bytes])->sin_port), (uint16_t)[sender localPort]);
+        }
+    }
+    XCTAssertEqual(total, (NSUInteger)10);
+    XCTAssertEqual([receiver datagramsReceived], (uint64_t)10);
+    XCTAssertNil([receiver datagramAtIndex:[receiver count]]);
+
+    /* A datagram longer than a slot is cut, and reported. */
+    uint8_t large[300];
+    struct iovec single = { large, sizeof(large) };
+    memset(large, 0x5A, sizeof(large));
+    XCTAssertEqual([sender sendBuffers:&single count:1], (intptr_t)1);
+    XCTAssertEqual(poll(&pfd, 1, 1000), 1);
+    XCTAssertEqual([receiver receiveBatch], (intptr_t)1);
+    XCTAssertEqual([receiver lengthOfDatagramAtIndex:0], (size_t)256);
+    XCTAssertTrue([receiver isDatagramTruncatedAtIndex:0]);
+    XCTAssertEqual([receiver datagramsTruncated], (uint64_t)1);
+
+    /* Replies go to the address of the sender, in IPv6 too. */
+    SFDatagramSocket *receiver6 = [[SFDatagramSocket alloc] init];
+    XCTAssertEqual([receiver6 bind:@"::1" port:0], 0);
+    XCTAssertEqual([receiver bind:@"::1" port:0], EAFNOSUPPORT);
+
+    SFDatagramSocket *sender6 = [[SFDatagramSocket alloc] init];
+    NSData *target = [[[SFResolver sharedResolver] addressesForHost:@"::1" port:[receiver6 localPort] error:NULL] firstObject];
+    XCTAssertTrue([sender6 send:"ping" length:4 toAddress:target]);
+
+    pfd.fd = [receiver6 descriptor];
+    XCTAssertEqual(poll(&pfd, 1, 1000), 1);
+    XCTAssertEqual([receiver6 receiveBatch], (intptr_t)1);
+    XCTAssertEqual(memcmp([receiver6 bytesOfDatagramAtIndex:0], "ping", 4), 0);
+    XCTAssertEqual(((const struct sockaddr *)[[receiver6 addressOfDatagramAtIndex:0] bytes])->sa_family, AF_INET6);
+
+    [sender close];
+    [receiver close];
+    [sender6 close];
+    [receiver6 close];
+}
+//}}}
+
+// Tuning
+// - (void)testSocketProfile;//{{{
+- (void)testSocketProfile
+{
+    SFSocketProfile *lowLatency = [SFSocketProfile profileNamed:@"low-latency"];
+    SFSocketProfile *bulk = [SFSocketProfile profileNamed:@"bulk-throughput"];
+    SFSocket *client, *peer;
+    int value;
+    socklen_t size = sizeof(int);
+
+    XCTAssertEqualObjects([lowLatency name], @"low-latency");
+    XCTAssertTrue([lowLatency noDelay]);
+    XCTAssertEqualObjects([bulk name], @"bulk-throughput");
+    XCTAssertFalse([bulk noDelay]);
+    XCTAssertNotNil([SFSocketProfile profileNamed:@"default"]);
+    XCTAssertNil([SFSocketProfile profileNamed:@"unknown"]);
+
+    /* Profiles are copied: changing the original doesn't change a socket. */
+    SFSocket *socket = [[SFSocket alloc] init];
+    [socket setProfile:lowLatency];
+    [lowLatency setNoDelay:NO];
+    XCTAssertTrue([[socket profile] noDelay]);
+    [lowLatency setNoDelay:YES];
+
+    /* Accepted sockets get the profile of the listening one. */
+    peer = [self profiledServer:lowLatency client:&client];
+    XCTAssertTrue([[peer profile] noDelay]);
+    XCTAssertEqual(getsockopt([client descriptor], IPPROTO_TCP, TCP_NODELAY, &value, &size), 0);
+    XCTAssertNotEqual(value, 0);
+    XCTAssertEqual(getsockopt([peer descriptor], IPPROTO_TCP, TCP_NODELAY, &value, &size), 0);
+    XCTAssertNotEqual(value, 0);
+    XCTAssertEqual(getsockopt([peer descriptor], SOL_SOCKET, SO_KEEPALIVE, &value, &size), 0);
+    XCTAssertNotEqual(value, 0);
+    [client close];
+    [peer close];
+
+    peer = [self profiledServer:bulk client:&client];
+    XCTAssertEqual(getsockopt([client descriptor], SOL_SOCKET, SO_SNDBUF, &value, &size), 0);
+    XCTAssertTrue(value >= [bulk sendBufferSize]);
+    XCTAssertEqual(getsockopt([peer descriptor], SOL_SOCKET, SO_RCVBUF, &value, &size), 0);
+    XCTAssertTrue(value >= [bulk receiveBufferSize]);
+    XCTAssertEqual(getsockopt([client descriptor], IPPROTO_TCP, TCP_NODELAY, &value, &size), 0);
+    XCTAssertEqual(value, 0);
+    [client close];
+    [peer close];
+
+    /* Sockets without a profile use the default one. */
+    [SFSocket setDefaultProfile:lowLatency];
+    peer = [self profiledServer:nil client:&client];
+    XCTAssertNil([client profile]);
+    XCTAssertEqual(getsockopt([client descriptor], IPPROTO_TCP, TCP_NODELAY, &value, &size), 0);
+    XCTAssertNotEqual(value, 0);
+    [SFSocket setDefaultProfile:nil];
+    XCTAssertNil([SFSocket defaultProfile]);
+    [client close];
+    [peer close];
+}
+//}}}
+
+// Server
+// - (void)testSocketServerAccept;//{{{
+- (void)testSocketServerAccept
+{
+    SFSocketServer *server = [[SFSocketServer alloc] initWithThreads:2];
+    SFSocket *client = [[SFSocket alloc] init];
+
+    XCTAssertEqual([[server loops] count], (NSUInteger)2);
+    XCTAssertEqual([server listen:@"127.0.0.1" port:0], 0);
+    XCTAssertNotEqual([server port], (NSUInteger)0);
+
+    [client open:@"127.0.0.1" port:[server port]];
+    for (int i = 0; (i < 1000) && ([server numberOfAccepts] == 0); ++i)
+        usleep(1000);
+
+    XCTAssertEqual([server numberOfAccepts], (uint64_t)1);
+    [server stop];
+    XCTAssertEqual([server port], (NSUInteger)0);
+}
+//}}}
+
+// Benchmarks
+// - (void)testSocketLoopThroughputReport;//{{{
+/**
+ * Connects LOOP_BENCHMARK_CONNECTIONS clients to local peers, all handled
+ * by one loop thread, and reports connections and round trips per second.
+ **/
+- (void)testSocketLoopThroughputReport
+{
+    SFSocketLoop *loop = [[SFSocketLoop alloc] init];
+    NSArray *clients = [self clientsWithCount:LOOP_BENCHMARK_CONNECTIONS];
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+
+    [loop setDelegate:self];
+    m_connected = m_received = m_finished = m_closed = 0;
+
+    NSDate *start = [NSDate date];
+    for (SFSocket *client in clients)
+    {
+        [client open:@"127.0.0.1" port:port];
+        XCTAssertTrue([loop addSocket:client]);
+
+        SFSocket *peer = [[SFSocket alloc] initWithDescriptor:accept(listener, NULL, NULL)];
+        XCTAssertTrue([loop addSocket:peer]);
+    }
+    XCTAssertTrue([loop start]);
+    XCTAssertTrue([self waitFor:&m_connected value:LOOP_BENCHMARK_CONNECTIONS]);
+    NSTimeInterval connecting = -[start timeIntervalSinceNow];
+
+    XCTAssertTrue([self waitFor:&m_finished value:LOOP_BENCHMARK_CONNECTIONS]);
+    NSTimeInterval elapsed = -[start timeIntervalSinceNow];
+
+    [loop stop];
+    XCTAssertEqual(m_received, (NSInteger)(LOOP_BENCHMARK_CONNECTIONS * LOOP_BENCHMARK_MESSAGES));
+    XCTAssertEqual([loop numberOfSockets], (NSUInteger)(2 * LOOP_BENCHMARK_CONNECTIONS));
+
+    uint64_t calls = 0;
+    for (SFSocket *client in clients)
+        calls += [client numberOfReceiveCalls];
+
+    NSLog(@"SFSocketLoop: %.0f connections/s, %.0f round trips/s, %.2f receive calls/message",
+          (LOOP_BENCHMARK_CONNECTIONS / connecting), (m_received / elapsed), ((double)calls / m_received));
+    close(listener);
+}
+//}}}
+// - (void)testWriteQueueThroughputReport;//{{{
+/**
+ * Sends QUEUE_BENCHMARK_SIZE bytes through the write queue, in buffers of
+ * QUEUE_CHUNK_SIZE bytes, to a peer in a loop thread that discards them.
+ * The producer stops while the socket is congested.
+ **/
+- (void)testWriteQueueThroughputReport
+{
+    SFSocketLoop *loop = [[SFSocketLoop alloc] init];
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+    SFSocket *client = [self connectedClient:port];
+    SFSocket *peer = [[SFSocket alloc] initWithDescriptor:accept(listener, NULL, NULL)];
+    NSData *chunk = [NSData dataWithData:[NSMutableData dataWithLength:QUEUE_CHUNK_SIZE]];
+    size_t queued;
+
+    m_clients = [NSSet set];
+    m_sink = YES;
+    m_sunk = 0;
+    [loop setDelegate:self];
+    XCTAssertTrue([loop addSocket:peer]);
+    XCTAssertTrue([loop start]);
+
+    NSDate *start = [NSDate date];
+    for (queued = 0; queued < QUEUE_BENCHMARK_SIZE; queued += QUEUE_CHUNK_SIZE)
+    {
+        XCTAssertTrue([client enqueueData:chunk]);
+        while ([client isCongested])
+            XCTAssertTrue([self waitWritable:client]);
+    }
+    while ([client queuedBytes] > 0)
+        XCTAssertTrue([self waitWritable:client]);
+
+    XCTAssertTrue([self waitFor:&m_sunk value:QUEUE_BENCHMARK_SIZE]);
+    NSTimeInterval elapsed = -[start timeIntervalSinceNow];
+
+    [loop stop];
+    m_sink = NO;
+    NSLog(@"SFSocket write queue: %.1f MB/s", (QUEUE_BENCHMARK_SIZE / elapsed / 1048576.0));
+    [client close];
+    close(listener);
+}
+//}}}
+// - (void)testSendFileThroughputReport;//{{{
+/**
+ * Sends a FILE_BENCHMARK_SIZE file to a loop that discards it, once with
+ * SFSocket::sendFile:offset:length: and once reading it in user space and
+ * queueing the buffers. Reports the throughput of both.
+ **/
+- (void)testSendFileThroughputReport
+{
+    SFSocketLoop *loop = [[SFSocketLoop alloc] init];
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+    SFSocket *client = [self connectedClient:port];
+    SFSocket *peer = [[SFSocket alloc] initWithDescriptor:accept(listener, NULL, NULL)];
+    NSFileHandle *file = [self temporaryFileWithData:[NSMutableData dataWithLength:FILE_BENCHMARK_SIZE]];
+    NSTimeInterval copied, zeroCopy;
+    size_t queued;
+
+    m_clients = [NSSet set];
+    m_sink = YES;
+    m_sunk = 0;
+    [loop setDelegate:self];
+    XCTAssertTrue([loop addSocket:peer]);
+    XCTAssertTrue([loop start]);
+
+    /* Reads the file in user space and sends the copies. */
+    NSDate *start = [NSDate date];
+    for (queued = 0; queued < FILE_BENCHMARK_SIZE; queued += QUEUE_CHUNK_SIZE)
+    {
+        NSMutableData *chunk = [NSMutableData dataWithLength:QUEUE_CHUNK_SIZE];
+
+        XCTAssertEqual(pread([file fileDescriptor], [chunk mutableBytes], QUEUE_CHUNK_SIZE, (off_t)queued), (ssize_t)QUEUE_CHUNK_SIZE);
+        XCTAssertTrue([client enqueueData:chunk]);
+        while ([client isCongested])
+            XCTAssertTrue([self waitWritable:client]);
+    }
+    while ([client queuedBytes] > 0)
+        XCTAssertTrue([self waitWritable:client]);
+    XCTAssertTrue([self waitFor:&m_sunk value:FILE_BENCHMARK_SIZE]);
+    copied = -[start timeIntervalSinceNow];
+
+    /* The kernel sends the file. */
+    m_sunk = 0;
+    [client resetStatistics];
+    start = [NSDate date];
+    XCTAssertTrue([client sendFile:file offset:0 length:FILE_BENCHMARK_SIZE]);
+    while ([client queuedBytes] > 0)
+        XCTAssertTrue([self waitWritable:client]);
+    XCTAssertTrue([self waitFor:&m_sunk value:FILE_BENCHMARK_SIZE]);
+    zeroCopy = -[start timeIntervalSinceNow];
+
+    [loop stop];
+    m_sink = NO;
+    NSLog(@"SFSocket file copy: %.1f MB/s, sendFile: %.1f MB/s in %llu calls",
+          (FILE_BENCHMARK_SIZE / copied / 1048576.0),
+          (FILE_BENCHMARK_SIZE / zeroCopy / 1048576.0),
+          [client numberOfSendCalls]);
+    [file closeFile];
+    [client close];
+    close(listener);
+}
+//}}}
+// - (void)testSocketProfileReport;//{{{
+/**
+ * Runs a ping-pong and a bulk transfer over loopback with each preset.
+ * Requests are sent as a header and a payload in two writes, the pattern
+ * the Nagle algorithm delays. Reports the average round trip and the
+ * throughput of each profile.
+ **/
+- (void)testSocketProfileReport
+{
+    for (NSString *name in @[ @"default", @"low-latency", @"bulk-throughput" ])
+    {
+        SFSocketProfile *profile = [SFSocketProfile profileNamed:name];
+        SFSocket *client, *peer;
+        uint8_t message[GATHER_HEADER_SIZE + GATHER_PAYLOAD_SIZE] = { 0 };
+        NSTimeInterval pingPong, bulk;
+        int round;
+
+        /* Ping-pong. */
+        peer = [self profiledServer:profile client:&client];
+        NSDate *start = [NSDate date];
+        for (round = 0; round < PROFILE_BENCHMARK_ROUNDS; ++round)
+        {
+            XCTAssertTrue([client send:message ofLength:GATHER_HEADER_SIZE]);
+            XCTAssertTrue([client send:(message + GATHER_HEADER_SIZE) ofLength:GATHER_PAYLOAD_SIZE]);
+            XCTAssertTrue([self receive:message length:sizeof(message) from:peer]);
+            XCTAssertTrue([peer send:message ofLength:sizeof(message)]);
+            XCTAssertTrue([self receive:message length:sizeof(message) from:client]);
+        }
+        pingPong = -[start timeIntervalSinceNow];
+        [client close];
+        [peer close];
+
+        /* Bulk transfer to a loop that discards the data. */
+        SFSocketLoop *loop = [[SFSocketLoop alloc] init];
+        NSData *chunk = [NSData dataWithData:[NSMutableData dataWithLength:QUEUE_CHUNK_SIZE]];
+        size_t queued;
+
+        peer = [self profiledServer:profile client:&client];
+        m_clients = [NSSet set];
+        m_sink = YES;
+        m_sunk = 0;
+        [loop setDelegate:self];
+        XCTAssertTrue([loop addSocket:peer]);
+        XCTAssertTrue([loop start]);
+
+        start = [NSDate date];
+        for (queued = 0; queued < PROFILE_BENCHMARK_SIZE; queued += QUEUE_CHUNK_SIZE)
+        {
+            XCTAssertTrue([client enqueueData:chunk]);
+            while ([client isCongested])
+                XCTAssertTrue([self waitWritable:client]);
+        }
+        while ([client queuedBytes] > 0)
+            XCTAssertTrue([self waitWritable:client]);
+        XCTAssertTrue([self waitFor:&m_sunk value:PROFILE_BENCHMARK_SIZE]);
+        bulk = -[start timeIntervalSinceNow];
+
+        [loop stop];
+        m_sink = NO;
+        [client close];
+
+        NSLog(@"SFSocketProfile %@: %.1f us per round trip, %.1f MB/s", name,
+              (pingPong * 1000000.0 / PROFILE_BENCHMARK_ROUNDS),
+              (PROFILE_BENCHMARK_SIZE / bulk / 1048576.0));
+    }
+}
+//}}}
+// - (void)testHappyEyeballsReport;//{{{
+/**
+ * Connects CONNECT_BENCHMARK_ATTEMPTS times to a pair of addresses whose
+ * first one, IPv6, never answers. First trying one address at a time, each
+ * for CONNECT_BENCHMARK_TIMEOUT seconds, then racing them with
+ * SFSocket::openAddresses:. Reports the median and the 99th percentile of
+ * the connect time.
+ **/
+- (void)testHappyEyeballsReport
+{
+    NSMutableArray *fillers = [NSMutableArray array];
+    SFSocket *server = [[SFSocket alloc] init];
+    NSTimeInterval *times = (NSTimeInterval *)calloc(CONNECT_BENCHMARK_ATTEMPTS, sizeof(NSTimeInterval));
+    socket_t blackhole;
+
+    XCTAssertEqual([server listen:@"127.0.0.1" port:0 reusePort:NO], 0);
+
+    NSData *dead = [self blackholeOn:@"::1" listener:&blackhole fillers:fillers];
+    NSData *live = [self addressOf:@"127.0.0.1" port:[server localPort]];
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (int i = 0; i < CONNECT_BENCHMARK_ATTEMPTS; ++i)
+        {
+            SFSocket *client = [[SFSocket alloc] init];
+            NSDate *start = [NSDate date];
+            error_t error;
+
+            if (pass == 0)
+            {
+                error = [client openAddress:dead];
+                if (error == EINPROGRESS)
+                    error = [client waitReady:CONNECT_BENCHMARK_TIMEOUT];
+                if (error != 0)
+                    error = [client openAddress:live];
+            }
+            else
+                error = [client openAddresses:@[ dead, live ]];
+
+            if (error == EINPROGRESS)
+                error = [client waitReady:CONNECT_BENCHMARK_TIMEOUT];
+            times[i] = -[start timeIntervalSinceNow];
+
+            XCTAssertEqual(error, 0);
+            [client close];
+
+            /* Keeps the backlog of the live listener empty. */
+            for (SFSocket *peer = [server accept]; peer != nil; peer = [server accept])
+                [peer close];
+        }
+
+        qsort_b(times, CONNECT_BENCHMARK_ATTEMPTS, sizeof(NSTimeInterval), ^int(const void *a, const void *b) {
+            NSTimeInterval x = *(const NSTimeInterval *)a, y = *(const NSTimeInterval *)b;
+            return ((x < y) ? -1 : ((x > y) ? 1 : 0));
+        });
+        NSLog(@"SFSocket connect, %@: p50 %.1f ms, p99 %.1f ms",
+              ((pass == 0) ? @"one address at a time" : @"happy eyeballs"),
+              (times[CONNECT_BENCHMARK_ATTEMPTS / 2] * 1e3), (times[(CONNECT_BENCHMARK_ATTEMPTS * 99) / 100] * 1e3));
+    }
+
+    for (SFSocket *filler in fillers)
+        [filler close];
+    free(times);
+    close(blackhole);
+    [server close];
+}
+//}}}
+// - (void)testDatagramThroughputReport;//{{{
+/**
+ * Sends DATAGRAM_BENCHMARK_COUNT datagrams of 64 and 1400 bytes over
+ * loopback, in batches, receiving each batch before sending the next one.
+ * Reports datagrams per second and system calls per datagram.
+ **/
+- (void)testDatagramThroughputReport
+{
+    const size_t sizes[] = { 64, 1400 };
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        SFDatagramSocket *receiver = [[SFDatagramSocket alloc] init];
+        SFDatagramSocket *sender = [[SFDatagramSocket alloc] init];
+        NSUInteger batch = [receiver batchSize];
+        struct iovec *buffers = (struct iovec *)calloc(batch, sizeof(struct iovec));
+        NSMutableData *payload = [NSMutableData dataWithLength:sizes[pass]];
+        struct pollfd pfd;
+        NSUInteger index, sent = 0, received = 0;
+
+        [receiver setProfile:[SFSocketProfile bulkThroughputProfile]];
+        XCTAssertEqual([receiver bind:@"127.0.0.1" port:0], 0);
+        XCTAssertEqual([sender connect:@"127.0.0.1" port:[receiver localPort]], 0);
+
+        for (index = 0; index < batch; ++index) {
+            buffers[index].iov_base = [payload mutableBytes];
+            buffers[index].iov_len  = sizes[pass];
+        }
+
+        pfd.fd = [receiver descriptor];
+        pfd.events = POLLIN;
+
+        NSDate *start = [NSDate date];
+        while (received < DATAGRAM_BENCHMARK_COUNT)
+        {
+            NSUInteger count = MIN(batch, DATAGRAM_BENCHMARK_COUNT - sent);
+            intptr_t result = [sender sendBuffers:buffers count:count];
+
+            XCTAssertTrue(result >= 0);
+            if (result < 0) break;
+            sent += (NSUInteger)result;
+
+            /* Drains what was sent. Loopback doesn't lose datagrams while
+             * the receive buffer has room. */
+            while ((received < sent) && (poll(&pfd, 1, 100) > 0))
+                received += (NSUInteger)MAX([receiver receiveBatch], 0);
+            if (received < sent) break;
+        }
+        NSTimeInterval elapsed = -[start timeIntervalSinceNow];
+
+        XCTAssertEqual(received, (NSUInteger)DATAGRAM_BENCHMARK_COUNT);
+        NSLog(@"SFDatagramSocket %zu bytes: %.0f datagrams/s, %.2f receive calls and %.2f send calls per datagram",
+              sizes[pass], (received / elapsed),
+              ((double)[receiver numberOfReceiveCalls] / received),
+              ((double)[sender numberOfSendCalls] / sent));
+
+        free(buffers);
+        [sender close];
+        [receiver close];
+    }
+}
+//}}}
+// - (void)testConnectionPoolReport;//{{{
+/**
+ * Makes POOL_BENCHMARK_REQUESTS requests, each one taking a connection to a
+ * local server and giving it back, with a new connection each time and with
+ * a pre-warmed pool. Reports the median and the 99th percentile of the time
+ * to get a connection.
+ **/
+- (void)testConnectionPoolReport
+{
+    SFSocketServer *server = [[SFSocketServer alloc] initWithThreads:1];
+    NSTimeInterval *times = (NSTimeInterval *)calloc(POOL_BENCHMARK_REQUESTS, sizeof(NSTimeInterval));
+
+    m_clients = [NSSet set];
+    [server setDelegate:self];
+    XCTAssertEqual([server listen:@"127.0.0.1" port:0], 0);
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        SFConnectionPool *pool = [[SFConnectionPool alloc] init];
+
+        if (pass == 1)
+            XCTAssertEqual([pool prewarmHost:@"127.0.0.1" port:[server port] count:4], (NSUInteger)4);
+
+        for (int i = 0; i < POOL_BENCHMARK_REQUESTS; ++i)
+        {
+            NSDate *start = [NSDate date];
+            SFSocket *socket = [pool connectionToHost:@"127.0.0.1" port:[server port] error:NULL];
+
+            times[i] = -[start timeIntervalSinceNow];
+            XCTAssertNotNil(socket);
+
+            if (pass == 0)
+                [pool discardConnection:socket];
+            else
+                [pool releaseConnection:socket];
+        }
+
+        qsort_b(times, POOL_BENCHMARK_REQUESTS, sizeof(NSTimeInterval), ^int(const void *a, const void *b) {
+            NSTimeInterval x = *(const NSTimeInterval *)a, y = *(const NSTimeInterval *)b;
+            return ((x < y) ? -1 : ((x > y) ? 1 : 0));
+        });
+        NSLog(@"SFConnectionPool, %@: p50 %.1f us, p99 %.1f us, hit rate %.2f, %llu handshakes",
+              ((pass == 0) ? @"new connections" : @"pre-warmed pool"),
+              (times[POOL_BENCHMARK_REQUESTS / 2] * 1e6), (times[(POOL_BENCHMARK_REQUESTS * 99) / 100] * 1e6),
+              [pool hitRate], (unsigned long long)[pool numberOfHandshakes]);
+        [pool closeAllConnections];
+    }
+
+    free(times);
+    [server stop];
+}
+//}}}
+// - (void)testScatterGatherReport;//{{{
+/**
+ * Sends GATHER_BENCHMARK_MESSAGES messages made of a header and a payload,
+ * first with two calls to SFSocket::send:ofLength: and then with a single
+ * SFSocket::sendBuffers:count:, to a peer that discards them.
+ **/
+- (void)testScatterGatherReport
+{
+    SFSocketLoop *loop = [[SFSocketLoop alloc] init];
+    uint16_t port;
+    socket_t listener = [self listenerWithPort:&port];
+    SFSocket *client = [self connectedClient:port];
+    SFSocket *peer = [[SFSocket alloc] initWithDescriptor:accept(listener, NULL, NULL)];
+    uint8_t header[GATHER_HEADER_SIZE] = { 0 };
+    uint8_t payload[GATHER_PAYLOAD_SIZE] = { 0 };
+    struct iovec buffers[2] = { { header, sizeof(header) }, { payload, sizeof(payload) } };
+    NSTimeInterval elapsed[2];
+    NSInteger expected = 0;
+
+    m_clients = [NSSet set];
+    m_sink = YES;
+    m_sunk = 0;
+    [loop setDelegate:self];
+    XCTAssertTrue([loop addSocket:peer]);
+    XCTAssertTrue([loop start]);
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        NSDate *start = [NSDate date];
+
+        for (int i = 0; i < GATHER_BENCHMARK_MESSAGES; ++i)
+        {
+            if (pass == 0) {
+                XCTAssertTrue([client send:header ofLength:sizeof(header)]);
+                XCTAssertTrue([client send:payload ofLength:sizeof(payload)]);
+            } else {
+                XCTAssertEqual([client sendBuffers:buffers count:2], (intptr_t)sizeof(header) + (intptr_t)sizeof(payload));
+            }
+            while ([client isCongested])
+                XCTAssertTrue([self waitWritable:client]);
+        }
+        while ([client queuedBytes] > 0)
+            XCTAssertTrue([self waitWritable:client]);
+
+        expected += GATHER_BENCHMARK_MESSAGES * (GATHER_HEADER_SIZE + GATHER_PAYLOAD_SIZE);
+        XCTAssertTrue([self waitFor:&m_sunk value:expected]);
+        elapsed[pass] = -[start timeIntervalSinceNow];
+    }
+
+    [loop stop];
+    m_sink = NO;
+    NSLog(@"SFSocket header + payload: send %.0f messages/s, sendBuffers %.0f messages/s",
+          (GATHER_BENCHMARK_MESSAGES / elapsed[0]), (GATHER_BENCHMARK_MESSAGES / elapsed[1]));
+    [client close];
+    close(listener);
+}
+//}}}
+// - (void)testSocketServerScalingReport;//{{{
+/**
+ * Runs the round trips of the loop benchmark against an SFSocketServer with
+ * 1, 2 and up to SERVER_BENCHMARK_THREADS threads. Clients run in a loop of
+ * their own.
+ **/
+- (void)testSocketServerScalingReport
+{
+    for (NSUInteger threads = 1; threads <= SERVER_BENCHMARK_THREADS; threads *= 2)
+    {
+        SFSocketServer *server = [[SFSocketServer alloc] initWithThreads:threads];
+        SFSocketLoop *loop = [[SFSocketLoop alloc] init];
+        NSArray *clients = [self clientsWithCount:LOOP_BENCHMARK_CONNECTIONS];
+
+        [server setDelegate:self];
+        [server setPinsThreads:YES];
+        [loop setDelegate:self];
+        m_connected = m_received = m_finished = m_closed = 0;
+        XCTAssertEqual([server listen:@"127.0.0.1" port:0], 0);
+
+        NSDate *start = [NSDate date];
+        for (SFSocket *client in clients)
+        {
+            [client open:@"127.0.0.1" port:[server port]];
+            [loop addSocket:client];
+        }
+        XCTAssertTrue([loop start]);
+        XCTAssertTrue([self waitFor:&m_connected value:LOOP_BENCHMARK_CONNECTIONS]);
+        NSTimeInterval connecting = -[start timeIntervalSinceNow];
+
+        XCTAssertTrue([self waitFor:&m_finished value:LOOP_BENCHMARK_CONNECTIONS]);
+        NSTimeInterval elapsed = -[start timeIntervalSinceNow];
+
+        [loop stop];
+        XCTAssertEqual([server numberOfAccepts], (uint64_t)LOOP_BENCHMARK_CONNECTIONS);
+        NSLog(@"SFSocketServer, %lu threads: %.0f accepts/s, %.0f requests/s",
+              (unsigned long)threads, (LOOP_BENCHMARK_CONNECTIONS / connecting), (m_received / elapsed));
+        [server stop];
+    }
+}
+//}}}
+@end
@@ -0,0 +1,1173 @@
+//
+//  SFStreamTests.m
+//  SimpleTests
+//
+//  Tests and benchmarks for the SFStream family of interfaces.
+//
+
+#import <XCTest/XCTest.h>
+#import <Simple/Simple.h>
+#import <objc/runtime.h>
+#import <malloc/malloc.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/** Total amount of bytes written in the writing benchmarks. */
+#define WRITE_BENCHMARK_SIZE    (1024 * 1024)
+
+/** Number of operations timed for each primitive in the codec benchmark. */
+#define CODEC_BENCHMARK_COUNT   (1000 * 1000)
+
+/** Number and size of the messages in the split benchmark. */
+#define SPLIT_MESSAGE_COUNT     10000
+#define SPLIT_MESSAGE_SIZE      128
+
+/** Number of elements in the typed array benchmark. */
+#define ARRAY_BENCHMARK_COUNT   (100 * 1000)
+
+/** Number of bytes in the checksum benchmark. */
+#define CHECKSUM_BENCHMARK_SIZE (16 * 1024 * 1024)
+
+/** Number of 3, 11 and 17 bits records in the bit field benchmark. */
+#define BITS_BENCHMARK_COUNT    (1000 * 1000)
+
+/**
+ * Times one primitive operation executed CODEC_BENCHMARK_COUNT times.
+ * @param label Name of the operation in the report.
+ * @param setup Statement executed before the timer starts.
+ * @param op Statement timed. \c i is the loop counter.
+ **/
+#define TIME_PRIMITIVE(label, setup, op) do { \
+    setup; \
+    NSDate *start = [NSDate date]; \
+    for (uint32_t i = 0; i < CODEC_BENCHMARK_COUNT; ++i) { op; } \
+    NSTimeInterval elapsed = -[start timeIntervalSinceNow]; \
+    NSLog(@"%-32s %6.2f ns/op", label, ((elapsed * 1e9) / CODEC_BENCHMARK_COUNT)); \
+} while (0)
+
+@interface SFStreamTests : XCTestCase
+@end
+
+@implementation SFStreamTests
+// Helpers
+// - (NSTimeInterval)writeIntsIn:(SFStream *)stream count:(size_t)count;//{{{
+- (NSTimeInterval)writeIntsIn:(SFStream *)stream count:(size_t)count
+{
+    NSDate *start = [NSDate date];
+
+    for (size_t i = 0; i < count; ++i)
+        [stream writeInt:(uint32_t)i];
+
+    return -[start timeIntervalSinceNow];
+}
+//}}}
+// - (NSTimeInterval)writeChunksIn:(SFStream *)stream from:(NSData *)data count:(size_t)count;//{{{
+- (NSTimeInterval)writeChunksIn:(SFStream *)stream from:(NSData *)data count:(size_t)count
+{
+    NSDate *start = [NSDate date];
+
+    for (size_t i = 0; i < count; ++i)
+        [stream write:[data bytes] length:[data length]];
+
+    return -[start timeIntervalSinceNow];
+}
+//}}}
+
+// - (malloc_statistics_t)splitBatch:(SFStream *)batch into:(NSMutableArray *)messages copying:(BOOL)copying;//{{{
+/**
+ * Splits a batch of messages and returns the growth of the heap.
+ **/
+- (malloc_statistics_t)splitBatch:(SFStream *)batch into:(NSMutableArray *)messages copying:(BOOL)copying
+{
+    malloc_statistics_t before, after;
+
+    [batch setReadPosition:0];
+    malloc_zone_statistics(NULL, &before);
+    while ([batch numberOfBytesAvailable] > 0)
+    {
+        if (copying)
+        {
+            [messages addObject:[[SFStream alloc] initWithBytes:[batch bytes] length:SPLIT_MESSAGE_SIZE]];
+            [batch setReadPosition:([batch readPosition] + SPLIT_MESSAGE_SIZE)];
+        }
+        else
+            [messages addObject:[batch streamFromReadingBytes:SPLIT_MESSAGE_SIZE]];
+    }
+    malloc_zone_statistics(NULL, &after);
+
+    after.blocks_in_use -= before.blocks_in_use;
+    after.size_in_use   -= before.size_in_use;
+    return after;
+}
+//}}}
+
+// Growth Policy
+// - (void)testGeometricGrowth;//{{{
+- (void)testGeometricGrowth
+{
+    SFStream *stream = [[SFStream alloc] init];
+    size_t reallocs = 0, capacity = [stream capacity];
+
+    for (size_t i = 0; i < (WRITE_BENCHMARK_SIZE / sizeof(uint32_t)); ++i)
+    {
+        [stream writeInt:(uint32_t)i];
+        if ([stream capacity] != capacity) {
+            capacity = [stream capacity];
+            reallocs++;
+        }
+    }
+
+    XCTAssertEqual([stream length], (size_t)WRITE_BENCHMARK_SIZE);
+    XCTAssertGreaterThanOrEqual([stream capacity], [stream length]);
+    XCTAssertLessThan(reallocs, (size_t)32);
+
+    [stream setReadPosition:(WRITE_BENCHMARK_SIZE - sizeof(uint32_t))];
+    XCTAssertEqual([stream readInt], (uint32_t)((WRITE_BENCHMARK_SIZE / sizeof(uint32_t)) - 1));
+}
+//}}}
+// - (void)testReserveAndShrink;//{{{
+- (void)testReserveAndShrink
+{
+    SFStream *stream = [[SFStream alloc] initWithCapacity:16];
+
+    XCTAssertTrue([stream reserveCapacity:4096]);
+    XCTAssertEqual([stream capacity], (size_t)4096);
+    XCTAssertTrue([stream reserveCapacity:1024]);
+    XCTAssertEqual([stream capacity], (size_t)4096);
+
+    [stream writeLong:0x0102030405060708ULL];
+    [stream shrinkToFit];
+    XCTAssertEqual([stream capacity], (size_t)8);
+    XCTAssertEqual([stream readLong], 0x0102030405060708ULL);
+
+    [stream writeInt:1];
+    [stream reset];
+    XCTAssertEqual([stream highWaterMark], (size_t)12);
+
+    [stream shrinkToFit];
+    XCTAssertEqual([stream capacity], (size_t)0);
+    [stream writeByte:0xAA];
+    XCTAssertEqual([stream length], (size_t)1);
+}
+//}}}
+// - (void)testExactGrowthFactor;//{{{
+- (void)testExactGrowthFactor
+{
+    SFStream *stream = [[SFStream alloc] initWithCapacity:100];
+
+    stream.growthFactor = 1.0f;
+    [stream write:"0123456789" length:10];
+    XCTAssertEqual([stream capacity], (size_t)100);
+    [stream reserveCapacity:0];
+    [stream shrinkToFit];
+    [stream writeInt:0];
+    XCTAssertEqual([stream capacity], (size_t)64);   /* Minimum capacity. */
+}
+//}}}
+
+// C Level Access
+// - (void)testInlineCodecInterop;//{{{
+- (void)testInlineCodecInterop
+{
+    SFStream *stream = [[SFStream alloc] init];
+    stream_t *s = [stream handle];
+    uint32_t value = 0;
+    double real = 0.0;
+
+    XCTAssertTrue(SFStreamWriteBigEndianInt(s, 0x01020304));
+    [stream writeLittleEndianDouble:2.5];
+    XCTAssertEqual([stream length], (size_t)12);
+    XCTAssertEqual(*[stream bytes], (uint8_t)0x01);
+
+    XCTAssertEqual([stream readBigEndianInt], (uint32_t)0x01020304);
+    XCTAssertTrue(SFStreamReadLittleEndianDouble(s, &real));
+    XCTAssertEqual(real, 2.5);
+
+    /* A failed read must not move the cursor. */
+    [stream writeShort:7];
+    XCTAssertFalse(SFStreamReadInt(s, &value));
+    XCTAssertEqual([stream numberOfBytesAvailable], (size_t)2);
+    XCTAssertEqual([stream readShort], (uint16_t)7);
+}
+//}}}
+
+// Ring Buffer
+// - (void)testRingWrapAround;//{{{
+- (void)testRingWrapAround
+{
+    SFRingStream *ring = [[SFRingStream alloc] initWithCapacity:64];
+    uint8_t block[48];
+    struct iovec segments[2];
+
+    for (size_t i = 0; i < sizeof(block); ++i) block[i] = (uint8_t)i;
+
+    XCTAssertTrue([ring powerOfTwo]);
+    XCTAssertEqual([ring capacity], (size_t)64);
+
+    /* Consumes 40 bytes and purges them, then writes across the end. */
+    [ring write:block length:sizeof(block)];
+    [ring setReadPosition:40];
+    [ring purgeReadBytes];
+    [ring write:block length:sizeof(block)];
+
+    XCTAssertEqual([ring capacity], (size_t)64);
+    XCTAssertEqual([ring length], (size_t)56);
+    XCTAssertEqual([ring readSegments:segments], 2);
+    XCTAssertEqual(segments[0].iov_len + segments[1].iov_len, (size_t)56);
+
+    XCTAssertEqual([ring readLong], *(uint64_t *)(block + 40));
+    for (size_t i = 0; i < sizeof(block); ++i)
+        XCTAssertEqual([ring readByte], block[i]);
+
+    XCTAssertEqual([ring numberOfBytesAvailable], (size_t)0);
+}
+//}}}
+// - (void)testRingDirectAccess;//{{{
+- (void)testRingDirectAccess
+{
+    SFRingStream *ring = [[SFRingStream alloc] initWithCapacity:100 powerOfTwo:NO];
+    struct iovec segments[2];
+    uint8_t byte = 0xAA;
+
+    XCTAssertFalse([ring powerOfTwo]);
+    [ring write:"012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789" length:90];
+    [ring setReadPosition:80];
+    [ring purgeReadBytes];
+
+    /* 20 bytes written through the segments wraps the buffer. */
+    int count = [ring writeSegments:segments length:20];
+    XCTAssertEqual(count, 2);
+    for (int i = 0; i < count; ++i)
+        memset(segments[i].iov_base, byte, segments[i].iov_len);
+    XCTAssertTrue([ring setWritePosition:([ring writePosition] + 20)]);
+    XCTAssertEqual([ring length], (size_t)30);
+
+    /* Contiguous access rearranges the buffer. */
+    const uint8_t *ptr = [ring bytes];
+    XCTAssertEqual(memcmp(ptr, "0123456789", 10), 0);
+    XCTAssertEqual(ptr[29], byte);
+    XCTAssertEqual([ring readSegments:segments], 1);
+}
+//}}}
+
+// Segmented Stream
+// - (void)testSegmentedAppendWithoutCopy;//{{{
+- (void)testSegmentedAppendWithoutCopy
+{
+    SFChunkPool *pool = [[SFChunkPool alloc] initWithChunkSize:256 maximumFreeChunks:8];
+    SFSegmentedStream *stream = [[SFSegmentedStream alloc] initWithPool:pool];
+    struct iovec segments[8];
+    uint8_t data[1000];
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)i;
+
+    [stream write:data length:100];
+    const uint8_t *first = [stream bytesAtIndex:0];
+
+    /* Appending never moves the bytes already written. */
+    [stream write:data length:sizeof(data)];
+    XCTAssertEqual([stream bytesAtIndex:0], first);
+    XCTAssertEqual([stream length], (size_t)1100);
+    XCTAssertEqual([stream numberOfChunks], (size_t)5);
+    XCTAssertEqual([pool chunksInUse], (size_t)5);
+
+    /* Segments cover the whole content in order. */
+    int count = [stream readSegments:segments count:8];
+    size_t total = 0;
+    XCTAssertEqual(count, 5);
+    for (int i = 0; i < count; ++i)
+        total += segments[i].iov_len;
+    XCTAssertEqual(total, (size_t)1100);
+    XCTAssertEqual(memcmp(segments[1].iov_base, (data + 156), 100), 0);
+
+    /* Contiguous access across chunks. */
+    XCTAssertEqual(memcmp([stream bytesAtIndex:100], data, sizeof(data)), 0);
+
+    /* Reading between bufferWithLength: and setWritePosition: doesn't touch
+     * the bytes being written. */
+    uint8_t *staged = (uint8_t *)[stream bufferWithLength:200];
+    XCTAssertTrue(staged != NULL);
+    memset(staged, 0xAB, 200);
+    XCTAssertEqual(memcmp([stream bytesAtIndex:100], data, sizeof(data)), 0);
+    XCTAssertTrue([stream setWritePosition:1300]);
+
+    const uint8_t *tail = [stream bytesAtIndex:1100];
+    for (size_t i = 0; i < 200; ++i)
+        if (tail[i] != 0xAB) { XCTFail(@"Wrong byte at %zu", i); break; }
+}
+//}}}
+// - (void)testSegmentedReleaseReadChunks;//{{{
+- (void)testSegmentedReleaseReadChunks
+{
+    SFChunkPool *pool = [[SFChunkPool alloc] initWithChunkSize:256 maximumFreeChunks:8];
+    SFSegmentedStream *stream = [[SFSegmentedStream alloc] initWithPool:pool];
+    uint8_t buffer[300];
+
+    for (uint32_t i = 0; i < 256; ++i)
+        [stream writeBigEndianInt:i];
+
+    XCTAssertEqual([pool chunksInUse], (size_t)4);
+    XCTAssertEqual([stream read:buffer length:300], (size_t)300);
+    XCTAssertEqual([pool chunksInUse], (size_t)3);
+    XCTAssertEqual([pool freeChunks], (size_t)1);
+
+    /* Positions before the first chunk alive are gone. */
+    XCTAssertFalse([stream setReadPosition:0]);
+    XCTAssertEqual([stream readBigEndianInt], (uint32_t)75);
+
+    [stream purgeReadBytes];
+    XCTAssertEqual([stream readPosition], (size_t)0);
+    XCTAssertEqual([stream length], (size_t)(1024 - 304));
+    XCTAssertEqual([stream readBigEndianInt], (uint32_t)76);
+
+    /* A value split between two chunks. */
+    XCTAssertTrue([stream setReadPosition:(512 - 304 - 2)]);
+    XCTAssertEqual([stream readBigEndianInt], (uint32_t)0x007F0000);
+
+    [stream reset];
+    XCTAssertEqual([pool chunksInUse], (size_t)0);
+    XCTAssertEqual([pool freeChunks], (size_t)4);
+}
+//}}}
+
+// Shared Buffers
+// - (void)testSliceCopyOnWrite;//{{{
+- (void)testSliceCopyOnWrite
+{
+    SFStream *stream = [[SFStream alloc] init];
+
+    for (uint32_t i = 0; i < 100; ++i)
+        [stream writeBigEndianInt:i];
+
+    SFStream *slice = [stream streamWithRange:NSMakeRange(40, 40)];
+    XCTAssertNotNil(slice);
+    XCTAssertTrue([stream isShared]);
+    XCTAssertEqual([slice bytes], [stream bytesAtIndex:40]);
+    XCTAssertEqual([slice readBigEndianInt], (uint32_t)10);
+    XCTAssertNil([stream streamWithRange:NSMakeRange(380, 40)]);
+
+    /* Appending after the shared bytes doesn't copy. */
+    const uint8_t *buffer = [stream bytesAtIndex:0];
+    [stream writeBigEndianInt:100];
+    XCTAssertEqual([stream bytesAtIndex:0], buffer);
+
+    /* Writing in the slice gives it its own copy. */
+    [slice setWritePosition:0];
+    [slice writeBigEndianInt:0xFFFFFFFF];
+    XCTAssertFalse([slice isShared]);
+    XCTAssertNotEqual([slice bytes], [stream bytesAtIndex:40]);
+    XCTAssertEqual([stream readPosition], (size_t)0);
+    [stream setReadPosition:40];
+    XCTAssertEqual([stream readBigEndianInt], (uint32_t)10);
+}
+//}}}
+// - (void)testDataViewOutlivesStream;//{{{
+- (void)testDataViewOutlivesStream
+{
+    NSData *data = nil;
+
+    @autoreleasepool {
+        SFStream *stream = [[SFStream alloc] initWithBytes:"0123456789" length:10];
+
+        [stream setReadPosition:2];
+        data = [stream dataFromReadingBytes:4];
+        XCTAssertEqual([data bytes], [stream bytesAtIndex:2]);
+        XCTAssertEqual([stream readPosition], (size_t)6);
+
+        /* Purging a shared buffer moves nothing. */
+        [stream purgeReadBytes];
+        XCTAssertEqual(memcmp([stream bytes], "6789", 4), 0);
+        stream = nil;
+    }
+    XCTAssertEqualObjects(data, [NSData dataWithBytes:"2345" length:4]);
+}
+//}}}
+// - (void)testSplitAllocationReport;//{{{
+/**
+ * Compares the heap used to split a batch of messages copying every message
+ * and sharing the batch buffer.
+ **/
+- (void)testSplitAllocationReport
+{
+    SFStream *batch = [[SFStream alloc] initWithCapacity:(SPLIT_MESSAGE_COUNT * SPLIT_MESSAGE_SIZE)];
+    NSMutableArray *messages = [NSMutableArray arrayWithCapacity:SPLIT_MESSAGE_COUNT];
+    malloc_statistics_t copied, shared;
+
+    for (size_t i = 0; i < (SPLIT_MESSAGE_COUNT * SPLIT_MESSAGE_SIZE / sizeof(uint32_t)); ++i)
+        [batch writeInt:(uint32_t)i];
+
+    @autoreleasepool {
+        copied = [self splitBatch:batch into:messages copying:YES];
+        [messages removeAllObjects];
+    }
+    @autoreleasepool {
+        shared = [self splitBatch:batch into:messages copying:NO];
+    }
+
+    NSLog(@"%d messages copied: %zu blocks, %zu bytes", SPLIT_MESSAGE_COUNT, copied.blocks_in_use, copied.size_in_use);
+    NSLog(@"%d messages shared: %zu blocks, %zu bytes", SPLIT_MESSAGE_COUNT, shared.blocks_in_use, shared.size_in_use);
+
+    XCTAssertEqual([messages count], (NSUInteger)SPLIT_MESSAGE_COUNT);
+    XCTAssertLessThan(shared.blocks_in_use, copied.blocks_in_use);
+    XCTAssertLessThan((shared.size_in_use + (SPLIT_MESSAGE_COUNT * SPLIT_MESSAGE_SIZE / 2)), copied.size_in_use);
+}
+//}}}
+
+// Mapped Files
+// - (NSString *)temporaryFileWithInts:(uint32_t)count;//{{{
+/**
+ * Creates a temporary file with a sequence of big-endian integers.
+ **/
+- (NSString *)temporaryFileWithInts:(uint32_t)count
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    SFStream *stream = [[SFStream alloc] initWithCapacity:(count * sizeof(uint32_t))];
+
+    for (uint32_t i = 0; i < count; ++i)
+        [stream writeBigEndianInt:i];
+
+    [[stream dataFromReadingBytes:-1] writeToFile:path atomically:NO];
+    return path;
+}
+//}}}
+// - (void)testMappedWindows;//{{{
+- (void)testMappedWindows
+{
+    NSString *path = [self temporaryFileWithInts:100000];
+    SFMappedStream *stream = [[SFMappedStream alloc] initWithPath:path offset:8 length:0 windowSize:1];
+    uint32_t expected = 2;
+
+    XCTAssertNotNil(stream);
+    XCTAssertEqual([stream length], (size_t)(400000 - 8));
+    XCTAssertEqual([stream windowSize], (size_t)getpagesize());
+
+    /* Values are read across window boundaries. */
+    [stream setAccessPattern:SFMappedStreamAccessSequential];
+    while ([stream numberOfBytesAvailable] >= sizeof(uint32_t))
+        XCTAssertEqual([stream readBigEndianInt], expected++);
+    XCTAssertEqual(expected, (uint32_t)100000);
+
+    /* Bulk reads larger than the window. */
+    NSMutableData *data = [NSMutableData dataWithLength:(3 * getpagesize())];
+    [stream setReadPosition:2];
+    XCTAssertEqual([stream read:[data mutableBytes] length:[data length]], [data length]);
+    XCTAssertEqual(OSSwapBigToHostInt32(*(const uint32_t *)((const uint8_t *)[data bytes] + 2)), (uint32_t)3);
+
+    /* Purging moves the start of the stream. */
+    [stream setReadPosition:4000];
+    [stream purgeReadBytes];
+    XCTAssertEqual([stream readBigEndianInt], (uint32_t)1002);
+    XCTAssertEqual(OSSwapBigToHostInt32(*(const uint32_t *)[stream bytesAtIndex:8 length:4]), (uint32_t)1004);
+
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+//}}}
+// - (void)testMappedStartupReport;//{{{
+/**
+ * Times opening a large sparse file. Only touched pages are loaded.
+ **/
+- (void)testMappedStartupReport
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    off_t size = ((off_t)2 * 1024 * 1024 * 1024);
+    int fd = open([path fileSystemRepresentation], (O_RDWR | O_CREAT | O_TRUNC), 0600);
+
+    XCTAssertTrue(fd >= 0);
+    XCTAssertEqual(ftruncate(fd, size), 0);
+    close(fd);
+
+    NSDate *start = [NSDate date];
+    SFMappedStream *stream = [[SFMappedStream alloc] initWithPath:path];
+    NSTimeInterval opened = -[start timeIntervalSinceNow];
+
+    XCTAssertNotNil(stream);
+    XCTAssertEqual([stream length], (size_t)size);
+    [stream setReadPosition:(size_t)(size - 8)];
+    XCTAssertEqual([stream readLong], (uint64_t)0);
+    NSLog(@"Mapping a 2 GB file: %.6f s", opened);
+
+    stream = nil;
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+//}}}
+
+// Framing
+// - (void)testVarintRoundTrip;//{{{
+- (void)testVarintRoundTrip
+{
+    SFStream *stream = [[SFStream alloc] init];
+    uint64_t values[300];
+    uint64_t value = 0;
+    int64_t signedValue = 0;
+
+    XCTAssertTrue([stream writeVarint:300]);
+    XCTAssertTrue([stream writeSignedVarint:-2]);
+    XCTAssertTrue([stream writeVarint:UINT64_MAX]);
+    XCTAssertEqual([stream length], (size_t)(2 + 1 + 10));
+
+    XCTAssertTrue([stream readVarint:&value]);
+    XCTAssertEqual(value, (uint64_t)300);
+    XCTAssertTrue([stream readSignedVarint:&signedValue]);
+    XCTAssertEqual(signedValue, (int64_t)-2);
+    XCTAssertTrue([stream readVarint:&value]);
+    XCTAssertEqual(value, UINT64_MAX);
+    XCTAssertFalse([stream readVarint:&value]);
+
+    /* Bulk decoding of mostly small values. */
+    [stream reset];
+    for (uint64_t i = 0; i < 300; ++i)
+        [stream writeVarint:((i % 10) ? i : (i << 20))];
+
+    XCTAssertEqual([stream readVarints:values count:300], (size_t)300);
+    XCTAssertEqual([stream numberOfBytesAvailable], (size_t)0);
+    for (uint64_t i = 0; i < 300; ++i)
+        XCTAssertEqual(values[i], ((i % 10) ? i : (i << 20)));
+}
+//}}}
+// - (void)testPartialFrames;//{{{
+- (void)testPartialFrames
+{
+    SFStream *source = [[SFStream alloc] init];
+    SFStream *input = [[SFStream alloc] init];
+    uint8_t payload[200];
+
+    memset(payload, 0x5A, sizeof(payload));
+    [source writeFrame:payload length:sizeof(payload)];
+    [source writeFrame:"abc" length:3];
+
+    /* Bytes arrive one at a time, as from SFSocket::readIntoStream:. */
+    NSMutableArray *frames = [NSMutableArray array];
+    size_t length = 0;
+    while ([source numberOfBytesAvailable] > 0)
+    {
+        uint8_t *ptr = [input bufferWithLength:1];
+        [source read:ptr length:1];
+        XCTAssertTrue([input setWritePosition:([input writePosition] + 1)]);
+
+        SFStream *frame = [input readFrameWithMaximumLength:1024];
+        if (frame != nil) [frames addObject:frame];
+    }
+
+    XCTAssertEqual([frames count], (NSUInteger)2);
+    XCTAssertEqual([frames[0] length], sizeof(payload));
+    XCTAssertEqual(memcmp([frames[1] bytes], "abc", 3), 0);
+    XCTAssertEqual([input numberOfBytesAvailable], (size_t)0);
+
+    /* A prefix greater than the limit is malformed. */
+    [input writeFrame:payload length:sizeof(payload)];
+    XCTAssertEqual([input peekFrameLength:&length maximumLength:100], SFFrameMalformed);
+    XCTAssertEqual([input peekFrameLength:&length maximumLength:SIZE_MAX], SFFrameComplete);
+    XCTAssertEqual(length, sizeof(payload));
+}
+//}}}
+
+// Typed Arrays
+// - (void)testTypedArrays;//{{{
+- (void)testTypedArrays
+{
+    SFStream *stream = [[SFStream alloc] init];
+    uint16_t shorts[37], shortsRead[37];
+    double doubles[19], doublesRead[19];
+
+    for (int i = 0; i < 37; ++i) shorts[i] = (uint16_t)(i * 1031);
+    for (int i = 0; i < 19; ++i) doubles[i] = (i * -3.25);
+
+    /* An odd start exercises unaligned access. */
+    [stream writeByte:1];
+    XCTAssertTrue([stream writeBigEndianInt16Array:shorts count:37]);
+    XCTAssertTrue([stream writeLittleEndianDoubleArray:doubles count:19]);
+
+    /* Same layout as the per-element methods. */
+    [stream readByte];
+    XCTAssertEqual([stream readBigEndianShort], shorts[0]);
+    XCTAssertEqual([stream readBigEndianShort], shorts[1]);
+
+    [stream setReadPosition:1];
+    XCTAssertTrue([stream readBigEndianInt16Array:shortsRead count:37]);
+    XCTAssertTrue([stream readLittleEndianDoubleArray:doublesRead count:19]);
+    XCTAssertEqual(memcmp(shorts, shortsRead, sizeof(shorts)), 0);
+    XCTAssertEqual(memcmp(doubles, doublesRead, sizeof(doubles)), 0);
+
+    /* Nothing is read when the array is not complete. */
+    [stream setReadPosition:1];
+    XCTAssertFalse([stream readBigEndianInt64Array:(uint64_t *)doublesRead count:100]);
+    XCTAssertEqual([stream readPosition], (size_t)1);
+}
+//}}}
+
+// Spill to Disk
+// - (void)testSpillToDisk;//{{{
+- (void)testSpillToDisk
+{
+    SFSpillStream *stream = [[SFSpillStream alloc] initWithThreshold:1024];
+    uint32_t value;
+
+    for (uint32_t i = 0; i < 200; ++i)
+        [stream writeBigEndianInt:i];
+    XCTAssertFalse([stream isSpilled]);
+
+    /* Passing the threshold moves everything to the file. */
+    for (uint32_t i = 200; i < 50000; ++i)
+        [stream writeBigEndianInt:i];
+    XCTAssertTrue([stream isSpilled]);
+    XCTAssertEqual([stream length], (size_t)200000);
+
+    /* Direct writes go through the write buffer. */
+    uint8_t *ptr = [stream bufferWithLength:4];
+    XCTAssertTrue(ptr != NULL);
+    value = OSSwapHostToBigInt32(50000);
+    memcpy(ptr, &value, 4);
+    XCTAssertTrue([stream setWritePosition:([stream writePosition] + 4)]);
+
+    /* Only the read window is contiguous. */
+    XCTAssertEqual([stream numberOfContiguousBytes], (size_t)(64 * 1024));
+    XCTAssertEqual(OSSwapBigToHostInt32(*(const uint32_t *)([stream bytes] + (64 * 1024) - 4)), (uint32_t)16383);
+
+    for (uint32_t i = 0; i < 40000; ++i)
+        if ([stream readBigEndianInt] != i) { XCTFail(@"Wrong value at %u", i); break; }
+    XCTAssertEqual(OSSwapBigToHostInt32(*(const uint32_t *)[stream bytes]), (uint32_t)40000);
+    XCTAssertEqual([stream numberOfContiguousBytes], [stream numberOfBytesAvailable]);
+
+    /* Purging leaves little enough data to go back to memory. */
+    [stream setReadPosition:(49900 * 4)];
+    [stream purgeReadBytes];
+    XCTAssertFalse([stream isSpilled]);
+    XCTAssertEqual([stream length], (size_t)(101 * 4));
+    XCTAssertEqual([stream readBigEndianInt], (uint32_t)49900);
+    [stream setReadPosition:(100 * 4)];
+    XCTAssertEqual([stream readBigEndianInt], (uint32_t)50000);
+    XCTAssertEqual([stream error], 0);
+}
+//}}}
+
+// Reader and Writer
+// - (void)testReaderWriterWithoutCopy;//{{{
+- (void)testReaderWriterWithoutCopy
+{
+    SFStreamWriter *writer = [[SFStreamWriter alloc] init];
+
+    for (uint32_t i = 0; i < 1000; ++i)
+        [writer writeBigEndianInt:i];
+    [writer writeLittleEndianDouble:1.5];
+
+    const void *buffer = [writer handle]->buffer;
+    NSData *data = [writer detachData];
+
+    /* The NSData object took the buffer. */
+    XCTAssertEqual([data length], (NSUInteger)4008);
+    XCTAssertEqual([data bytes], buffer);
+    XCTAssertEqual([writer length], (size_t)0);
+    XCTAssertEqual([writer capacity], (size_t)0);
+
+    /* The reader reads the same bytes. */
+    SFStreamReader *reader = [[SFStreamReader alloc] initWithData:data];
+    XCTAssertEqual([reader bytes], (const uint8_t *)buffer);
+    for (uint32_t i = 0; i < 1000; ++i)
+        if ([reader readBigEndianInt] != i) { XCTFail(@"Wrong value at %u", i); break; }
+    XCTAssertEqual([reader readLittleEndianDouble], 1.5);
+    XCTAssertEqual([reader numberOfBytesAvailable], (size_t)0);
+
+    /* Purging moves the start of the borrowed bytes. */
+    [reader setReadPosition:3996];
+    [reader purgeReadBytes];
+    XCTAssertEqual([reader length], (size_t)12);
+    XCTAssertEqual([reader readBigEndianInt], (uint32_t)999);
+
+    /* Both work through the protocols. */
+    id<SFStreamReaderProtocol> input = [[SFStreamReader alloc] initWithBytes:"\x01\x02" length:2];
+    XCTAssertEqual([input readBigEndianShort], (uint16_t)0x0102);
+    XCTAssertEqual([[writer detachData] length], (NSUInteger)0);
+}
+//}}}
+
+// Checksums
+// - (void)testChecksums;//{{{
+- (void)testChecksums
+{
+    SFStream *stream = [[SFStream alloc] init];
+    stream_checksum_t checksum;
+
+    /* Reference values of both algorithms. */
+    XCTAssertEqual(SFCrc32c(0, "123456789", 9), (uint32_t)0xE3069283);
+    XCTAssertEqual(SFHash64("abc", 3, 0), (uint64_t)0x44BC2CF5AD770999ULL);
+
+    [stream writeByte:0xFF];
+    [stream startChecksum:&checksum seed:7];
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        [stream writeBigEndianInt:(i * 2654435761U)];
+        if ((i % 3) == 0) [stream updateChecksum:&checksum];
+    }
+    [stream updateChecksum:&checksum];
+
+    /* Computed while writing or over the bytes to read, the same result. */
+    [stream readByte];
+    XCTAssertEqual(checksum.crc, [stream crc32cOfLength:4000]);
+    XCTAssertEqual(SFHash64Final(&checksum.hash), [stream hash64OfLength:SIZE_MAX seed:7]);
+    XCTAssertEqual([stream readPosition], (size_t)1);
+    XCTAssertNotEqual([stream hash64OfLength:4000 seed:8], SFHash64Final(&checksum.hash));
+}
+//}}}
+// - (void)testChecksumAcrossPurge;//{{{
+/**
+ * Purges the bytes already processed between two updates.
+ **/
+- (void)testChecksumAcrossPurge
+{
+    SFStream *stream = [[SFStream alloc] init];
+    stream_checksum_t checksum;
+    uint8_t data[2000], skipped[600];
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)(i * 31 + 7);
+
+    [stream write:"prefix" length:6];
+    [stream startChecksum:&checksum seed:3];
+    [stream write:data length:1000];
+    [stream updateChecksum:&checksum];
+
+    /* Moves the data already processed to the start of the buffer. */
+    XCTAssertEqual([stream read:skipped length:sizeof(skipped)], sizeof(skipped));
+    [stream purgeReadBytes];
+    XCTAssertEqual([stream length], (size_t)406);
+
+    [stream write:(data + 1000) length:1000];
+    [stream updateChecksum:&checksum];
+
+    XCTAssertEqual(checksum.crc, SFCrc32c(0, data, sizeof(data)));
+    XCTAssertEqual(SFHash64Final(&checksum.hash), SFHash64(data, sizeof(data), 3));
+}
+//}}}
+
+// Compression
+// - (void)testCompressionRoundTrip;//{{{
+/**
+ * Compresses a payload in pieces and decompresses it as the compressed bytes
+ * arrive in small pieces, with both algorithms.
+ **/
+- (void)testCompressionRoundTrip
+{
+    const size_t length = (200 * 1024);
+    uint8_t *payload = (uint8_t *)malloc(length);
+    uint8_t *result = (uint8_t *)malloc(length + 4096);
+    SFCompressionAlgorithm algorithms[] = { SFCompressionDeflate, SFCompressionLZ };
+
+    for (size_t i = 0; i < length; ++i)
+        payload[i] = (uint8_t)("message payload "[i % 16] + ((i / 1000) % 3));
+
+    for (size_t a = 0; a < 2; ++a)
+    {
+        SFStream *wire = [[SFStream alloc] init];
+        SFStream *input = [[SFStream alloc] init];
+        SFCompressor *compressor = [[SFCompressor alloc] initWithStream:wire algorithm:algorithms[a]];
+        SFDecompressor *decompressor = [[SFDecompressor alloc] initWithStream:input algorithm:algorithms[a]];
+        size_t total = 0;
+
+        for (size_t offset = 0; offset < length; offset += 7000)
+            XCTAssertTrue([compressor write:(payload + offset) length:MIN(7000, (length - offset))]);
+        XCTAssertTrue([compressor finish]);
+
+        XCTAssertEqual([compressor bytesIn], (uint64_t)length);
+        XCTAssertEqual([compressor bytesOut], (uint64_t)[wire length]);
+        XCTAssertGreaterThan([compressor ratio], 4.0);
+
+        /* Compressed bytes arrive 1000 at a time. */
+        while ([wire numberOfBytesAvailable] > 0)
+        {
+            size_t part = MIN((size_t)1000, [wire numberOfBytesAvailable]);
+            [input write:[wire bytes] length:part];
+            [wire setReadPosition:([wire readPosition] + part)];
+
+            size_t done;
+            while ((done = [decompressor read:(result + total) length:4096]) > 0)
+                total += done;
+        }
+
+        XCTAssertEqual([decompressor error], 0);
+        XCTAssertTrue([decompressor isFinished]);
+        XCTAssertEqual(total, length);
+        XCTAssertEqual(memcmp(payload, result, length), 0);
+        XCTAssertEqual([decompressor bytesOut], (uint64_t)length);
+        NSLog(@"%@: ratio %.2f, %.1f MB/s compressing, %.1f MB/s decompressing",
+              ((algorithms[a] == SFCompressionLZ) ? @"LZ" : @"Deflate"), [compressor ratio],
+              ([compressor throughput] / 1e6), ([decompressor throughput] / 1e6));
+    }
+    free(payload);
+    free(result);
+}
+//}}}
+// - (void)testDecompressMalformed;//{{{
+- (void)testDecompressMalformed
+{
+    SFStream *input = [[SFStream alloc] init];
+    SFDecompressor *decompressor = [[SFDecompressor alloc] initWithStream:input algorithm:SFCompressionLZ];
+    uint8_t block[] = { 0x20, 0x0E, 0x40, 'a', 'b', 'c', 'd', 0xFF, 0xFF };
+    uint8_t buffer[64];
+
+    /* The match offset points before the start of the block. */
+    [input write:block length:sizeof(block)];
+    XCTAssertEqual([decompressor read:buffer length:sizeof(buffer)], (size_t)0);
+    XCTAssertEqual([decompressor error], EILSEQ);
+}
+//}}}
+
+// Searching
+// - (void)testIndexOfBytes;//{{{
+- (void)testIndexOfBytes
+{
+    NSMutableData *data = [NSMutableData dataWithLength:1000];
+    const char *pattern = "boundary-1234567890";
+    SFStream *stream;
+
+    memset([data mutableBytes], 'b', 1000);
+    memcpy(((uint8_t *)[data mutableBytes] + 700), pattern, strlen(pattern));
+    ((uint8_t *)[data mutableBytes])[900] = 0;
+    stream = [[SFStream alloc] initWithData:data];
+
+    XCTAssertEqual([stream indexOfByte:0 fromPosition:0], (size_t)900);
+    XCTAssertEqual([stream indexOfByte:0 fromPosition:901], (size_t)NSNotFound);
+    XCTAssertEqual([stream indexOfBytes:pattern length:strlen(pattern) fromPosition:0], (size_t)700);
+    XCTAssertEqual([stream indexOfBytes:pattern length:strlen(pattern) fromPosition:701], (size_t)NSNotFound);
+    XCTAssertEqual([stream indexOfBytes:"bbbo" length:4 fromPosition:10], (size_t)698);
+}
+//}}}
+// - (void)testReadUntilDelimiter;//{{{
+- (void)testReadUntilDelimiter
+{
+    NSData *crlf = [NSData dataWithBytes:"\r\n" length:2];
+    const char *input = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+    SFStream *stream = [[SFStream alloc] init];
+    NSMutableArray *lines = [NSMutableArray array];
+    size_t resume = 0;
+
+    /* Bytes arrive three at a time. The delimiter is split sometimes. */
+    for (size_t i = 0; input[i] != 0; i += 3)
+    {
+        [stream write:(input + i) length:MIN((size_t)3, strlen(input + i))];
+
+        SFStream *line;
+        while ((line = [stream readUntilDelimiter:crlf resume:&resume]) != nil)
+            [lines addObject:[[NSString alloc] initWithBytes:[line bytes] length:[line length] encoding:NSASCIIStringEncoding]];
+
+        XCTAssertTrue(resume <= [stream numberOfBytesAvailable]);
+        [stream purgeReadBytes];
+    }
+
+    XCTAssertEqualObjects(lines, (@[ @"HTTP/1.1 200 OK", @"Content-Length: 0", @"" ]));
+    XCTAssertEqual([stream numberOfBytesAvailable], (size_t)0);
+}
+//}}}
+
+// Bit Fields
+// - (void)testBitFieldRoundTrip;//{{{
+- (void)testBitFieldRoundTrip
+{
+    SFStream *stream = [[SFStream alloc] init];
+    SFBitWriter *writer = [[SFBitWriter alloc] initWithStream:stream];
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        XCTAssertTrue([writer writeBits:i count:3]);
+        XCTAssertTrue([writer writeBits:(i * 19) count:11]);
+        XCTAssertTrue([writer writeBits:(i * 1237) count:17]);
+        XCTAssertTrue([writer writeUnary:(i % 9)]);
+        XCTAssertTrue([writer writeExpGolomb:(i * i)]);
+        XCTAssertTrue([writer writeSignedExpGolomb:((int64_t)i - 50)]);
+    }
+    XCTAssertTrue([writer writeBits:0x0123456789ABCDEFULL count:64]);
+    [writer alignToByte];
+    XCTAssertTrue([writer writeBits:0xA5 count:8]);
+    XCTAssertTrue([writer flush]);
+    [stream writeByte:0x7E];
+    XCTAssertFalse([writer writeExpGolomb:UINT64_MAX]);
+    XCTAssertEqual([writer error], EINVAL);
+
+    SFBitReader *reader = [[SFBitReader alloc] initWithStream:stream];
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        XCTAssertEqual([reader readBits:3], (uint64_t)(i & 0x07));
+        XCTAssertEqual([reader readBits:11], (uint64_t)((i * 19) & 0x7FF));
+        XCTAssertEqual([reader readBits:17], (uint64_t)((i * 1237) & 0x1FFFF));
+        XCTAssertEqual([reader readUnary], (uint64_t)(i % 9));
+        XCTAssertEqual([reader readExpGolomb], (uint64_t)(i * i));
+        XCTAssertEqual([reader readSignedExpGolomb], ((int64_t)i - 50));
+    }
+    XCTAssertEqual([reader readBits:64], 0x0123456789ABCDEFULL);
+    [reader alignToByte];
+    XCTAssertEqual([reader readBits:8], (uint64_t)0xA5);
+
+    /* Bytes written directly are read directly after synchronizing. */
+    [reader synchronize];
+    XCTAssertEqual([stream readByte], (uint8_t)0x7E);
+    XCTAssertEqual([reader bitsAvailable], (size_t)0);
+    XCTAssertEqual([reader readBits:1], (uint64_t)0);
+    XCTAssertEqual([reader error], ENODATA);
+}
+//}}}
+
+// Benchmarks
+// - (void)testPurgeCycleReport;//{{{
+/**
+ * Simulates a socket read loop that receives 4K blocks and consumes only
+ * complete 1000 bytes frames, leaving partial frames in the buffer. Reports
+ * the time spent by SFStream (memmove on purge) and SFRingStream.
+ **/
+- (void)testPurgeCycleReport
+{
+    NSArray *streams = @[ [[SFStream alloc] initWithCapacity:65536],
+                          [[SFRingStream alloc] initWithCapacity:65536] ];
+    NSMutableData *block = [NSMutableData dataWithLength:4096];
+    uint8_t frame[1000];
+
+    for (id<SFStreamReaderProtocol, SFStreamWriterProtocol> stream in streams)
+    {
+        NSDate *start = [NSDate date];
+
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            [stream write:[block bytes] length:[block length]];
+            while ([stream numberOfBytesAvailable] >= sizeof(frame))
+                [stream read:frame length:sizeof(frame)];
+            [stream purgeReadBytes];
+        }
+
+        NSTimeInterval elapsed = -[start timeIntervalSinceNow];
+        NSLog(@"%s: %.1f MB/s", object_getClassName(stream),
+              ((4096.0 * 100000.0) / (1024.0 * 1024.0)) / elapsed);
+    }
+}
+//}}}
+// - (void)testPrimitiveCodecReport;//{{{
+/**
+ * Reports the cost, in nanoseconds, of each primitive operation using the
+ * Objective-C messages and the inline functions of sfstreamio.h.
+ **/
+- (void)testPrimitiveCodecReport
+{
+    const size_t size = (CODEC_BENCHMARK_COUNT * sizeof(uint64_t));
+    SFStream *stream = [[SFStream alloc] initWithCapacity:size];
+    stream_t *s = [stream handle];
+    uint16_t u16; uint32_t u32; uint64_t u64; float f32; double f64;
+
+    TIME_PRIMITIVE("-writeShort:", [stream reset], [stream writeShort:(uint16_t)i]);
+    TIME_PRIMITIVE("SFStreamWriteShort()", [stream reset], SFStreamWriteShort(s, (uint16_t)i));
+    TIME_PRIMITIVE("-writeBigEndianInt:", [stream reset], [stream writeBigEndianInt:i]);
+    TIME_PRIMITIVE("SFStreamWriteBigEndianInt()", [stream reset], SFStreamWriteBigEndianInt(s, i));
+    TIME_PRIMITIVE("-writeLittleEndianLong:", [stream reset], [stream writeLittleEndianLong:i]);
+    TIME_PRIMITIVE("SFStreamWriteLittleEndianLong()", [stream reset], SFStreamWriteLittleEndianLong(s, i));
+    TIME_PRIMITIVE("-writeBigEndianDouble:", [stream reset], [stream writeBigEndianDouble:i]);
+    TIME_PRIMITIVE("SFStreamWriteBigEndianDouble()", [stream reset], SFStreamWriteBigEndianDouble(s, i));
+
+    /* The stream now has CODEC_BENCHMARK_COUNT * 8 bytes to be read. */
+    TIME_PRIMITIVE("-readShort", [stream setReadPosition:0], u16 = [stream readShort]);
+    TIME_PRIMITIVE("SFStreamReadShort()", [stream setReadPosition:0], SFStreamReadShort(s, &u16));
+    TIME_PRIMITIVE("-readInt", [stream setReadPosition:0], u32 = [stream readInt]);
+    TIME_PRIMITIVE("SFStreamReadInt()", [stream setReadPosition:0], SFStreamReadInt(s, &u32));
+    TIME_PRIMITIVE("-readBigEndianInt", [stream setReadPosition:0], u32 = [stream readBigEndianInt]);
+    TIME_PRIMITIVE("SFStreamReadBigEndianInt()", [stream setReadPosition:0], SFStreamReadBigEndianInt(s, &u32));
+    TIME_PRIMITIVE("-readLittleEndianLong", [stream setReadPosition:0], u64 = [stream readLittleEndianLong]);
+    TIME_PRIMITIVE("SFStreamReadLittleEndianLong()", [stream setReadPosition:0], SFStreamReadLittleEndianLong(s, &u64));
+    TIME_PRIMITIVE("-readBigEndianFloat", [stream setReadPosition:0], f32 = [stream readBigEndianFloat]);
+    TIME_PRIMITIVE("SFStreamReadBigEndianFloat()", [stream setReadPosition:0], SFStreamReadBigEndianFloat(s, &f32));
+    TIME_PRIMITIVE("-readBigEndianDouble", [stream setReadPosition:0], f64 = [stream readBigEndianDouble]);
+    TIME_PRIMITIVE("SFStreamReadBigEndianDouble()", [stream setReadPosition:0], SFStreamReadBigEndianDouble(s, &f64));
+
+    XCTAssertEqual([stream length], size);
+}
+//}}}
+// - (void)testTypedArrayThroughputReport;//{{{
+/**
+ * Compares decoding an array of big-endian floats element by element and
+ * with a single typed array read.
+ **/
+- (void)testTypedArrayThroughputReport
+{
+    SFStream *stream = [[SFStream alloc] initWithCapacity:(ARRAY_BENCHMARK_COUNT * sizeof(float))];
+    float *values = (float *)malloc(ARRAY_BENCHMARK_COUNT * sizeof(float));
+    double bytes = (double)(ARRAY_BENCHMARK_COUNT * sizeof(float));
+    NSDate *start;
+
+    for (size_t i = 0; i < ARRAY_BENCHMARK_COUNT; ++i)
+        [stream writeBigEndianFloat:(float)i];
+
+    start = [NSDate date];
+    for (size_t i = 0; i < ARRAY_BENCHMARK_COUNT; ++i)
+        values[i] = [stream readBigEndianFloat];
+    NSTimeInterval single = -[start timeIntervalSinceNow];
+
+    [stream setReadPosition:0];
+    start = [NSDate date];
+    XCTAssertTrue([stream readBigEndianFloatArray:values count:ARRAY_BENCHMARK_COUNT]);
+    NSTimeInterval bulk = -[start timeIntervalSinceNow];
+
+    XCTAssertEqual(values[ARRAY_BENCHMARK_COUNT - 1], (float)(ARRAY_BENCHMARK_COUNT - 1));
+    NSLog(@"readBigEndianFloat:      %8.3f GB/s", ((bytes / single) / 1e9));
+    NSLog(@"readBigEndianFloatArray: %8.3f GB/s", ((bytes / bulk) / 1e9));
+    free(values);
+}
+//}}}
+// - (void)testChecksumThroughputReport;//{{{
+/**
+ * Compares a byte by byte CRC32C with the accelerated one and the 64 bits
+ * hash.
+ **/
+- (void)testChecksumThroughputReport
+{
+    uint8_t *data = (uint8_t *)malloc(CHECKSUM_BENCHMARK_SIZE);
+    const double bytes = (double)CHECKSUM_BENCHMARK_SIZE;
+    uint32_t crc = 0xFFFFFFFF;
+    NSDate *start;
+
+    for (size_t i = 0; i < CHECKSUM_BENCHMARK_SIZE; ++i) data[i] = (uint8_t)(i * 131);
+    SFStream *stream = [[SFStream alloc] initWithBytes:data length:CHECKSUM_BENCHMARK_SIZE];
+
+    start = [NSDate date];
+    for (size_t i = 0; i < CHECKSUM_BENCHMARK_SIZE; ++i)
+    {
+        crc ^= data[i];
+        for (int k = 0; k < 8; ++k)
+            crc = ((crc & 1) ? ((crc >> 1) ^ 0x82F63B78U) : (crc >> 1));
+    }
+    NSTimeInterval bitwise = -[start timeIntervalSinceNow];
+
+    start = [NSDate date];
+    uint32_t fast = [stream crc32cOfLength:CHECKSUM_BENCHMARK_SIZE];
+    NSTimeInterval accelerated = -[start timeIntervalSinceNow];
+
+    start = [NSDate date];
+    [stream hash64OfLength:CHECKSUM_BENCHMARK_SIZE seed:0];
+    NSTimeInterval hashed = -[start timeIntervalSinceNow];
+
+    XCTAssertEqual(fast, ~crc);
+    NSLog(@"CRC32C byte by byte: %8.3f GB/s", ((bytes / bitwise) / 1e9));
+    NSLog(@"CRC32C accelerated:  %8.3f GB/s", ((bytes / accelerated) / 1e9));
+    NSLog(@"Hash64:              %8.3f GB/s", ((bytes / hashed) / 1e9));
+    free(data);
+}
+//}}}
+// - (void)testBitFieldDecodeReport;//{{{
+/**
+ * Compares decoding packed 3, 11 and 17 bits fields by shifting bytes read
+ * one at a time, with SFBitReader messages and with the inline functions.
+ **/
+- (void)testBitFieldDecodeReport
+{
+    SFStream *stream = [[SFStream alloc] initWithCapacity:(BITS_BENCHMARK_COUNT * 4)];
+    SFBitWriter *writer = [[SFBitWriter alloc] initWithStream:stream];
+    const double fields = (3.0 * BITS_BENCHMARK_COUNT);
+    const unsigned widths[3] = { 3, 11, 17 };
+    uint64_t manual = 0, messages = 0, inlined = 0, value;
+    NSDate *start;
+
+    for (uint32_t i = 0; i < BITS_BENCHMARK_COUNT; ++i)
+    {
+        [writer writeBits:i count:3];
+        [writer writeBits:i count:11];
+        [writer writeBits:i count:17];
+    }
+    [writer flush];
+
+    start = [NSDate date];
+    uint64_t acc = 0;
+    unsigned bits = 0;
+    for (uint32_t i = 0; i < (3 * BITS_BENCHMARK_COUNT); ++i)
+    {
+        unsigned width = widths[i % 3];
+        while (bits < width) {
+            acc = ((acc << 8) | [stream readByte]);
+            bits += 8;
+        }
+        bits -= width;
+        manual += ((acc >> bits) & ((1ULL << width) - 1));
+    }
+    NSTimeInterval shifted = -[start timeIntervalSinceNow];
+
+    [stream setReadPosition:0];
+    SFBitReader *reader = [[SFBitReader alloc] initWithStream:stream];
+    start = [NSDate date];
+    for (uint32_t i = 0; i < (3 * BITS_BENCHMARK_COUNT); ++i)
+        messages += [reader readBits:widths[i % 3]];
+    NSTimeInterval sent = -[start timeIntervalSinceNow];
+
+    [stream setReadPosition:0];
+    bitreader_t r;
+    SFBitReaderInit(&r, [stream handle]);
+    start = [NSDate date];
+    for (uint32_t i = 0; i < (3 * BITS_BENCHMARK_COUNT); ++i)
+    {
+        SFBitReaderRead(&r, widths[i % 3], &value);
+        inlined += value;
+    }
+    NSTimeInterval direct = -[start timeIntervalSinceNow];
+
+    XCTAssertEqual(manual, messages);
+    XCTAssertEqual(manual, inlined);
+    NSLog(@"Shifting bytes:    %8.2f M fields/s", ((fields / shifted) / 1e6));
+    NSLog(@"-readBits:         %8.2f M fields/s", ((fields / sent) / 1e6));
+    NSLog(@"SFBitReaderRead(): %8.2f M fields/s", ((fields / direct) / 1e6));
+}
+//}}}
+// - (void)testWriteThroughputReport;//{{{
+/**
+ * Reports, in MB/s, the throughput of small primitive writes and bulk writes
+ * with the old exact growth (factor 1.0) and the geometric growth.
+ **/
+- (void)testWriteThroughputReport
+{
+    NSMutableData *chunk = [NSMutableData dataWithLength:4096];
+    const size_t ints = (WRITE_BENCHMARK_SIZE / sizeof(uint32_t));
+    const size_t chunks = (WRITE_BENCHMARK_SIZE / [chunk length]);
+    const double megabytes = ((double)WRITE_BENCHMARK_SIZE / (1024.0 * 1024.0));
+    float factors[] = { 1.0f, 2.0f };
+
+    for (size_t f = 0; f < (sizeof(factors) / sizeof(float)); ++f)
+    {
+        SFStream *stream = [[SFStream alloc] init];
+        stream.growthFactor = factors[f];
+        NSTimeInterval small = [self writeIntsIn:stream count:ints];
+
+        stream = [[SFStream alloc] init];
+        stream.growthFactor = factors[f];
+        NSTimeInterval bulk = [self writeChunksIn:stream from:chunk count:chunks];
+
+        stream = [[SFStream alloc] initWithCapacity:WRITE_BENCHMARK_SIZE];
+        NSTimeInterval reserved = [self writeIntsIn:stream count:ints];
+
+        NSLog(@"SFStream growth %.1f: writeInt %.1f MB/s, 4K writes %.1f MB/s, writeInt presized %.1f MB/s",
+              factors[f], (megabytes / small), (megabytes / bulk), (megabytes / reserved));
+    }
+}
+//}}}
+// - (void)testPerformanceWriteIntExactGrowth;//{{{
+- (void)testPerformanceWriteIntExactGrowth
+{
+    [self measureBlock:^{
+        SFStream *stream = [[SFStream alloc] init];
+        stream.growthFactor = 1.0f;
+        [self writeIntsIn:stream count:(WRITE_BENCHMARK_SIZE / sizeof(uint32_t))];
+    }];
+}
+//}}}
+// - (void)testPerformanceWriteIntGeometricGrowth;//{{{
+- (void)testPerformanceWriteIntGeometricGrowth
+{
+    [self measureBlock:^{
+        SFStream *stream = [[SFStream alloc] init];
+        [self writeIntsIn:stream count:(WRITE_BENCHMARK_SIZE / sizeof(uint32_t))];
+    }];
+}
+//}}}
+// - (void)testPerformanceBulkWrite;//{{{
+- (void)testPerformanceBulkWrite
+{
+    NSMutableData *chunk = [NSMutableData dataWithLength:4096];
+
+    [self measureBlock:^{
+        SFStream *stream = [[SFStream alloc] init];
+        [self writeChunksIn:stream from:chunk count:(WRITE_BENCHMARK_SIZE / [chunk length])];
+    }];
+}
+//}}}
+@end